@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+
+// 전역 operator new를 교체해 힙 할당 횟수를 센다 (configs.h ALLOC_COUNTER 1일 때만 교체)
+// 정상 재생 중 프레임당 할당이 0인지 확인하는 용도 - 구간 전후 count() 차이로 측정
+class AllocCounter {
+public:
+    static uint64_t count();    // 프로그램 시작 이후 누적 할당 횟수
+    static uint64_t bytes();    // 누적 할당 바이트
+};
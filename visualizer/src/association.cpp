@@ -0,0 +1,221 @@
+#include "association.h"
+#include "configs.h"
+#include "parallel_utils.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <fstream>
+
+#define ASSOC_POINT_GRAIN   16384   // 스레드가 한 번에 가져가는 점 수
+
+
+void Association::buildGrid(const ObjBinary& obj) {
+    const size_t n = obj.obj_data.size();
+    box_min.assign(n * 3, 0.0f);
+    box_max.assign(n * 3, 0.0f);
+    grid_nx = grid_ny = 0;
+
+    float lo_x = std::numeric_limits<float>::max(), lo_y = lo_x;
+    float hi_x = -std::numeric_limits<float>::max(), hi_y = hi_x;
+    bool any = false;
+    for(size_t b = 0; b < n; ++b) {
+        const ObjData& o = obj.obj_data[b];
+        box_min[b * 3 + 0] = std::min(o.min_x, o.max_x);  box_max[b * 3 + 0] = std::max(o.min_x, o.max_x);
+        box_min[b * 3 + 1] = std::min(o.min_y, o.max_y);  box_max[b * 3 + 1] = std::max(o.min_y, o.max_y);
+        box_min[b * 3 + 2] = std::min(o.min_z, o.max_z);  box_max[b * 3 + 2] = std::max(o.min_z, o.max_z);
+        if(o.obj_id == -1) {
+            continue;
+        }
+        any = true;
+        lo_x = std::min(lo_x, box_min[b * 3 + 0]);  hi_x = std::max(hi_x, box_max[b * 3 + 0]);
+        lo_y = std::min(lo_y, box_min[b * 3 + 1]);  hi_y = std::max(hi_y, box_max[b * 3 + 1]);
+    }
+    if(!any) {
+        return;
+    }
+
+    // 박스 전체를 덮는 격자 - 셀 수가 너무 많으면 셀 크기를 키움
+    cell_size = ASSOC_CELL_SIZE;
+    float span = std::max(hi_x - lo_x, hi_y - lo_y);
+    if(span / cell_size > ASSOC_MAX_GRID_DIM) {
+        cell_size = span / ASSOC_MAX_GRID_DIM;
+    }
+    grid_min_x = lo_x;
+    grid_min_y = lo_y;
+    grid_nx = static_cast<int>((hi_x - lo_x) / cell_size) + 1;
+    grid_ny = static_cast<int>((hi_y - lo_y) / cell_size) + 1;
+
+    // 2 pass CSR : 셀별 박스 수 -> 누적 시작 위치 -> 채우기
+    cell_start.assign(static_cast<size_t>(grid_nx) * grid_ny + 1, 0);
+    auto forEachCell = [&](size_t b, auto&& fn) {
+        int x0 = static_cast<int>((box_min[b * 3 + 0] - grid_min_x) / cell_size);
+        int x1 = static_cast<int>((box_max[b * 3 + 0] - grid_min_x) / cell_size);
+        int y0 = static_cast<int>((box_min[b * 3 + 1] - grid_min_y) / cell_size);
+        int y1 = static_cast<int>((box_max[b * 3 + 1] - grid_min_y) / cell_size);
+        for(int cy = y0; cy <= y1; ++cy)
+            for(int cx = x0; cx <= x1; ++cx)
+                fn(static_cast<size_t>(cy) * grid_nx + cx);
+    };
+    for(size_t b = 0; b < n; ++b) {
+        if(obj.obj_data[b].obj_id == -1) continue;
+        forEachCell(b, [&](size_t cell) { ++cell_start[cell + 1]; });
+    }
+    for(size_t c = 1; c < cell_start.size(); ++c) {
+        cell_start[c] += cell_start[c - 1];
+    }
+    cell_boxes.resize(cell_start.back());
+    cell_fill.assign(cell_start.begin(), cell_start.end() - 1);
+    for(size_t b = 0; b < n; ++b) {
+        if(obj.obj_data[b].obj_id == -1) continue;
+        forEachCell(b, [&](size_t cell) { cell_boxes[cell_fill[cell]++] = static_cast<uint32_t>(b); });
+    }
+}
+
+
+const std::vector<BoxLidarStats>& Association::associate(const ObjBinary& obj, const LidarBinary& lidar, bool parallel) {
+    // 버퍼를 재사용하는 호출자(원격 보기 클라이언트)도 있으므로 주소 + 시간으로 같은 프레임 판단
+    if(&obj == last_obj && &lidar == last_lidar && obj.time == last_obj_time && lidar.time == last_lidar_time) {
+        return stats;
+    }
+    last_obj = &obj;
+    last_lidar = &lidar;
+    last_obj_time = obj.time;
+    last_lidar_time = lidar.time;
+
+    const size_t boxes = obj.obj_data.size();
+    stats.assign(boxes, BoxLidarStats());
+    buildGrid(obj);
+    if(grid_nx == 0) {
+        return stats;
+    }
+
+    const size_t workers = parallel ? workerCount() : 1;
+    worker_count.resize(workers);
+    worker_refl.resize(workers);
+    worker_nearest.resize(workers);
+    for(size_t w = 0; w < workers; ++w) {
+        worker_count[w].assign(boxes, 0);
+        worker_refl[w].assign(boxes, 0.0);
+        worker_nearest[w].assign(boxes, std::numeric_limits<float>::max());
+    }
+
+    const auto& points = lidar.lidar_data;
+    const float inv_cell = 1.0f / cell_size;
+
+    parallelFor(points.size(), ASSOC_POINT_GRAIN, workers, [&](size_t begin, size_t end, size_t worker) {
+        uint32_t* count = worker_count[worker].data();
+        double* refl = worker_refl[worker].data();
+        float* nearest = worker_nearest[worker].data();
+
+        for(size_t i = begin; i < end; ++i) {
+            const LidarData& p = points[i];
+            int cx = static_cast<int>(std::floor((p.x - grid_min_x) * inv_cell));
+            int cy = static_cast<int>(std::floor((p.y - grid_min_y) * inv_cell));
+            if(cx < 0 || cy < 0 || cx >= grid_nx || cy >= grid_ny) {
+                continue;       // 모든 박스 밖
+            }
+            size_t cell = static_cast<size_t>(cy) * grid_nx + cx;
+            for(uint32_t k = cell_start[cell]; k < cell_start[cell + 1]; ++k) {
+                uint32_t b = cell_boxes[k];
+                const float* bmin = &box_min[b * 3];
+                const float* bmax = &box_max[b * 3];
+                if(p.x < bmin[0] || p.x > bmax[0] || p.y < bmin[1] || p.y > bmax[1] || p.z < bmin[2] || p.z > bmax[2]) {
+                    continue;
+                }
+                ++count[b];
+                refl[b] += p.reflectivity;
+                float range = std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
+                nearest[b] = std::min(nearest[b], range);
+            }
+        }
+    });
+
+    for(size_t b = 0; b < boxes; ++b) {
+        uint32_t count = 0;
+        double refl = 0.0;
+        float nearest = std::numeric_limits<float>::max();
+        for(size_t w = 0; w < workers; ++w) {
+            count += worker_count[w][b];
+            refl += worker_refl[w][b];
+            nearest = std::min(nearest, worker_nearest[w][b]);
+        }
+        stats[b].point_count = count;
+        if(count > 0) {
+            stats[b].nearest_range = nearest;
+            stats[b].mean_reflectivity = static_cast<float>(refl / count);
+        }
+    }
+    return stats;
+}
+
+
+bool Association::exportCsv(const std::string& filename, const std::vector<ObjBinary>& obj_list,
+                            const std::vector<LidarBinary>& lidar_list, const std::vector<int>& obj_to_lidar_mapping,
+                            const CompactLidarStore* compact) {
+    std::ofstream ofs(filename);
+    if(!ofs) {
+        std::cerr << "Failed to open association table: " << filename << std::endl;
+        return false;
+    }
+
+    MyTimer timer;
+
+    // 프레임 단위 병렬 (프레임 내부는 직렬) -> 결과는 프레임 순서대로 기록
+    std::vector<std::vector<BoxLidarStats>> frame_stats(obj_list.size());
+    const size_t workers = workerCount();
+    std::vector<Association> worker_assoc(workers);
+    std::vector<LidarBinary> worker_frames(workers);       // --compact : 스레드별 복원 버퍼
+    parallelFor(obj_list.size(), 16, workers, [&](size_t begin, size_t end, size_t worker) {
+        for(size_t f = begin; f < end; ++f) {
+            int lidar_idx = (f < obj_to_lidar_mapping.size()) ? obj_to_lidar_mapping[f] : -1;
+            if(lidar_idx < 0) {
+                continue;
+            }
+            const LidarBinary& lidar = CompactLidarStore::view(compact, lidar_list, lidar_idx, worker_frames[worker]);
+            frame_stats[f] = worker_assoc[worker].associate(obj_list[f], lidar, false);
+        }
+    });
+
+    ofs << "obj_frame,obj_time,lidar_frame,lidar_time,det_idx,obj_id,label,reported_distance,"
+           "point_count,nearest_range,range_error,mean_reflectivity\n";
+
+    size_t rows = 0;
+    for(size_t f = 0; f < obj_list.size(); ++f) {
+        int lidar_idx = (f < obj_to_lidar_mapping.size()) ? obj_to_lidar_mapping[f] : -1;
+        const auto& objs = obj_list[f].obj_data;
+        for(size_t d = 0; d < objs.size(); ++d) {
+            if(objs[d].obj_id == -1) {
+                continue;
+            }
+            auto it = objId_to_label.find(objs[d].obj_id);
+            const char* label = (it != objId_to_label.end()) ? it->second.c_str() : "unknown";
+
+            ofs << f << "," << obj_list[f].time << ",";
+            if(lidar_idx < 0) {
+                ofs << ",,";
+            } else {
+                ofs << lidar_idx << "," << lidar_list[lidar_idx].time << ",";
+            }
+            ofs << d << "," << objs[d].obj_id << "," << label << "," << objs[d].distance << ",";
+
+            if(lidar_idx < 0) {
+                ofs << ",,,\n";
+            } else {
+                const BoxLidarStats& s = frame_stats[f][d];
+                ofs << s.point_count << ",";
+                if(s.point_count > 0) {
+                    ofs << s.nearest_range << "," << (objs[d].distance - s.nearest_range) << "," << s.mean_reflectivity << "\n";
+                } else {
+                    ofs << ",,\n";
+                }
+            }
+            ++rows;
+        }
+    }
+
+    timer.end();
+    std::cout << "\n[Export] association table: " << filename << " (" << rows << " rows, "
+              << std::chrono::duration<double, std::milli>(timer.end_time - timer.start_time).count() << " ms)" << std::endl;
+    return true;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include "binary_utils.h"
+#include "compact_lidar.h"
+
+
+// 객체 박스 하나에 들어간 라이다 점 통계
+struct BoxLidarStats {
+    uint32_t point_count = 0;
+    float nearest_range = -1.0f;        // 박스 내 점의 원점 최단거리 (점 없으면 -1)
+    float mean_reflectivity = 0.0f;
+};
+
+// 라이다 점 -> 객체 박스 할당 (xy 균일 격자로 후보 박스만 검사, 점 x 박스 전수 비교 없음)
+class Association {
+public:
+    // 같은 (객체, 라이다) 프레임 쌍이면 다시 계산하지 않음
+    // out_stats[i]는 obj.obj_data[i]에 대응 (obj_id == -1 박스는 빈 통계)
+    const std::vector<BoxLidarStats>& associate(const ObjBinary& obj, const LidarBinary& lidar, bool parallel = true);
+
+    // 전체 녹화 표 : 객체 프레임마다 obj_to_lidar_mapping의 라이다 프레임으로 계산해 CSV 저장 (compact : --compact 저장소)
+    static bool exportCsv(const std::string& filename, const std::vector<ObjBinary>& obj_list,
+                          const std::vector<LidarBinary>& lidar_list, const std::vector<int>& obj_to_lidar_mapping,
+                          const CompactLidarStore* compact = nullptr);
+
+private:
+    void buildGrid(const ObjBinary& obj);
+
+    const ObjBinary* last_obj = nullptr;
+    const LidarBinary* last_lidar = nullptr;
+    uint64_t last_obj_time = 0;
+    uint64_t last_lidar_time = 0;
+
+    // 격자 (CSR) : 셀 -> 겹치는 박스 목록
+    float grid_min_x = 0.0f, grid_min_y = 0.0f;
+    float cell_size = 1.0f;
+    int grid_nx = 0, grid_ny = 0;
+    std::vector<uint32_t> cell_start;
+    std::vector<uint32_t> cell_boxes;
+    std::vector<uint32_t> cell_fill;            // CSR 채우기 위치 (capacity 재사용)
+    std::vector<float> box_min, box_max;        // 박스별 xyz (정렬된 min/max)
+
+    std::vector<std::vector<uint32_t>> worker_count;    // 스레드별 누적
+    std::vector<std::vector<double>> worker_refl;
+    std::vector<std::vector<float>> worker_nearest;
+
+    std::vector<BoxLidarStats> stats;
+};
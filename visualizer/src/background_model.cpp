@@ -0,0 +1,143 @@
+#include "background_model.h"
+#include "configs.h"
+
+#include <cmath>
+#include <bitset>
+
+
+// 21bit씩 묶음 (voxel 0.2m 기준 약 ±200km)
+static inline uint64_t voxelKey(int64_t ix, int64_t iy, int64_t iz) {
+    return ((static_cast<uint64_t>(ix) & 0x1FFFFF) << 42) | ((static_cast<uint64_t>(iy) & 0x1FFFFF) << 21) | (static_cast<uint64_t>(iz) & 0x1FFFFF);
+}
+
+
+const std::vector<uint8_t>& BackgroundModel::getStaticMask() const {
+    return mask;
+}
+
+size_t BackgroundModel::getStaticCount() const {
+    return static_count;
+}
+
+const std::vector<LidarData>& BackgroundModel::getBackgroundPoints() const {
+    return background_points;
+}
+
+uint32_t BackgroundModel::getVersion() const {
+    return version;
+}
+
+size_t BackgroundModel::getVoxelCount() const {
+    return voxels.size();
+}
+
+void BackgroundModel::reset() {
+    voxels.clear();
+    frame_counter = 0;
+    frames_since_refresh = 0;
+    background_points.clear();
+    ++version;
+}
+
+bool BackgroundModel::isStatic(const Voxel& v) const {
+    // 마지막 관측 이후 지난 프레임만큼 이력을 밀어서 창 안의 관측 횟수를 셈
+    uint32_t age = frame_counter - v.last_frame;
+    if(age >= BG_HISTORY_FRAMES) {
+        return false;
+    }
+    uint32_t window = (BG_HISTORY_FRAMES >= 32) ? 0xFFFFFFFFu : ((1u << BG_HISTORY_FRAMES) - 1);
+    uint32_t history = (v.history << age) & window;
+    return std::bitset<32>(history).count() >= BG_STATIC_HITS;
+}
+
+
+// 이번 프레임 관측 기록 (프레임당 한 번만 이력 이동)
+// 대표점은 voxel 안의 점으로만 갱신 - 면 이웃 관측의 점은 이웃 voxel 밖에 있음
+BackgroundModel::Voxel& BackgroundModel::observe(uint64_t key, const LidarData& p, bool own) {
+    auto it = voxels.find(key);
+    if(it == voxels.end()) {
+        Voxel v;
+        v.history = 1;
+        v.last_frame = frame_counter;
+        v.has_point = 0;
+        v.static_now = 0;
+        it = voxels.emplace(key, v).first;
+    } else if(it->second.last_frame != frame_counter) {
+        Voxel& v = it->second;
+        v.static_now = isStatic(v) ? 1 : 0;
+        uint32_t age = frame_counter - v.last_frame;
+        v.history = ((age >= 32) ? 0u : (v.history << age)) | 1u;
+        v.last_frame = frame_counter;
+    }
+    Voxel& v = it->second;
+    if(own) {
+        v.point = p;
+        v.has_point = 1;
+    }
+    return v;
+}
+
+
+void BackgroundModel::update(const LidarBinary& frame) {
+    if(&frame == last_frame && frame.time == last_time) {
+        return;
+    }
+    if(last_frame != nullptr && (frame.time < last_time || frame.time - last_time > BG_MAX_GAP_MS)) {
+        reset();        // 탐색 이동 - 이전 이력은 현재 장면과 무관
+    }
+    last_frame = &frame;
+    last_time = frame.time;
+    ++frame_counter;
+
+    const auto& points = frame.lidar_data;
+    const size_t n = points.size();
+    if(mask.size() < n) {
+        mask.resize(n);
+    }
+
+    // 정적 판정은 이번 프레임 반영 전 이력 기준 -> 새로 나타난 물체는 바로 변화 점으로 분류
+    // 경계 근처 점은 면 이웃 voxel도 관측한 것으로 기록 -> 잡음으로 경계를 오가는 정적 표면(경계에 걸친 평면 등)도 정적으로 잡힘
+    const float inv = 1.0f / BG_VOXEL_SIZE;
+    size_t count = 0;
+    for(size_t i = 0; i < n; ++i) {
+        const LidarData& p = points[i];
+        const float fx = p.x * inv, fy = p.y * inv, fz = p.z * inv;
+        const int64_t ix = static_cast<int64_t>(std::floor(fx));
+        const int64_t iy = static_cast<int64_t>(std::floor(fy));
+        const int64_t iz = static_cast<int64_t>(std::floor(fz));
+
+        mask[i] = observe(voxelKey(ix, iy, iz), p, true).static_now;
+        count += mask[i];
+
+        const float rx = fx - ix, ry = fy - iy, rz = fz - iz;
+        if(rx < BG_BORDER_MARGIN)               observe(voxelKey(ix - 1, iy, iz), p, false);
+        else if(rx > 1.0f - BG_BORDER_MARGIN)   observe(voxelKey(ix + 1, iy, iz), p, false);
+        if(ry < BG_BORDER_MARGIN)               observe(voxelKey(ix, iy - 1, iz), p, false);
+        else if(ry > 1.0f - BG_BORDER_MARGIN)   observe(voxelKey(ix, iy + 1, iz), p, false);
+        if(rz < BG_BORDER_MARGIN)               observe(voxelKey(ix, iy, iz - 1), p, false);
+        else if(rz > 1.0f - BG_BORDER_MARGIN)   observe(voxelKey(ix, iy, iz + 1), p, false);
+    }
+    static_count = count;
+
+    if(++frames_since_refresh >= BG_REFRESH_FRAMES) {
+        refreshBackground();
+    }
+}
+
+// 정적 voxel 대표점 다시 모음 + 오래 관측되지 않은 voxel 정리
+void BackgroundModel::refreshBackground() {
+    frames_since_refresh = 0;
+    background_points.clear();
+
+    for(auto it = voxels.begin(); it != voxels.end();) {
+        if(frame_counter - it->second.last_frame >= BG_HISTORY_FRAMES) {
+            it = voxels.erase(it);
+            continue;
+        }
+        if(it->second.has_point && isStatic(it->second)) {
+            background_points.push_back(it->second.point);
+        }
+        ++it;
+    }
+    ++version;
+}
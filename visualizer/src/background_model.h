@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include "binary_utils.h"
+
+
+enum class BackgroundMode { OFF, SPLIT, CHANGES_ONLY };     // 전체 점 / 정적 배경 + 변화 점 / 변화 점만
+
+// voxel hash 정적 배경 모델 - 재생되는 프레임마다 점진적으로 갱신
+// voxel마다 최근 프레임 관측 이력(비트)을 두고 BG_STATIC_HITS 이상 관측되면 정적으로 판정
+class BackgroundModel {
+public:
+    // 프레임을 모델에 반영하고 점별 정적 여부 표시 (같은 프레임이면 다시 계산하지 않음)
+    // 시간이 역행하거나 BG_MAX_GAP_MS 이상 건너뛰면 모델 초기화
+    void update(const LidarBinary& frame);
+
+    const std::vector<uint8_t>& getStaticMask() const;     // 1 : 정적 voxel의 점
+    size_t getStaticCount() const;                          // 현재 프레임의 정적 점 수
+
+    // 정적 배경 점 (voxel 대표점 원본 - 반사도 / cluster_id 포함, 색은 그리는 쪽 모드로), BG_REFRESH_FRAMES 프레임마다 다시 모음 -> 다시 모으면 version 증가
+    const std::vector<LidarData>& getBackgroundPoints() const;
+    uint32_t getVersion() const;
+    size_t getVoxelCount() const;
+
+    void reset();
+
+private:
+    struct Voxel {
+        uint32_t history;       // bit 0 : 가장 최근 처리 프레임
+        uint32_t last_frame;
+        LidarData point;        // 이 voxel 안에 떨어진 마지막 점 (면 이웃 관측은 이력만 갱신)
+        uint8_t has_point;      // 0 : 면 이웃 관측으로만 생긴 voxel (대표점 없음 -> 배경 점에서 제외)
+        uint8_t static_now;     // 이번 프레임 판정 (같은 voxel의 점들이 같은 판정을 받도록)
+    };
+
+    bool isStatic(const Voxel& v) const;
+    Voxel& observe(uint64_t key, const LidarData& p, bool own);    // own : p가 이 voxel 안의 점
+    void refreshBackground();
+
+    std::unordered_map<uint64_t, Voxel> voxels;
+    uint32_t frame_counter = 0;
+    uint32_t frames_since_refresh = 0;
+
+    const LidarBinary* last_frame = nullptr;
+    uint64_t last_time = 0;
+
+    std::vector<uint8_t> mask;
+    size_t static_count = 0;
+
+    std::vector<LidarData> background_points;
+    uint32_t version = 0;
+};
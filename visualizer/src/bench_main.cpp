@@ -0,0 +1,497 @@
+// 벤치마크 CLI : 고정 시드 합성 입력으로 로더 / 타임라인 / 매칭 / picking / 화면 준비 / 렌더링 시간 측정
+// 결과는 사람이 읽는 표(stdout) + JSON 파일 (회귀 추적용)
+// Usage: ./aeronSW_bench [--out bench_results.json] [--quick]
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <filesystem>
+#include <algorithm>
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include "configs.h"
+#include "binary_utils.h"
+#include "timeline.h"
+#include "space.h"
+#include "camera.h"
+#include "viewport_layout.h"
+#include "alloc_counter.h"
+#include "recording_generator.h"
+#include "parallel_utils.h"
+#include "compact_lidar.h"
+#include "picker.h"
+
+
+float orbitRadius = INIT_CAM_RADIUS;      // space.cpp extern (뷰어에서는 main.cpp 소유)
+
+struct BenchResult {
+    std::string name;
+    size_t iterations = 0;
+    double mean_ms = 0.0;
+    double min_ms = 0.0;
+    double max_ms = 0.0;
+    std::vector<std::pair<std::string, double>> metrics;    // MB/s, frames/s 등
+    bool skipped = false;
+};
+
+static std::vector<BenchResult> results;
+
+
+// 한 번 예열 후 iterations회 측정
+template <typename Fn>
+static BenchResult& runBench(const std::string& name, size_t iterations, Fn&& fn) {
+    fn();
+    BenchResult r;
+    r.name = name;
+    r.iterations = iterations;
+    r.min_ms = std::numeric_limits<double>::max();
+    double total = 0.0;
+    for(size_t i = 0; i < iterations; ++i) {
+        MyTimer timer;
+        fn();
+        timer.end();
+        double ms = std::chrono::duration<double, std::milli>(timer.end_time - timer.start_time).count();
+        total += ms;
+        r.min_ms = std::min(r.min_ms, ms);
+        r.max_ms = std::max(r.max_ms, ms);
+    }
+    r.mean_ms = total / static_cast<double>(iterations);
+    results.push_back(r);
+    return results.back();
+}
+
+static void skipBench(const std::string& name) {
+    BenchResult r;
+    r.name = name;
+    r.skipped = true;
+    results.push_back(r);
+}
+
+
+// 로더는 프레임마다 콘솔 출력 -> 측정 중에는 버림 (rdbuf 복구 시 상태도 복구됨)
+struct MuteConsole {
+    std::streambuf* out = std::cout.rdbuf(nullptr);
+    std::streambuf* err = std::cerr.rdbuf(nullptr);
+    ~MuteConsole() {
+        std::cout.rdbuf(out);
+        std::cerr.rdbuf(err);
+    }
+};
+
+
+//============================= 합성 입력 (고정 시드, RecordingGenerator) =================================
+template <typename Frame, typename Item>
+static bool writeFrames(const std::string& filename, const std::vector<Frame>& frames, const std::vector<Item> Frame::* items) {
+    std::ofstream ofs(filename, std::ios::binary);
+    for(const auto& f : frames) {
+        ofs.write(reinterpret_cast<const char*>(&f.time), sizeof(f.time));
+        ofs.write(reinterpret_cast<const char*>(&f.num), sizeof(f.num));
+        ofs.write(reinterpret_cast<const char*>((f.*items).data()), (f.*items).size() * sizeof(Item));
+    }
+    return static_cast<bool>(ofs);
+}
+
+
+//============================= 결과 출력 =================================
+static void printResults() {
+    std::cout << "\n" << std::left << std::setw(36) << "benchmark" << std::right << std::setw(8) << "iters"
+              << std::setw(12) << "mean ms" << std::setw(12) << "min ms" << std::setw(12) << "max ms" << "  metrics" << std::endl;
+    for(const auto& r : results) {
+        std::cout << std::left << std::setw(36) << r.name << std::right;
+        if(r.skipped) {
+            std::cout << "  skipped (no GL context)" << std::endl;
+            continue;
+        }
+        std::cout << std::setw(8) << r.iterations << std::fixed << std::setprecision(3)
+                  << std::setw(12) << r.mean_ms << std::setw(12) << r.min_ms << std::setw(12) << r.max_ms << " ";
+        for(const auto& m : r.metrics) {
+            std::cout << " " << std::setprecision(1) << m.second << " " << m.first;
+        }
+        std::cout << std::endl;
+    }
+}
+
+static bool writeJson(const std::string& filename, size_t lidar_frames, size_t lidar_points) {
+    std::ofstream ofs(filename);
+    if(!ofs) {
+        std::cerr << "Failed to open benchmark output: " << filename << std::endl;
+        return false;
+    }
+    ofs << std::setprecision(6) << "{\n  \"config\": {\"seed\": " << BENCH_SEED << ", \"lidar_frames\": " << lidar_frames
+        << ", \"lidar_points\": " << lidar_points << ", \"obj_per_frame\": " << BENCH_OBJ_PER_FRAME
+        << ", \"timeline_frames\": " << BENCH_TIMELINE_FRAMES
+        << ", \"workers\": " << WorkerPool::instance().size() << "},\n  \"benchmarks\": [\n";
+    for(size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        ofs << "    {\"name\": \"" << r.name << "\"";
+        if(r.skipped) {
+            ofs << ", \"skipped\": true";
+        } else {
+            ofs << ", \"iterations\": " << r.iterations << ", \"mean_ms\": " << r.mean_ms
+                << ", \"min_ms\": " << r.min_ms << ", \"max_ms\": " << r.max_ms;
+            for(const auto& m : r.metrics) {
+                ofs << ", \"" << m.first << "\": " << m.second;
+            }
+        }
+        ofs << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    ofs << "  ]\n}\n";
+    return true;
+}
+
+
+int main(int argc, char* argv[]) {
+    std::string out_file = "bench_results.json";
+    bool quick = false;
+    for(int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if(arg == "--out" && i + 1 < argc)  out_file = argv[++i];
+        else if(arg == "--quick")           quick = true;
+        else {
+            std::cout << "Usage: ./aeronSW_bench [--out bench_results.json] [--quick]" << std::endl;
+            return -1;
+        }
+    }
+
+    const size_t lidar_frames = quick ? BENCH_LIDAR_FRAMES / 10 : BENCH_LIDAR_FRAMES;
+    const size_t lidar_points = BENCH_LIDAR_POINTS;
+    const size_t iterations = quick ? 2 : 5;
+
+    // 라이다 10Hz, 객체인식 10Hz (라이다 사이 50ms 지점)
+    GeneratorOptions gen_options;
+    gen_options.points = static_cast<uint32_t>(lidar_points);
+    gen_options.detections = BENCH_OBJ_PER_FRAME;
+    gen_options.seed = BENCH_SEED;
+    RecordingGenerator generator(gen_options);
+    std::mt19937 rng(BENCH_SEED);
+    const uint64_t t0 = generator.getStartTimeMs();
+    std::vector<LidarBinary> lidar_src(lidar_frames);
+    std::vector<ObjBinary> obj_src(lidar_frames);
+    for(size_t f = 0; f < lidar_frames; ++f) {
+        generator.makeLidarFrame(f, t0 + f * 100, lidar_src[f]);
+        generator.makeObjFrame(f, t0 + f * 100 + 50, obj_src[f]);
+    }
+
+    std::filesystem::path tmp_dir = std::filesystem::temp_directory_path();
+    std::string lidar_file = (tmp_dir / "aeronSW_bench.uld").string();
+    std::string obj_file = (tmp_dir / "aeronSW_bench.udd").string();
+    if(!writeFrames(lidar_file, lidar_src, &LidarBinary::lidar_data) || !writeFrames(obj_file, obj_src, &ObjBinary::obj_data)) {
+        std::cerr << "Failed to write benchmark input to " << tmp_dir << std::endl;
+        return 1;
+    }
+    const double lidar_mb = std::filesystem::file_size(lidar_file) / (1024.0 * 1024.0);
+    const double obj_mb = std::filesystem::file_size(obj_file) / (1024.0 * 1024.0);
+    std::cout << "Input: " << lidar_frames << " lidar frames x " << lidar_points << " points (" << std::fixed << std::setprecision(1)
+              << lidar_mb << " MB), " << lidar_frames << " obj frames x " << BENCH_OBJ_PER_FRAME << std::endl;
+
+
+    //============================= 로더 =================================
+    std::vector<LidarBinary> lidar_list;
+    std::vector<ObjBinary> obj_list;
+    {
+        BenchResult& r = runBench("load_lidar_binary", iterations, [&] {
+            MuteConsole mute;
+            lidar_list.clear();
+            BinaryUtils::load_lidar_binary(lidar_file, lidar_list);
+        });
+        r.metrics.push_back({"MB/s", lidar_mb / (r.mean_ms / 1000.0)});
+        r.metrics.push_back({"frames/s", lidar_list.size() / (r.mean_ms / 1000.0)});
+    }
+    {
+        BenchResult& r = runBench("load_obj_binary", iterations, [&] {
+            MuteConsole mute;
+            obj_list.clear();
+            BinaryUtils::load_obj_binary(obj_file, obj_list);
+        });
+        r.metrics.push_back({"MB/s", obj_mb / (r.mean_ms / 1000.0)});
+        r.metrics.push_back({"frames/s", obj_list.size() / (r.mean_ms / 1000.0)});
+    }
+    std::filesystem::remove(lidar_file);
+    std::filesystem::remove(obj_file);
+
+
+    //============================= 압축 메모리 표현 (--compact) =================================
+    // 원래 배치 복사(lidar_copy)가 비교 기준 : 압축하지 않으면 프레임을 올릴 때 드는 최소 비용
+    {
+        std::vector<CompactLidarFrame> compact(lidar_list.size());
+        uint64_t compact_bytes = 0;
+        BenchResult& enc = runBench("compact_encode", iterations, [&] {
+            for(size_t f = 0; f < lidar_list.size(); ++f) {
+                CompactLidarStore::encode(lidar_list[f], compact[f]);
+            }
+        });
+        for(const CompactLidarFrame& c : compact) {
+            compact_bytes += c.xyz.size() * sizeof(uint16_t) + c.reflectivity.size() + c.cluster.size() * sizeof(uint16_t) +
+                             c.non_finite.size() * sizeof(CompactNonFinite);
+        }
+        const double points = static_cast<double>(lidar_points) * lidar_list.size();
+        enc.metrics.push_back({"Mpoints/s", points / (enc.mean_ms * 1000.0)});
+        enc.metrics.push_back({"bytes/point", compact_bytes / points});
+
+        LidarBinary scratch;
+        BenchResult& dec = runBench("compact_decode", iterations, [&] {
+            for(const CompactLidarFrame& c : compact) {
+                CompactLidarStore::decode(c, scratch);
+            }
+        });
+        dec.metrics.push_back({"Mpoints/s", points / (dec.mean_ms * 1000.0)});
+
+        std::vector<LidarData> copy;
+        BenchResult& raw = runBench("lidar_copy", iterations, [&] {
+            for(const LidarBinary& frame : lidar_list) {
+                copy.assign(frame.lidar_data.begin(), frame.lidar_data.end());
+            }
+        });
+        raw.metrics.push_back({"Mpoints/s", points / (raw.mean_ms * 1000.0)});
+        raw.metrics.push_back({"bytes/point", static_cast<double>(sizeof(LidarData))});
+    }
+
+
+    //============================= 타임라인 / 매칭 =================================
+    // 긴 녹화를 흉내낸 헤더만 있는 프레임 목록 (점 데이터 없음), 센서 주기에 지터
+    std::vector<LidarBinary> long_lidar(BENCH_TIMELINE_FRAMES);
+    std::vector<ObjBinary> long_obj(BENCH_TIMELINE_FRAMES);
+    {
+        std::uniform_int_distribution<uint64_t> jitter(0, 20);
+        for(size_t f = 0; f < BENCH_TIMELINE_FRAMES; ++f) {
+            long_lidar[f].time = t0 + f * 100 + jitter(rng);
+            long_obj[f].time = t0 + f * 100 + 40 + jitter(rng);
+        }
+    }
+    std::vector<UnifiedData> timeline;
+    {
+        BenchResult& r = runBench("timeline_build", iterations, [&] {
+            Timeline::build(long_lidar, long_obj, timeline);
+        });
+        r.metrics.push_back({"entries/s", timeline.size() / (r.mean_ms / 1000.0)});
+    }
+    {
+        std::vector<size_t> lidar_to_timeline, obj_to_timeline;
+        runBench("timeline_reverse_index", iterations, [&] {
+            Timeline::buildReverseIndex(timeline, long_lidar.size(), long_obj.size(), lidar_to_timeline, obj_to_timeline);
+        });
+    }
+    {
+        std::vector<int> mapping;
+        BenchResult& r = runBench("obj_to_lidar_mapping", iterations, [&] {
+            Timeline::buildObjToLidarMapping(long_obj, long_lidar, mapping);
+        });
+        r.metrics.push_back({"frames/s", long_obj.size() / (r.mean_ms / 1000.0)});
+    }
+    {
+        // 녹화 구간 전체에 고르게 흩어진 질의
+        const size_t queries = 100000;
+        std::vector<uint64_t> query_times(queries);
+        std::uniform_int_distribution<uint64_t> qt(t0, t0 + BENCH_TIMELINE_FRAMES * 100);
+        for(auto& t : query_times) t = qt(rng);
+        BinaryUtils utils;
+        volatile int sink = 0;
+        BenchResult& r = runBench("findClosestLidarFrame", iterations, [&] {
+            int acc = 0;
+            for(uint64_t t : query_times) acc += utils.findClosestLidarFrame(t, long_lidar);
+            sink = acc;
+        });
+        (void)sink;
+        r.metrics.push_back({"ns/query", r.mean_ms * 1e6 / queries});
+    }
+
+
+    //============================= picking (광선 -> 점 BVH, GL 불필요) =================================
+    {
+        GeneratorOptions pick_options = gen_options;
+        pick_options.points = BENCH_PICK_POINTS;
+        LidarBinary pick_frames[2];         // 번갈아 넘겨 매 클릭 BVH 재생성 (재생 중 클릭 = 새 프레임)
+        RecordingGenerator(pick_options).makeLidarFrame(0, t0, pick_frames[0]);
+        pick_frames[1] = pick_frames[0];
+        const glm::vec3 eye(30.0f, -30.0f, 20.0f);
+        std::uniform_int_distribution<size_t> target(0, pick_frames[0].lidar_data.size() - 1);
+        Picker picker;
+        size_t frame_sel = 0;
+        double build_ms = 0.0, query_ms = 0.0;
+        size_t picks = 0;
+        auto pickPoint = [&](const LidarBinary& frame) {
+            const LidarData& p = frame.lidar_data[target(rng)];
+            picker.pick(eye, glm::normalize(glm::vec3(p.x, p.y, p.z) - eye), &frame, nullptr);
+            build_ms += picker.getResult().build_ms;
+            query_ms += picker.getResult().elapsed_ms;
+            ++picks;
+        };
+        const std::string suffix = std::to_string(BENCH_PICK_POINTS);
+        BenchResult& r = runBench("pick_build_query_" + suffix, iterations, [&] {
+            frame_sel ^= 1;
+            pickPoint(pick_frames[frame_sel]);
+        });
+        r.metrics.push_back({"ms build", build_ms / picks});
+        r.metrics.push_back({"ms query", query_ms / picks});
+
+        build_ms = query_ms = 0.0;
+        picks = 0;
+        BenchResult& q = runBench("pick_query_" + suffix, iterations * 100, [&] {
+            pickPoint(pick_frames[frame_sel]);
+        });
+        q.metrics.push_back({"us query", query_ms * 1000.0 / picks});
+    }
+
+
+    //============================= 화면 준비 / 렌더링 (숨김 창 GL context) =================================
+    glutInit(&argc, argv);
+    GLFWwindow* window = nullptr;
+    if(glfwInit()) {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        window = glfwCreateWindow(WINDOW_WIDTH, WINDOW_HEIGHT, "aeronSW_bench", nullptr, nullptr);
+    }
+    if(window != nullptr) {
+        glfwMakeContextCurrent(window);
+        glfwSwapInterval(0);
+        glewExperimental = GL_TRUE;
+        if(glewInit() != GLEW_OK) {
+            glfwDestroyWindow(window);
+            window = nullptr;
+        }
+    }
+
+    const size_t render_counts[] = {10000, 100000, 1000000};
+    const size_t view_counts[] = {1, 2, 4};
+    bool alloc_failed = false;
+    if(window == nullptr) {
+        std::cerr << "No GL context (headless without display?) - Space benchmarks skipped" << std::endl;
+        skipBench("lidarIntoSpace");
+        skipBench("lidarIntoSpace_cluster_ground");
+        skipBench("objIntoSpace");
+        for(size_t n : render_counts) skipBench("render_" + std::to_string(n));
+        for(size_t views : view_counts) skipBench("render_views_" + std::to_string(views));
+        skipBench("steady_playback");
+    } else {
+        glViewport(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
+        glMatrixMode(GL_PROJECTION);
+        glLoadIdentity();
+        gluPerspective(FOV_Y, static_cast<double>(WINDOW_WIDTH) / WINDOW_HEIGHT, NEAR_PLANE, FAR_PLANE);
+        glEnable(GL_DEPTH_TEST);
+
+        Camera camera;
+        camera.setPosition(glm::vec3(30.0f, -30.0f, 20.0f));
+        camera.setTarget(glm::vec3(0.0f));
+        glm::mat4 view = camera.getViewMatrix();
+        glMatrixMode(GL_MODELVIEW);
+        glLoadMatrixf(&view[0][0]);
+
+        Space space;
+
+        // 프레임마다 결과를 캐시하므로 매 반복 다른 프레임을 올림
+        size_t next = 0;
+        auto intoSpace = [&] {
+            space.clearLidarPoints();
+            space.lidarIntoSpace(lidar_list[next]);
+            next = (next + 1) % lidar_list.size();
+        };
+        {
+            BenchResult& r = runBench("lidarIntoSpace", lidar_list.size(), intoSpace);
+            r.metrics.push_back({"Mpoints/s", lidar_points / (r.mean_ms * 1000.0)});
+        }
+        {
+            space.toggleClusterMode();
+            space.cycleGroundMode();
+            BenchResult& r = runBench("lidarIntoSpace_cluster_ground", lidar_list.size(), intoSpace);
+            r.metrics.push_back({"Mpoints/s", lidar_points / (r.mean_ms * 1000.0)});
+            space.toggleClusterMode();
+            space.cycleGroundMode();
+            space.cycleGroundMode();
+        }
+        {
+            size_t obj_next = 0;
+            space.clearLidarPoints();
+            space.lidarIntoSpace(lidar_list[0]);
+            runBench("objIntoSpace", obj_list.size(), [&] {
+                space.clearObjPoints();
+                space.clearBoxes();
+                space.objIntoSpace(obj_list[obj_next]);
+                obj_next = (obj_next + 1) % obj_list.size();
+            });
+        }
+
+        // 렌더링 : 점 수별 한 프레임 (glFinish로 GPU 완료까지)
+        for(size_t n : render_counts) {
+            GeneratorOptions render_options = gen_options;
+            render_options.points = static_cast<uint32_t>(n);
+            LidarBinary frame;
+            RecordingGenerator(render_options).makeLidarFrame(0, t0, frame);
+            space.clearLidarPoints();
+            space.clearObjPoints();
+            space.clearBoxes();
+            space.lidarIntoSpace(frame);
+            space.objIntoSpace(obj_list[0]);
+            BenchResult& r = runBench("render_" + std::to_string(n), iterations * 10, [&] {
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                space.render();
+                glFinish();
+            });
+            r.metrics.push_back({"fps", 1000.0 / r.mean_ms});
+        }
+
+        // 보기 수별 한 프레임 : 마지막 render 프레임(점 최다)을 올린 버퍼 그대로 보기마다 다시 그림 (준비 / 업로드 없음)
+        ViewportLayout layout;
+        for(size_t views : view_counts) {
+            layout.setViewCount(views);
+            layout.update(camera.getPosition(), camera.getTarget(), glm::length(camera.getPosition() - camera.getTarget()));
+            BenchResult& r = runBench("render_views_" + std::to_string(views), iterations * 10, [&] {
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                for(size_t v = 0; v < layout.getViewCount(); ++v) {
+                    layout.apply(v);
+                    space.renderScene();
+                }
+                layout.restoreFullWindow();
+                space.renderText();
+                glFinish();
+            });
+            r.metrics.push_back({"fps", 1000.0 / r.mean_ms});
+            r.metrics.push_back({"ms/view", r.mean_ms / views});
+        }
+
+        // 정상 재생 힙 할당 검사 : 모든 프레임을 한 바퀴 재생해 버퍼 capacity를 채운 뒤 같은 프레임을 다시 재생하는 동안 할당 0
+        // (뷰어 메인 루프의 프레임 준비 + 그리기와 같은 순서, 할당은 프레임 호출 안에서만 셈)
+        {
+            auto playFrame = [&](size_t f) {
+                space.clearLines();
+                space.clearBoxes();
+                space.drawGrid();
+                space.clearLidarPoints();
+                space.lidarIntoSpace(lidar_list[f]);
+                space.clearObjPoints();
+                space.objIntoSpace(obj_list[f % obj_list.size()]);
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                space.render();
+            };
+            for(size_t f = 0; f < lidar_list.size(); ++f) {
+                playFrame(f);
+            }
+            size_t next_frame = 0;
+            uint64_t playback_allocs = 0;
+            BenchResult& r = runBench("steady_playback", lidar_list.size() - 1, [&] {
+                const uint64_t before = AllocCounter::count();
+                playFrame(next_frame);
+                playback_allocs += AllocCounter::count() - before;
+                next_frame = (next_frame + 1) % lidar_list.size();
+            });
+            glFinish();
+            r.metrics.push_back({"allocs", static_cast<double>(playback_allocs)});
+            if(playback_allocs > 0) {
+                std::cerr << "[Alloc] steady playback allocated " << playback_allocs << " times in " << lidar_list.size()
+                          << " frames (expected 0)" << std::endl;
+                alloc_failed = true;
+            }
+        }
+
+        glfwDestroyWindow(window);
+    }
+    glfwTerminate();
+
+    printResults();
+    if(writeJson(out_file, lidar_frames, lidar_points)) {
+        std::cout << "\nResults written to " << out_file << std::endl;
+    }
+    return alloc_failed ? 1 : 0;
+}
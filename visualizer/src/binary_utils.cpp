@@ -1,9 +1,21 @@
 
 #include "binary_utils.h"
+#include "profiler.h"
+
+#include <limits>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#include <xmmintrin.h>
+#endif
 
 
 // LidarBinary를 바이너리 파일에서 읽기
-bool BinaryUtils::load_lidar_binary(const std::string& filename, std::vector<LidarBinary>& out_data_list) {
+bool BinaryUtils::load_lidar_binary(const std::string& filename, std::vector<LidarBinary>& out_data_list, const LidarRoi* roi) {
+    PROFILE_SCOPE("BinaryUtils::load_lidar_binary");
     std::ifstream ifs(filename, std::ios::binary);
     if (!ifs) {
         std::cerr << "Failed to open Lidar file: " << filename << std::endl;   
@@ -11,6 +23,7 @@ bool BinaryUtils::load_lidar_binary(const std::string& filename, std::vector<Lid
     }
 
     int total_count = 0;
+    RoiStats roi_stats;
 
     while(ifs.peek() != EOF) {      // 모든 파일 읽기
         LidarBinary data;
@@ -39,11 +52,19 @@ bool BinaryUtils::load_lidar_binary(const std::string& filename, std::vector<Lid
             break;
         }
 
+        if(roi != nullptr) {        // 제자리에서 줄임, push_back 복사본은 남은 점 크기만 할당
+            data.num = static_cast<uint32_t>(filter_lidar_points(data.lidar_data.data(), data.num, *roi, &roi_stats));
+            data.lidar_data.resize(data.num);
+        }
+
         out_data_list.push_back(data);
         std::cout << "[LOADED] idx: " << total_count - 1 << ", time: " << data.time << ", num: " << data.num << std::endl;
     }
 
     ifs.close();
+    if(roi != nullptr) {
+        print_roi_stats(filename, roi_stats);
+    }
     return true;
 }
 
@@ -62,6 +83,7 @@ std::streamsize getFileSize(const std::string& filename) {
 
 // ObjBinary를 바이너리 파일에서 읽기
 bool BinaryUtils::load_obj_binary(const std::string& filename, std::vector<ObjBinary>& out_data_list) {
+    PROFILE_SCOPE("BinaryUtils::load_obj_binary");
     std::ifstream ifs(filename, std::ios::binary);
     if (!ifs) {
         std::cerr << "Failed to open ObjectInfo file: " << filename << std::endl;   
@@ -124,6 +146,219 @@ bool BinaryUtils::load_obj_binary(const std::string& filename, std::vector<ObjBi
 }
 
 
+static inline bool isValidFrameHeader(uint64_t time, uint32_t num) {
+    return num != 0 && time != 0 && time >= 1600000000000ULL && time <= 1900000000000ULL;
+}
+
+bool BinaryUtils::read_lidar_frame(std::istream& is, LidarBinary& out_data, const LidarRoi* roi, RoiStats* roi_stats) {
+    PROFILE_SCOPE("BinaryUtils::read_lidar_frame");
+    while(is.peek() != EOF) {
+        is.read(reinterpret_cast<char*>(&out_data.time), sizeof(out_data.time));
+        is.read(reinterpret_cast<char*>(&out_data.num), sizeof(out_data.num));
+        if(!is) {
+            return false;
+        }
+        if(!isValidFrameHeader(out_data.time, out_data.num)) {
+            continue;
+        }
+        out_data.lidar_data.resize(out_data.num);
+        is.read(reinterpret_cast<char*>(out_data.lidar_data.data()), out_data.num * sizeof(LidarData));
+        if(is.gcount() != static_cast<std::streamsize>(out_data.num * sizeof(LidarData))) {
+            return false;
+        }
+        if(roi != nullptr) {
+            out_data.num = static_cast<uint32_t>(filter_lidar_points(out_data.lidar_data.data(), out_data.num, *roi, roi_stats));
+            out_data.lidar_data.resize(out_data.num);      // capacity 유지 (스트리밍 버퍼 재사용)
+        }
+        return true;
+    }
+    return false;
+}
+
+bool BinaryUtils::read_obj_frame(std::istream& is, ObjBinary& out_data) {
+    PROFILE_SCOPE("BinaryUtils::read_obj_frame");
+    while(is.peek() != EOF) {
+        is.read(reinterpret_cast<char*>(&out_data.time), sizeof(out_data.time));
+        is.read(reinterpret_cast<char*>(&out_data.num), sizeof(out_data.num));
+        if(!is) {
+            return false;
+        }
+        if(!isValidFrameHeader(out_data.time, out_data.num)) {
+            continue;
+        }
+        if(out_data.num > 100000) {
+            return false;       // 손상된 헤더 - 이후 위치를 믿을 수 없음
+        }
+        out_data.obj_data.resize(out_data.num);
+        is.read(reinterpret_cast<char*>(out_data.obj_data.data()), out_data.num * sizeof(ObjData));
+        return is.gcount() == static_cast<std::streamsize>(out_data.num * sizeof(ObjData));
+    }
+    return false;
+}
+
+
+// 관심 영역 필터 - 조건별 통과 mask를 구해 처음 걸린 조건으로 집계하고 통과한 점만 앞으로 당김 (w <= i라 제자리 가능)
+// SSE2 : LidarData 앞 16 bytes(x, y, z, reflectivity)를 점 4개 읽어 전치 -> 조건마다 비교 4개를 한 번에
+size_t BinaryUtils::filter_lidar_points(LidarData* points, size_t count, const LidarRoi& roi, RoiStats* stats) {
+    static const uint8_t bit_count[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+    const float min_r2 = roi.min_range * roi.min_range;
+    const float max_r2 = roi.max_range * roi.max_range;
+    uint64_t fail_range = 0, fail_height = 0, fail_box = 0, fail_refl = 0;
+    size_t w = 0;
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128 v_min_r2 = _mm_set1_ps(min_r2), v_max_r2 = _mm_set1_ps(max_r2);
+    const __m128 v_min_z = _mm_set1_ps(roi.min_z), v_max_z = _mm_set1_ps(roi.max_z);
+    const __m128 bx0 = _mm_set1_ps(roi.box_min.x), by0 = _mm_set1_ps(roi.box_min.y), bz0 = _mm_set1_ps(roi.box_min.z);
+    const __m128 bx1 = _mm_set1_ps(roi.box_max.x), by1 = _mm_set1_ps(roi.box_max.y), bz1 = _mm_set1_ps(roi.box_max.z);
+    // 부호 없는 비교 : 부호 비트를 뒤집어 부호 있는 비교로 (refl >= min  <=>  refl > min - 1)
+    const __m128i sign = _mm_set1_epi32(static_cast<int>(0x80000000u));
+    const __m128i v_min_refl = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(roi.min_reflectivity - 1)), sign);
+    const bool check_refl = roi.min_reflectivity > 0;
+    for(; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(&points[i].x);
+        __m128 y = _mm_loadu_ps(&points[i + 1].x);
+        __m128 z = _mm_loadu_ps(&points[i + 2].x);
+        __m128 r = _mm_loadu_ps(&points[i + 3].x);
+        _MM_TRANSPOSE4_PS(x, y, z, r);
+
+        const __m128 r2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+        const int ok_range = _mm_movemask_ps(_mm_and_ps(_mm_cmpge_ps(r2, v_min_r2), _mm_cmple_ps(r2, v_max_r2)));
+        const int ok_height = _mm_movemask_ps(_mm_and_ps(_mm_cmpge_ps(z, v_min_z), _mm_cmple_ps(z, v_max_z)));
+        const __m128 in_x = _mm_and_ps(_mm_cmpge_ps(x, bx0), _mm_cmple_ps(x, bx1));
+        const __m128 in_y = _mm_and_ps(_mm_cmpge_ps(y, by0), _mm_cmple_ps(y, by1));
+        const __m128 in_z = _mm_and_ps(_mm_cmpge_ps(z, bz0), _mm_cmple_ps(z, bz1));
+        const int ok_box = _mm_movemask_ps(_mm_and_ps(_mm_and_ps(in_x, in_y), in_z));
+        const int ok_refl = check_refl
+            ? _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(_mm_xor_si128(_mm_castps_si128(r), sign), v_min_refl))) : 0xF;
+
+        fail_range += bit_count[~ok_range & 0xF];
+        fail_height += bit_count[ok_range & ~ok_height & 0xF];
+        fail_box += bit_count[ok_range & ok_height & ~ok_box & 0xF];
+        fail_refl += bit_count[ok_range & ok_height & ok_box & ~ok_refl & 0xF];
+
+        const int keep = ok_range & ok_height & ok_box & ok_refl;
+        if(keep == 0xF && w == i) {     // 모두 통과 + 아직 버린 점 없음 -> 복사 없음
+            w += 4;
+            continue;
+        }
+        for(int k = 0; k < 4; ++k) {
+            if(keep & (1 << k)) {
+                points[w++] = points[i + k];
+            }
+        }
+    }
+#endif
+    for(; i < count; ++i) {
+        const LidarData& p = points[i];
+        const float r2 = p.x * p.x + p.y * p.y + p.z * p.z;
+        if(!(r2 >= min_r2 && r2 <= max_r2)) {
+            ++fail_range;
+        } else if(!(p.z >= roi.min_z && p.z <= roi.max_z)) {
+            ++fail_height;
+        } else if(!(p.x >= roi.box_min.x && p.x <= roi.box_max.x && p.y >= roi.box_min.y && p.y <= roi.box_max.y &&
+                    p.z >= roi.box_min.z && p.z <= roi.box_max.z)) {
+            ++fail_box;
+        } else if(p.reflectivity < roi.min_reflectivity) {
+            ++fail_refl;
+        } else {
+            points[w++] = p;
+        }
+    }
+
+    if(stats != nullptr) {
+        ++stats->frames;
+        stats->points_in += count;
+        stats->points_kept += w;
+        stats->range += fail_range;
+        stats->height += fail_height;
+        stats->box += fail_box;
+        stats->reflectivity += fail_refl;
+    }
+    return w;
+}
+
+void BinaryUtils::print_roi_stats(const std::string& label, const RoiStats& stats) {
+    const double kept = stats.points_in > 0 ? 100.0 * stats.points_kept / stats.points_in : 0.0;
+    std::cout << "[ROI] " << label << ": " << stats.points_kept << " / " << stats.points_in << " points kept ("
+              << std::fixed << std::setprecision(1) << kept << " %) in " << stats.frames << " frames, dropped range "
+              << stats.range << ", height " << stats.height << ", box " << stats.box << ", reflectivity " << stats.reflectivity
+              << std::defaultfloat << std::setprecision(6) << std::endl;
+}
+
+
+// 헤더 위치에서 한 페이지씩 pread - ifstream은 seek 뒤 읽을 때마다 버퍼 + 커널 readahead로 payload까지 읽어 들임
+// POSIX_FADV_RANDOM으로 readahead를 끄고, 비정상 헤더가 이어지는 구간(12 bytes씩 전진)은 읽어 둔 페이지에서 처리
+#define SCAN_PAGE_SIZE  4096
+
+static bool scanHeaders(const std::string& filename, size_t item_size, uint32_t max_num, HeaderScan& out_scan) {
+    out_scan.frames.clear();
+    out_scan.skipped = 0;
+    out_scan.truncated = false;
+    out_scan.file_size = 0;
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    struct stat st;
+    if(fd < 0 || ::fstat(fd, &st) != 0) {
+        std::cerr << "Failed to open file: " << filename << std::endl;
+        if(fd >= 0) ::close(fd);
+        return false;
+    }
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_RANDOM);
+    out_scan.file_size = static_cast<uint64_t>(st.st_size);
+
+    unsigned char page[SCAN_PAGE_SIZE];
+    uint64_t page_pos = 0;
+    uint64_t page_len = 0;
+
+    const uint64_t header_size = sizeof(uint64_t) + sizeof(uint32_t);
+    uint64_t pos = 0;
+    while(pos < out_scan.file_size) {
+        if(out_scan.file_size - pos < header_size) {
+            out_scan.truncated = true;
+            break;
+        }
+        if(pos < page_pos || pos + header_size > page_pos + page_len) {
+            ssize_t n = ::pread(fd, page, SCAN_PAGE_SIZE, static_cast<off_t>(pos));
+            if(n < static_cast<ssize_t>(header_size)) {
+                out_scan.truncated = true;
+                break;
+            }
+            page_pos = pos;
+            page_len = static_cast<uint64_t>(n);
+        }
+        FrameHeader header;
+        std::memcpy(&header.time, page + (pos - page_pos), sizeof(header.time));
+        std::memcpy(&header.num, page + (pos - page_pos) + sizeof(header.time), sizeof(header.num));
+        pos += header_size;
+        if(!isValidFrameHeader(header.time, header.num)) {
+            ++out_scan.skipped;      // 로더처럼 payload 없이 다음 12 bytes를 헤더로 읽음
+            continue;
+        }
+        const uint64_t payload = static_cast<uint64_t>(header.num) * item_size;
+        if(header.num > max_num || payload > out_scan.file_size - pos) {
+            out_scan.truncated = true;
+            break;
+        }
+        header.payload_offset = pos;
+        out_scan.frames.push_back(header);
+        pos += payload;
+    }
+    ::close(fd);
+    return true;
+}
+
+bool BinaryUtils::scan_lidar_headers(const std::string& filename, HeaderScan& out_scan) {
+    PROFILE_SCOPE("BinaryUtils::scan_lidar_headers");
+    return scanHeaders(filename, sizeof(LidarData), std::numeric_limits<uint32_t>::max(), out_scan);
+}
+
+bool BinaryUtils::scan_obj_headers(const std::string& filename, HeaderScan& out_scan) {
+    PROFILE_SCOPE("BinaryUtils::scan_obj_headers");
+    return scanHeaders(filename, sizeof(ObjData), 100000, out_scan);       // load_obj_binary 비정상 크기 기준
+}
+
+
 // 객체 시간에 가장 가까운 라이다 프레임 인덱스를 찾는 이진탐색 함수
 int BinaryUtils::findClosestLidarFrame(uint64_t obj_time, const std::vector<LidarBinary>& lidar_list) {
     int left = 0;
@@ -12,14 +12,14 @@
 #include <atomic>
 #include <sstream>
 
-#include <GL/glew.h>
-#include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/constants.hpp>
 
+#include "configs.h"
 
-#define LIDAR_ID 0
+
+#define LIDAR_ID 0      // 기준 라이다 센서 (lidar_0_*.uld), 다른 센서는 lidar_fusion으로 이 센서 시간축에 합침
 #define MAX_TIME_DIFF   100      // 100ms
 
 // 저장된 라이다 구조체
@@ -60,15 +60,65 @@ struct UnifiedData {
     size_t index;
 };
 
+// 로드 시 관심 영역 (configs.h ROI_*) - 모든 조건을 만족하는 점만 남김 (좌표가 NaN인 점도 버림)
+struct LidarRoi {
+    float min_range = ROI_MIN_RANGE;        // 센서 원점 3D 거리 // m
+    float max_range = ROI_MAX_RANGE;
+    float min_z = ROI_MIN_Z;
+    float max_z = ROI_MAX_Z;
+    glm::vec3 box_min = ROI_BOX_MIN;
+    glm::vec3 box_max = ROI_BOX_MAX;
+    uint32_t min_reflectivity = ROI_MIN_REFLECTIVITY;
+};
+
+// 버린 점은 처음 걸린 조건 하나로 집계 (거리 -> 높이 -> 상자 -> 반사도 순)
+struct RoiStats {
+    uint64_t frames = 0;
+    uint64_t points_in = 0;
+    uint64_t points_kept = 0;
+    uint64_t range = 0;
+    uint64_t height = 0;
+    uint64_t box = 0;
+    uint64_t reflectivity = 0;
+};
+
+// 헤더만 훑은 프레임 (payload는 건너뜀)
+struct FrameHeader {
+    uint64_t time;
+    uint32_t num;
+    uint64_t payload_offset;    // 파일 안 payload 시작 위치
+};
+
+struct HeaderScan {
+    std::vector<FrameHeader> frames;
+    uint64_t file_size = 0;
+    size_t skipped = 0;         // 로더가 건너뛰는 헤더 (num / time 비정상)
+    bool truncated = false;     // 마지막 payload가 끊겼거나 비정상 크기 -> 로더가 여기서 멈춤
+};
+
 
 class BinaryUtils {
 public:
-    // LidarBinary를 바이너리 파일에서 읽기
-    static bool load_lidar_binary(const std::string& filename, std::vector<LidarBinary>& out_data_list);
+    // LidarBinary를 바이너리 파일에서 읽기 (roi가 있으면 읽으면서 관심 영역 밖 점을 버리고 파일별 통계 출력)
+    static bool load_lidar_binary(const std::string& filename, std::vector<LidarBinary>& out_data_list, const LidarRoi* roi = nullptr);
 
     // obj Binary 파일
     static bool load_obj_binary(const std::string& filename, std::vector<ObjBinary>& out_data_list);
 
+    // 스트림에서 다음 유효 프레임 하나 읽기 (로더와 같은 기준으로 비정상 프레임은 조용히 건너뜀)
+    // out_data의 버퍼를 재사용 -> 프레임 단위 스트리밍 처리에서 재할당 없음, 파일 끝 / 손상이면 false
+    static bool read_lidar_frame(std::istream& is, LidarBinary& out_data, const LidarRoi* roi = nullptr, RoiStats* roi_stats = nullptr);
+    static bool read_obj_frame(std::istream& is, ObjBinary& out_data);
+
+    // 관심 영역 밖 점을 제자리에서 지우고 남은 점을 앞으로 당김 (SSE2 점 4개 단위), 남은 점 수 반환
+    static size_t filter_lidar_points(LidarData* points, size_t count, const LidarRoi& roi, RoiStats* stats = nullptr);
+    static void print_roi_stats(const std::string& label, const RoiStats& stats);
+
+    // 헤더만 읽고 payload는 seek로 건너뛰며 프레임 목록 수집 - 로더와 같은 기준으로 건너뛰고 멈춤
+    // 점 payload를 읽지 않으므로 파일 크기와 무관하게 프레임 수에 비례한 시간
+    static bool scan_lidar_headers(const std::string& filename, HeaderScan& out_scan);
+    static bool scan_obj_headers(const std::string& filename, HeaderScan& out_scan);
+
     // 이진탐색 함수
     int findClosestLidarFrame(uint64_t obj_time, const std::vector<LidarBinary>& lidar_list);
 };
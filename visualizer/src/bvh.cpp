@@ -0,0 +1,87 @@
+#include "bvh.h"
+
+#include <algorithm>
+#include <numeric>
+
+#define BVH_LEAF_SIZE   4       // leaf 노드당 최대 primitive 수
+
+
+void Bvh::clear() {
+    nodes.clear();
+    prim_index.clear();
+}
+
+bool Bvh::empty() const {
+    return nodes.empty();
+}
+
+void Bvh::build(const std::vector<glm::vec3>& prim_min, const std::vector<glm::vec3>& prim_max) {
+    const uint32_t n = static_cast<uint32_t>(prim_min.size());
+    nodes.clear();
+    if(n == 0) {
+        prim_index.clear();
+        return;
+    }
+
+    prim_index.resize(n);
+    std::iota(prim_index.begin(), prim_index.end(), 0u);
+
+    std::vector<glm::vec3> centroid(n);
+    for(uint32_t i = 0; i < n; ++i) {
+        centroid[i] = (prim_min[i] + prim_max[i]) * 0.5f;
+    }
+
+    struct BuildItem {
+        uint32_t node;
+        uint32_t begin;
+        uint32_t end;
+    };
+
+    nodes.reserve(2 * (n / BVH_LEAF_SIZE + 1));
+    nodes.push_back(BvhNode());
+    std::vector<BuildItem> stack;
+    stack.push_back({0, 0, n});
+
+    while(!stack.empty()) {
+        BuildItem item = stack.back();
+        stack.pop_back();
+
+        glm::vec3 bmin = prim_min[prim_index[item.begin]];
+        glm::vec3 bmax = prim_max[prim_index[item.begin]];
+        glm::vec3 cmin = centroid[prim_index[item.begin]];
+        glm::vec3 cmax = cmin;
+        for(uint32_t i = item.begin + 1; i < item.end; ++i) {
+            uint32_t p = prim_index[i];
+            bmin = glm::min(bmin, prim_min[p]);
+            bmax = glm::max(bmax, prim_max[p]);
+            cmin = glm::min(cmin, centroid[p]);
+            cmax = glm::max(cmax, centroid[p]);
+        }
+        nodes[item.node].bmin = bmin;
+        nodes[item.node].bmax = bmax;
+
+        uint32_t count = item.end - item.begin;
+        glm::vec3 extent = cmax - cmin;
+        if(count <= BVH_LEAF_SIZE || (extent.x == 0.0f && extent.y == 0.0f && extent.z == 0.0f)) {
+            nodes[item.node].first = item.begin;
+            nodes[item.node].count = count;
+            continue;
+        }
+
+        // centroid 범위가 가장 긴 축에서 중앙값 분할
+        int axis = (extent.x > extent.y) ? 0 : 1;
+        if(extent.z > extent[axis]) axis = 2;
+        uint32_t mid = item.begin + count / 2;
+        std::nth_element(prim_index.begin() + item.begin, prim_index.begin() + mid, prim_index.begin() + item.end,
+                         [&](uint32_t a, uint32_t b) { return centroid[a][axis] < centroid[b][axis]; });
+
+        uint32_t left = static_cast<uint32_t>(nodes.size());
+        nodes.push_back(BvhNode());
+        nodes.push_back(BvhNode());
+        nodes[item.node].first = left;
+        nodes[item.node].count = 0;
+
+        stack.push_back({left, item.begin, mid});
+        stack.push_back({left + 1, mid, item.end});
+    }
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <glm/glm.hpp>
+
+
+struct BvhNode {
+    glm::vec3 bmin;
+    glm::vec3 bmax;
+    uint32_t first;     // leaf : 첫 primitive 위치 / inner : 왼쪽 자식 노드 (오른쪽 = first + 1)
+    uint32_t count;     // 0이면 inner 노드
+};
+
+// primitive AABB 목록 위의 BVH (중앙값 분할, O(n log n) 생성)
+class Bvh {
+public:
+    void build(const std::vector<glm::vec3>& prim_min, const std::vector<glm::vec3>& prim_max);
+    void clear();
+    bool empty() const;
+
+    // 광선과 교차하는 primitive 중 가장 가까운 것 (없으면 -1)
+    // hit(prim_idx, t_best, t_out) : primitive 정밀 교차 검사, t_best보다 가까우면 true
+    template <typename HitFn>
+    int intersect(const glm::vec3& origin, const glm::vec3& dir, float& out_t, HitFn&& hit) const;
+
+private:
+    static bool rayBox(const glm::vec3& origin, const glm::vec3& inv_dir,
+                       const glm::vec3& bmin, const glm::vec3& bmax, float t_max, float& t_near);
+
+    std::vector<BvhNode> nodes;
+    std::vector<uint32_t> prim_index;
+};
+
+
+inline bool Bvh::rayBox(const glm::vec3& origin, const glm::vec3& inv_dir,
+                        const glm::vec3& bmin, const glm::vec3& bmax, float t_max, float& t_near) {
+    float t0 = 0.0f, t1 = t_max;
+    for(int a = 0; a < 3; ++a) {
+        float ta = (bmin[a] - origin[a]) * inv_dir[a];
+        float tb = (bmax[a] - origin[a]) * inv_dir[a];
+        if(ta > tb) std::swap(ta, tb);
+        t0 = ta > t0 ? ta : t0;
+        t1 = tb < t1 ? tb : t1;
+        if(t0 > t1) return false;
+    }
+    t_near = t0;
+    return true;
+}
+
+template <typename HitFn>
+int Bvh::intersect(const glm::vec3& origin, const glm::vec3& dir, float& out_t, HitFn&& hit) const {
+    if(nodes.empty()) {
+        return -1;
+    }
+
+    glm::vec3 inv_dir(1.0f / dir.x, 1.0f / dir.y, 1.0f / dir.z);
+    float best_t = std::numeric_limits<float>::max();
+    int best = -1;
+
+    uint32_t stack[64];
+    int sp = 0;
+    stack[sp++] = 0;
+
+    while(sp > 0) {
+        const BvhNode& node = nodes[stack[--sp]];
+        float t_near;
+        if(!rayBox(origin, inv_dir, node.bmin, node.bmax, best_t, t_near)) {
+            continue;
+        }
+
+        if(node.count > 0) {
+            for(uint32_t i = node.first; i < node.first + node.count; ++i) {
+                float t;
+                if(hit(prim_index[i], best_t, t)) {
+                    best_t = t;
+                    best = static_cast<int>(prim_index[i]);
+                }
+            }
+            continue;
+        }
+
+        // 가까운 자식을 먼저 꺼내도록 먼 자식을 먼저 push
+        uint32_t left = node.first;
+        uint32_t right = node.first + 1;
+        float tl, tr;
+        bool hl = rayBox(origin, inv_dir, nodes[left].bmin, nodes[left].bmax, best_t, tl);
+        bool hr = rayBox(origin, inv_dir, nodes[right].bmin, nodes[right].bmax, best_t, tr);
+        if(hl && hr) {
+            if(tl < tr) { stack[sp++] = right; stack[sp++] = left; }
+            else        { stack[sp++] = left;  stack[sp++] = right; }
+        } else if(hl) {
+            stack[sp++] = left;
+        } else if(hr) {
+            stack[sp++] = right;
+        }
+    }
+
+    out_t = best_t;
+    return best;
+}
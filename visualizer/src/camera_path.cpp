@@ -0,0 +1,220 @@
+#include "camera_path.h"
+
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+
+namespace {
+
+bool samePose(const CameraPose& a, const CameraPose& b) {
+    return a.radius == b.radius && a.h_angle == b.h_angle && a.v_angle == b.v_angle &&
+           a.pan_x == b.pan_x && a.pan_y == b.pan_y;
+}
+
+}
+
+
+bool CameraPath::load(const std::string& filename) {
+    std::ifstream ifs(filename);
+    if(!ifs) {
+        std::cerr << "Failed to open camera path: " << filename << std::endl;
+        return false;
+    }
+    clear();
+
+    std::string line;
+    size_t line_no = 0;
+    while(std::getline(ifs, line)) {
+        ++line_no;
+        size_t comment = line.find('#');
+        if(comment != std::string::npos) {
+            line.erase(comment);
+        }
+        std::istringstream iss(line);
+        std::string cmd;
+        if(!(iss >> cmd)) {
+            continue;
+        }
+
+        bool ok = true;
+        if(cmd == "step") {
+            ok = static_cast<bool>(iss >> step_ms) && step_ms > 0.0;
+        } else if(cmd == "warmup") {
+            ok = static_cast<bool>(iss >> warmup_frames);
+        } else if(cmd == "pose") {
+            PathPose p;
+            ok = static_cast<bool>(iss >> p.frame >> p.pose.radius >> p.pose.h_angle >> p.pose.v_angle >> p.pose.pan_x >> p.pose.pan_y) &&
+                 (poses.empty() || p.frame > poses.back().frame);
+            if(ok) poses.push_back(p);
+        } else if(cmd == "key") {
+            PathKey k;
+            ok = static_cast<bool>(iss >> k.frame >> k.key);
+            if(ok) keys.push_back(k);
+        } else {
+            ok = false;
+        }
+        if(!ok) {
+            std::cerr << filename << ":" << line_no << ": invalid line (frames must increase): " << line << std::endl;
+            return false;
+        }
+    }
+    std::stable_sort(keys.begin(), keys.end(), [](const PathKey& a, const PathKey& b) { return a.frame < b.frame; });
+
+    if(poses.empty()) {
+        std::cerr << "Camera path has no pose: " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool CameraPath::save(const std::string& filename) const {
+    std::ofstream ofs(filename);
+    if(!ofs) {
+        std::cerr << "Failed to write camera path: " << filename << std::endl;
+        return false;
+    }
+    ofs << "# aeronSW camera path (pose frame radius h_deg v_deg pan_x pan_y / key frame name)\n"
+        << "step " << step_ms << "\n"
+        << "warmup " << warmup_frames << "\n"
+        << std::setprecision(9);
+    // pose / key를 frame 순서로 섞어서 기록
+    size_t k = 0;
+    for(size_t i = 0; i <= poses.size(); ++i) {
+        size_t frame = (i < poses.size()) ? poses[i].frame : std::numeric_limits<size_t>::max();
+        for(; k < keys.size() && keys[k].frame <= frame; ++k) {
+            ofs << "key " << keys[k].frame << " " << keys[k].key << "\n";
+        }
+        if(i < poses.size()) {
+            const CameraPose& p = poses[i].pose;
+            ofs << "pose " << poses[i].frame << " " << p.radius << " " << p.h_angle << " " << p.v_angle
+                << " " << p.pan_x << " " << p.pan_y << "\n";
+        }
+    }
+    // 마지막 pose가 끝까지 그대로였으면 구간 끝 frame도 남김
+    if(!poses.empty() && last_frame > poses.back().frame) {
+        const CameraPose& p = poses.back().pose;
+        ofs << "pose " << last_frame << " " << p.radius << " " << p.h_angle << " " << p.v_angle
+            << " " << p.pan_x << " " << p.pan_y << "\n";
+    }
+    return static_cast<bool>(ofs);
+}
+
+void CameraPath::clear() {
+    poses.clear();
+    keys.clear();
+    step_ms = FLY_DEFAULT_STEP_MS;
+    warmup_frames = FLY_DEFAULT_WARMUP;
+    last_frame = 0;
+}
+
+
+void CameraPath::record(size_t frame, const CameraPose& pose) {
+    if(!poses.empty() && samePose(poses.back().pose, pose)) {
+        last_frame = frame;
+        return;
+    }
+    // 멈춰 있던 구간 끝을 남겨야 보간 시 그 구간이 그대로 재생됨
+    if(!poses.empty() && last_frame > poses.back().frame) {
+        poses.push_back({last_frame, poses.back().pose});
+    }
+    poses.push_back({frame, pose});
+    last_frame = frame;
+}
+
+void CameraPath::addKey(size_t frame, const std::string& key) {
+    keys.push_back({frame, key});
+}
+
+
+void CameraPath::sample(size_t frame, CameraPose& out) const {
+    if(poses.empty()) {
+        out = CameraPose();
+        return;
+    }
+    auto it = std::upper_bound(poses.begin(), poses.end(), frame, [](size_t f, const PathPose& p) { return f < p.frame; });
+    if(it == poses.begin()) {
+        out = poses.front().pose;
+        return;
+    }
+    if(it == poses.end()) {
+        out = poses.back().pose;
+        return;
+    }
+    const PathPose& a = *(it - 1);
+    const PathPose& b = *it;
+    float t = static_cast<float>(frame - a.frame) / static_cast<float>(b.frame - a.frame);
+    out.radius = a.pose.radius + (b.pose.radius - a.pose.radius) * t;
+    out.h_angle = a.pose.h_angle + (b.pose.h_angle - a.pose.h_angle) * t;
+    out.v_angle = a.pose.v_angle + (b.pose.v_angle - a.pose.v_angle) * t;
+    out.pan_x = a.pose.pan_x + (b.pose.pan_x - a.pose.pan_x) * t;
+    out.pan_y = a.pose.pan_y + (b.pose.pan_y - a.pose.pan_y) * t;
+}
+
+const std::vector<PathKey>& CameraPath::getKeys() const {
+    return keys;
+}
+
+size_t CameraPath::getFrameCount() const {
+    size_t end = std::max(last_frame, poses.empty() ? 0 : poses.back().frame);
+    if(!keys.empty()) {
+        end = std::max(end, keys.back().frame);
+    }
+    return (poses.empty() && keys.empty()) ? 0 : end + 1;
+}
+
+double CameraPath::getStepMs() const {
+    return step_ms;
+}
+
+size_t CameraPath::getWarmupFrames() const {
+    return warmup_frames;
+}
+
+bool CameraPath::empty() const {
+    return poses.empty() && keys.empty();
+}
+
+
+void CameraPath::summarize(std::vector<double> frame_ms, FrameTimeSummary& out) {
+    out = FrameTimeSummary();
+    out.frames = frame_ms.size();
+    if(frame_ms.empty()) {
+        return;
+    }
+    std::sort(frame_ms.begin(), frame_ms.end());
+    auto rank = [&](double p) {
+        size_t r = static_cast<size_t>(std::ceil(p * frame_ms.size()));
+        return frame_ms[std::min(std::max<size_t>(r, 1), frame_ms.size()) - 1];
+    };
+    double total = 0.0;
+    for(double ms : frame_ms) total += ms;
+    out.min_ms = frame_ms.front();
+    out.median_ms = rank(0.5);
+    out.p99_ms = rank(0.99);
+    out.mean_ms = total / frame_ms.size();
+    out.max_ms = frame_ms.back();
+}
+
+bool CameraPath::writeResults(const std::string& filename, const std::string& path_name, double step_ms, size_t views,
+                              const FrameTimeSummary& summary, const std::vector<double>& frame_ms) {
+    std::ofstream ofs(filename);
+    if(!ofs) {
+        std::cerr << "Failed to open flythrough output: " << filename << std::endl;
+        return false;
+    }
+    ofs << std::setprecision(6) << "{\n  \"path\": \"" << path_name << "\", \"step_ms\": " << step_ms
+        << ", \"window\": [" << WINDOW_WIDTH << ", " << WINDOW_HEIGHT << "], \"views\": " << views << ",\n"
+        << "  \"frames\": " << summary.frames << ", \"min_ms\": " << summary.min_ms << ", \"median_ms\": " << summary.median_ms
+        << ", \"p99_ms\": " << summary.p99_ms << ", \"mean_ms\": " << summary.mean_ms << ", \"max_ms\": " << summary.max_ms << ",\n"
+        << "  \"frame_ms\": [";
+    for(size_t i = 0; i < frame_ms.size(); ++i) {
+        ofs << (i % 16 == 0 ? "\n    " : " ") << frame_ms[i] << (i + 1 < frame_ms.size() ? "," : "");
+    }
+    ofs << "\n  ]\n}\n";
+    return static_cast<bool>(ofs);
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+#include "configs.h"
+
+
+// 궤도 카메라 상태 (main.cpp orbitRadius / horizontalAngle / verticalAngle / WASD 이동)
+struct CameraPose {
+    float radius = INIT_CAM_RADIUS;
+    float h_angle = INIT_CAM_HANGLE * 360.0f / 100.0f;     // degree
+    float v_angle = INIT_CAM_VANGLE * 360.0f / 100.0f;     // degree
+    float pan_x = 0.0f, pan_y = 0.0f;                       // cameraPosition = cameraTarget 이동량 // m
+};
+
+struct PathPose {
+    size_t frame;
+    CameraPose pose;
+};
+
+struct PathKey {
+    size_t frame;
+    std::string key;        // "c", "space", "pageup" ... (main.cpp 키 이름)
+};
+
+struct FrameTimeSummary {
+    size_t frames = 0;
+    double min_ms = 0.0;
+    double median_ms = 0.0;
+    double p99_ms = 0.0;
+    double mean_ms = 0.0;
+    double max_ms = 0.0;
+};
+
+// 비행 경로 (--flythrough 재생 / --record-path 녹화) - 프레임 번호별 카메라 keyframe + 키 입력
+// 텍스트 파일, 한 줄에 하나 (# 뒤는 주석)
+//   step [ms]                                      재생 시 렌더 프레임당 타임라인 진행 시간
+//   warmup [frames]                                통계에서 뺄 앞쪽 프레임 수
+//   pose [frame] [radius] [h_deg] [v_deg] [pan_x] [pan_y]
+//   key [frame] [name]
+// keyframe 사이는 선형 보간 -> 손으로 적은 몇 줄짜리 경로도, 녹화한 매 프레임 경로도 같은 형식
+class CameraPath {
+public:
+    bool load(const std::string& filename);
+    bool save(const std::string& filename) const;
+    void clear();
+
+    // 녹화 - frame 오름차순, 바뀌지 않은 pose는 구간 끝만 남김 (재생 결과는 같음)
+    void record(size_t frame, const CameraPose& pose);
+    void addKey(size_t frame, const std::string& key);
+
+    void sample(size_t frame, CameraPose& out) const;       // 범위 밖이면 처음 / 마지막 keyframe
+    const std::vector<PathKey>& getKeys() const;            // frame 오름차순
+    size_t getFrameCount() const;                           // 마지막 keyframe / 키 입력 + 1
+    double getStepMs() const;
+    size_t getWarmupFrames() const;
+    bool empty() const;
+
+    // 프레임 시간 요약 (nearest-rank 백분위)
+    static void summarize(std::vector<double> frame_ms, FrameTimeSummary& out);
+    // 요약 + 프레임별 시간 JSON (렌더러 변경 전후 비교용)
+    static bool writeResults(const std::string& filename, const std::string& path_name, double step_ms, size_t views,
+                             const FrameTimeSummary& summary, const std::vector<double>& frame_ms);
+
+private:
+    std::vector<PathPose> poses;
+    std::vector<PathKey> keys;
+    double step_ms = FLY_DEFAULT_STEP_MS;
+    size_t warmup_frames = FLY_DEFAULT_WARMUP;
+    size_t last_frame = 0;      // 녹화 중 마지막 frame (pose가 그대로인 구간 끝)
+};
@@ -0,0 +1,221 @@
+// 원격 보기 클라이언트 : aeronSW_server가 보내는 압축 프레임을 받아 그리기만 함 (녹화 파일 / 로더 불필요)
+// Usage: ./aeronSW_client [host] [port]
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <GL/glut.h>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+#include <algorithm>
+
+#include "camera.h"
+#include "space.h"
+#include "configs.h"
+#include "binary_utils.h"
+#include "stream_protocol.h"
+#include "frame_client.h"
+
+
+// Globals
+Camera camera;
+Space space;
+FrameClient client;
+
+bool leftMousePressed = false;
+double lastMouseX = 0.0, lastMouseY = 0.0;
+float horizontalAngle = glm::radians(INIT_CAM_HANGLE * 360.0f / 100.0f), verticalAngle = glm::radians(INIT_CAM_VANGLE * 360.0f / 100.0f);
+float orbitRadius = INIT_CAM_RADIUS;        // space.cpp extern
+
+glm::vec3 cameraPosition(0.0f, 0.0f, 0.0f);
+glm::vec3 cameraTarget(0.0f, 0.0f, 0.0f);
+
+bool playing = true;
+float play_speed = 1.0f;
+
+void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
+void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
+void cursorPosCallback(GLFWwindow* window, double xpos, double ypos);
+void scrollCallback(GLFWwindow* window, double xoffset, double yoffset);
+void setupViewport(const GLuint width, const GLuint height);
+
+
+int main(int argc, char* argv[]) {
+    std::string host = (argc > 1) ? argv[1] : "127.0.0.1";
+    int port = (argc > 2) ? std::atoi(argv[2]) : STREAM_DEFAULT_PORT;
+    if(port <= 0 || port > 65535) {
+        std::cout << "Usage: ./aeronSW_client [host] [port]" << std::endl;
+        return -1;
+    }
+
+    if(!client.connect(host, static_cast<uint16_t>(port))) {
+        return 1;
+    }
+    const StreamHello& hello = client.getHello();
+    std::cout << "Connected to " << host << ":" << port << " - " << hello.lidar_frames << " lidar / " << hello.obj_frames
+              << " obj frames, " << space.formatUnixTime(hello.first_time) << " ~ " << space.formatUnixTime(hello.last_time)
+              << ", quantization " << hello.quant_step * 1000.0f << " mm" << std::endl;
+
+    /**** Initialize GLFW ****/
+    glutInit(&argc, argv);      // glutBitmapCharacter()용
+
+    if (!glfwInit()) {
+        std::cerr << "Failed to initialize GLFW" << std::endl;
+        return -1;
+    }
+
+    GLFWwindow* window = glfwCreateWindow(WINDOW_WIDTH, WINDOW_HEIGHT, ("Remote - " + host).c_str(), nullptr, nullptr);
+    if (!window) {
+        std::cerr << "Failed to create GLFW window" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+
+    glfwMakeContextCurrent(window);
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK) {
+        std::cerr << "Failed to initialize GLEW" << std::endl;
+        return -1;
+    }
+
+    setupViewport(WINDOW_WIDTH, WINDOW_HEIGHT);
+    glEnable(GL_DEPTH_TEST);
+
+    glfwSetKeyCallback(window, keyCallback);
+    glfwSetMouseButtonCallback(window, mouseButtonCallback);
+    glfwSetCursorPosCallback(window, cursorPosCallback);
+    glfwSetScrollCallback(window, scrollCallback);
+
+    // 화면에 올린 프레임 (수신 스레드 버퍼와 교환, Space는 주소 + 시간으로 프레임 변경 판단)
+    LidarBinary shown_lidar;
+    ObjBinary shown_obj;
+    bool has_lidar = false;
+    bool show_obj = false;      // 마지막으로 받은 것이 검출 목록이면 라이다 위에 박스 표시 (뷰어 타임라인 모드와 같음)
+
+    while (!glfwWindowShouldClose(window)) {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        space.clearLines();
+        space.clearBoxes();
+        space.drawGrid();
+
+        if(client.takeLidar(shown_lidar)) {
+            has_lidar = true;
+            show_obj = false;
+        }
+        if(client.takeObj(shown_obj)) {
+            show_obj = true;
+        }
+        space.clearLidarPoints();
+        space.clearObjPoints();
+        if(has_lidar) {
+            space.lidarIntoSpace(shown_lidar);
+        }
+        if(show_obj) {
+            space.objIntoSpace(shown_obj);
+        }
+
+        float x = orbitRadius * glm::cos(verticalAngle) * glm::cos(horizontalAngle) + cameraPosition.x;
+        float y = orbitRadius * glm::cos(verticalAngle) * glm::sin(horizontalAngle) + cameraPosition.y;
+        float z = orbitRadius * glm::sin(verticalAngle) + cameraPosition.z;
+        camera.setPosition(glm::vec3(x, y, z));
+        camera.setTarget(cameraTarget);
+
+        glm::mat4 view = camera.getViewMatrix();
+        glMatrixMode(GL_MODELVIEW);
+        glLoadMatrixf(&view[0][0]);
+        space.render();
+
+        // 연결 / 전송 상태
+        ClientStats stats = client.getStats();
+        std::ostringstream status;
+        status << std::fixed << std::setprecision(0) << space.formatUnixTime(stats.time) << "  x" << std::setprecision(2) << play_speed
+               << (client.isConnected() ? (stats.ended ? "  [end]" : (playing ? "" : "  [paused]")) : "  [disconnected]")
+               << "  |  " << std::setprecision(0) << stats.kbps << " kbps, " << std::setprecision(1) << stats.lidar_fps << " fps, stride "
+               << stats.stride << ", decode " << std::setprecision(2) << stats.decode_ms << " ms";
+        space.renderText2D(status.str(), 10, WINDOW_HEIGHT - 10, glm::vec3(1.0f, 1.0f, 1.0f));
+
+        glfwSwapBuffers(window);
+        glfwPollEvents();
+    }
+
+    client.close();
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return 0;
+}
+
+
+void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
+    if (action == GLFW_PRESS || action == GLFW_REPEAT) {
+        glm::vec3 cameraDirection(glm::cos(horizontalAngle), glm::sin(horizontalAngle), 0.0f);
+        glm::vec3 cameraOrthoDirection(-glm::sin(horizontalAngle), glm::cos(horizontalAngle), 0.0f);
+        if (key == GLFW_KEY_W) {                            //w
+            cameraPosition -= CAMERA_SPEED * cameraDirection;
+            cameraTarget -= CAMERA_SPEED * cameraDirection;
+        } else if (key == GLFW_KEY_S) {                     //s
+            cameraPosition += CAMERA_SPEED * cameraDirection;
+            cameraTarget += CAMERA_SPEED * cameraDirection;
+        } else if (key == GLFW_KEY_A) {                     //a
+            cameraPosition -= CAMERA_SPEED * cameraOrthoDirection;
+            cameraTarget -= CAMERA_SPEED * cameraOrthoDirection;
+        } else if (key == GLFW_KEY_D) {                     //d
+            cameraPosition += CAMERA_SPEED * cameraOrthoDirection;
+            cameraTarget += CAMERA_SPEED * cameraOrthoDirection;
+        } else if (key == GLFW_KEY_ESCAPE) {                //esc
+            glfwSetWindowShouldClose(window, GLFW_TRUE);
+        } else if (key == GLFW_KEY_P) {                     //p
+            playing = client.getStats().ended || !playing;  //play / pause (server side), 녹화 끝에서는 처음부터 다시 재생
+            client.sendControl(playing ? StreamCommand::PLAY : StreamCommand::PAUSE);
+        } else if (key == GLFW_KEY_LEFT) {                  //left
+            client.sendControl(StreamCommand::SEEK, -STREAM_SEEK_STEP_MS);
+        } else if (key == GLFW_KEY_RIGHT) {                 //right
+            client.sendControl(StreamCommand::SEEK, STREAM_SEEK_STEP_MS);
+        } else if (key == GLFW_KEY_C) {                     //c
+            space.toggleClusterMode();
+        } else if (key == GLFW_KEY_G) {                     //g
+            space.cycleGroundMode();
+        } else if (key == GLFW_KEY_PAGE_UP) {               //page up
+            play_speed = std::min(play_speed * 2.0f, STREAM_MAX_SPEED);        //speed up
+            client.sendControl(StreamCommand::SPEED, static_cast<int32_t>(play_speed * 1000.0f));
+        } else if (key == GLFW_KEY_PAGE_DOWN) {             //page down
+            play_speed = std::max(play_speed * 0.5f, 1.0f / STREAM_MAX_SPEED); //speed down
+            client.sendControl(StreamCommand::SPEED, static_cast<int32_t>(play_speed * 1000.0f));
+        }
+    }
+}
+
+void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
+    if (button == GLFW_MOUSE_BUTTON_LEFT) {
+        leftMousePressed = (action == GLFW_PRESS);
+    }
+}
+
+void cursorPosCallback(GLFWwindow* window, double xpos, double ypos) {
+    if (leftMousePressed) {
+        horizontalAngle += (float)((xpos - lastMouseX) * ORBIT_SPEED);
+        verticalAngle -= (float)((ypos - lastMouseY) * ORBIT_SPEED);
+
+        // 상하 회전 제한 (90도 범위 유지)
+        if (verticalAngle > glm::radians(89.0f)) verticalAngle = glm::radians(89.0f);
+        if (verticalAngle < glm::radians(-89.0f)) verticalAngle = glm::radians(-89.0f);
+    }
+    lastMouseX = xpos;
+    lastMouseY = ypos;
+}
+
+void scrollCallback(GLFWwindow* window, double xoffset, double yoffset) {
+    orbitRadius -= (float)(yoffset * ZOOM_SPEED);
+    if (orbitRadius < 1.0f) orbitRadius = 1.0f;     // 최소 거리 제한
+}
+
+void setupViewport(const GLuint width, const GLuint height) {
+    glViewport(0, 0, width, height);
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    gluPerspective(FOV_Y, static_cast<double>(width) / height, NEAR_PLANE, FAR_PLANE);
+}
@@ -0,0 +1,200 @@
+#include "cluster_stats.h"
+#include "configs.h"
+#include "parallel_utils.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#define CLUSTER_POINT_GRAIN     16384   // 스레드가 한 번에 가져가는 점 수
+
+
+void ClusterStats::resetAccum(Accum& a) const {
+    a.count = 0;
+    a.sx = a.sy = a.sz = 0.0;
+    a.sxx = a.sxy = a.syy = 0.0;
+    a.bmin = glm::vec3(std::numeric_limits<float>::max());
+    a.bmax = glm::vec3(-std::numeric_limits<float>::max());
+    a.umin = a.vmin = std::numeric_limits<float>::max();
+    a.umax = a.vmax = -std::numeric_limits<float>::max();
+}
+
+size_t ClusterStats::slotOf(int cluster_id) const {
+    if(dense) {
+        return static_cast<size_t>(cluster_id - id_min);
+    }
+    return sparse_slot.find(cluster_id)->second;
+}
+
+const std::vector<ClusterInfo>& ClusterStats::getClusters() const {
+    return clusters;
+}
+
+// 골든 비율 hue 간격 팔레트 - 점마다 호출되므로 미리 계산한 표에서 조회
+static std::vector<glm::vec3> buildClusterPalette() {
+    std::vector<glm::vec3> palette(CLUSTER_PALETTE_SIZE);
+    for(int i = 0; i < CLUSTER_PALETTE_SIZE; ++i) {
+        float h = std::fmod(i * 0.618034f, 1.0f) * 6.0f;
+        float x = 1.0f - std::fabs(std::fmod(h, 2.0f) - 1.0f);
+        switch(static_cast<int>(h)) {
+            case 0:  palette[i] = glm::vec3(1.0f, x, 0.0f); break;
+            case 1:  palette[i] = glm::vec3(x, 1.0f, 0.0f); break;
+            case 2:  palette[i] = glm::vec3(0.0f, 1.0f, x); break;
+            case 3:  palette[i] = glm::vec3(0.0f, x, 1.0f); break;
+            case 4:  palette[i] = glm::vec3(x, 0.0f, 1.0f); break;
+            default: palette[i] = glm::vec3(1.0f, 0.0f, x); break;
+        }
+    }
+    return palette;
+}
+
+void ClusterStats::clusterColor(int cluster_id, glm::vec3& out_color) {
+    static const std::vector<glm::vec3> palette = buildClusterPalette();
+    if(cluster_id < 0) {
+        out_color = glm::vec3(0.4f, 0.4f, 0.4f);    // 미분류(noise) : 회색
+        return;
+    }
+    out_color = palette[cluster_id % CLUSTER_PALETTE_SIZE];
+}
+
+
+void ClusterStats::compute(const LidarBinary& frame) {
+    if(&frame == last_frame && frame.time == last_time) {
+        return;
+    }
+    last_frame = &frame;
+    last_time = frame.time;
+    clusters.clear();
+
+    const auto& points = frame.lidar_data;
+    const size_t n = points.size();
+
+    // id 범위 파악 (음수 = 미분류)
+    int lo = std::numeric_limits<int>::max();
+    int hi = std::numeric_limits<int>::min();
+    for(size_t i = 0; i < n; ++i) {
+        int id = points[i].cluster_id;
+        if(id < 0) continue;
+        lo = std::min(lo, id);
+        hi = std::max(hi, id);
+    }
+    if(lo > hi) {
+        return;
+    }
+
+    id_min = lo;
+    dense = (static_cast<int64_t>(hi) - lo) < CLUSTER_DENSE_LIMIT;
+    if(dense) {
+        slot_count = static_cast<size_t>(hi - lo + 1);
+    } else {
+        sparse_slot.clear();
+        for(size_t i = 0; i < n; ++i) {
+            int id = points[i].cluster_id;
+            if(id >= 0) sparse_slot.emplace(id, sparse_slot.size());
+        }
+        slot_count = sparse_slot.size();
+    }
+
+    const size_t workers = workerCount();
+    worker_accum.resize(workers);
+    for(auto& acc : worker_accum) {
+        if(acc.size() < slot_count) acc.resize(slot_count);
+        for(size_t s = 0; s < slot_count; ++s) resetAccum(acc[s]);
+    }
+
+    // pass 1 : 개수, 합, 공분산용 제곱합, AABB
+    parallelFor(n, CLUSTER_POINT_GRAIN, workers, [&](size_t begin, size_t end, size_t worker) {
+        Accum* acc = worker_accum[worker].data();
+        for(size_t i = begin; i < end; ++i) {
+            const LidarData& p = points[i];
+            if(p.cluster_id < 0) continue;
+            Accum& a = acc[slotOf(p.cluster_id)];
+            ++a.count;
+            a.sx += p.x;  a.sy += p.y;  a.sz += p.z;
+            a.sxx += double(p.x) * p.x;
+            a.sxy += double(p.x) * p.y;
+            a.syy += double(p.y) * p.y;
+            a.bmin = glm::min(a.bmin, glm::vec3(p.x, p.y, p.z));
+            a.bmax = glm::max(a.bmax, glm::vec3(p.x, p.y, p.z));
+        }
+    });
+
+    if(merged.size() < slot_count) merged.resize(slot_count);
+    if(axis_cos.size() < slot_count) {
+        axis_cos.resize(slot_count);
+        axis_sin.resize(slot_count);
+    }
+    for(size_t s = 0; s < slot_count; ++s) {
+        Accum& m = merged[s];
+        resetAccum(m);
+        for(size_t w = 0; w < workers; ++w) {
+            const Accum& a = worker_accum[w][s];
+            m.count += a.count;
+            m.sx += a.sx;  m.sy += a.sy;  m.sz += a.sz;
+            m.sxx += a.sxx;  m.sxy += a.sxy;  m.syy += a.syy;
+            m.bmin = glm::min(m.bmin, a.bmin);
+            m.bmax = glm::max(m.bmax, a.bmax);
+        }
+
+        // xy 공분산의 주축 방향 (yaw)
+        float angle = 0.0f;
+        if(m.count > 1) {
+            double mx = m.sx / m.count;
+            double my = m.sy / m.count;
+            double cxx = m.sxx / m.count - mx * mx;
+            double cxy = m.sxy / m.count - mx * my;
+            double cyy = m.syy / m.count - my * my;
+            angle = static_cast<float>(0.5 * std::atan2(2.0 * cxy, cxx - cyy));
+        }
+        axis_cos[s] = std::cos(angle);
+        axis_sin[s] = std::sin(angle);
+    }
+
+    // pass 2 : 주축 좌표계에서의 범위 -> OBB
+    parallelFor(n, CLUSTER_POINT_GRAIN, workers, [&](size_t begin, size_t end, size_t worker) {
+        Accum* acc = worker_accum[worker].data();
+        for(size_t i = begin; i < end; ++i) {
+            const LidarData& p = points[i];
+            if(p.cluster_id < 0) continue;
+            size_t s = slotOf(p.cluster_id);
+            Accum& a = acc[s];
+            float u = p.x * axis_cos[s] + p.y * axis_sin[s];
+            float v = -p.x * axis_sin[s] + p.y * axis_cos[s];
+            a.umin = std::min(a.umin, u);  a.umax = std::max(a.umax, u);
+            a.vmin = std::min(a.vmin, v);  a.vmax = std::max(a.vmax, v);
+        }
+    });
+
+    std::vector<int> slot_id;
+    if(!dense) {
+        slot_id.resize(slot_count);
+        for(const auto& kv : sparse_slot) slot_id[kv.second] = kv.first;
+    }
+
+    for(size_t s = 0; s < slot_count; ++s) {
+        Accum& m = merged[s];
+        if(m.count < CLUSTER_MIN_POINTS) {
+            continue;
+        }
+        for(size_t w = 0; w < workers; ++w) {
+            const Accum& a = worker_accum[w][s];
+            m.umin = std::min(m.umin, a.umin);  m.umax = std::max(m.umax, a.umax);
+            m.vmin = std::min(m.vmin, a.vmin);  m.vmax = std::max(m.vmax, a.vmax);
+        }
+
+        glm::vec3 axis_u(axis_cos[s], axis_sin[s], 0.0f);
+        glm::vec3 axis_v(-axis_sin[s], axis_cos[s], 0.0f);
+
+        ClusterInfo info;
+        info.cluster_id = dense ? static_cast<int>(s) + id_min : slot_id[s];
+        info.count = m.count;
+        info.centroid = glm::vec3(m.sx / m.count, m.sy / m.count, m.sz / m.count);
+        info.aabb_min = m.bmin;
+        info.aabb_max = m.bmax;
+        info.obb_point = axis_u * m.umin + axis_v * m.vmin + glm::vec3(0.0f, 0.0f, m.bmin.z);
+        info.obb_xway = axis_u * (m.umax - m.umin);
+        info.obb_yway = axis_v * (m.vmax - m.vmin);
+        info.obb_zway = glm::vec3(0.0f, 0.0f, m.bmax.z - m.bmin.z);
+        clusters.push_back(info);
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <glm/glm.hpp>
+
+#include "binary_utils.h"
+
+
+// cluster_id별 통계 - AABB, xy 평면 주축 방향 OBB, 중심, 점 개수
+struct ClusterInfo {
+    int cluster_id;
+    uint32_t count;
+    glm::vec3 centroid;
+    glm::vec3 aabb_min;
+    glm::vec3 aabb_max;
+    // OBB : Space::addBox(point, xway, yway, zway) 형식 (한 꼭짓점 + 세 모서리 벡터)
+    glm::vec3 obb_point;
+    glm::vec3 obb_xway;
+    glm::vec3 obb_yway;
+    glm::vec3 obb_zway;
+};
+
+// 프레임 준비 시 cluster_id 기준 병렬 group-by (스레드별 누적 -> 병합)
+class ClusterStats {
+public:
+    // 같은 프레임이면 다시 계산하지 않음
+    void compute(const LidarBinary& frame);
+    const std::vector<ClusterInfo>& getClusters() const;
+
+    static void clusterColor(int cluster_id, glm::vec3& out_color);
+
+private:
+    struct Accum {
+        uint32_t count;
+        double sx, sy, sz;
+        double sxx, sxy, syy;
+        glm::vec3 bmin, bmax;
+        float umin, umax, vmin, vmax;   // 주축 좌표 범위 (2번째 pass)
+    };
+
+    void resetAccum(Accum& a) const;
+    size_t slotOf(int cluster_id) const;
+
+    const LidarBinary* last_frame = nullptr;
+    uint64_t last_time = 0;
+
+    int id_min = 0;
+    size_t slot_count = 0;
+    bool dense = true;                                   // id 범위가 작으면 배열, 아니면 해시
+    std::unordered_map<int, size_t> sparse_slot;         // dense == false일 때 id -> slot
+
+    std::vector<std::vector<Accum>> worker_accum;        // 스레드별 누적 버퍼 (프레임 사이 재사용)
+    std::vector<Accum> merged;
+    std::vector<float> axis_cos, axis_sin;               // slot별 주축 방향
+    std::vector<ClusterInfo> clusters;
+};
@@ -0,0 +1,291 @@
+#include "compact_lidar.h"
+#include "configs.h"
+#include "parallel_utils.h"
+#include "profiler.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#include <xmmintrin.h>
+#endif
+
+
+namespace {
+
+// 점 배열만 복원 (out은 in.num개 크기) - time / num은 건드리지 않음 (materialize 중 다른 스레드가 읽음)
+// SSE2 : 점 4개씩 16bit -> float 변환 후 4x4 전치, LidarData 앞 16 bytes(x, y, z, reflectivity)는 한 번에 저장
+void decodePoints(const CompactLidarFrame& in, LidarData* out) {
+    const size_t n = in.num;
+    const uint16_t* qx = in.xyz.data();
+    const uint16_t* qy = qx + n;
+    const uint16_t* qz = qy + n;
+    const uint8_t* refl = in.reflectivity.data();
+    const uint16_t* cluster = in.cluster.data();
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i shift = _mm_cvtsi32_si128(in.reflectivity_shift);
+    const __m128 ox = _mm_set1_ps(in.origin[0]), oy = _mm_set1_ps(in.origin[1]), oz = _mm_set1_ps(in.origin[2]);
+    const __m128 sx = _mm_set1_ps(in.scale[0]), sy = _mm_set1_ps(in.scale[1]), sz = _mm_set1_ps(in.scale[2]);
+    alignas(16) int32_t ids[4];
+    for(; i + 4 <= n; i += 4) {
+        __m128 x = _mm_add_ps(ox, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(qx + i)), zero)), sx));
+        __m128 y = _mm_add_ps(oy, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(qy + i)), zero)), sy));
+        __m128 z = _mm_add_ps(oz, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(qz + i)), zero)), sz));
+        int32_t r4;
+        std::memcpy(&r4, refl + i, 4);
+        __m128i r = _mm_sll_epi32(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(r4), zero), zero), shift);
+        __m128 w = _mm_castsi128_ps(r);     // reflectivity 비트 그대로 전치
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+        __m128i c = _mm_sub_epi32(_mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(cluster + i)), zero), one);
+        _mm_store_si128(reinterpret_cast<__m128i*>(ids), c);
+        _mm_storeu_ps(&out[i].x, x);        out[i].cluster_id = ids[0];
+        _mm_storeu_ps(&out[i + 1].x, y);    out[i + 1].cluster_id = ids[1];
+        _mm_storeu_ps(&out[i + 2].x, z);    out[i + 2].cluster_id = ids[2];
+        _mm_storeu_ps(&out[i + 3].x, w);    out[i + 3].cluster_id = ids[3];
+    }
+#endif
+    for(; i < n; ++i) {
+        out[i].x = in.origin[0] + static_cast<float>(qx[i]) * in.scale[0];
+        out[i].y = in.origin[1] + static_cast<float>(qy[i]) * in.scale[1];
+        out[i].z = in.origin[2] + static_cast<float>(qz[i]) * in.scale[2];
+        out[i].reflectivity = static_cast<uint32_t>(refl[i]) << in.reflectivity_shift;
+        out[i].cluster_id = static_cast<int>(cluster[i]) - 1;
+    }
+    for(const CompactNonFinite& p : in.non_finite) {
+        out[p.index].x = p.x;
+        out[p.index].y = p.y;
+        out[p.index].z = p.z;
+    }
+}
+
+uint64_t frameBytes(const CompactLidarFrame& frame) {
+    return sizeof(CompactLidarFrame) + frame.xyz.size() * sizeof(uint16_t) + frame.reflectivity.size() +
+           frame.cluster.size() * sizeof(uint16_t) + frame.non_finite.size() * sizeof(CompactNonFinite);
+}
+
+}
+
+
+void CompactLidarStore::encode(const LidarBinary& frame, CompactLidarFrame& out) {
+    const std::vector<LidarData>& pts = frame.lidar_data;
+    const size_t n = pts.size();
+    out.time = frame.time;
+    out.num = static_cast<uint32_t>(n);
+    out.xyz.resize(n * 3);
+    out.reflectivity.resize(n);
+    out.cluster.resize(n);
+    out.non_finite.clear();
+
+    // 축별 범위 (비정상 좌표는 범위에서 빼고 non_finite에 원래 값 보관)
+    float lo[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+    float hi[3] = {-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max()};
+    uint32_t max_refl = 0;
+    for(const LidarData& p : pts) {
+        const float v[3] = {p.x, p.y, p.z};
+        for(int a = 0; a < 3; ++a) {
+            if(std::isfinite(v[a])) {
+                lo[a] = std::min(lo[a], v[a]);
+                hi[a] = std::max(hi[a], v[a]);
+            }
+        }
+        max_refl = std::max(max_refl, p.reflectivity);
+    }
+    float inv[3];
+    for(int a = 0; a < 3; ++a) {
+        if(lo[a] > hi[a]) {
+            lo[a] = hi[a] = 0.0f;
+        }
+        const float range = hi[a] - lo[a];
+        out.origin[a] = lo[a];
+        out.scale[a] = range / 65535.0f;
+        inv[a] = (range > 0.0f) ? 65535.0f / range : 0.0f;
+    }
+    out.reflectivity_shift = 0;
+    while((max_refl >> out.reflectivity_shift) > 255) {
+        ++out.reflectivity_shift;
+    }
+
+    uint16_t* qx = out.xyz.data();
+    uint16_t* qy = qx + n;
+    uint16_t* qz = qy + n;
+    auto quantize = [&](float v, int a) -> uint16_t {
+        if(!std::isfinite(v)) {
+            return 0;       // 복원 때 non_finite 값으로 덮음
+        }
+        float q = std::round((v - lo[a]) * inv[a]);
+        return static_cast<uint16_t>(std::min(std::max(q, 0.0f), 65535.0f));
+    };
+    for(size_t i = 0; i < n; ++i) {
+        const LidarData& p = pts[i];
+        qx[i] = quantize(p.x, 0);
+        qy[i] = quantize(p.y, 1);
+        qz[i] = quantize(p.z, 2);
+        if(!std::isfinite(p.x) || !std::isfinite(p.y) || !std::isfinite(p.z)) {
+            out.non_finite.push_back({static_cast<uint32_t>(i), p.x, p.y, p.z});
+        }
+        out.reflectivity[i] = static_cast<uint8_t>(p.reflectivity >> out.reflectivity_shift);
+        out.cluster[i] = static_cast<uint16_t>(std::min(std::max(p.cluster_id + 1, 0), 65535));
+    }
+}
+
+void CompactLidarStore::decode(const CompactLidarFrame& in, LidarBinary& out) {
+    out.time = in.time;
+    out.num = in.num;
+    out.lidar_data.resize(in.num);
+    decodePoints(in, out.lidar_data.data());
+}
+
+
+void CompactLidarStore::build(std::vector<LidarBinary>& list) {
+    PROFILE_SCOPE("CompactLidarStore::build");
+    clear();
+    MyTimer timer;
+    frames.resize(list.size());
+    parallelFor(list.size(), 1, [&](size_t begin, size_t end, size_t) {
+        for(size_t i = begin; i < end; ++i) {
+            encode(list[i], frames[i]);
+        }
+    });
+    timer.end();
+    encode_ms = std::chrono::duration<double, std::milli>(timer.end_time - timer.start_time).count();
+    measureDecode();
+
+    for(size_t i = 0; i < list.size(); ++i) {
+        raw_bytes += list[i].lidar_data.size() * sizeof(LidarData);
+        compact_bytes += frameBytes(frames[i]);
+        non_finite_points += frames[i].non_finite.size();
+        std::vector<LidarData>().swap(list[i].lidar_data);     // capacity까지 해제
+    }
+}
+
+void CompactLidarStore::append(std::vector<CompactLidarFrame>& encoded, double encoded_ms) {
+    for(CompactLidarFrame& frame : encoded) {
+        raw_bytes += static_cast<uint64_t>(frame.num) * sizeof(LidarData);
+        compact_bytes += frameBytes(frame);
+        non_finite_points += frame.non_finite.size();
+        frames.push_back(std::move(frame));
+    }
+    encoded.clear();
+    encode_ms += encoded_ms;
+}
+
+void CompactLidarStore::measureDecode() {
+    // 원래 배치 표본은 복원해서 만듦 (점진 로드는 원본 점 배열이 남아 있지 않음) - 같은 점 수 / 같은 20 bytes 배치
+    // 버퍼는 미리 한 번 채워 할당 제외
+    const size_t samples = std::min<size_t>(COMPACT_SAMPLE_FRAMES, frames.size());
+    if(samples == 0) {
+        return;
+    }
+    std::vector<LidarBinary> raw(samples);
+    LidarBinary scratch;
+    std::vector<LidarData> copy;
+    for(size_t s = 0; s < samples; ++s) {
+        const size_t i = s * frames.size() / samples;
+        decode(frames[i], raw[s]);
+        decode(frames[i], scratch);
+        copy.assign(raw[s].lidar_data.begin(), raw[s].lidar_data.end());
+    }
+    MyTimer decode_timer;
+    for(size_t s = 0; s < samples; ++s) {
+        decode(frames[s * frames.size() / samples], scratch);
+    }
+    decode_timer.end();
+    MyTimer copy_timer;
+    for(size_t s = 0; s < samples; ++s) {
+        copy.assign(raw[s].lidar_data.begin(), raw[s].lidar_data.end());
+    }
+    copy_timer.end();
+    decode_ms = std::chrono::duration<double, std::milli>(decode_timer.end_time - decode_timer.start_time).count() / samples;
+    copy_ms = std::chrono::duration<double, std::milli>(copy_timer.end_time - copy_timer.start_time).count() / samples;
+}
+
+void CompactLidarStore::clear() {
+    frames.clear();
+    materialized = SIZE_MAX;
+    raw_bytes = 0;
+    compact_bytes = 0;
+    non_finite_points = 0;
+    encode_ms = 0.0;
+    decode_ms = 0.0;
+    copy_ms = 0.0;
+    last_decode_ms = 0.0;
+}
+
+bool CompactLidarStore::empty() const {
+    return frames.empty();
+}
+
+
+void CompactLidarStore::materialize(size_t idx, std::vector<LidarBinary>& list) {
+    if(idx >= frames.size() || idx >= list.size() || idx == materialized) {
+        return;
+    }
+    PROFILE_SCOPE("CompactLidarStore::materialize");
+    MyTimer timer;
+    std::vector<LidarData>& points = list[idx].lidar_data;
+    if(materialized < list.size()) {
+        points.swap(list[materialized].lidar_data);    // 직전 프레임 버퍼 재사용, 직전 프레임은 빈 배열로
+    }
+    points.resize(frames[idx].num);
+    decodePoints(frames[idx], points.data());
+    materialized = idx;
+    timer.end();
+    last_decode_ms = std::chrono::duration<double, std::milli>(timer.end_time - timer.start_time).count();
+}
+
+const LidarBinary& CompactLidarStore::view(const CompactLidarStore* store, const std::vector<LidarBinary>& list, size_t idx,
+                                           LidarBinary& scratch) {
+    if(store == nullptr || store->empty()) {
+        return list[idx];
+    }
+    decode(store->frames[idx], scratch);
+    return scratch;
+}
+
+
+uint64_t CompactLidarStore::getRawBytes() const {
+    return raw_bytes;
+}
+
+uint64_t CompactLidarStore::getCompactBytes() const {
+    return compact_bytes;
+}
+
+uint64_t CompactLidarStore::getNonFinitePoints() const {
+    return non_finite_points;
+}
+
+double CompactLidarStore::getEncodeMs() const {
+    return encode_ms;
+}
+
+double CompactLidarStore::getDecodeMs() const {
+    return decode_ms;
+}
+
+double CompactLidarStore::getCopyMs() const {
+    return copy_ms;
+}
+
+double CompactLidarStore::getLastDecodeMs() const {
+    return last_decode_ms;
+}
+
+void CompactLidarStore::printReport() const {
+    const double mb = 1024.0 * 1024.0;
+    std::cout << "[Compact] " << frames.size() << " frames, " << std::fixed << std::setprecision(1) << raw_bytes / mb << " MB -> "
+              << compact_bytes / mb << " MB (" << (raw_bytes > 0 ? 100.0 * compact_bytes / raw_bytes : 0.0) << " %), encode "
+              << encode_ms << " ms";
+    if(decode_ms > 0.0) {       // measureDecode 전 (빈 저장소)은 생략
+        std::cout << ", decode " << std::setprecision(3) << decode_ms << " ms / frame (raw copy " << copy_ms << " ms)";
+    }
+    if(non_finite_points > 0) {     // 손상 좌표는 원래 값(NaN / inf) 그대로 복원 -> 각 단계가 --compact 없을 때처럼 건너뜀
+        std::cout << ", " << non_finite_points << " non-finite points restored as-is";
+    }
+    std::cout << std::defaultfloat << std::setprecision(6) << std::endl;
+}
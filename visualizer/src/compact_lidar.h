@@ -0,0 +1,76 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "binary_utils.h"
+
+
+// 좌표가 비정상(NaN / inf)인 점 - 양자화하지 않고 원래 값 보관 (복원 후 덮어씀 -> --compact 없을 때와 같은 점)
+struct CompactNonFinite {
+    uint32_t index;
+    float x, y, z;
+};
+
+// 라이다 프레임 하나의 메모리 압축 표현 - 점당 9 bytes (LidarData 20 bytes)
+// xyz : 프레임별 축 범위를 16bit로 양자화 (범위 100 m면 간격 1.5 mm), 반사도 8bit, cluster id 16bit
+struct CompactLidarFrame {
+    uint64_t time = 0;
+    uint32_t num = 0;
+    float origin[3] = {0.0f, 0.0f, 0.0f};      // 축별 최소값
+    float scale[3] = {0.0f, 0.0f, 0.0f};       // 양자화 간격 (축별 범위 / 65535)
+    uint8_t reflectivity_shift = 0;             // 반사도가 255를 넘는 프레임은 오른쪽 shift (하위 비트 손실)
+    std::vector<uint16_t> xyz;                  // [x ... | y ... | z ...] (SoA, num x 3)
+    std::vector<uint8_t> reflectivity;
+    std::vector<uint16_t> cluster;              // cluster_id + 1 (-1 noise -> 0), 65534 초과는 포화
+    std::vector<CompactNonFinite> non_finite;   // 보통 비어 있음 (손상 녹화)
+};
+
+// 전체 녹화의 압축 저장소 (뷰어 --compact)
+// build 후 원본 lidar_data는 해제하고 time / num만 남김 -> 프레임 주소(포인터 비교 / 포인터 산술)는 그대로
+// 화면에 올리는 프레임은 materialize로 원본 자리에 복원, 백그라운드 처리는 view로 자기 버퍼에 복원
+class CompactLidarStore {
+public:
+    static void encode(const LidarBinary& frame, CompactLidarFrame& out);
+    static void decode(const CompactLidarFrame& in, LidarBinary& out);     // SSE2 (없으면 스칼라), out 버퍼 재사용
+
+    // frames를 압축하고 원본 점 배열 해제 (프레임 단위 병렬)
+    void build(std::vector<LidarBinary>& frames);
+    // 점진 로드 : 다른 스레드에서 encode한 프레임을 뒤에 옮겨 붙임 (라이다 프레임 배열과 같은 순서 / 개수로), encode_ms는 누적
+    // 표본 복원 시간은 다 붙인 뒤 measureDecode로 측정
+    void append(std::vector<CompactLidarFrame>& encoded, double encoded_ms);
+    // 고르게 뽑은 표본 프레임 복원 vs 같은 점을 원래 배치(LidarData)로 복사 -> getDecodeMs / getCopyMs (build는 자동 호출)
+    void measureDecode();
+    void clear();
+    bool empty() const;
+
+    // frames[idx].lidar_data 복원, 직전에 복원한 프레임은 다시 비움 (버퍼 교환 -> 재할당 없음)
+    // 메인 스레드 전용 - 백그라운드 스레드는 lidar_data를 읽지 말고 view 사용
+    void materialize(size_t idx, std::vector<LidarBinary>& frames);
+
+    // 저장소가 비어 있으면 list[idx] 그대로, 아니면 scratch에 복원해 돌려줌 (여러 스레드에서 동시 호출 가능)
+    static const LidarBinary& view(const CompactLidarStore* store, const std::vector<LidarBinary>& list, size_t idx,
+                                   LidarBinary& scratch);
+
+    uint64_t getRawBytes() const;           // 압축 전 점 배열 (LidarData 20 bytes / 점)
+    uint64_t getCompactBytes() const;
+    uint64_t getNonFinitePoints() const;    // 원래 값 그대로 보관한 비정상 좌표 점 수
+    double getEncodeMs() const;
+    double getDecodeMs() const;             // 표본 프레임 평균 복원 시간 (measureDecode)
+    double getCopyMs() const;               // 같은 표본을 원래 배치 그대로 복사하는 시간 (비교 기준)
+    double getLastDecodeMs() const;         // 마지막 materialize
+
+    void printReport() const;
+
+private:
+    std::vector<CompactLidarFrame> frames;
+    size_t materialized = SIZE_MAX;
+    uint64_t raw_bytes = 0;
+    uint64_t compact_bytes = 0;
+    uint64_t non_finite_points = 0;
+    double encode_ms = 0.0;
+    double decode_ms = 0.0;
+    double copy_ms = 0.0;
+    double last_decode_ms = 0.0;
+};
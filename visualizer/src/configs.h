@@ -9,6 +9,23 @@
 #define WINDOW_WIDTH    1280        //창 너비
 #define WINDOW_HEIGHT   720         //창 높이
 
+// projection
+#define FOV_Y           45.0f       // 수직 시야각 // degree
+#define NEAR_PLANE      0.1f
+#define FAR_PLANE       100.0f
+
+// multi-viewport (뷰어 v 키 / --views, viewport_layout.h) - 한 번 준비 / 업로드한 버퍼를 보기마다 카메라만 바꿔 다시 그림
+#define VIEW_DEFAULT_COUNT  1           // 시작 보기 수 (1, 2, 4)
+#define VIEW_ORTHO_SCALE    1.0f        // 평행 투영 보기 크기 : 궤도 반지름 거리의 원근 화면과 같은 폭 x 이 값
+#define VIEW_ORTHO_DEPTH    50.0f       // 평행 투영 카메라를 중심에서 떨어뜨리는 거리 (앞뒤로 그리는 범위) // m
+
+// 보기 종류 - ORBIT : 마우스 / 키로 조작하는 원근 카메라, 나머지는 ORBIT 중심과 수평 방향을 따라가는 평행 투영
+// TOP : 위에서 내려다봄 (화면 위쪽 = 궤도 카메라가 보는 방향), SIDE : 오른쪽 옆에서, FRONT : 궤도 카메라 쪽에서 수평으로
+enum ViewKind { VIEW_ORBIT, VIEW_TOP, VIEW_SIDE, VIEW_FRONT };
+static const ViewKind view_layout_1[] = {VIEW_ORBIT};
+static const ViewKind view_layout_2[] = {VIEW_ORBIT, VIEW_TOP};                         // 좌 / 우
+static const ViewKind view_layout_4[] = {VIEW_ORBIT, VIEW_TOP, VIEW_SIDE, VIEW_FRONT};   // 좌상 / 우상 / 좌하 / 우하
+
 // Constants
 #define ORBIT_SPEED         0.01f   // 궤도 회전 속도
 #define TRANSLATION_SPEED   0.5f    // 이동 속도
@@ -17,6 +34,7 @@
 #define CAMERA_SPEED        0.1f
 
 // Scene set
+#define LIDAR_POINT_SIZE    2.0f    // 라이다 점 크기 (GL_POINTS) // pixel
 #define GRID_NUM        16
 #define GRID_Z_OFFSET   -0.01f
 #define GRID_COEFFI     2
@@ -31,10 +49,170 @@
 #define PANORAMA_WINDOW_WIDTH   2048
 #define PANORAMA_WINDOW_HEIGHT  512
 #define ZOOM                    2
+#define PANORAMA_ELEV_MIN       -30.0f  // 범위 이미지 고도각 하한 // degree
+#define PANORAMA_ELEV_MAX       30.0f   // 범위 이미지 고도각 상한 // degree
+#define PANORAMA_MAX_RANGE      100.0f  // 거리 색상 최대값 // m
+
+// cluster
+#define CLUSTER_MIN_POINTS      3       // 박스를 그릴 최소 점 개수
+#define CLUSTER_DENSE_LIMIT     4096    // cluster_id 범위가 이보다 작으면 배열 group-by, 크면 해시
+#define CLUSTER_PALETTE_SIZE    64
+
+// ground (RANSAC)
+#define GROUND_DIST_THRESHOLD       0.15f   // 평면 inlier 거리 // m
+#define GROUND_RANSAC_ITERATIONS    200     // 가설 수
+#define GROUND_WARM_ITERATIONS      24      // warm start 시 가설 수
+#define GROUND_WARM_MIN_RATIO       0.3     // 직전 평면 inlier 비율이 이 이상이면 warm start
+#define GROUND_MIN_INLIER_RATIO     0.1     // inlier 비율이 이보다 작으면 지면 없음
+#define GROUND_SAMPLE_POINTS        8192    // 가설 점수 계산 표본 수
+#define GROUND_MAX_TILT             30.0f   // 지면 법선 최대 기울기 // degree
+#define GROUND_DIM_FACTOR           0.25f   // dim 모드 지면 점 밝기
+
+// association (lidar point -> detection box)
+#define ASSOC_CELL_SIZE     2.0f    // 박스 격자 셀 크기 // m
+#define ASSOC_MAX_GRID_DIM  256     // 격자 한 변 최대 셀 수 (넘으면 셀 크기를 키움)
+
+// tracker
+#define TRACK_GATE_DIST         2.0f    // 예측 위치와 검출 중심 최대 거리 (= 공간 해시 셀 크기) // m
+#define TRACK_MAX_GAP_MS        1000    // 마지막 검출 후 이 시간 지나면 track 종료 // ms
+#define TRACK_MAX_MISSES        5       // 연속 미검출 프레임 수 한도
+#define TRACK_VELOCITY_ALPHA    0.5f    // 속도 갱신 평활 계수
+#define TRACK_HUNGARIAN_MAX     64      // 연결 성분이 이보다 크면 greedy 할당
+#define TRACK_TRAIL_LENGTH      30      // 화면에 그리는 궤적 점 수
+
+// multi-lidar fusion (lidar_N_*.uld, 기준 센서 binary_utils.h LIDAR_ID)
+#define FUSION_MAX_TIME_DIFF    50      // 기준 스윕과 묶을 다른 센서 스윕의 최대 시간 차 // ms
+
+// 센서별 외부 파라미터 : 센서 좌표 -> 공통(기체) 좌표, 위치 m / 회전 degree (R = yaw(z) * pitch(y) * roll(x))
+// 목록에 없는 센서는 단위 변환
+struct LidarExtrinsic {
+    int sensor_id;
+    float x, y, z;
+    float roll, pitch, yaw;
+};
+static const LidarExtrinsic lidar_extrinsics[] = {
+    {0,     0.0f, 0.0f, 0.0f,       0.0f, 0.0f, 0.0f},
+};
+
+// static background model
+#define BG_VOXEL_SIZE       0.2f    // voxel 한 변 // m
+#define BG_BORDER_MARGIN    0.25f   // voxel 경계에서 이 비율 이내인 점은 면 이웃 voxel도 관측으로 기록
+#define BG_HISTORY_FRAMES   10      // 관측 이력 창 (32 이하)
+#define BG_STATIC_HITS      8       // 창 안에서 이만큼 관측되면 정적
+#define BG_REFRESH_FRAMES   20      // 정적 배경 점 재수집 / GPU 재업로드 주기
+#define BG_MAX_GAP_MS       1000    // 프레임 간격이 이보다 크면 모델 초기화 (탐색 이동) // ms
+
+// scan registration / accumulated map (scan_registration.h)
+#define REG_VOXEL_SIZE          0.5f    // 정합 / 지도용 스윕 축소 voxel // m
+#define REG_MIN_RANGE           1.0f    // 이보다 가까운 점 제외 (기체 자신) // m
+#define REG_MAX_RANGE           100.0f  // 이보다 먼 점 제외 // m
+#define REG_MIN_VOXEL_POINTS    4       // 법선을 구할 voxel 최소 점 수
+#define REG_PLANARITY           0.1f    // 최소 / 중간 고유값 비가 이보다 작으면 평면 voxel (target)
+#define REG_MAX_SOURCE_POINTS   4000    // 정합에 쓰는 source voxel 수 상한 (일정 간격 표본)
+#define REG_MAX_CORR_DIST       1.5f    // 대응점 최대 거리 // m
+#define REG_HUBER_DELTA         0.1f    // 잔차가 이보다 크면 가중치 감소 // m
+#define REG_MAX_ITERATIONS      30
+#define REG_CONVERGE_EPS        1e-4f   // 갱신량(회전 rad + 이동 m)이 이보다 작으면 종료
+#define REG_MIN_INLIER_RATIO    0.3f    // 대응점 비율이 이보다 낮으면 정합 실패 -> 등속 예측 사용
+#define REG_MAX_GAP_MS          500     // 스윕 간격이 이보다 크면 등속 예측 대신 정지 가정 // ms
+#define REG_POINT_GRAIN         256     // 대응점 탐색 청크 (점 수)
+#define REG_BATCH_PER_WORKER    2       // 스윕 축소 묶음 = worker 수 x 이 값
+#define REG_MAP_VOXEL_SIZE      0.5f    // 누적 지도 voxel // m
+#define REG_MAP_MIN_HITS        3       // 이만큼 스윕에서 관측된 지도 voxel만 표시 (움직이는 물체 흔적 제외)
+#define REG_MAP_BRIGHTNESS      0.6f    // 지도 점 색 밝기 (현재 스윕보다 어둡게)
+#define REG_MAP_POINT_SIZE      1.0f    // 지도 점 크기 // pixel
+
+// picking
+#define PICK_POINT_RADIUS   0.1f    // 광선-점 선택 허용 반경 // m
+
+// density map (bird's-eye)
+#define DENSITY_MAP_CELLS       256     // 격자 한 변 셀 수
+#define DENSITY_MAP_RANGE       100.0f  // 원점 기준 누적 반경 // m
+#define DENSITY_MAP_VIEW_SIZE   256     // 화면 표시 크기 // pixel
+#define DENSITY_MAP_MARGIN      10      // 화면 우하단 여백 // pixel
+
+// timeline stats strip (3D 화면 하단)
+#define TIMELINE_STRIP_HEIGHT       80      // 채널 4줄 전체 높이 // pixel
+#define TIMELINE_STRIP_MARGIN       10      // 화면 좌하단 여백 // pixel
+#define TIMELINE_STRIP_MIN_SPAN     16      // 최대 확대 시 보이는 항목 수
+#define TIMELINE_STRIP_ZOOM_STEP    0.8f    // 스크롤 한 칸 확대 배율
+
+// export (aeronSW_export)
+#define EXPORT_BATCH_PER_WORKER 2           // 묶음 하나의 프레임 수 = worker 수 x 이 값 (메모리 상한)
+#define EXPORT_DEFAULT_DIR      "export"    // 기본 출력 디렉토리
+
+// benchmark (aeronSW_bench) - 고정 시드 합성 입력
+#define BENCH_SEED              42
+#define BENCH_LIDAR_FRAMES      100     // --quick : 1/10
+#define BENCH_LIDAR_POINTS      65536   // 프레임당 점 수
+#define BENCH_OBJ_PER_FRAME     8
+#define BENCH_TIMELINE_FRAMES   200000  // 타임라인 / 매칭 측정용 센서별 프레임 수 (헤더만, 약 5시간 분량)
+#define BENCH_PICK_POINTS       1000000 // picking 측정 프레임 점 수 (render_1000000과 같은 크기)
+
+// flythrough benchmark (뷰어 --flythrough / --record-path, camera_path.h)
+#define FLY_DEFAULT_STEP_MS     100                         // 렌더 프레임당 타임라인 진행 (경로 파일 step으로 변경) // ms
+#define FLY_DEFAULT_WARMUP      10                          // 통계에서 뺄 앞쪽 프레임 수 (경로 파일 warmup으로 변경)
+#define FLY_DEFAULT_RESULT_FILE "flythrough_results.json"
+
+// recording generator (aeronSW_generate)
+#define GEN_BATCH_PER_WORKER    2               // 묶음 하나의 스윕 수 = worker 수 x 이 값 (메모리 상한)
+#define GEN_DEFAULT_DIR         "generated"     // 기본 출력 디렉토리
+
+// recording inspector (aeronSW_inspect)
+#define INSPECT_GAP_FACTOR      3.0     // 중앙 프레임 간격의 이 배수를 넘으면 끊김으로 집계
+#define INSPECT_MAX_GAPS        10      // 출력할 가장 긴 끊김 수
+
+// load-time ROI (binary_utils.h LidarRoi) - 로드 중 관심 영역 밖 점을 버림, 모든 조건을 만족하는 점만 남김
+#define ROI_FILTER              0           // 1 : 뷰어 / 서버 로드 시 항상 적용 (0이면 --roi로 켬)
+#define ROI_MIN_RANGE           1.0f        // 센서 원점 3D 거리 하한 (기체 자체 반사 제거) // m
+#define ROI_MAX_RANGE           120.0f      // 센서 원점 3D 거리 상한 // m
+#define ROI_MIN_Z               -30.0f      // 높이 구간 // m
+#define ROI_MAX_Z               30.0f
+#define ROI_BOX_MIN             glm::vec3(-1000.0f, -1000.0f, -1000.0f)    // 축 정렬 상자 (비행 경로 주변 통로) // m
+#define ROI_BOX_MAX             glm::vec3(1000.0f, 1000.0f, 1000.0f)
+#define ROI_MIN_REFLECTIVITY    0           // 반사도 하한 (0 : 끔)
+
+// recording merge (frame_merge.h) - 파일 하나를 시간순 run 하나로 보고 k-way 병합
+#define MERGE_REORDER_WINDOW    16      // run마다 미리 읽는 프레임 수 (이 안의 순서 뒤바뀜은 복구, 넘으면 버림)
+
+// compact lidar (뷰어 --compact, compact_lidar.h) - 점당 9 bytes 메모리 표현
+#define COMPACT_SAMPLE_FRAMES   32      // 복원 / 복사 비용 측정에 쓰는 표본 프레임 수
+
+// progressive load (뷰어, progressive_loader.h) - 창을 먼저 띄우고 녹화를 시간 구간 단위로 백그라운드 로드하며 재생
+#define LOAD_CHUNK_MS           1000    // 로드 스레드가 한 번에 넘기는 녹화 시간 구간 (첫 구간이 준비되면 재생 시작) // ms
+#define LOAD_POLL_BUDGET_MS     2.0     // 메인 루프 한 바퀴에서 구간을 받아 타임라인 / 매칭 표를 늘리는 시간 상한 // ms
+#define LOAD_WORKERS            1       // 로드 스레드의 융합 / 압축 병렬 수 (1 : 작업 스레드 풀을 쓰지 않음 -> 화면 프레임 처리와 경쟁 없음)
+
+// remote viewing (aeronSW_server / aeronSW_client, stream_protocol.h)
+#define STREAM_DEFAULT_PORT         7400
+#define STREAM_QUANT_STEP           0.005f      // 점 좌표 양자화 간격 // m
+#define STREAM_MAX_STRIDE           16          // 대역폭이 부족할 때 점을 솎는 최대 간격
+#define STREAM_MAX_INFLIGHT_BYTES   (8 << 20)   // 보냈지만 ACK 안 된 양이 이보다 많으면 라이다 프레임 건너뜀
+#define STREAM_CONGESTED_BYTES      (2 << 20)   // 이보다 많으면 혼잡으로 보고 stride 2배
+#define STREAM_MAX_LAG_MS           200         // 재생 시각보다 이만큼 늦은 라이다 프레임은 건너뜀 // ms
+#define STREAM_PROBE_FRAMES         20          // 혼잡 없이 이만큼 보내면 stride 절반
+#define STREAM_SEEK_STEP_MS         5000        // 클라이언트 좌우 방향키 이동 // ms
+#define STREAM_MAX_SPEED            16.0f       // 클라이언트 PgUp / PgDn 배속 범위 (1/이 값 ~ 이 값, 2배씩)
+#define STREAM_STATS_INTERVAL_MS    1000        // 서버 / 클라이언트 전송 통계 갱신 주기 // ms
+#define STREAM_MAX_MESSAGE_BYTES    (64u << 20) // 받는 메시지 크기 상한 (잘못된 헤더 방어)
 
 // dataset
+#define UAM_DATA_PATH   "../../data/uam_data"
 #define COCODATASET 1
 
+// debug
+#ifndef ALLOC_COUNTER
+#define ALLOC_COUNTER   0       // 1 : 전역 operator new 교체로 힙 할당 횟수 집계 (alloc_counter.h) - aeronSW_bench는 CMake에서 1 (정상 재생 할당 검사), 뷰어는 -DAERONSW_ALLOC_COUNTER=ON
+#endif
+
+// profiler (단계별 프레임 시간 HUD / Chrome trace, profiler.h)
+#define PROFILER                    1           // 0 : PROFILE_SCOPE probe 코드 자체를 빼고 빌드
+#define PROFILE_MAX_STAGES          48
+#define PROFILE_HISTORY_FRAMES      240         // 백분위 계산 창 (프레임)
+#define PROFILE_HUD_REFRESH         15          // HUD 숫자 갱신 주기 (프레임)
+#define PROFILE_TRACE_MAX_EVENTS    2000000     // trace 이벤트 상한 (24 bytes / 이벤트), 넘으면 버림
+#define PROFILE_TRACE_DEFAULT_FILE  "trace.json"
+
 
 #include <chrono>
 #include <unordered_map>
@@ -60,6 +238,10 @@ public:
         return std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();    // 밀리초 값을 정수로 반환
     }
 
+    double elapsed_us(){
+        return std::chrono::duration<double, std::micro>(end_time - start_time).count();     // 마이크로초 (소수 포함)
+    }
+
     std::chrono::time_point<std::chrono::high_resolution_clock> start_time;     // high_resolution_clock 기준의 한 시점
     std::chrono::time_point<std::chrono::high_resolution_clock> end_time;
 
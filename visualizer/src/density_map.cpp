@@ -0,0 +1,340 @@
+#include "density_map.h"
+#include "parallel_utils.h"
+
+#include <cmath>
+#include <algorithm>
+#include <iostream>
+
+#define DENSITY_FRAME_GRAIN  4      // 스레드가 한 번에 가져가는 프레임 수 (최소)
+#define DENSITY_WORKER_CHUNKS 8     // 스레드당 청크 수 - 청크 경계마다 셀 구간이 끊기므로 너무 잘게 나누지 않음
+
+
+namespace {
+
+struct CellRun {
+    uint32_t cell;
+    uint32_t begin, end;
+};
+
+// 스레드별 타일 - 셀별 누적 수 + 지금 이어지는 프레임 구간 (잠금/원자연산 없이 누적)
+// 한 스레드가 가져가는 청크는 오름차순이라 구간이 끊길 때만 runs에 기록
+struct Tile {
+    std::vector<uint32_t> counts;
+    std::vector<uint32_t> run_begin;
+    std::vector<uint32_t> run_end;      // 0 = 구간 없음
+    std::vector<CellRun> runs;
+
+    explicit Tile(size_t cells) : counts(cells, 0), run_begin(cells, 0), run_end(cells, 0) {}
+
+    void hit(uint32_t cell, uint32_t frame) {
+        ++counts[cell];
+        if(run_end[cell] == frame + 1) {
+            return;
+        }
+        if(run_end[cell] == frame) {
+            run_end[cell] = frame + 1;
+            return;
+        }
+        if(run_end[cell] != 0) {
+            runs.push_back({cell, run_begin[cell], run_end[cell]});
+        }
+        run_begin[cell] = frame;
+        run_end[cell] = frame + 1;
+    }
+
+    void flush() {
+        for(uint32_t cell = 0; cell < run_end.size(); ++cell) {
+            if(run_end[cell] != 0) {
+                runs.push_back({cell, run_begin[cell], run_end[cell]});
+            }
+        }
+    }
+};
+
+// 스레드별 구간 -> 셀별 구간 목록 (셀 기준 counting sort, 셀 안에서 시작 순 정렬 후 이어지는 구간 합침)
+void buildCellRanges(std::vector<Tile>& tiles, size_t workers, std::vector<uint32_t>& offsets,
+                     std::vector<DensityMap::FrameRange>& ranges) {
+    const size_t cells = DENSITY_MAP_CELLS * DENSITY_MAP_CELLS;
+    std::vector<uint32_t> fill(cells + 1, 0);
+    for(auto& tile : tiles) {
+        tile.flush();
+        for(const CellRun& run : tile.runs) ++fill[run.cell + 1];
+    }
+    for(size_t i = 0; i < cells; ++i) fill[i + 1] += fill[i];
+    offsets = fill;
+
+    ranges.resize(fill[cells]);
+    for(auto& tile : tiles) {
+        for(const CellRun& run : tile.runs) ranges[fill[run.cell]++] = {run.begin, run.end};
+        std::vector<CellRun>().swap(tile.runs);
+    }
+
+    std::vector<uint32_t> merged(cells, 0);
+    parallelForBackground(cells, 256, workers, [&](size_t begin, size_t end, size_t) {
+        for(size_t i = begin; i < end; ++i) {
+            auto first = ranges.begin() + offsets[i];
+            auto last = ranges.begin() + offsets[i + 1];
+            if(first == last) {
+                continue;
+            }
+            std::sort(first, last, [](const DensityMap::FrameRange& a, const DensityMap::FrameRange& b) { return a.begin < b.begin; });
+            auto out = first;
+            for(auto it = first + 1; it != last; ++it) {
+                if(it->begin <= out->end) out->end = std::max(out->end, it->end);
+                else *++out = *it;
+            }
+            merged[i] = static_cast<uint32_t>(out - first + 1);
+        }
+    });
+
+    // 합친 구간을 앞으로 당김
+    size_t write = 0;
+    for(size_t i = 0; i < cells; ++i) {
+        const size_t read = offsets[i];
+        offsets[i] = static_cast<uint32_t>(write);
+        std::copy(ranges.begin() + read, ranges.begin() + read + merged[i], ranges.begin() + write);
+        write += merged[i];
+    }
+    offsets[cells] = static_cast<uint32_t>(write);
+    ranges.resize(write);
+    ranges.shrink_to_fit();
+}
+
+void expandRanges(const std::vector<uint32_t>& offsets, const std::vector<DensityMap::FrameRange>& ranges, size_t cell,
+                  std::vector<size_t>& out) {
+    for(uint32_t r = offsets[cell]; r < offsets[cell + 1]; ++r) {
+        for(uint32_t f = ranges[r].begin; f < ranges[r].end; ++f) out.push_back(f);
+    }
+}
+
+}
+
+
+DensityMap::DensityMap()
+    : lidar_list(nullptr), obj_list(nullptr), ready(false), cancel(false), visible(false),
+      selected_x(-1), selected_y(-1) {}
+
+DensityMap::~DensityMap() {
+    stop();
+}
+
+void DensityMap::stop() {
+    cancel = true;      // 남은 프레임은 버림 (ready는 false로 남음)
+    if(build_thread.joinable()) {
+        build_thread.join();
+    }
+}
+
+void DensityMap::startBuild(const std::vector<LidarBinary>& lidar, const std::vector<ObjBinary>& obj, const CompactLidarStore* compact_store) {
+    if(build_thread.joinable()) {
+        build_thread.join();
+    }
+    lidar_list = &lidar;
+    obj_list = &obj;
+    compact = compact_store;
+    ready = false;
+    cancel = false;
+    build_thread = std::thread(&DensityMap::build, this);
+}
+
+bool DensityMap::isReady() const {
+    return ready.load();
+}
+
+void DensityMap::toggleVisible() {
+    visible = !visible;
+}
+
+bool DensityMap::isVisible() const {
+    return visible;
+}
+
+void DensityMap::setSelectedCell(int cell_x, int cell_y) {
+    selected_x = cell_x;
+    selected_y = cell_y;
+}
+
+int DensityMap::worldToCell(float v) const {
+    float t = (v + DENSITY_MAP_RANGE) / (2.0f * DENSITY_MAP_RANGE);
+    int cell = static_cast<int>(std::floor(t * DENSITY_MAP_CELLS));
+    return (cell >= 0 && cell < DENSITY_MAP_CELLS) ? cell : -1;
+}
+
+
+void DensityMap::build() {
+    MyTimer timer;
+    const size_t cells = DENSITY_MAP_CELLS * DENSITY_MAP_CELLS;
+    const size_t workers = workerCount();
+
+    std::vector<Tile> lidar_tiles(workers, Tile(cells));
+    std::vector<Tile> obj_tiles(workers, Tile(cells));
+
+    const size_t lidar_grain = std::max<size_t>(DENSITY_FRAME_GRAIN, lidar_list->size() / (workers * DENSITY_WORKER_CHUNKS));
+    parallelForBackground(lidar_list->size(), lidar_grain, workers, [&](size_t begin, size_t end, size_t worker) {
+        Tile& tile = lidar_tiles[worker];
+        LidarBinary scratch;
+        for(size_t f = begin; f < end && !cancel; ++f) {
+            for(const auto& p : CompactLidarStore::view(compact, *lidar_list, f, scratch).lidar_data) {
+                int cx = worldToCell(p.x);
+                int cy = worldToCell(p.y);
+                if(cx >= 0 && cy >= 0) {
+                    tile.hit(static_cast<uint32_t>(cy * DENSITY_MAP_CELLS + cx), static_cast<uint32_t>(f));
+                }
+            }
+        }
+    });
+
+    const size_t obj_grain = std::max<size_t>(DENSITY_FRAME_GRAIN * 64, obj_list->size() / (workers * DENSITY_WORKER_CHUNKS));
+    parallelForBackground(obj_list->size(), obj_grain, workers, [&](size_t begin, size_t end, size_t worker) {
+        Tile& tile = obj_tiles[worker];
+        for(size_t f = begin; f < end && !cancel; ++f) {
+            for(const auto& obj : (*obj_list)[f].obj_data) {
+                if(obj.obj_id == -1) {
+                    continue;
+                }
+                int cx = worldToCell(0.5f * (obj.min_x + obj.max_x));
+                int cy = worldToCell(0.5f * (obj.min_y + obj.max_y));
+                if(cx >= 0 && cy >= 0) {
+                    tile.hit(static_cast<uint32_t>(cy * DENSITY_MAP_CELLS + cx), static_cast<uint32_t>(f));
+                }
+            }
+        }
+    });
+
+    if(cancel) {
+        return;
+    }
+
+    // 타일 병합 - 셀 행 단위로 나눠 병렬 합산
+    lidar_counts.assign(cells, 0);
+    obj_counts.assign(cells, 0);
+    parallelForBackground(DENSITY_MAP_CELLS, 8, workers, [&](size_t row_begin, size_t row_end, size_t) {
+        size_t begin = row_begin * DENSITY_MAP_CELLS;
+        size_t end = row_end * DENSITY_MAP_CELLS;
+        for(size_t t = 0; t < workers; ++t) {
+            const uint32_t* lt = lidar_tiles[t].counts.data();
+            const uint32_t* ot = obj_tiles[t].counts.data();
+            for(size_t i = begin; i < end; ++i) {
+                lidar_counts[i] += lt[i];
+                obj_counts[i] += ot[i];
+            }
+        }
+    });
+    buildCellRanges(lidar_tiles, workers, lidar_cell_offsets, lidar_cell_ranges);
+    buildCellRanges(obj_tiles, workers, obj_cell_offsets, obj_cell_ranges);
+
+    buildImage();
+    ready = true;
+
+    timer.end();
+    std::cout << "Density map built: " << lidar_list->size() << " lidar / " << obj_list->size()
+              << " obj frames, " << lidar_cell_ranges.size() + obj_cell_ranges.size() << " cell frame ranges, " << timer.elapsed_ms() << " ms" << std::endl;
+}
+
+// 로그 스케일 히트맵 (검정 -> 빨강 -> 노랑 -> 흰색), 객체 중심이 있는 셀은 aqua
+void DensityMap::buildImage() {
+    const size_t cells = DENSITY_MAP_CELLS * DENSITY_MAP_CELLS;
+    rgb_image.assign(cells * 3, 0);
+
+    uint32_t max_count = *std::max_element(lidar_counts.begin(), lidar_counts.end());
+    float norm = (max_count > 0) ? 1.0f / std::log1p(static_cast<float>(max_count)) : 0.0f;
+
+    for(size_t i = 0; i < cells; ++i) {
+        if(obj_counts[i] > 0) {
+            rgb_image[i * 3 + 0] = 0;
+            rgb_image[i * 3 + 1] = 255;
+            rgb_image[i * 3 + 2] = 255;
+            continue;
+        }
+        float t = std::log1p(static_cast<float>(lidar_counts[i])) * norm;
+        rgb_image[i * 3 + 0] = static_cast<unsigned char>(std::min(std::max(3.0f * t, 0.0f), 1.0f) * 255.0f);
+        rgb_image[i * 3 + 1] = static_cast<unsigned char>(std::min(std::max(3.0f * t - 1.0f, 0.0f), 1.0f) * 255.0f);
+        rgb_image[i * 3 + 2] = static_cast<unsigned char>(std::min(std::max(3.0f * t - 2.0f, 0.0f), 1.0f) * 255.0f);
+    }
+}
+
+
+bool DensityMap::screenToCell(double mouse_x, double mouse_y, int& cell_x, int& cell_y) const {
+    double x0 = WINDOW_WIDTH - DENSITY_MAP_VIEW_SIZE - DENSITY_MAP_MARGIN;
+    double y0 = DENSITY_MAP_MARGIN;
+    double px = mouse_x - x0;
+    double py = (WINDOW_HEIGHT - mouse_y) - y0;     // 마우스는 좌상단 기준, 지도는 좌하단 기준
+
+    if(px < 0.0 || py < 0.0 || px >= DENSITY_MAP_VIEW_SIZE || py >= DENSITY_MAP_VIEW_SIZE) {
+        return false;
+    }
+    cell_x = static_cast<int>(px * DENSITY_MAP_CELLS / DENSITY_MAP_VIEW_SIZE);
+    cell_y = static_cast<int>(py * DENSITY_MAP_CELLS / DENSITY_MAP_VIEW_SIZE);
+    return true;
+}
+
+void DensityMap::collectCellFrames(int cell_x, int cell_y, std::vector<size_t>& out_lidar, std::vector<size_t>& out_obj) const {
+    out_lidar.clear();
+    out_obj.clear();
+    if(!ready || cell_x < 0 || cell_y < 0 || cell_x >= DENSITY_MAP_CELLS || cell_y >= DENSITY_MAP_CELLS) {
+        return;
+    }
+    const size_t cell = static_cast<size_t>(cell_y) * DENSITY_MAP_CELLS + cell_x;
+    expandRanges(lidar_cell_offsets, lidar_cell_ranges, cell, out_lidar);
+    expandRanges(obj_cell_offsets, obj_cell_ranges, cell, out_obj);
+}
+
+
+void DensityMap::render() const {
+    if(!visible) {
+        return;
+    }
+
+    const float x0 = WINDOW_WIDTH - DENSITY_MAP_VIEW_SIZE - DENSITY_MAP_MARGIN;
+    const float y0 = DENSITY_MAP_MARGIN;
+    const float size = DENSITY_MAP_VIEW_SIZE;
+
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    gluOrtho2D(0, WINDOW_WIDTH, 0, WINDOW_HEIGHT);
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+    glDisable(GL_DEPTH_TEST);
+
+    if(ready) {
+        float zoom = size / DENSITY_MAP_CELLS;
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glPixelZoom(zoom, zoom);
+        glRasterPos2f(x0, y0);
+        glDrawPixels(DENSITY_MAP_CELLS, DENSITY_MAP_CELLS, GL_RGB, GL_UNSIGNED_BYTE, rgb_image.data());
+        glPixelZoom(1.0f, 1.0f);
+
+        if(selected_x >= 0 && selected_y >= 0) {
+            float cx = x0 + selected_x * zoom;
+            float cy = y0 + selected_y * zoom;
+            float cs = std::max(zoom, 3.0f);
+            glColor3f(0.0f, 1.0f, 0.0f);
+            glBegin(GL_LINE_LOOP);
+            glVertex2f(cx, cy);             glVertex2f(cx + cs, cy);
+            glVertex2f(cx + cs, cy + cs);   glVertex2f(cx, cy + cs);
+            glEnd();
+        }
+    } else {
+        const char* text = "building density map...";
+        glColor3f(1.0f, 1.0f, 1.0f);
+        glRasterPos2f(x0 + 8.0f, y0 + size * 0.5f);
+        for(const char* c = text; *c; ++c) {
+            glutBitmapCharacter(GLUT_BITMAP_HELVETICA_12, *c);
+        }
+    }
+
+    // 테두리
+    glColor3f(0.6f, 0.6f, 0.6f);
+    glBegin(GL_LINE_LOOP);
+    glVertex2f(x0, y0);                 glVertex2f(x0 + size, y0);
+    glVertex2f(x0 + size, y0 + size);   glVertex2f(x0, y0 + size);
+    glEnd();
+
+    glEnable(GL_DEPTH_TEST);
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include <GL/glew.h>
+#include <GL/glut.h>
+
+#include "configs.h"
+#include "binary_utils.h"
+#include "compact_lidar.h"
+
+
+// 전체 녹화 구간의 라이다 점 / 객체 중심을 누적한 top-down 밀도(점유) 지도
+// 프레임 전체를 스레드별 타일에 병렬로 래스터화한 뒤 합침 (백그라운드 스레드에서 생성)
+// 래스터화하면서 셀별로 점이 떨어진 프레임 구간도 기록 -> 지도 클릭은 점을 다시 읽지 않고 구간 목록으로 답함
+class DensityMap {
+public:
+    DensityMap();
+    ~DensityMap();
+
+    // compact가 있으면 (--compact) 점은 저장소에서 복원해 읽음
+    void startBuild(const std::vector<LidarBinary>& lidar_list, const std::vector<ObjBinary>& obj_list,
+                    const CompactLidarStore* compact = nullptr);
+    bool isReady() const;
+    // 생성 중단 + 스레드 join - 프레임 배열(main 지역 변수)이 소멸하기 전에 호출
+    void stop();
+
+    void toggleVisible();
+    bool isVisible() const;
+
+    // 메인 창 마우스 좌표(좌상단 기준) -> 셀 좌표, 지도 밖이면 false
+    bool screenToCell(double mouse_x, double mouse_y, int& cell_x, int& cell_y) const;
+
+    // 해당 셀에 점/객체 중심이 하나라도 떨어진 프레임 인덱스 (오름차순) - 생성 때 기록한 구간을 펼침
+    void collectCellFrames(int cell_x, int cell_y, std::vector<size_t>& out_lidar, std::vector<size_t>& out_obj) const;
+
+    void setSelectedCell(int cell_x, int cell_y);
+
+    // 메인 창 우하단 오버레이
+    void render() const;
+
+    // 프레임 구간 [begin, end)
+    struct FrameRange {
+        uint32_t begin, end;
+    };
+
+private:
+    void build();
+    int worldToCell(float v) const;
+    void buildImage();
+
+    const std::vector<LidarBinary>* lidar_list;
+    const std::vector<ObjBinary>* obj_list;
+    const CompactLidarStore* compact = nullptr;
+
+    std::vector<uint32_t> lidar_counts;     // DENSITY_MAP_CELLS x DENSITY_MAP_CELLS
+    std::vector<uint32_t> obj_counts;
+    std::vector<unsigned char> rgb_image;
+
+    // 셀 i의 프레임 구간 = ranges[offsets[i], offsets[i + 1]) (시작 순, 이어지는 구간은 하나로 합침)
+    std::vector<uint32_t> lidar_cell_offsets;
+    std::vector<FrameRange> lidar_cell_ranges;
+    std::vector<uint32_t> obj_cell_offsets;
+    std::vector<FrameRange> obj_cell_ranges;
+
+    std::thread build_thread;
+    std::atomic<bool> ready;
+    std::atomic<bool> cancel;
+    bool visible;
+    int selected_x, selected_y;
+};
@@ -0,0 +1,157 @@
+#include "detection_index.h"
+#include "configs.h"
+#include "parallel_utils.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+
+size_t DetectionIndex::getPostingCount() const {
+    return posting_count;
+}
+
+double DetectionIndex::getElapsedMs() const {
+    return elapsed_ms;
+}
+
+
+void DetectionIndex::build(const std::vector<ObjBinary>& obj_list) {
+    MyTimer timer;
+    postings.clear();
+    posting_count = 0;
+
+    // 클래스별 개수로 미리 reserve -> 채우기
+    std::unordered_map<int, size_t> class_sizes;
+    for(const auto& frame : obj_list) {
+        for(const auto& o : frame.obj_data) {
+            if(o.obj_id != -1) ++class_sizes[o.obj_id];
+        }
+    }
+    for(const auto& kv : class_sizes) {
+        postings[kv.first].by_time.reserve(kv.second);
+    }
+    for(size_t f = 0; f < obj_list.size(); ++f) {
+        for(const auto& o : obj_list[f].obj_data) {
+            // 거리가 NaN / inf 인 검출은 거리 조건을 판정할 수 없으므로 색인하지 않음
+            if(o.obj_id == -1 || !std::isfinite(o.distance)) continue;
+            postings[o.obj_id].by_time.push_back({obj_list[f].time, o.distance, static_cast<uint32_t>(f)});
+            ++posting_count;
+        }
+    }
+
+    // 클래스 단위 병렬 정렬
+    std::vector<ClassPostings*> lists;
+    for(auto& kv : postings) lists.push_back(&kv.second);
+    parallelForBackground(lists.size(), 1, [&](size_t begin, size_t end, size_t) {
+        for(size_t c = begin; c < end; ++c) {
+            auto& by_time = lists[c]->by_time;
+            std::sort(by_time.begin(), by_time.end(), [](const Posting& a, const Posting& b) {
+                return (a.time != b.time) ? a.time < b.time : a.frame < b.frame;
+            });
+            auto& by_distance = lists[c]->by_distance;
+            by_distance.resize(by_time.size());
+            for(size_t i = 0; i < by_distance.size(); ++i) by_distance[i] = static_cast<uint32_t>(i);
+            std::sort(by_distance.begin(), by_distance.end(), [&](uint32_t a, uint32_t b) {
+                return by_time[a].distance < by_time[b].distance;
+            });
+        }
+    });
+
+    timer.end();
+    elapsed_ms = std::chrono::duration<double, std::milli>(timer.end_time - timer.start_time).count();
+}
+
+
+void DetectionIndex::find(const DetectionQuery& query, std::vector<uint32_t>& out_frames) const {
+    out_frames.clear();
+    auto it = postings.find(query.class_id);
+    if(it == postings.end()) {
+        return;
+    }
+    const auto& by_time = it->second.by_time;
+    const auto& by_distance = it->second.by_distance;
+
+    auto t_lo = std::lower_bound(by_time.begin(), by_time.end(), query.time_begin,
+                                 [](const Posting& p, uint64_t t) { return p.time < t; });
+    auto t_hi = std::upper_bound(t_lo, by_time.end(), query.time_end,
+                                 [](uint64_t t, const Posting& p) { return t < p.time; });
+    // '<' / '>' 조건은 경계값을 포함하지 않음 (min_distance < d < max_distance)
+    auto inDistance = [&](const Posting& p) { return p.distance > query.min_distance && p.distance < query.max_distance; };
+
+    if(query.first_only) {
+        for(auto p = t_lo; p != t_hi; ++p) {
+            if(inDistance(*p)) {
+                out_frames.push_back(p->frame);
+                return;
+            }
+        }
+        return;
+    }
+
+    auto d_lo = std::upper_bound(by_distance.begin(), by_distance.end(), query.min_distance,
+                                 [&](float d, uint32_t i) { return d < by_time[i].distance; });
+    auto d_hi = std::lower_bound(d_lo, by_distance.end(), query.max_distance,
+                                 [&](uint32_t i, float d) { return by_time[i].distance < d; });
+
+    if(d_hi - d_lo < t_hi - t_lo) {
+        // 거리 조건이 더 좁음 : 거리 범위를 훑으며 시간 필터
+        for(auto i = d_lo; i != d_hi; ++i) {
+            const Posting& p = by_time[*i];
+            if(p.time >= query.time_begin && p.time <= query.time_end) out_frames.push_back(p.frame);
+        }
+    } else {
+        for(auto p = t_lo; p != t_hi; ++p) {
+            if(inDistance(*p)) out_frames.push_back(p->frame);
+        }
+    }
+    std::sort(out_frames.begin(), out_frames.end());
+    out_frames.erase(std::unique(out_frames.begin(), out_frames.end()), out_frames.end());
+}
+
+
+bool DetectionIndex::parseQuery(const std::string& text, DetectionQuery& out_query) {
+    out_query = DetectionQuery();
+
+    size_t label_end = text.find_first_of("<>:");
+    std::string label = text.substr(0, label_end);
+    std::replace(label.begin(), label.end(), '_', ' ');
+    for(const auto& kv : objId_to_label) {
+        if(kv.second == label) {
+            out_query.class_id = kv.first;
+            break;
+        }
+    }
+    if(out_query.class_id == -1) {
+        std::cerr << "Unknown class label in query: " << label << std::endl;
+        return false;
+    }
+
+    size_t pos = label_end;
+    while(pos != std::string::npos && pos < text.size()) {
+        char op = text[pos];
+        if(op == ':') {
+            if(text.compare(pos + 1, std::string::npos, "first") != 0) {
+                std::cerr << "Unknown query option: " << text.substr(pos) << std::endl;
+                return false;
+            }
+            out_query.first_only = true;
+            break;
+        }
+        if(op != '<' && op != '>') {
+            std::cerr << "Invalid query: " << text << std::endl;
+            return false;
+        }
+        const char* begin = text.c_str() + pos + 1;
+        char* end = nullptr;
+        float value = std::strtof(begin, &end);
+        if(end == begin) {
+            std::cerr << "Invalid distance in query: " << text.substr(pos) << std::endl;
+            return false;
+        }
+        if(op == '<') out_query.max_distance = value;
+        else          out_query.min_distance = value;
+        pos = static_cast<size_t>(end - text.c_str());
+    }
+    return true;
+}
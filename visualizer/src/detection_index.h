@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <limits>
+#include <cstdint>
+#include <unordered_map>
+
+#include "binary_utils.h"
+
+
+struct DetectionQuery {
+    int class_id = -1;
+    float min_distance = -std::numeric_limits<float>::infinity();     // 거리 조건은 양쪽 모두 경계 미포함
+    float max_distance = std::numeric_limits<float>::infinity();
+    uint64_t time_begin = 0;
+    uint64_t time_end = std::numeric_limits<uint64_t>::max();
+    bool first_only = false;        // 시간상 첫 등장 프레임 하나만
+};
+
+// 녹화 전체 객체인식 검출의 클래스별 역색인 (로드 시 생성)
+// 클래스마다 시간순 posting 배열 + 거리순 인덱스 배열 -> 조건 범위를 이분 탐색 후 더 좁은 쪽만 훑음
+class DetectionIndex {
+public:
+    void build(const std::vector<ObjBinary>& obj_list);
+
+    // 조건에 맞는 검출이 있는 객체 프레임 인덱스 (오름차순, 중복 없음)
+    void find(const DetectionQuery& query, std::vector<uint32_t>& out_frames) const;
+
+    // "person<15", "car>5<30", "truck:first" (라벨의 공백은 '_', '<' / '>' 는 경계 미포함)
+    static bool parseQuery(const std::string& text, DetectionQuery& out_query);
+
+    size_t getPostingCount() const;
+    double getElapsedMs() const;
+
+private:
+    struct Posting {
+        uint64_t time;
+        float distance;
+        uint32_t frame;
+    };
+    struct ClassPostings {
+        std::vector<Posting> by_time;           // (time, frame) 순
+        std::vector<uint32_t> by_distance;      // by_time 인덱스, 거리순
+    };
+
+    std::unordered_map<int, ClassPostings> postings;
+    size_t posting_count = 0;
+    double elapsed_ms = 0.0;
+};
@@ -0,0 +1,191 @@
+#include "frame_client.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+
+FrameClient::~FrameClient() {
+    close();
+}
+
+
+bool FrameClient::connect(const std::string& host, uint16_t port) {
+    close();
+    if(!socket.connect(host, port)) {
+        return false;
+    }
+    StreamHeader header;
+    std::vector<uint8_t> message;
+    if(!socket.recvMessage(header, message) || static_cast<StreamMessage>(header.type) != StreamMessage::HELLO ||
+       message.size() < sizeof(StreamHello)) {
+        std::cerr << "Invalid hello from " << host << ":" << port << std::endl;
+        socket.close();
+        return false;
+    }
+    std::memcpy(&hello, message.data(), sizeof(hello));
+    received_bytes = sizeof(StreamHeader) + header.size;
+
+    codec.reset();
+    {
+        std::lock_guard<std::mutex> lock(frame_mutex);
+        lidar_pending = false;
+        obj_pending = false;
+        stats = ClientStats();
+        stats.time = hello.first_time;
+    }
+    connected = true;
+    receiver = std::thread(&FrameClient::receiveLoop, this);
+    return true;
+}
+
+const StreamHello& FrameClient::getHello() const {
+    return hello;
+}
+
+bool FrameClient::isConnected() const {
+    return connected;
+}
+
+
+bool FrameClient::sendAck(uint32_t seq) {
+    StreamAck ack;
+    ack.received_bytes = received_bytes;
+    ack.seq = seq;
+    ack.reserved = 0;
+    std::lock_guard<std::mutex> lock(send_mutex);
+    return socket.sendMessage(StreamMessage::ACK, seq, &ack, sizeof(ack));
+}
+
+bool FrameClient::sendControl(StreamCommand command, int32_t value) {
+    StreamControl control;
+    control.command = static_cast<uint32_t>(command);
+    control.value = value;
+    std::lock_guard<std::mutex> lock(send_mutex);
+    return socket.sendMessage(StreamMessage::CONTROL, 0, &control, sizeof(control));
+}
+
+
+void FrameClient::receiveLoop() {
+    StreamHeader header;
+    std::vector<uint8_t> message;
+    StreamFrameInfo info;
+
+    // 통계 창
+    auto window_start = std::chrono::steady_clock::now();
+    uint64_t window_bytes = 0;
+    size_t window_lidar = 0;
+    double window_decode_ms = 0.0;
+
+    while(socket.recvMessage(header, message)) {
+        received_bytes += sizeof(StreamHeader) + header.size;
+        window_bytes += sizeof(StreamHeader) + header.size;
+        const StreamMessage type = static_cast<StreamMessage>(header.type);
+
+        if(type == StreamMessage::LIDAR || type == StreamMessage::OBJ) {
+            if(message.size() < sizeof(info)) {
+                std::cerr << "Invalid frame message" << std::endl;
+                break;
+            }
+            std::memcpy(&info, message.data(), sizeof(info));
+            const uint8_t* data = message.data() + sizeof(info);
+            const size_t size = message.size() - sizeof(info);
+
+            if(type == StreamMessage::LIDAR) {
+                MyTimer timer;
+                if(!codec.decodeLidar(data, size, info.time, decoded_lidar)) {
+                    std::cerr << "Corrupted lidar frame (timeline_idx = " << info.timeline_idx << ")" << std::endl;
+                    break;
+                }
+                timer.end();
+                window_decode_ms += std::chrono::duration<double, std::milli>(timer.end_time - timer.start_time).count();
+                ++window_lidar;
+            } else if(!FrameCodec::decodeObj(data, size, info.time, decoded_obj)) {
+                std::cerr << "Corrupted obj frame (timeline_idx = " << info.timeline_idx << ")" << std::endl;
+                break;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(frame_mutex);
+                if(type == StreamMessage::LIDAR) {
+                    pending_lidar.lidar_data.swap(decoded_lidar.lidar_data);
+                    pending_lidar.time = decoded_lidar.time;
+                    pending_lidar.num = decoded_lidar.num;
+                    lidar_pending = true;
+                    stats.stride = info.stride;
+                } else {
+                    pending_obj.obj_data.swap(decoded_obj.obj_data);
+                    pending_obj.time = decoded_obj.time;
+                    pending_obj.num = decoded_obj.num;
+                    obj_pending = true;
+                }
+                stats.time = info.time;
+                stats.timeline_idx = info.timeline_idx;
+                stats.ended = false;
+            }
+        }
+        else if(type == StreamMessage::END) {
+            std::lock_guard<std::mutex> lock(frame_mutex);
+            stats.ended = true;
+        }
+
+        if(!sendAck(header.seq)) {
+            break;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        double window_ms = std::chrono::duration<double, std::milli>(now - window_start).count();
+        if(window_ms >= STREAM_STATS_INTERVAL_MS) {
+            std::lock_guard<std::mutex> lock(frame_mutex);
+            stats.kbps = window_bytes * 8.0 / window_ms;
+            stats.lidar_fps = window_lidar * 1000.0 / window_ms;
+            stats.decode_ms = (window_lidar > 0) ? window_decode_ms / window_lidar : 0.0;
+            stats.received_bytes = received_bytes;
+            window_start = now;
+            window_bytes = 0;
+            window_lidar = 0;
+            window_decode_ms = 0.0;
+        }
+    }
+    connected = false;
+}
+
+
+bool FrameClient::takeLidar(LidarBinary& inout_frame) {
+    std::lock_guard<std::mutex> lock(frame_mutex);
+    if(!lidar_pending) {
+        return false;
+    }
+    inout_frame.lidar_data.swap(pending_lidar.lidar_data);
+    inout_frame.time = pending_lidar.time;
+    inout_frame.num = pending_lidar.num;
+    lidar_pending = false;
+    return true;
+}
+
+bool FrameClient::takeObj(ObjBinary& inout_frame) {
+    std::lock_guard<std::mutex> lock(frame_mutex);
+    if(!obj_pending) {
+        return false;
+    }
+    inout_frame.obj_data.swap(pending_obj.obj_data);
+    inout_frame.time = pending_obj.time;
+    inout_frame.num = pending_obj.num;
+    obj_pending = false;
+    return true;
+}
+
+ClientStats FrameClient::getStats() const {
+    std::lock_guard<std::mutex> lock(frame_mutex);
+    return stats;
+}
+
+
+void FrameClient::close() {
+    socket.shutdown();
+    if(receiver.joinable()) {
+        receiver.join();
+    }
+    socket.close();
+    connected = false;
+}
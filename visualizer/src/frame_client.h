@@ -0,0 +1,65 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+
+#include "configs.h"
+#include "binary_utils.h"
+#include "stream_protocol.h"
+#include "frame_codec.h"
+
+
+struct ClientStats {
+    double kbps = 0.0;              // 최근 STREAM_STATS_INTERVAL_MS 수신량
+    double lidar_fps = 0.0;
+    double decode_ms = 0.0;         // 라이다 프레임 평균 복원 시간
+    uint32_t stride = 1;            // 마지막 라이다 프레임 점 간격
+    uint64_t time = 0;              // 마지막 프레임 녹화 시각
+    uint32_t timeline_idx = 0;
+    uint64_t received_bytes = 0;
+    bool ended = false;
+};
+
+// 원격 보기 클라이언트 - 수신 스레드가 프레임을 복원해 최신 것만 남기고 (화면이 느리면 중간 프레임은 덮어씀) 처리 즉시 ACK
+// 화면 쪽은 takeLidar / takeObj로 새 프레임을 버퍼 교환으로 가져감 (재할당 없음)
+class FrameClient {
+public:
+    ~FrameClient();
+
+    bool connect(const std::string& host, uint16_t port);     // HELLO까지 받으면 true
+    const StreamHello& getHello() const;
+    bool isConnected() const;
+
+    bool takeLidar(LidarBinary& inout_frame);   // 새 프레임이 있으면 inout_frame과 교환 후 true
+    bool takeObj(ObjBinary& inout_frame);
+
+    bool sendControl(StreamCommand command, int32_t value = 0);
+    ClientStats getStats() const;
+    void close();
+
+private:
+    void receiveLoop();
+    bool sendAck(uint32_t seq);
+
+    StreamSocket socket;
+    std::thread receiver;
+    std::atomic<bool> connected{false};
+    StreamHello hello{};
+    std::mutex send_mutex;              // 화면 스레드(제어) / 수신 스레드(ACK) 전송 직렬화
+
+    FrameCodec codec;
+    LidarBinary decoded_lidar;
+    ObjBinary decoded_obj;
+
+    mutable std::mutex frame_mutex;
+    LidarBinary pending_lidar;
+    ObjBinary pending_obj;
+    bool lidar_pending = false;
+    bool obj_pending = false;
+    ClientStats stats;
+    uint64_t received_bytes = 0;        // 수신 스레드 전용
+};
@@ -0,0 +1,207 @@
+#include "frame_codec.h"
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+
+namespace {
+
+enum : uint8_t { MODE_KEY = 0, MODE_DELTA = 1 };
+
+constexpr size_t COST_SAMPLES = 512;    // 예측 방식 선택에 쓰는 표본 점 수
+constexpr size_t MAX_VARINT = 5;        // uint32 varint 최대 bytes
+
+inline uint32_t zigzag(int32_t v) {
+    return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+
+inline int32_t unzigzag(uint32_t v) {
+    return static_cast<int32_t>((v >> 1) ^ (~(v & 1) + 1));
+}
+
+inline uint8_t* writeVarint(uint8_t* p, uint32_t v) {
+    while(v >= 0x80) {
+        *p++ = static_cast<uint8_t>(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = static_cast<uint8_t>(v);
+    return p;
+}
+
+inline bool readVarint(const uint8_t*& p, const uint8_t* end, uint32_t& out) {
+    uint32_t v = 0;
+    for(int shift = 0; shift < 35; shift += 7) {
+        if(p >= end) {
+            return false;
+        }
+        uint8_t b = *p++;
+        v |= static_cast<uint32_t>(b & 0x7f) << shift;
+        if((b & 0x80) == 0) {
+            out = v;
+            return true;
+        }
+    }
+    return false;
+}
+
+inline int32_t quantize(float v) {
+    float q = std::nearbyint(v / STREAM_QUANT_STEP);
+    q = std::min(std::max(q, -2147483520.0f), 2147483520.0f);   // float로 표현되는 int32 범위 안
+    return static_cast<int32_t>(q);
+}
+
+}
+
+
+void FrameCodec::reset() {
+    prev.clear();
+    prev_stride = 0;
+    key_frame = true;
+}
+
+bool FrameCodec::wasKeyFrame() const {
+    return key_frame;
+}
+
+
+void FrameCodec::encodeLidar(const LidarBinary& frame, uint32_t stride, std::vector<uint8_t>& out) {
+    if(stride == 0) {
+        stride = 1;
+    }
+    const size_t count = std::min<size_t>(frame.num, frame.lidar_data.size());
+
+    // 양자화 (유한하지 않은 좌표는 뺌)
+    cur.resize((count / stride + 1) * FIELDS);
+    size_t num = 0;
+    for(size_t i = 0; i < count; i += stride) {
+        const LidarData& p = frame.lidar_data[i];
+        if(!std::isfinite(p.x) || !std::isfinite(p.y) || !std::isfinite(p.z)) {
+            continue;
+        }
+        int32_t* q = &cur[num * FIELDS];
+        q[0] = quantize(p.x);
+        q[1] = quantize(p.y);
+        q[2] = quantize(p.z);
+        q[3] = static_cast<int32_t>(p.reflectivity);
+        q[4] = p.cluster_id;
+        ++num;
+    }
+    cur.resize(num * FIELDS);
+
+    // 표본 점에서 두 예측의 오차 합 비교 -> delta frame은 같은 stride로 이어질 때만
+    size_t ref_count = 0;
+    if(stride == prev_stride && !prev.empty()) {
+        size_t shared = std::min(num, prev.size() / FIELDS);
+        size_t step = std::max<size_t>(1, shared / COST_SAMPLES);
+        uint64_t intra_cost = 0, inter_cost = 0;
+        for(size_t i = 1; i < shared; i += step) {
+            for(int f = 0; f < FIELDS; ++f) {
+                int64_t v = cur[i * FIELDS + f];
+                intra_cost += static_cast<uint64_t>(std::llabs(v - cur[(i - 1) * FIELDS + f]));
+                inter_cost += static_cast<uint64_t>(std::llabs(v - prev[i * FIELDS + f]));
+            }
+        }
+        if(inter_cost < intra_cost) {
+            ref_count = shared;
+        }
+    }
+    key_frame = (ref_count == 0);
+
+    // [mode][num][ref_count] + 점마다 FIELDS개 zigzag varint
+    out.resize(1 + 2 * MAX_VARINT + num * FIELDS * MAX_VARINT);
+    uint8_t* p = out.data();
+    *p++ = key_frame ? MODE_KEY : MODE_DELTA;
+    p = writeVarint(p, static_cast<uint32_t>(num));
+    p = writeVarint(p, static_cast<uint32_t>(ref_count));
+
+    const int32_t zero[FIELDS] = {0, 0, 0, 0, 0};
+    for(size_t i = 0; i < num; ++i) {
+        const int32_t* q = &cur[i * FIELDS];
+        const int32_t* pred = i < ref_count ? &prev[i * FIELDS] : (i > 0 ? q - FIELDS : zero);
+        for(int f = 0; f < FIELDS; ++f) {
+            // 차이는 uint32 wrap-around로 계산 (decode에서 같은 방식으로 더하면 원래 값)
+            p = writeVarint(p, zigzag(static_cast<int32_t>(static_cast<uint32_t>(q[f]) - static_cast<uint32_t>(pred[f]))));
+        }
+    }
+    out.resize(p - out.data());
+
+    prev.swap(cur);
+    prev_stride = stride;
+}
+
+bool FrameCodec::decodeLidar(const uint8_t* data, size_t size, uint64_t time, LidarBinary& out) {
+    const uint8_t* p = data;
+    const uint8_t* end = data + size;
+    uint32_t num, ref_count;
+    if(size < 1) {
+        return false;
+    }
+    uint8_t mode = *p++;
+    if(mode > MODE_DELTA || !readVarint(p, end, num) || !readVarint(p, end, ref_count)) {
+        return false;
+    }
+    // 점 하나 최소 FIELDS bytes -> 헤더의 점 수가 payload보다 크면 손상
+    if(static_cast<size_t>(end - p) < static_cast<size_t>(num) * FIELDS ||
+       (mode == MODE_KEY && ref_count != 0) ||
+       (mode == MODE_DELTA && (ref_count > num || ref_count > prev.size() / FIELDS))) {
+        return false;
+    }
+    key_frame = (mode == MODE_KEY);
+
+    cur.resize(static_cast<size_t>(num) * FIELDS);
+    const int32_t zero[FIELDS] = {0, 0, 0, 0, 0};
+    for(size_t i = 0; i < num; ++i) {
+        int32_t* q = &cur[i * FIELDS];
+        const int32_t* pred = i < ref_count ? &prev[i * FIELDS] : (i > 0 ? q - FIELDS : zero);
+        for(int f = 0; f < FIELDS; ++f) {
+            uint32_t v;
+            if(!readVarint(p, end, v)) {
+                return false;
+            }
+            q[f] = static_cast<int32_t>(static_cast<uint32_t>(pred[f]) + static_cast<uint32_t>(unzigzag(v)));
+        }
+    }
+
+    out.time = time;
+    out.num = num;
+    out.lidar_data.resize(num);
+    for(size_t i = 0; i < num; ++i) {
+        const int32_t* q = &cur[i * FIELDS];
+        LidarData& d = out.lidar_data[i];
+        d.x = q[0] * STREAM_QUANT_STEP;
+        d.y = q[1] * STREAM_QUANT_STEP;
+        d.z = q[2] * STREAM_QUANT_STEP;
+        d.reflectivity = static_cast<uint32_t>(q[3]);
+        d.cluster_id = q[4];
+    }
+    prev.swap(cur);
+    return true;
+}
+
+
+void FrameCodec::encodeObj(const ObjBinary& frame, std::vector<uint8_t>& out) {
+    const size_t num = std::min<size_t>(frame.num, frame.obj_data.size());
+    out.resize(MAX_VARINT + num * sizeof(ObjData));
+    uint8_t* p = writeVarint(out.data(), static_cast<uint32_t>(num));
+    if(num > 0) {
+        std::memcpy(p, frame.obj_data.data(), num * sizeof(ObjData));
+    }
+    out.resize((p - out.data()) + num * sizeof(ObjData));
+}
+
+bool FrameCodec::decodeObj(const uint8_t* data, size_t size, uint64_t time, ObjBinary& out) {
+    const uint8_t* p = data;
+    const uint8_t* end = data + size;
+    uint32_t num;
+    if(!readVarint(p, end, num) || static_cast<size_t>(end - p) != static_cast<size_t>(num) * sizeof(ObjData)) {
+        return false;
+    }
+    out.time = time;
+    out.num = num;
+    out.obj_data.resize(num);
+    if(num > 0) {
+        std::memcpy(out.obj_data.data(), p, num * sizeof(ObjData));
+    }
+    return true;
+}
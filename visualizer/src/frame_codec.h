@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "configs.h"
+#include "binary_utils.h"
+
+
+// 원격 보기용 프레임 압축 (연결마다 서버 / 클라이언트 쪽에 하나씩, 같은 순서로 encode / decode)
+// 라이다 : 좌표를 STREAM_QUANT_STEP 간격 정수로 양자화한 뒤 예측값과의 차이를 zigzag varint로 기록
+//   key frame   - 바로 앞 점으로 예측 (스캔 순서상 이웃 점은 가까움)
+//   delta frame - 직전 프레임의 같은 위치 점으로 예측 (정지 장면 / 같은 레이저 순서면 차이가 거의 0)
+//   프레임마다 일부 점을 표본으로 두 예측의 오차 합을 비교해 작은 쪽 선택 (stride가 바뀌면 key frame)
+// 검출 목록 : 개수 varint + ObjData 그대로 (프레임당 수십 개라 압축 이득 작음)
+class FrameCodec {
+public:
+    void reset();       // seek 등으로 프레임이 이어지지 않을 때 양쪽 모두 호출 -> 다음 프레임은 key frame
+
+    // stride : 이 간격마다 한 점씩만 보냄 (1 = 전체), 좌표가 유한하지 않은 점은 뺌
+    void encodeLidar(const LidarBinary& frame, uint32_t stride, std::vector<uint8_t>& out);
+    // out의 점 버퍼는 재사용, 손상된 payload면 false (상태는 reset 필요)
+    bool decodeLidar(const uint8_t* data, size_t size, uint64_t time, LidarBinary& out);
+    bool wasKeyFrame() const;       // 마지막 encode / decode가 key frame이었는지
+
+    static void encodeObj(const ObjBinary& frame, std::vector<uint8_t>& out);
+    static bool decodeObj(const uint8_t* data, size_t size, uint64_t time, ObjBinary& out);
+
+private:
+    static constexpr int FIELDS = 5;    // x, y, z, reflectivity, cluster_id
+
+    std::vector<int32_t> prev;          // 직전 프레임 양자화 값 (점마다 FIELDS개)
+    std::vector<int32_t> cur;
+    uint32_t prev_stride = 0;
+    bool key_frame = true;
+};
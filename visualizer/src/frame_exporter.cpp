@@ -0,0 +1,336 @@
+#include "frame_exporter.h"
+#include "configs.h"
+#include "parallel_utils.h"
+
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <thread>
+#include <algorithm>
+
+
+#define EXPORT_COUNT_WIDTH  20      // 헤더 점 개수 자리 (uint64 최대 자릿수) - merge 끝에 같은 길이로 덮어씀
+#define EXPORT_FIXED_LIMIT  1e14f   // 이 크기 이상 / 비정상 좌표는 지수 표기 (고정 소수점은 정수부 14자리까지)
+#define EXPORT_FLOAT_WIDTH  24      // writeFixed4 최대 길이 : 부호 + 14자리 + '.' + 4자리 = 20, "%.4e"는 12 이하
+
+static_assert(sizeof(LidarData) == 20, "binary PLY / PCD rows are written straight from LidarData");
+
+
+// snprintf("%.4f")보다 수 배 빠른 고정 소수점 출력 (ASCII 내보내기는 포맷이 병목)
+static inline char* writeUint(char* dst, uint64_t v) {
+    char tmp[20];
+    int n = 0;
+    do {
+        tmp[n++] = static_cast<char>('0' + v % 10);
+        v /= 10;
+    } while(v != 0);
+    while(n > 0) *dst++ = tmp[--n];
+    return dst;
+}
+
+static inline char* writeInt(char* dst, int64_t v) {
+    if(v < 0) {
+        *dst++ = '-';
+        return writeUint(dst, static_cast<uint64_t>(-v));
+    }
+    return writeUint(dst, static_cast<uint64_t>(v));
+}
+
+static inline char* writeFixed4(char* dst, float v) {
+    if(!std::isfinite(v) || std::fabs(v) >= EXPORT_FIXED_LIMIT) {
+        // 손상 / 거대 좌표 : 길이가 정해진 지수 표기 (float 최대 "-3.4028e+38"), 혹시 넘어도 쓴 만큼만 전진
+        char tmp[EXPORT_FLOAT_WIDTH];
+        int n = std::snprintf(tmp, sizeof(tmp), "%.4e", v);
+        n = std::min(std::max(n, 0), EXPORT_FLOAT_WIDTH - 1);
+        std::memcpy(dst, tmp, static_cast<size_t>(n));
+        return dst + n;
+    }
+    int64_t scaled = std::llround(static_cast<double>(v) * 10000.0);
+    if(scaled < 0) {
+        *dst++ = '-';
+        scaled = -scaled;
+    }
+    dst = writeUint(dst, static_cast<uint64_t>(scaled / 10000));
+    *dst++ = '.';
+    int64_t frac = scaled % 10000;
+    dst[0] = static_cast<char>('0' + frac / 1000);
+    dst[1] = static_cast<char>('0' + frac / 100 % 10);
+    dst[2] = static_cast<char>('0' + frac / 10 % 10);
+    dst[3] = static_cast<char>('0' + frac % 10);
+    return dst + 4;
+}
+
+
+FrameExporter::FrameExporter(const ExportOptions& options) : options(options) {
+}
+
+size_t FrameExporter::getFrameCount() const {
+    return frame_count;
+}
+
+uint64_t FrameExporter::getItemCount() const {
+    return item_count;
+}
+
+uint64_t FrameExporter::getBytesWritten() const {
+    return bytes_written;
+}
+
+double FrameExporter::getElapsedMs() const {
+    return elapsed_ms;
+}
+
+MergeStats FrameExporter::getMergeStats() const {
+    return (options.format == ExportFormat::CSV) ? obj_merger.getStats() : lidar_merger.getStats();
+}
+
+const char* FrameExporter::extension() const {
+    switch(options.format) {
+        case ExportFormat::PLY: return ".ply";
+        case ExportFormat::PCD: return ".pcd";
+        default:                return ".csv";
+    }
+}
+
+std::string FrameExporter::frameFileName(size_t frame_idx, uint64_t time) const {
+    char name[64];
+    std::snprintf(name, sizeof(name), "%s_%06zu_%llu", (options.format == ExportFormat::CSV) ? "detections" : "lidar",
+                  frame_idx, static_cast<unsigned long long>(time));
+    return options.out_dir + "/" + name + extension();
+}
+
+
+// 점 개수는 EXPORT_COUNT_WIDTH 자리로 채움 -> 헤더 길이가 개수와 무관
+std::string FrameExporter::header(uint64_t count, bool with_frame) const {
+    if(options.format == ExportFormat::CSV) {
+        return "time,det_idx,obj_id,label,distance,size,nearest_x,nearest_y,nearest_z,"
+               "min_x,min_y,min_z,max_x,max_y,max_z\n";
+    }
+
+    char count_str[EXPORT_COUNT_WIDTH + 1];
+    std::snprintf(count_str, sizeof(count_str), "%-*llu", EXPORT_COUNT_WIDTH, static_cast<unsigned long long>(count));
+
+    std::string h;
+    if(options.format == ExportFormat::PLY) {
+        h += "ply\n";
+        h += options.binary ? "format binary_little_endian 1.0\n" : "format ascii 1.0\n";
+        h += "element vertex ";
+        h += count_str;
+        h += "\nproperty float x\nproperty float y\nproperty float z\n"
+             "property uint reflectivity\nproperty int cluster_id\n";
+        if(with_frame) h += "property uint frame\n";
+        h += "end_header\n";
+    } else {
+        h += "# .PCD v0.7 - Point Cloud Data file format\nVERSION 0.7\n";
+        h += with_frame ? "FIELDS x y z reflectivity cluster_id frame\nSIZE 4 4 4 4 4 4\nTYPE F F F U I U\nCOUNT 1 1 1 1 1 1\n"
+                        : "FIELDS x y z reflectivity cluster_id\nSIZE 4 4 4 4 4\nTYPE F F F U I\nCOUNT 1 1 1 1 1\n";
+        h += "WIDTH ";
+        h += count_str;
+        h += "\nHEIGHT 1\nVIEWPOINT 0 0 0 1 0 0 0\nPOINTS ";
+        h += count_str;
+        h += options.binary ? "\nDATA binary\n" : "\nDATA ascii\n";
+    }
+    return h;
+}
+
+
+void FrameExporter::formatLidar(const LidarBinary& frame, uint32_t frame_idx, std::string& out) const {
+    const auto& points = frame.lidar_data;
+    const bool with_frame = options.merge;
+
+    if(options.binary) {
+        if(!with_frame) {
+            out.append(reinterpret_cast<const char*>(points.data()), points.size() * sizeof(LidarData));
+            return;
+        }
+        const size_t row = sizeof(LidarData) + sizeof(uint32_t);
+        size_t offset = out.size();
+        out.resize(offset + points.size() * row);
+        char* dst = &out[offset];
+        for(const auto& p : points) {
+            std::memcpy(dst, &p, sizeof(LidarData));
+            std::memcpy(dst + sizeof(LidarData), &frame_idx, sizeof(uint32_t));
+            dst += row;
+        }
+        return;
+    }
+
+    // 한 줄 최대 길이만큼 잡아두고 쓴 만큼만 남김 (좌표 3개 + reflectivity 10자리 + cluster_id 11자리 + frame 10자리 + 구분자 6)
+    const size_t max_line = 3 * EXPORT_FLOAT_WIDTH + 10 + 11 + 10 + 6;
+    size_t offset = out.size();
+    out.resize(offset + points.size() * max_line);
+    char* begin = &out[0];
+    char* dst = begin + offset;
+    for(const auto& p : points) {
+        dst = writeFixed4(dst, p.x);    *dst++ = ' ';
+        dst = writeFixed4(dst, p.y);    *dst++ = ' ';
+        dst = writeFixed4(dst, p.z);    *dst++ = ' ';
+        dst = writeUint(dst, p.reflectivity);   *dst++ = ' ';
+        dst = writeInt(dst, p.cluster_id);
+        if(with_frame) {
+            *dst++ = ' ';
+            dst = writeUint(dst, frame_idx);
+        }
+        *dst++ = '\n';
+    }
+    out.resize(static_cast<size_t>(dst - begin));
+}
+
+void FrameExporter::formatObj(const ObjBinary& frame, std::string& out) const {
+    char line[512];
+    for(size_t d = 0; d < frame.obj_data.size(); ++d) {
+        const ObjData& o = frame.obj_data[d];
+        if(o.obj_id == -1) {
+            continue;
+        }
+        auto it = objId_to_label.find(o.obj_id);
+        const char* label = (it != objId_to_label.end()) ? it->second.c_str() : "unknown";
+        const char* fmt = "%llu,%zu,%d,%s,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n";
+        int len = std::snprintf(line, sizeof(line), fmt,
+                                static_cast<unsigned long long>(frame.time), d, o.obj_id, label, o.distance, o.size,
+                                o.nearest_x, o.nearest_y, o.nearest_z, o.min_x, o.min_y, o.min_z, o.max_x, o.max_y, o.max_z);
+        if(len < 0) {
+            continue;
+        }
+        if(static_cast<size_t>(len) < sizeof(line)) {
+            out.append(line, static_cast<size_t>(len));
+            continue;
+        }
+        // 손상된 거대 좌표로 줄이 버퍼를 넘음 : 필요한 길이만큼 잡아 다시 포맷 (잘린 줄을 쓰지 않음)
+        size_t offset = out.size();
+        out.resize(offset + static_cast<size_t>(len) + 1);
+        std::snprintf(&out[offset], static_cast<size_t>(len) + 1, fmt,
+                      static_cast<unsigned long long>(frame.time), d, o.obj_id, label, o.distance, o.size,
+                      o.nearest_x, o.nearest_y, o.nearest_z, o.min_x, o.min_y, o.min_z, o.max_x, o.max_y, o.max_z);
+        out.resize(offset + static_cast<size_t>(len));
+    }
+}
+
+
+bool FrameExporter::readBatch(Batch& batch) {
+    batch.count = 0;
+    batch.first_frame = frame_count;
+    const bool lidar = (options.format != ExportFormat::CSV);
+    const size_t capacity = lidar ? batch.lidar.size() : batch.obj.size();
+
+    while(batch.count < capacity) {
+        bool ok = lidar ? lidar_merger.next(batch.lidar[batch.count])
+                        : obj_merger.next(batch.obj[batch.count]);
+        if(!ok) {
+            break;      // 모든 파일 끝 (손상된 꼬리는 로더와 같이 버림)
+        }
+        ++batch.count;
+    }
+    frame_count += batch.count;
+    return batch.count > 0;
+}
+
+void FrameExporter::formatBatch(Batch& batch) const {
+    parallelFor(batch.count, 1, [&](size_t begin, size_t end, size_t) {
+        for(size_t i = begin; i < end; ++i) {
+            std::string& out = batch.text[i];
+            out.clear();        // capacity 유지 -> 묶음 버퍼 재사용
+            if(options.format == ExportFormat::CSV) {
+                formatObj(batch.obj[i], out);
+                batch.items[i] = static_cast<uint64_t>(std::count(out.begin(), out.end(), '\n'));
+            } else {
+                formatLidar(batch.lidar[i], static_cast<uint32_t>(batch.first_frame + i), out);
+                batch.items[i] = batch.lidar[i].lidar_data.size();
+            }
+        }
+    });
+}
+
+bool FrameExporter::writeBatch(const Batch& batch) {
+    for(size_t i = 0; i < batch.count; ++i) {
+        if(options.merge) {
+            merged.write(batch.text[i].data(), static_cast<std::streamsize>(batch.text[i].size()));
+            if(!merged) {
+                std::cerr << "Failed to write export file" << std::endl;
+                return false;
+            }
+        } else {
+            uint64_t time = (options.format == ExportFormat::CSV) ? batch.obj[i].time : batch.lidar[i].time;
+            std::string filename = frameFileName(batch.first_frame + i, time);
+            std::ofstream ofs(filename, std::ios::binary);
+            std::string h = header(batch.items[i], false);
+            ofs.write(h.data(), static_cast<std::streamsize>(h.size()));
+            ofs.write(batch.text[i].data(), static_cast<std::streamsize>(batch.text[i].size()));
+            if(!ofs) {
+                std::cerr << "Failed to write export file: " << filename << std::endl;
+                return false;
+            }
+            bytes_written += h.size();
+        }
+        bytes_written += batch.text[i].size();
+        item_count += batch.items[i];
+    }
+    return true;
+}
+
+
+bool FrameExporter::run(const std::vector<std::string>& file_list) {
+    MyTimer timer;
+    lidar_merger.clear();
+    obj_merger.clear();
+    if(options.format == ExportFormat::CSV) RecordingMerge::addRuns(file_list, obj_merger);
+    else                                     RecordingMerge::addRuns(file_list, lidar_merger);
+    frame_count = 0;
+    item_count = 0;
+    bytes_written = 0;
+
+    if(options.merge) {
+        std::string filename = options.out_dir + "/" + options.name + extension();
+        merged.open(filename, std::ios::binary);
+        if(!merged) {
+            std::cerr << "Failed to open export file: " << filename << std::endl;
+            return false;
+        }
+        std::string h = header(0, true);
+        merged.write(h.data(), static_cast<std::streamsize>(h.size()));
+        bytes_written += h.size();
+    }
+
+    // 묶음 2개를 번갈아 사용 : 한 묶음을 쓰는 동안 다음 묶음 읽기 + 포맷
+    const size_t batch_size = WorkerPool::instance().size() * EXPORT_BATCH_PER_WORKER;
+    Batch batches[2];
+    for(auto& b : batches) {
+        if(options.format == ExportFormat::CSV) b.obj.resize(batch_size);
+        else                                     b.lidar.resize(batch_size);
+        b.text.resize(batch_size);
+        b.items.resize(batch_size);
+    }
+
+    std::thread writer;
+    bool write_ok = true;
+    size_t cur = 0;
+    while(readBatch(batches[cur])) {
+        formatBatch(batches[cur]);
+        if(writer.joinable()) {
+            writer.join();
+        }
+        if(!write_ok) {
+            break;
+        }
+        writer = std::thread([this, &write_ok, batch = &batches[cur]] {
+            write_ok = writeBatch(*batch);
+        });
+        cur ^= 1;
+    }
+    if(writer.joinable()) {
+        writer.join();
+    }
+
+    if(options.merge) {
+        if(options.format != ExportFormat::CSV) {
+            std::string h = header(item_count, true);      // 같은 길이로 개수만 채움
+            merged.seekp(0);
+            merged.write(h.data(), static_cast<std::streamsize>(h.size()));
+        }
+        merged.close();
+    }
+
+    timer.end();
+    elapsed_ms = std::chrono::duration<double, std::milli>(timer.end_time - timer.start_time).count();
+    return write_ok;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+
+#include "binary_utils.h"
+#include "frame_merge.h"
+
+
+enum class ExportFormat { PLY, PCD, CSV };      // PLY / PCD : 라이다 점, CSV : 객체인식 검출 표
+
+struct ExportOptions {
+    ExportFormat format = ExportFormat::PLY;
+    bool binary = false;            // PLY / PCD 바이너리 (CSV는 항상 텍스트)
+    bool merge = false;             // 구간 전체를 파일 하나로 (false : 프레임마다 파일 하나)
+    std::string out_dir = ".";
+    std::string name = "export";    // merge 파일 이름 (확장자 제외)
+};
+
+// 녹화 파일을 프레임 단위로 스트리밍하며 내보내기
+// 읽기(호출 스레드) -> 포맷(worker pool, 프레임 단위 병렬) -> 쓰기(쓰기 스레드)를 묶음 단위로 겹쳐 처리
+// 메모리는 묶음 2개(pool 크기 x EXPORT_BATCH_PER_WORKER 프레임) + 병합 창(frame_merge.h)으로 고정 -> 구간 길이와 무관
+class FrameExporter {
+public:
+    explicit FrameExporter(const ExportOptions& options);
+
+    // format이 PLY / PCD면 라이다(.uld), CSV면 객체인식(.udd) 파일 목록 (파일끼리는 시간순 병합)
+    bool run(const std::vector<std::string>& files);
+
+    size_t getFrameCount() const;
+    uint64_t getItemCount() const;      // 점 수 / 검출 행 수
+    uint64_t getBytesWritten() const;
+    double getElapsedMs() const;
+    MergeStats getMergeStats() const;
+
+private:
+    struct Batch {
+        std::vector<LidarBinary> lidar;
+        std::vector<ObjBinary> obj;
+        std::vector<std::string> text;  // 포맷된 프레임 본문
+        std::vector<uint64_t> items;
+        size_t count = 0;
+        size_t first_frame = 0;         // 내보낸 프레임 중 첫 프레임 번호
+    };
+
+    bool readBatch(Batch& batch);
+    void formatBatch(Batch& batch) const;
+    bool writeBatch(const Batch& batch);
+
+    void formatLidar(const LidarBinary& frame, uint32_t frame_idx, std::string& out) const;
+    void formatObj(const ObjBinary& frame, std::string& out) const;
+    std::string header(uint64_t count, bool with_frame) const;
+    std::string frameFileName(size_t frame_idx, uint64_t time) const;
+    const char* extension() const;
+
+    ExportOptions options;
+
+    // 입력 : 파일마다 run 하나, 시간순 병합하며 이어 읽음 (파일은 run 차례에만 열림)
+    FrameMerger<LidarBinary> lidar_merger;
+    FrameMerger<ObjBinary> obj_merger;
+
+    // merge 출력 : 헤더의 점 개수는 끝난 뒤 같은 길이로 다시 씀
+    std::ofstream merged;
+
+    size_t frame_count = 0;
+    uint64_t item_count = 0;
+    uint64_t bytes_written = 0;
+    double elapsed_ms = 0.0;
+};
@@ -0,0 +1,98 @@
+#include "frame_merge.h"
+#include "profiler.h"
+
+#include <iostream>
+#include <cstring>
+
+
+namespace {
+
+// 8바이트 단위 곱셈-xorshift hash (payload는 LidarData 20 / ObjData 44 바이트 배열, padding 없음)
+uint64_t hashBytes(const void* data, size_t size, uint64_t seed) {
+    const uint64_t mul = 0x9E3779B97F4A7C15ULL;
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint64_t h = seed ^ (size * mul);
+    size_t i = 0;
+    for(; i + 8 <= size; i += 8) {
+        uint64_t w;
+        std::memcpy(&w, p + i, 8);
+        h = (h ^ w) * mul;
+        h ^= h >> 29;
+    }
+    if(i < size) {
+        uint64_t w = 0;
+        std::memcpy(&w, p + i, size - i);
+        h = (h ^ w) * mul;
+        h ^= h >> 29;
+    }
+    return h ^ (h >> 32);
+}
+
+template <typename Frame>
+void drainRuns(FrameMerger<Frame>& merger, std::vector<Frame>& out_data_list, MergeStats& out_stats) {
+    Frame frame;
+    while(merger.next(frame)) {
+        out_data_list.push_back(std::move(frame));
+        frame = Frame();
+    }
+    out_stats = merger.getStats();
+}
+
+}
+
+
+bool RecordingMerge::loadLidar(const std::vector<std::string>& files, std::vector<LidarBinary>& out_data_list, MergeStats& out_stats,
+                               const LidarRoi* roi) {
+    PROFILE_SCOPE("RecordingMerge::loadLidar");
+    FrameMerger<LidarBinary> merger;
+    std::vector<RoiStats> roi_stats(files.size());
+    size_t open_failures = 0;
+    addRunsWith(files, merger, [roi, &roi_stats](std::istream& is, LidarBinary& out, size_t f) {
+        return readLidarFrame(is, out, roi, &roi_stats[f]);
+    }, &open_failures);
+    drainRuns(merger, out_data_list, out_stats);
+    if(roi != nullptr) {
+        for(size_t f = 0; f < files.size(); ++f) {
+            if(roi_stats[f].frames > 0) {
+                BinaryUtils::print_roi_stats(files[f], roi_stats[f]);
+            }
+        }
+    }
+    return open_failures == 0;
+}
+
+bool RecordingMerge::loadObj(const std::vector<std::string>& files, std::vector<ObjBinary>& out_data_list, MergeStats& out_stats) {
+    PROFILE_SCOPE("RecordingMerge::loadObj");
+    FrameMerger<ObjBinary> merger;
+    size_t open_failures = 0;
+    addRuns(files, merger, &open_failures);
+    drainRuns(merger, out_data_list, out_stats);
+    return open_failures == 0;
+}
+
+
+bool RecordingMerge::readLidarFrame(std::istream& is, LidarBinary& out_data, const LidarRoi* roi, RoiStats* roi_stats) {
+    if(!BinaryUtils::read_lidar_frame(is, out_data, roi, roi_stats)) {
+        return false;
+    }
+    if(roi != nullptr && out_data.lidar_data.capacity() > out_data.lidar_data.size()) {
+        out_data.lidar_data.shrink_to_fit();    // 보관할 프레임 : 버린 점 자리까지 메모리에서 뺌
+    }
+    return true;
+}
+
+
+uint64_t RecordingMerge::signature(const LidarBinary& frame) {
+    return hashBytes(frame.lidar_data.data(), frame.lidar_data.size() * sizeof(LidarData), frame.num);
+}
+
+uint64_t RecordingMerge::signature(const ObjBinary& frame) {
+    return hashBytes(frame.obj_data.data(), frame.obj_data.size() * sizeof(ObjData), frame.num);
+}
+
+
+void RecordingMerge::printStats(const std::string& label, const MergeStats& stats) {
+    std::cout << "[Merge] " << label << ": " << stats.runs << " files, " << stats.frames_out << " / " << stats.frames_in << " frames"
+              << " (" << stats.duplicates << " duplicates, " << stats.reordered << " reordered, " << stats.late << " late dropped, "
+              << stats.overlapping_runs << " overlapping files)" << std::endl;
+}
@@ -0,0 +1,297 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <functional>
+#include <algorithm>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+#include "configs.h"
+#include "binary_utils.h"
+
+
+struct MergeStats {
+    size_t runs = 0;                // 병합한 run (파일) 수
+    size_t frames_in = 0;
+    size_t frames_out = 0;
+    size_t duplicates = 0;          // 같은 시간 + 같은 내용 -> 버림
+    size_t reordered = 0;           // run 안에서 앞 프레임보다 시간이 이른 프레임 (재정렬 창 안이면 복구)
+    size_t late = 0;                // 이미 내보낸 시간보다 이른 프레임 (창을 넘는 뒤바뀜) -> 버림
+    size_t overlapping_runs = 0;    // 앞 run (파일 이름 순)이 끝나기 전에 시작하는 run
+};
+
+template <typename Frame> class FrameMerger;
+
+// 녹화 파일 목록 병합 - 파일 하나를 시간순 run 하나로 보고 FrameMerger로 스트리밍 병합
+class RecordingMerge {
+public:
+    // 파일마다 run 하나로 열어 병합한 프레임을 out_data_list 뒤에 추가 (열지 못한 파일은 건너뛰고 false)
+    // roi가 있으면 읽으면서 관심 영역 밖 점을 버리고 파일별 ROI 통계 출력
+    static bool loadLidar(const std::vector<std::string>& files, std::vector<LidarBinary>& out_data_list, MergeStats& out_stats,
+                          const LidarRoi* roi = nullptr);
+    static bool loadObj(const std::vector<std::string>& files, std::vector<ObjBinary>& out_data_list, MergeStats& out_stats);
+
+    // 파일마다 run 하나 추가 (프레임 단위로 꺼내 쓰는 경우) - 파일은 merger가 읽을 때만 열림
+    // 첫 프레임은 잠깐 열어 읽고 닫음, 병합이 run의 첫 시간에 닿으면 다시 열어 끝까지 읽은 뒤 닫음
+    // -> 동시에 열린 파일 = 시간이 겹치는 run 수 (구간이 길어도 fd 한도와 무관), 열지 못한 파일은 빈 run (open_failures에 셈)
+    template <typename Frame>
+    static void addRuns(const std::vector<std::string>& files, FrameMerger<Frame>& merger, size_t* open_failures = nullptr);
+    // read(istream&, Frame&, 파일 번호)로 읽는 run 추가 (파일별 상태가 필요한 경우)
+    template <typename Frame, typename Read>
+    static void addRunsWith(const std::vector<std::string>& files, FrameMerger<Frame>& merger, Read read,
+                            size_t* open_failures = nullptr);
+
+    // 스트림에서 라이다 프레임 하나 읽기 - roi가 있으면 관심 영역 밖 점을 버리고 남긴 프레임은 버린 점 자리까지 메모리 반환
+    static bool readLidarFrame(std::istream& is, LidarBinary& out_data, const LidarRoi* roi, RoiStats* roi_stats);
+
+    // 프레임 내용 서명 (num + payload 64bit hash) - 같은 시간 프레임끼리만 비교
+    static uint64_t signature(const LidarBinary& frame);
+    static uint64_t signature(const ObjBinary& frame);
+
+    static void printStats(const std::string& label, const MergeStats& stats);
+
+private:
+    static bool readFrame(std::istream& is, LidarBinary& out_data) { return BinaryUtils::read_lidar_frame(is, out_data); }
+    static bool readFrame(std::istream& is, ObjBinary& out_data) { return BinaryUtils::read_obj_frame(is, out_data); }
+};
+
+
+// 각자 시간순인 run k개를 하나의 시간순 프레임 열로 스트리밍 병합
+// - run 머리들의 min-heap (시간, run 번호) : 프레임당 O(log k), 같은 시간이면 먼저 추가한 run부터
+// - 처음 머리가 된 run만 MERGE_REORDER_WINDOW 프레임 min-heap으로 채움 -> run 안의 국소적인 순서 뒤바뀜 복구
+//   아직 차례가 오지 않은 run은 첫 프레임 하나만 들고 있음 (메모리 : k + 겹치는 run 수 x 창 크기 프레임)
+// - 마지막으로 내보낸 시간과 같은 프레임은 내용 서명을 비교해 이미 내보낸 것과 같으면 중복으로 버림
+//   (서명은 시간이 같은 프레임이 이어질 때만 계산 -> 겹치지 않는 녹화에서는 hash 비용 없음)
+// - 창을 넘어 늦게 나온 프레임은 버림 -> 출력은 항상 시간 오름차순 (findClosestLidarFrame 이진 탐색 전제)
+template <typename Frame>
+class FrameMerger {
+public:
+    typedef std::function<bool(Frame&)> Source;     // 다음 프레임을 out에 읽기 (버퍼 재사용), 끝이면 false
+
+    explicit FrameMerger(size_t reorder_window = MERGE_REORDER_WINDOW)
+        : window(std::max<size_t>(reorder_window, 1)) {}
+
+    void clear() {
+        runs.clear();
+        heads.clear();
+        same_time_signatures.clear();
+        started = false;
+        has_last = false;
+        last_time = 0;
+        stats = MergeStats();
+    }
+
+    // 파일 이름 순서로 추가 - next() 호출 전에만
+    void addRun(Source source) {
+        Run run;
+        run.source = std::move(source);
+        runs.push_back(std::move(run));
+    }
+
+    // 다음 프레임을 out과 맞바꿔 돌려줌 (out의 이전 버퍼는 다음 읽기에 재사용), 모든 run이 끝나면 false
+    bool next(Frame& out) {
+        if(!started) {
+            start();
+        }
+        while(!heads.empty()) {
+            std::pop_heap(heads.begin(), heads.end(), HeadGreater());
+            size_t r = heads.back().run;
+            heads.pop_back();
+            Run& run = runs[r];
+
+            if(!run.warm) {         // 처음 차례가 온 run : 창을 채운 뒤 다시 머리 비교
+                run.warm = true;
+                fill(run, window);
+                pushHead(r);
+                continue;
+            }
+
+            std::pop_heap(run.pending.begin(), run.pending.end(), FrameGreater());
+            Frame& frame = run.pending.back();
+            bool keep = true;
+            if(has_last && frame.time < last_time) {
+                ++stats.late;
+                keep = false;
+            } else if(has_last && frame.time == last_time) {
+                uint64_t sig = RecordingMerge::signature(frame);
+                if(std::find(same_time_signatures.begin(), same_time_signatures.end(), sig) != same_time_signatures.end()) {
+                    ++stats.duplicates;
+                    keep = false;
+                } else {
+                    same_time_signatures.push_back(sig);
+                }
+            } else {
+                same_time_signatures.clear();
+            }
+
+            if(keep) {
+                std::swap(out, frame);
+            }
+            std::swap(run.spare, frame);
+            run.pending.pop_back();
+            fill(run, window);
+            pushHead(r);
+
+            if(!keep) {
+                continue;
+            }
+            // 새 시간의 첫 프레임 : 같은 시간 프레임이 뒤따를 때만 서명 보관
+            if(same_time_signatures.empty() && !heads.empty() && heads.front().time == out.time) {
+                same_time_signatures.push_back(RecordingMerge::signature(out));
+            }
+            has_last = true;
+            last_time = out.time;
+            ++stats.frames_out;
+            return true;
+        }
+        return false;
+    }
+
+    // overlapping_runs는 모든 run을 다 읽은 뒤에 정확함
+    MergeStats getStats() const {
+        MergeStats s = stats;
+        s.runs = runs.size();
+        bool any = false;
+        uint64_t prev_end = 0;
+        for(const Run& run : runs) {
+            if(run.frames == 0) {
+                continue;
+            }
+            if(any && run.first_time < prev_end) {
+                ++s.overlapping_runs;
+            }
+            prev_end = any ? std::max(prev_end, run.max_time) : run.max_time;
+            any = true;
+        }
+        return s;
+    }
+
+private:
+    struct Run {
+        Source source;
+        std::vector<Frame> pending;     // min-heap (time), 크기 <= window
+        Frame spare;                    // 다음 읽기 버퍼
+        uint64_t first_time = 0;
+        uint64_t max_time = 0;          // 지금까지 읽은 가장 늦은 시간 (순서 뒤바뀜 판정)
+        size_t frames = 0;
+        bool warm = false;
+        bool exhausted = false;
+    };
+
+    struct Head {
+        uint64_t time;
+        size_t run;
+    };
+
+    struct HeadGreater {
+        bool operator()(const Head& a, const Head& b) const {
+            return a.time != b.time ? a.time > b.time : a.run > b.run;
+        }
+    };
+
+    struct FrameGreater {
+        bool operator()(const Frame& a, const Frame& b) const { return a.time > b.time; }
+    };
+
+    void start() {
+        started = true;
+        heads.clear();
+        heads.reserve(runs.size());
+        for(size_t r = 0; r < runs.size(); ++r) {
+            fill(runs[r], 1);
+            pushHead(r);
+        }
+    }
+
+    void fill(Run& run, size_t limit) {
+        while(!run.exhausted && run.pending.size() < limit) {
+            if(!run.source(run.spare)) {
+                run.exhausted = true;
+                break;
+            }
+            ++stats.frames_in;
+            if(run.frames == 0) {
+                run.first_time = run.spare.time;
+            } else if(run.spare.time < run.max_time) {
+                ++stats.reordered;
+            }
+            run.max_time = std::max(run.max_time, run.spare.time);
+            ++run.frames;
+            run.pending.push_back(std::move(run.spare));
+            run.spare = Frame();
+            std::push_heap(run.pending.begin(), run.pending.end(), FrameGreater());
+        }
+    }
+
+    void pushHead(size_t r) {
+        if(runs[r].pending.empty()) {
+            return;
+        }
+        heads.push_back({runs[r].pending.front().time, r});
+        std::push_heap(heads.begin(), heads.end(), HeadGreater());
+    }
+
+    size_t window;
+    std::vector<Run> runs;
+    std::vector<Head> heads;                    // min-heap (time, run)
+    std::vector<uint64_t> same_time_signatures; // last_time에 내보낸 프레임 서명
+    bool started = false;
+    bool has_last = false;
+    uint64_t last_time = 0;
+    MergeStats stats;
+};
+
+
+template <typename Frame>
+void RecordingMerge::addRuns(const std::vector<std::string>& files, FrameMerger<Frame>& merger, size_t* open_failures) {
+    addRunsWith(files, merger, [](std::istream& is, Frame& out, size_t) { return readFrame(is, out); }, open_failures);
+}
+
+template <typename Frame, typename Read>
+void RecordingMerge::addRunsWith(const std::vector<std::string>& files, FrameMerger<Frame>& merger, Read read,
+                                 size_t* open_failures) {
+    struct RunFile {
+        std::string path;
+        std::unique_ptr<std::ifstream> input;
+        std::streamoff offset = 0;      // 닫아 둔 동안 다음 프레임 위치
+        bool first = true;
+        bool done = false;
+    };
+    for(size_t f = 0; f < files.size(); ++f) {
+        std::shared_ptr<RunFile> file = std::make_shared<RunFile>();
+        file->path = files[f];
+        merger.addRun([file, f, read, open_failures](Frame& out) {
+            if(file->done) {
+                return false;
+            }
+            if(!file->input) {
+                file->input.reset(new std::ifstream(file->path, std::ios::binary));
+                if(!*file->input) {
+                    std::cerr << "Failed to open file: " << file->path << std::endl;
+                    if(open_failures != nullptr) {
+                        ++*open_failures;
+                    }
+                    file->input.reset();
+                    file->done = true;
+                    return false;
+                }
+                file->input->seekg(file->offset);
+            }
+            if(!read(*file->input, out, f)) {
+                file->input.reset();
+                file->done = true;
+                return false;
+            }
+            if(file->first) {           // 아직 차례가 오지 않은 run : 머리 프레임만 들고 파일은 닫음
+                file->first = false;
+                file->offset = file->input->tellg();
+                file->input.reset();
+            }
+            return true;
+        });
+    }
+}
@@ -0,0 +1,306 @@
+#include "frame_server.h"
+
+#include <thread>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+
+using StreamClock = std::chrono::steady_clock;
+
+
+FrameServer::FrameServer(const std::vector<LidarBinary>& lidar_list, const std::vector<ObjBinary>& obj_list,
+                         const std::vector<UnifiedData>& timeline)
+    : lidar_list(lidar_list), obj_list(obj_list), timeline(timeline) {}
+
+
+uint64_t FrameServer::entryTime(size_t timeline_idx) const {
+    const UnifiedData& entry = timeline[timeline_idx];
+    return (entry.type == DataType::LIDAR) ? lidar_list[entry.index].time : obj_list[entry.index].time;
+}
+
+size_t FrameServer::findEntry(uint64_t time) const {
+    size_t lo = 0, hi = timeline.size();
+    while(lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if(entryTime(mid) < time) lo = mid + 1;
+        else                      hi = mid;
+    }
+    if(lo >= timeline.size()) {
+        lo = timeline.size() - 1;
+    }
+    // 검출 항목에서 시작하면 겹쳐 그릴 라이다가 없음 -> 바로 앞 라이다 항목부터
+    for(size_t i = lo + 1; i-- > 0;) {
+        if(timeline[i].type == DataType::LIDAR) {
+            return i;
+        }
+    }
+    return lo;
+}
+
+
+void FrameServer::receiveLoop(StreamSocket& client) {
+    StreamHeader header;
+    std::vector<uint8_t> message;
+    while(client.recvMessage(header, message)) {
+        const StreamMessage type = static_cast<StreamMessage>(header.type);
+        if(type == StreamMessage::ACK && message.size() >= sizeof(StreamAck)) {
+            StreamAck ack;
+            std::memcpy(&ack, message.data(), sizeof(ack));
+            acked_bytes.store(ack.received_bytes);
+        }
+        else if(type == StreamMessage::CONTROL && message.size() >= sizeof(StreamControl)) {
+            StreamControl control;
+            std::memcpy(&control, message.data(), sizeof(control));
+            std::lock_guard<std::mutex> lock(control_mutex);
+            switch(static_cast<StreamCommand>(control.command)) {
+                case StreamCommand::PLAY:  playing = true; break;
+                case StreamCommand::PAUSE: playing = false; break;
+                case StreamCommand::SEEK:
+                    seek_pending = true;
+                    seek_offset_ms += control.value;
+                    break;
+                case StreamCommand::SPEED:
+                    if(control.value > 0) {
+                        speed_pending = true;
+                        pending_speed = control.value / 1000.0f;
+                    }
+                    break;
+            }
+            control_cv.notify_one();
+        }
+    }
+    std::lock_guard<std::mutex> lock(control_mutex);
+    disconnected = true;
+    control_cv.notify_one();
+}
+
+
+void FrameServer::serve(StreamSocket& client, const ServerOptions& options) {
+    playing = true;
+    seek_pending = false;
+    seek_offset_ms = 0;
+    speed_pending = false;
+    disconnected = false;
+    acked_bytes.store(0);
+    codec.reset();
+    sent_bytes = 0;
+    sent_lidar = 0;
+    skipped_lidar = 0;
+    sent_obj = 0;
+
+    StreamHello hello;
+    std::memset(&hello, 0, sizeof(hello));
+    if(!timeline.empty()) {
+        hello.first_time = entryTime(0);
+        hello.last_time = entryTime(timeline.size() - 1);
+    }
+    hello.timeline_size = static_cast<uint32_t>(timeline.size());
+    hello.lidar_frames = static_cast<uint32_t>(lidar_list.size());
+    hello.obj_frames = static_cast<uint32_t>(obj_list.size());
+    hello.quant_step = STREAM_QUANT_STEP;
+
+    uint32_t seq = 0;
+    if(!client.sendMessage(StreamMessage::HELLO, seq++, &hello, sizeof(hello))) {
+        return;
+    }
+    sent_bytes += sizeof(StreamHeader) + sizeof(hello);
+
+    std::thread receiver(&FrameServer::receiveLoop, this, std::ref(client));
+
+    // 재생 시각 = media_anchor + (지금 - wall_anchor) x 배속 (일시 정지 중에는 media_anchor 고정)
+    // 배속 변경 / 이동 / 재생 상태가 바뀌면 현재 재생 시각으로 기준점을 다시 잡음
+    const double first_time = static_cast<double>(hello.first_time);
+    const double last_time = static_cast<double>(hello.last_time);
+    float speed = (options.speed > 0.0f) ? options.speed : 1.0f;
+    bool is_playing = true;
+    bool ended = timeline.empty();
+    size_t timeline_idx = 0;
+    double media_anchor = first_time;
+    StreamClock::time_point wall_anchor = StreamClock::now();
+    bool forcing = false;           // 일시 정지 중 이동 -> 목표 시각까지의 항목은 기다리지 않고 보냄
+    uint64_t force_until = 0;
+
+    uint32_t stride = 1;
+    size_t good_frames = 0;
+    StreamClock::time_point link_free_at = wall_anchor;
+
+    StreamClock::time_point stats_start = wall_anchor;
+    uint64_t stats_bytes = sent_bytes;
+    size_t stats_lidar = 0, stats_skipped = 0, stats_obj = 0;
+
+    auto mediaNow = [&](StreamClock::time_point now) {
+        return is_playing ? media_anchor + std::chrono::duration<double, std::milli>(now - wall_anchor).count() * speed : media_anchor;
+    };
+
+    while(true) {
+        //============================= 제어 메시지 반영 =================================
+        bool want_play, do_seek, do_speed;
+        int64_t seek_ms;
+        float new_speed;
+        {
+            std::lock_guard<std::mutex> lock(control_mutex);
+            if(disconnected) {
+                break;
+            }
+            want_play = playing;
+            do_seek = seek_pending;
+            seek_ms = seek_offset_ms;
+            do_speed = speed_pending;
+            new_speed = pending_speed;
+            seek_pending = false;
+            seek_offset_ms = 0;
+            speed_pending = false;
+        }
+        StreamClock::time_point now = StreamClock::now();
+        if(do_speed || do_seek || want_play != is_playing) {
+            media_anchor = mediaNow(now);
+            wall_anchor = now;
+        }
+        if(do_speed) {
+            speed = new_speed;
+        }
+        // 녹화 끝에서 다시 재생하면 처음부터
+        if(want_play && !is_playing && ended && !do_seek && !timeline.empty()) {
+            do_seek = true;
+            seek_ms = 0;
+            media_anchor = first_time;
+        }
+        is_playing = want_play;
+        if(do_seek && !timeline.empty()) {
+            double target = std::min(std::max(media_anchor + static_cast<double>(seek_ms), first_time), last_time);
+            timeline_idx = findEntry(static_cast<uint64_t>(target));
+            media_anchor = target;
+            codec.reset();          // 다음 라이다 프레임은 key frame
+            ended = false;
+            good_frames = 0;
+            forcing = !is_playing;
+            force_until = static_cast<uint64_t>(target);
+        }
+
+        //============================= 전송 통계 =================================
+        double stats_ms = std::chrono::duration<double, std::milli>(now - stats_start).count();
+        if(stats_ms >= STREAM_STATS_INTERVAL_MS) {
+            uint64_t inflight = sent_bytes - std::min(sent_bytes, acked_bytes.load());
+            std::cout << "[Server] " << std::fixed << std::setprecision(1) << (sent_bytes - stats_bytes) * 8.0 / stats_ms << " kbps, lidar "
+                      << (sent_lidar - stats_lidar) << " sent / " << (skipped_lidar - stats_skipped) << " skipped, obj " << (sent_obj - stats_obj)
+                      << ", stride " << stride << ", inflight " << inflight / 1024 << " KB, x" << speed << (is_playing ? "" : " (paused)")
+                      << std::defaultfloat << std::endl;
+            stats_start = now;
+            stats_bytes = sent_bytes;
+            stats_lidar = sent_lidar;
+            stats_skipped = skipped_lidar;
+            stats_obj = sent_obj;
+        }
+
+        //============================= 다음 항목 시각까지 대기 =================================
+        if(ended || (!is_playing && !forcing)) {
+            std::unique_lock<std::mutex> lock(control_mutex);
+            control_cv.wait_for(lock, std::chrono::milliseconds(STREAM_STATS_INTERVAL_MS));
+            continue;
+        }
+        const uint64_t entry_time = entryTime(timeline_idx);
+        if(forcing && entry_time > force_until) {
+            forcing = false;
+            continue;
+        }
+        const double media_now = forcing ? static_cast<double>(force_until) : mediaNow(now);
+        if(entry_time > media_now) {
+            double wait_ms = std::min((entry_time - media_now) / speed, 20.0);
+            std::unique_lock<std::mutex> lock(control_mutex);
+            control_cv.wait_for(lock, std::chrono::duration<double, std::milli>(wait_ms));
+            continue;
+        }
+        const double lag_ms = (media_now - entry_time) / speed;     // 재생 시각보다 늦은 정도 // 실제 ms
+
+        //============================= 항목 전송 =================================
+        const UnifiedData& entry = timeline[timeline_idx];
+        StreamFrameInfo info;
+        info.time = entry_time;
+        info.timeline_idx = static_cast<uint32_t>(timeline_idx);
+        info.stride = 1;
+        size_t message_bytes = 0;
+        bool ok = true;
+
+        if(entry.type == DataType::LIDAR) {
+            const uint64_t inflight = sent_bytes - std::min(sent_bytes, acked_bytes.load());
+            if(!forcing && (lag_ms > STREAM_MAX_LAG_MS || inflight > STREAM_MAX_INFLIGHT_BYTES)) {
+                // 너무 늦었거나 클라이언트가 못 따라옴 -> 건너뛰고 점 간격도 늘림
+                ++skipped_lidar;
+                stride = std::min<uint32_t>(stride * 2, STREAM_MAX_STRIDE);
+                good_frames = 0;
+            } else {
+                codec.encodeLidar(lidar_list[entry.index], stride, payload);
+                info.stride = stride;
+                ok = client.sendMessage(StreamMessage::LIDAR, seq++, &info, sizeof(info), payload.data(), payload.size());
+                message_bytes = sizeof(StreamHeader) + sizeof(info) + payload.size();
+                ++sent_lidar;
+
+                if(inflight > STREAM_CONGESTED_BYTES || lag_ms > STREAM_MAX_LAG_MS / 2) {
+                    stride = std::min<uint32_t>(stride * 2, STREAM_MAX_STRIDE);
+                    good_frames = 0;
+                } else if(++good_frames >= STREAM_PROBE_FRAMES && stride > 1) {
+                    stride /= 2;
+                    good_frames = 0;
+                }
+            }
+        } else {
+            FrameCodec::encodeObj(obj_list[entry.index], payload);
+            ok = client.sendMessage(StreamMessage::OBJ, seq++, &info, sizeof(info), payload.data(), payload.size());
+            message_bytes = sizeof(StreamHeader) + sizeof(info) + payload.size();
+            ++sent_obj;
+        }
+        if(!ok) {
+            break;
+        }
+        sent_bytes += message_bytes;
+
+        // 대역폭 제한 모의 : 보낸 양만큼 링크가 바쁜 것으로 보고 그동안 다음 전송을 막음
+        if(options.limit_bytes_per_s > 0.0 && message_bytes > 0) {
+            link_free_at = std::max(link_free_at, StreamClock::now()) +
+                           std::chrono::duration_cast<StreamClock::duration>(std::chrono::duration<double>(message_bytes / options.limit_bytes_per_s));
+            std::this_thread::sleep_until(link_free_at);
+        }
+
+        if(++timeline_idx >= timeline.size()) {
+            ok = client.sendMessage(StreamMessage::END, seq++, nullptr, 0);
+            sent_bytes += sizeof(StreamHeader);
+            std::cout << "[Server] end of recording (" << sent_lidar << " lidar sent, " << skipped_lidar << " skipped, "
+                      << sent_obj << " obj)" << std::endl;
+            timeline_idx = timeline.size() - 1;
+            ended = true;
+            forcing = false;
+            media_anchor = last_time;
+            is_playing = false;
+            {
+                std::lock_guard<std::mutex> lock(control_mutex);
+                playing = false;
+            }
+            if(!ok) {
+                break;
+            }
+        }
+    }
+
+    client.shutdown();
+    receiver.join();
+}
+
+
+uint64_t FrameServer::getSentBytes() const {
+    return sent_bytes;
+}
+
+size_t FrameServer::getSentLidar() const {
+    return sent_lidar;
+}
+
+size_t FrameServer::getSkippedLidar() const {
+    return skipped_lidar;
+}
+
+size_t FrameServer::getSentObj() const {
+    return sent_obj;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+
+#include "configs.h"
+#include "binary_utils.h"
+#include "stream_protocol.h"
+#include "frame_codec.h"
+
+
+struct ServerOptions {
+    float speed = 1.0f;                 // 시작 배속
+    double limit_bytes_per_s = 0.0;     // 0 : 제한 없음, 아니면 이 대역폭의 링크를 흉내 (localhost 테스트용)
+};
+
+// 원격 보기 서버 - 불러온 녹화를 타임라인 순서 / 녹화 시간 간격대로 클라이언트 하나에 스트리밍 (aeronSW_server)
+// 라이다 프레임은 FrameCodec으로 양자화 + 직전 프레임 대비 차이 압축, 검출 목록은 그대로
+// 전송량 조절 : 보냈지만 ACK 안 된 양 / 재생 시각 대비 지연으로 혼잡 판단
+//   혼잡하면 점 간격(stride)을 2배, 한동안 혼잡이 없으면 절반 -> 너무 늦거나 밀린 라이다 프레임은 건너뜀 (검출 목록은 항상 보냄)
+class FrameServer {
+public:
+    FrameServer(const std::vector<LidarBinary>& lidar_list, const std::vector<ObjBinary>& obj_list,
+                const std::vector<UnifiedData>& timeline);
+
+    // 연결이 끊길 때까지 재생 / 제어 처리 (블록), 녹화 끝에서는 END를 보내고 일시 정지 상태로 대기
+    void serve(StreamSocket& client, const ServerOptions& options);
+
+    // 마지막 serve 통계
+    uint64_t getSentBytes() const;
+    size_t getSentLidar() const;
+    size_t getSkippedLidar() const;
+    size_t getSentObj() const;
+
+private:
+    void receiveLoop(StreamSocket& client);
+    uint64_t entryTime(size_t timeline_idx) const;
+    size_t findEntry(uint64_t time) const;          // time 이후 첫 항목, 바로 앞 라이다 항목이 있으면 거기부터
+
+    const std::vector<LidarBinary>& lidar_list;
+    const std::vector<ObjBinary>& obj_list;
+    const std::vector<UnifiedData>& timeline;
+
+    // 수신 스레드 -> 재생 루프
+    std::mutex control_mutex;
+    std::condition_variable control_cv;
+    bool playing = true;
+    bool seek_pending = false;
+    int64_t seek_offset_ms = 0;
+    bool speed_pending = false;
+    float pending_speed = 1.0f;
+    bool disconnected = false;
+    std::atomic<uint64_t> acked_bytes{0};
+
+    FrameCodec codec;
+    std::vector<uint8_t> payload;
+    uint64_t sent_bytes = 0;
+    size_t sent_lidar = 0;
+    size_t skipped_lidar = 0;
+    size_t sent_obj = 0;
+};
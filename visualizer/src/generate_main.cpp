@@ -0,0 +1,81 @@
+// 합성 녹화 생성 CLI : .uld / .udd 스트레스 테스트 데이터 작성 (실제 녹화와 같은 파일명 / 레코드 배치)
+// Usage: ./aeronSW_generate [options]
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+
+#include "configs.h"
+#include "recording_generator.h"
+#include "parallel_utils.h"
+
+
+static void printHowToUse() {
+    std::cout << "Usage: ./aeronSW_generate [options]\n"
+              << "  --out dir            output directory (default " << GEN_DEFAULT_DIR << ", viewer reads " << UAM_DATA_PATH << ")\n"
+              << "  --start time         first frame time, yy-MM-dd-HH-mm-ss (default 24-01-01-00-00-00)\n"
+              << "  --seconds s          recording length (default 60)\n"
+              << "  --file-seconds s     length of one file (default 60)\n"
+              << "  --hz f               lidar sweep rate (default 10)\n"
+              << "  --obj-hz f           detection frame rate (default 10)\n"
+              << "  --points n           points per sweep (default 65536)\n"
+              << "  --det n              detections per frame (default 8)\n"
+              << "  --jitter ms          timestamp jitter (default 0)\n"
+              << "  --reorder p          out-of-order timestamp rate (default 0)\n"
+              << "  --duplicate p        duplicate timestamp rate (default 0)\n"
+              << "  --corrupt p          corrupted record rate (default 0)\n"
+              << "  --seed n             random seed (default 1)" << std::endl;
+}
+
+
+int main(int argc, char* argv[]) {
+    GeneratorOptions options;
+    options.out_dir = GEN_DEFAULT_DIR;
+    for(int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if(i + 1 >= argc) {
+            printHowToUse();
+            return -1;
+        }
+        const char* value = argv[++i];
+        if(arg == "--out")                  options.out_dir = value;
+        else if(arg == "--start")           options.start_time = value;
+        else if(arg == "--seconds")         options.seconds = std::atof(value);
+        else if(arg == "--file-seconds")    options.file_seconds = std::atof(value);
+        else if(arg == "--hz")              options.sweep_hz = std::atof(value);
+        else if(arg == "--obj-hz")          options.obj_hz = std::atof(value);
+        else if(arg == "--points")          options.points = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        else if(arg == "--det")             options.detections = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        else if(arg == "--jitter")          options.jitter_ms = std::atof(value);
+        else if(arg == "--reorder")         options.reorder_rate = std::atof(value);
+        else if(arg == "--duplicate")       options.duplicate_rate = std::atof(value);
+        else if(arg == "--corrupt")         options.corrupt_rate = std::atof(value);
+        else if(arg == "--seed")            options.seed = std::strtoull(value, nullptr, 10);
+        else {
+            printHowToUse();
+            return -1;
+        }
+    }
+
+    RecordingGenerator generator(options);
+    if(!generator.run()) {
+        return 1;
+    }
+
+    double gb = generator.getBytesWritten() / (1024.0 * 1024.0 * 1024.0);
+    double sec = generator.getElapsedMs() / 1000.0;
+    std::cout << "Generated " << generator.getFileCount() << " files in " << options.out_dir << ": "
+              << generator.getLidarFrameCount() << " sweeps x " << options.points << " points, "
+              << generator.getObjFrameCount() << " detection frames x " << options.detections << "\n"
+              << std::fixed << std::setprecision(2) << gb << " GB in " << generator.getElapsedMs() << " ms ("
+              << ((sec > 0.0) ? gb / sec : 0.0) << " GB/s, " << WorkerPool::instance().size() << " workers)" << std::endl;
+
+    typedef RecordingGenerator G;
+    std::cout << "Corrupted records: empty " << generator.getCorruptionCount(G::CORRUPT_EMPTY)
+              << ", bad time " << generator.getCorruptionCount(G::CORRUPT_BAD_TIME)
+              << ", nan points " << generator.getCorruptionCount(G::CORRUPT_NAN)
+              << ", huge count " << generator.getCorruptionCount(G::CORRUPT_HUGE_COUNT)
+              << ", truncated " << generator.getCorruptionCount(G::CORRUPT_TRUNCATED) << std::endl;
+    return 0;
+}
@@ -0,0 +1,232 @@
+#include "ground_filter.h"
+#include "configs.h"
+#include "parallel_utils.h"
+
+#include <cmath>
+#include <algorithm>
+
+#define GROUND_ITERATION_GRAIN  8       // 스레드가 한 번에 가져가는 가설 수
+#define GROUND_MAX_WORKERS      64
+
+
+// 스레드별 난수 (xorshift32) - std::random 엔진보다 가볍고 할당 없음
+static inline uint32_t nextRandom(uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static bool planeFromPoints(float x0, float y0, float z0, float x1, float y1, float z1,
+                            float x2, float y2, float z2, GroundPlane& out) {
+    float ux = x1 - x0, uy = y1 - y0, uz = z1 - z0;
+    float vx = x2 - x0, vy = y2 - y0, vz = z2 - z0;
+    float nx = uy * vz - uz * vy;
+    float ny = uz * vx - ux * vz;
+    float nz = ux * vy - uy * vx;
+    float len = std::sqrt(nx * nx + ny * ny + nz * nz);
+    if(len < 1e-6f) {
+        return false;
+    }
+    if(nz < 0.0f) {
+        nx = -nx; ny = -ny; nz = -nz;
+    }
+    out.a = nx / len;
+    out.b = ny / len;
+    out.c = nz / len;
+    out.d = -(out.a * x0 + out.b * y0 + out.c * z0);
+    out.valid = true;
+    return true;
+}
+
+
+const std::vector<uint8_t>& GroundFilter::getGroundMask() const {
+    return mask;
+}
+
+const GroundPlane& GroundFilter::getPlane() const {
+    return plane;
+}
+
+size_t GroundFilter::getGroundCount() const {
+    return ground_count;
+}
+
+double GroundFilter::getElapsedMs() const {
+    return elapsed_ms;
+}
+
+bool GroundFilter::wasWarmStarted() const {
+    return warm_started;
+}
+
+
+size_t GroundFilter::countInliers(const GroundPlane& p) const {
+    const float* __restrict x = sample_x.data();
+    const float* __restrict y = sample_y.data();
+    const float* __restrict z = sample_z.data();
+    const float thr = GROUND_DIST_THRESHOLD;
+    size_t count = 0;
+    for(size_t i = 0; i < sample_count; ++i) {
+        float dist = p.a * x[i] + p.b * y[i] + p.c * z[i] + p.d;
+        count += (std::fabs(dist) < thr) ? 1 : 0;
+    }
+    return count;
+}
+
+// inlier로 z = alpha*x + beta*y + gamma 최소제곱 (지면은 수평에 가까우므로 z 기준 회귀)
+void GroundFilter::refine(GroundPlane& p) const {
+    double sxx = 0, sxy = 0, sx = 0, syy = 0, sy = 0, n = 0, sxz = 0, syz = 0, sz = 0;
+    for(size_t i = 0; i < sample_count; ++i) {
+        float dist = p.a * sample_x[i] + p.b * sample_y[i] + p.c * sample_z[i] + p.d;
+        if(std::fabs(dist) >= GROUND_DIST_THRESHOLD) continue;
+        double x = sample_x[i], y = sample_y[i], z = sample_z[i];
+        sxx += x * x; sxy += x * y; sx += x;
+        syy += y * y; sy += y; n += 1;
+        sxz += x * z; syz += y * z; sz += z;
+    }
+    if(n < 3) {
+        return;
+    }
+
+    // 3x3 정규방정식 (Cramer)
+    double m[3][3] = {{sxx, sxy, sx}, {sxy, syy, sy}, {sx, sy, n}};
+    double r[3] = {sxz, syz, sz};
+    double det = m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+               - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+               + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+    if(std::fabs(det) < 1e-9) {
+        return;
+    }
+    double sol[3];
+    for(int k = 0; k < 3; ++k) {
+        double t[3][3];
+        for(int i = 0; i < 3; ++i) for(int j = 0; j < 3; ++j) t[i][j] = (j == k) ? r[i] : m[i][j];
+        sol[k] = (t[0][0] * (t[1][1] * t[2][2] - t[1][2] * t[2][1])
+                - t[0][1] * (t[1][0] * t[2][2] - t[1][2] * t[2][0])
+                + t[0][2] * (t[1][0] * t[2][1] - t[1][1] * t[2][0])) / det;
+    }
+
+    // alpha*x + beta*y - z + gamma = 0 -> 단위 법선
+    double len = std::sqrt(sol[0] * sol[0] + sol[1] * sol[1] + 1.0);
+    p.a = static_cast<float>(-sol[0] / len);
+    p.b = static_cast<float>(-sol[1] / len);
+    p.c = static_cast<float>(1.0 / len);
+    p.d = static_cast<float>(-sol[2] / len);
+    p.valid = true;
+}
+
+
+void GroundFilter::process(const LidarBinary& frame) {
+    if(&frame == last_frame && frame.time == last_time) {
+        return;
+    }
+    last_frame = &frame;
+    last_time = frame.time;
+
+    MyTimer timer;
+    soa.load(frame);
+    const size_t n = soa.size;
+    if(mask.size() < n) {
+        mask.resize(n);
+    }
+    std::fill(mask.begin(), mask.begin() + n, 0);
+    ground_count = 0;
+    if(n < 3) {
+        plane.valid = false;
+        return;
+    }
+
+    // 균등 간격 표본 - 가설 점수 계산은 표본으로, 최종 라벨링만 전체 점으로
+    size_t stride = std::max<size_t>(1, n / GROUND_SAMPLE_POINTS);
+    sample_count = (n + stride - 1) / stride;
+    if(sample_x.size() < sample_count) {
+        sample_x.resize(sample_count);
+        sample_y.resize(sample_count);
+        sample_z.resize(sample_count);
+    }
+    for(size_t i = 0, j = 0; j < sample_count; i += stride, ++j) {
+        sample_x[j] = soa.x[i];
+        sample_y[j] = soa.y[i];
+        sample_z[j] = soa.z[i];
+    }
+
+    // warm start : 직전 평면이 표본의 일정 비율 이상을 설명하면 반복 수를 줄임
+    GroundPlane best;
+    size_t best_score = 0;
+    int iterations = GROUND_RANSAC_ITERATIONS;
+    warm_started = false;
+    if(plane.valid) {
+        best = plane;
+        best_score = countInliers(plane);
+        if(best_score >= sample_count * GROUND_WARM_MIN_RATIO) {
+            iterations = GROUND_WARM_ITERATIONS;
+            warm_started = true;
+        }
+    }
+
+    // 병렬 RANSAC : 가설을 worker에 나누고 worker별 최고 가설을 합침
+    const size_t workers = std::min<size_t>(workerCount(), GROUND_MAX_WORKERS);
+    GroundPlane worker_best[GROUND_MAX_WORKERS];
+    size_t worker_score[GROUND_MAX_WORKERS] = {0};
+    const float min_normal_z = std::cos(GROUND_MAX_TILT * 3.14159265f / 180.0f);
+
+    parallelFor(iterations, GROUND_ITERATION_GRAIN, workers, [&](size_t begin, size_t end, size_t worker) {
+        uint32_t rng = static_cast<uint32_t>(frame.time * 2654435761u) ^ static_cast<uint32_t>(begin * 40503u + 1);
+        if(rng == 0) rng = 1;
+        for(size_t it = begin; it < end; ++it) {
+            size_t i0 = nextRandom(rng) % sample_count;
+            size_t i1 = nextRandom(rng) % sample_count;
+            size_t i2 = nextRandom(rng) % sample_count;
+            GroundPlane hyp;
+            if(!planeFromPoints(sample_x[i0], sample_y[i0], sample_z[i0],
+                                sample_x[i1], sample_y[i1], sample_z[i1],
+                                sample_x[i2], sample_y[i2], sample_z[i2], hyp)) {
+                continue;
+            }
+            if(hyp.c < min_normal_z) {
+                continue;       // 지면이라 보기 어려운 기울기
+            }
+            size_t score = countInliers(hyp);
+            if(score > worker_score[worker]) {
+                worker_score[worker] = score;
+                worker_best[worker] = hyp;
+            }
+        }
+    });
+
+    for(size_t w = 0; w < workers; ++w) {
+        if(worker_score[w] > best_score) {
+            best_score = worker_score[w];
+            best = worker_best[w];
+        }
+    }
+
+    if(!best.valid || best_score < sample_count * GROUND_MIN_INLIER_RATIO) {
+        plane.valid = false;
+        timer.end();
+        elapsed_ms = std::chrono::duration<double, std::milli>(timer.end_time - timer.start_time).count();
+        return;
+    }
+    refine(best);
+    plane = best;
+
+    // 전체 점 라벨링 (벡터화)
+    const float* __restrict x = soa.x.data();
+    const float* __restrict y = soa.y.data();
+    const float* __restrict z = soa.z.data();
+    uint8_t* __restrict out = mask.data();
+    const float pa = plane.a, pb = plane.b, pc = plane.c, pd = plane.d;
+    const float thr = GROUND_DIST_THRESHOLD;
+    size_t count = 0;
+    for(size_t i = 0; i < n; ++i) {
+        float dist = pa * x[i] + pb * y[i] + pc * z[i] + pd;
+        uint8_t is_ground = (std::fabs(dist) < thr) ? 1 : 0;
+        out[i] = is_ground;
+        count += is_ground;
+    }
+    ground_count = count;
+
+    timer.end();
+    elapsed_ms = std::chrono::duration<double, std::milli>(timer.end_time - timer.start_time).count();
+}
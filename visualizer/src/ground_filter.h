@@ -0,0 +1,45 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "binary_utils.h"
+#include "lidar_soa.h"
+
+
+// 평면 ax + by + cz + d = 0, (a, b, c)는 단위 법선 (c > 0)
+struct GroundPlane {
+    float a = 0.0f, b = 0.0f, c = 1.0f, d = 0.0f;
+    bool valid = false;
+};
+
+// 병렬 RANSAC 지면 평면 추정 + 지면 점 표시 (프레임 준비 시 실행)
+// 직전 프레임 평면을 warm start로 사용 - 여전히 잘 맞으면 적은 반복만 수행
+class GroundFilter {
+public:
+    // 같은 프레임이면 다시 계산하지 않음
+    void process(const LidarBinary& frame);
+
+    const std::vector<uint8_t>& getGroundMask() const;     // 1 : 지면 점
+    const GroundPlane& getPlane() const;
+    size_t getGroundCount() const;
+    double getElapsedMs() const;
+    bool wasWarmStarted() const;
+
+private:
+    size_t countInliers(const GroundPlane& plane) const;   // 표본 점 대상 (벡터화)
+    void refine(GroundPlane& plane) const;                  // 표본 inlier 최소제곱 재추정
+
+    const LidarBinary* last_frame = nullptr;
+    uint64_t last_time = 0;
+
+    LidarSoA soa;
+    std::vector<float> sample_x, sample_y, sample_z;       // 점수 계산용 균등 표본 (연속 배열)
+    size_t sample_count = 0;
+
+    std::vector<uint8_t> mask;
+    GroundPlane plane;
+    size_t ground_count = 0;
+    double elapsed_ms = 0.0;
+    bool warm_started = false;
+};
@@ -0,0 +1,55 @@
+// 녹화 점검 CLI : 창 / GL 없이 프레임 헤더만 훑어 녹화 구성 요약 (파일 / 프레임 수, 시간 범위, 끊김, 주기, 클래스별 검출 수)
+// Usage: ./aeronSW_inspect [start_time] [end_time] [--files] [--data dir]
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <iomanip>
+#include <filesystem>
+
+#include "configs.h"
+#include "recording_files.h"
+#include "recording_inspector.h"
+#include "parallel_utils.h"
+
+
+int main(int argc, char* argv[]) {
+    if(argc < 3) {
+        std::cout << "Usage: ./aeronSW_inspect [start_time] [end_time] [--files] [--data dir]\n"
+                  << "Time Format: yy-MM-dd-HH-mm-ss\n"
+                  << "--files : per-file frame counts and time ranges\n"
+                  << "--data  : recording directory (default " << UAM_DATA_PATH << ")" << std::endl;
+        return -1;
+    }
+
+    std::string uam_data_path = UAM_DATA_PATH;
+    bool per_file = false;
+    for(int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        if(arg == "--files")                        per_file = true;
+        else if(arg == "--data" && i + 1 < argc)    uam_data_path = argv[++i];
+        else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return -1;
+        }
+    }
+
+    if(!std::filesystem::exists(uam_data_path)) {
+        std::cerr << "UAM data directory is not found: " << uam_data_path << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> lidar_files, detectinfo_files;
+    if(!RecordingFiles::collect(uam_data_path, argv[1], argv[2], lidar_files, detectinfo_files)) {
+        return 1;
+    }
+
+    RecordingInspector inspector;
+    bool ok = inspector.run(lidar_files, detectinfo_files);
+    inspector.print(std::cout, per_file);
+
+    std::cout << "Scanned " << lidar_files.size() + detectinfo_files.size() << " files, read "
+              << std::fixed << std::setprecision(1) << inspector.getBytesRead() / (1024.0 * 1024.0) << " MB of headers / detections in "
+              << inspector.getElapsedMs() << " ms (" << WorkerPool::instance().size() << " workers)" << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+#include "kd_tree.h"
+
+#include <algorithm>
+
+#define KD_LEAF_SIZE    12      // leaf 하나의 최대 점 수
+#define KD_MAX_DEPTH    64      // 조회 스택 크기 (중앙값 분할이라 log2(n) + 1을 넘지 않음)
+
+
+void KdTree::build(const std::vector<glm::vec3>& points) {
+    clear();
+    if(points.empty()) {
+        return;
+    }
+    sorted_points = points;
+    point_index.resize(points.size());
+    for(uint32_t i = 0; i < point_index.size(); ++i) {
+        point_index[i] = i;
+    }
+    nodes.reserve(2 * (points.size() / KD_LEAF_SIZE + 1));
+    buildNode(0, static_cast<uint32_t>(points.size()));
+
+    std::vector<glm::vec3> ordered(points.size());
+    for(size_t i = 0; i < point_index.size(); ++i) {
+        ordered[i] = points[point_index[i]];
+    }
+    sorted_points.swap(ordered);
+}
+
+// point_index[first, first + count) 구간을 가장 넓은 축의 중앙값으로 나눔 (sorted_points는 분할 중 원래 순서 그대로 참조)
+uint32_t KdTree::buildNode(uint32_t first, uint32_t count) {
+    const uint32_t node_idx = static_cast<uint32_t>(nodes.size());
+    nodes.push_back(KdNode());
+
+    glm::vec3 bmin = sorted_points[point_index[first]];
+    glm::vec3 bmax = bmin;
+    for(uint32_t i = first + 1; i < first + count; ++i) {
+        bmin = glm::min(bmin, sorted_points[point_index[i]]);
+        bmax = glm::max(bmax, sorted_points[point_index[i]]);
+    }
+    glm::vec3 extent = bmax - bmin;
+
+    if(count <= KD_LEAF_SIZE || (extent.x == 0.0f && extent.y == 0.0f && extent.z == 0.0f)) {
+        nodes[node_idx].split = 0.0f;
+        nodes[node_idx].axis = 3;
+        nodes[node_idx].first = first;
+        nodes[node_idx].count = count;
+        return node_idx;
+    }
+
+    int axis = 0;
+    if(extent.y > extent[axis]) axis = 1;
+    if(extent.z > extent[axis]) axis = 2;
+
+    const uint32_t half = count / 2;
+    const std::vector<glm::vec3>& pts = sorted_points;
+    std::nth_element(point_index.begin() + first, point_index.begin() + first + half, point_index.begin() + first + count,
+                     [&pts, axis](uint32_t a, uint32_t b) { return pts[a][axis] < pts[b][axis]; });
+    const float split = pts[point_index[first + half]][axis];
+
+    buildNode(first, half);
+    const uint32_t right = buildNode(first + half, count - half);
+    nodes[node_idx].split = split;
+    nodes[node_idx].axis = static_cast<uint32_t>(axis);
+    nodes[node_idx].first = right;
+    nodes[node_idx].count = 0;
+    return node_idx;
+}
+
+void KdTree::clear() {
+    nodes.clear();
+    sorted_points.clear();
+    point_index.clear();
+}
+
+bool KdTree::empty() const {
+    return nodes.empty();
+}
+
+size_t KdTree::size() const {
+    return sorted_points.size();
+}
+
+
+int KdTree::nearest(const glm::vec3& query, float max_dist_sq, float& out_dist_sq) const {
+    if(nodes.empty()) {
+        return -1;
+    }
+
+    // (노드, 분할면까지 거리 제곱) 스택 - 가까운 쪽 먼저, 먼 쪽은 현재 최단거리보다 가까울 때만
+    struct Entry { uint32_t node; float plane_dist_sq; };
+    Entry stack[KD_MAX_DEPTH];
+    int top = 0;
+    stack[top++] = {0, 0.0f};
+
+    float best = max_dist_sq;
+    int best_idx = -1;
+    while(top > 0) {
+        const Entry entry = stack[--top];
+        if(entry.plane_dist_sq >= best) {
+            continue;
+        }
+        const KdNode* node = &nodes[entry.node];
+        uint32_t node_idx = entry.node;
+        while(node->axis != 3) {
+            const float diff = query[node->axis] - node->split;
+            const uint32_t near_child = (diff < 0.0f) ? node_idx + 1 : node->first;
+            const uint32_t far_child = (diff < 0.0f) ? node->first : node_idx + 1;
+            if(diff * diff < best && top < KD_MAX_DEPTH) {
+                stack[top++] = {far_child, diff * diff};
+            }
+            node_idx = near_child;
+            node = &nodes[node_idx];
+        }
+        for(uint32_t i = node->first; i < node->first + node->count; ++i) {
+            const glm::vec3 d = sorted_points[i] - query;
+            const float dist_sq = d.x * d.x + d.y * d.y + d.z * d.z;
+            if(dist_sq < best) {
+                best = dist_sq;
+                best_idx = static_cast<int>(i);
+            }
+        }
+    }
+
+    if(best_idx < 0) {
+        return -1;
+    }
+    out_dist_sq = best;
+    return static_cast<int>(point_index[best_idx]);
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+
+struct KdNode {
+    float split;        // inner : 분할 좌표
+    uint32_t axis;      // inner : 0 / 1 / 2, leaf : 3
+    uint32_t first;     // leaf : 첫 점 위치 / inner : 오른쪽 자식 노드 (왼쪽 = 현재 + 1)
+    uint32_t count;     // leaf 점 수
+};
+
+// 정적 점 집합 위의 3D kd-tree (중앙값 분할, leaf bucket) - 최근접 점 조회
+// 점은 트리 순서로 복사해 leaf 안 점들이 메모리상 연속 -> 조회 중 캐시 미스 감소
+// build 후 조회는 읽기 전용이라 여러 스레드에서 동시에 호출 가능
+class KdTree {
+public:
+    void build(const std::vector<glm::vec3>& points);
+    void clear();
+    bool empty() const;
+    size_t size() const;
+
+    // max_dist_sq 안의 최근접 점 (원래 points 인덱스), 없으면 -1
+    int nearest(const glm::vec3& query, float max_dist_sq, float& out_dist_sq) const;
+
+private:
+    uint32_t buildNode(uint32_t first, uint32_t count);
+
+    std::vector<KdNode> nodes;
+    std::vector<glm::vec3> sorted_points;
+    std::vector<uint32_t> point_index;      // 트리 순서 -> 원래 인덱스
+};
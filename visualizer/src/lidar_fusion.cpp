@@ -0,0 +1,233 @@
+#include "lidar_fusion.h"
+#include "parallel_utils.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+glm::mat4 LidarFusion::extrinsicMatrix(int sensor_id) {
+    glm::mat4 m(1.0f);
+    for(const LidarExtrinsic& e : lidar_extrinsics) {
+        if(e.sensor_id != sensor_id) {
+            continue;
+        }
+        // R = Rz(yaw) * Ry(pitch) * Rx(roll), 열 우선 (m[col][row])
+        const float d2r = 3.14159265358979f / 180.0f;
+        const float cr = std::cos(e.roll * d2r),  sr = std::sin(e.roll * d2r);
+        const float cp = std::cos(e.pitch * d2r), sp = std::sin(e.pitch * d2r);
+        const float cy = std::cos(e.yaw * d2r),   sy = std::sin(e.yaw * d2r);
+        m[0][0] = cy * cp;  m[1][0] = cy * sp * sr - sy * cr;   m[2][0] = cy * sp * cr + sy * sr;
+        m[0][1] = sy * cp;  m[1][1] = sy * sp * sr + cy * cr;   m[2][1] = sy * sp * cr - cy * sr;
+        m[0][2] = -sp;      m[1][2] = cp * sr;                  m[2][2] = cp * cr;
+        m[3][0] = e.x;
+        m[3][1] = e.y;
+        m[3][2] = e.z;
+        return m;
+    }
+    return m;
+}
+
+// LidarData는 20 bytes (x, y, z, reflectivity, cluster_id)라 SoA로 펼치는 비용이 곱셈보다 큼 -> 점 하나를 SSE 레지스터 하나로 변환
+// 16 bytes 읽기 = x, y, z, reflectivity, 결과의 4번째 lane은 원래 reflectivity 비트를 그대로 둠
+void LidarFusion::transformPoints(const LidarData* in, size_t count, const glm::mat4& m, LidarData* out) {
+#if defined(__SSE2__)
+    const __m128 c0 = _mm_setr_ps(m[0][0], m[0][1], m[0][2], 0.0f);
+    const __m128 c1 = _mm_setr_ps(m[1][0], m[1][1], m[1][2], 0.0f);
+    const __m128 c2 = _mm_setr_ps(m[2][0], m[2][1], m[2][2], 0.0f);
+    const __m128 t = _mm_setr_ps(m[3][0], m[3][1], m[3][2], 0.0f);
+    const __m128 xyz_mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    for(size_t i = 0; i < count; ++i) {
+        __m128 p = _mm_loadu_ps(&in[i].x);
+        __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_shuffle_ps(p, p, 0x00)), _mm_mul_ps(c1, _mm_shuffle_ps(p, p, 0x55))),
+                              _mm_add_ps(_mm_mul_ps(c2, _mm_shuffle_ps(p, p, 0xAA)), t));
+        r = _mm_or_ps(_mm_and_ps(xyz_mask, r), _mm_andnot_ps(xyz_mask, p));
+        int cluster_id = in[i].cluster_id;
+        _mm_storeu_ps(&out[i].x, r);
+        out[i].cluster_id = cluster_id;
+    }
+#else
+    for(size_t i = 0; i < count; ++i) {
+        const float x = in[i].x, y = in[i].y, z = in[i].z;
+        LidarData p = in[i];
+        p.x = m[0][0] * x + m[1][0] * y + m[2][0] * z + m[3][0];
+        p.y = m[0][1] * x + m[1][1] * y + m[2][1] * z + m[3][1];
+        p.z = m[0][2] * x + m[1][2] * y + m[2][2] * z + m[3][2];
+        out[i] = p;
+    }
+#endif
+}
+
+void LidarFusion::sensorColor(size_t slot, glm::vec3& out_color) {
+    static const glm::vec3 palette[] = {
+        {0.0f, 0.9f, 0.4f}, {1.0f, 0.6f, 0.0f}, {0.2f, 0.6f, 1.0f}, {1.0f, 0.2f, 0.6f},
+        {0.9f, 0.9f, 0.1f}, {0.6f, 0.3f, 1.0f}, {0.1f, 0.9f, 0.9f}, {0.9f, 0.9f, 0.9f}
+    };
+    out_color = palette[slot % (sizeof(palette) / sizeof(palette[0]))];
+}
+
+
+void LidarFusion::build(const std::vector<int>& sensor_ids, std::vector<std::vector<LidarBinary>>& sensor_frames,
+                        std::vector<LidarBinary>& out_frames) {
+    MyTimer timer;
+    out_frames.clear();
+    begin(sensor_ids);
+    if(!slot_src.empty()) {
+        out_frames = std::move(sensor_frames[slot_src[0]]);
+    }
+
+    std::vector<uint32_t> batch_offsets;
+    std::vector<size_t> batch_matched;
+    fuse(out_frames, sensor_frames, batch_offsets, batch_matched, workerCount());
+    commit(out_frames, batch_offsets, batch_matched);
+    sensor_frames.clear();
+
+    timer.end();
+    elapsed_ms = std::chrono::duration<double, std::milli>(timer.end_time - timer.start_time).count();
+}
+
+
+size_t LidarFusion::referenceSensor(const std::vector<int>& sensor_ids) {
+    for(size_t s = 0; s < sensor_ids.size(); ++s) {
+        if(sensor_ids[s] == LIDAR_ID) return s;
+    }
+    return 0;
+}
+
+void LidarFusion::begin(const std::vector<int>& sensor_ids) {
+    slot_sensor_ids.clear();
+    slot_src.clear();
+    matrices.clear();
+    offsets.clear();
+    frames_begin = nullptr;
+    frame_count = 0;
+    elapsed_ms = 0.0;
+
+    // slot 0 = 기준 센서 (LIDAR_ID, 없으면 첫 센서), 나머지는 id 순
+    const size_t ref = referenceSensor(sensor_ids);
+    if(!sensor_ids.empty()) slot_src.push_back(ref);
+    for(size_t s = 0; s < sensor_ids.size(); ++s) {
+        if(s != ref) slot_src.push_back(s);
+    }
+    for(size_t src : slot_src) {
+        slot_sensor_ids.push_back(sensor_ids[src]);
+        matrices.push_back(extrinsicMatrix(sensor_ids[src]));
+    }
+    matched_sweeps.assign(slot_src.size(), 0);
+}
+
+void LidarFusion::fuse(std::vector<LidarBinary>& ref_frames, const std::vector<std::vector<LidarBinary>>& sensor_frames,
+                       std::vector<uint32_t>& out_offsets, std::vector<size_t>& out_matched, size_t workers) const {
+    const size_t slots = slot_src.size();
+    const size_t frames = ref_frames.size();
+    out_matched.assign(slots, 0);
+    out_offsets.clear();
+    if(slots == 0) {
+        return;
+    }
+    out_matched[0] = frames;
+
+    // 다른 센서마다 기준 스윕 시간에 가장 가까운 스윕 (시간순 이분 탐색)
+    std::vector<std::vector<int32_t>> match(slots);
+    for(size_t k = 1; k < slots; ++k) {
+        const std::vector<LidarBinary>& list = sensor_frames[slot_src[k]];
+        match[k].assign(frames, -1);
+        for(size_t f = 0; f < frames; ++f) {
+            const uint64_t t = ref_frames[f].time;
+            auto it = std::lower_bound(list.begin(), list.end(), t, [](const LidarBinary& frame, uint64_t time) {
+                return frame.time < time;
+            });
+            int32_t best = -1;
+            uint64_t best_diff = std::numeric_limits<uint64_t>::max();
+            if(it != list.end()) {
+                best = static_cast<int32_t>(it - list.begin());
+                best_diff = it->time - t;
+            }
+            if(it != list.begin()) {
+                uint64_t diff = t - (it - 1)->time;
+                if(diff <= best_diff) {
+                    best = static_cast<int32_t>(it - 1 - list.begin());
+                    best_diff = diff;
+                }
+            }
+            if(best >= 0 && best_diff <= FUSION_MAX_TIME_DIFF) {
+                match[k][f] = best;
+                ++out_matched[k];
+            }
+        }
+    }
+
+    // 프레임별 센서 구간
+    out_offsets.assign(frames * (slots + 1), 0);
+    for(size_t f = 0; f < frames; ++f) {
+        uint32_t* off = &out_offsets[f * (slots + 1)];
+        uint32_t pos = static_cast<uint32_t>(ref_frames[f].lidar_data.size());
+        off[0] = 0;
+        for(size_t k = 1; k < slots; ++k) {
+            off[k] = pos;
+            if(match[k][f] >= 0) pos += static_cast<uint32_t>(sensor_frames[slot_src[k]][match[k][f]].lidar_data.size());
+        }
+        off[slots] = pos;
+    }
+
+    // 변환 + 이어 붙이기 (프레임 단위 병렬)
+    const bool ref_identity = (matrices[0] == glm::mat4(1.0f));
+    parallelFor(frames, 1, workers, [&](size_t begin, size_t end, size_t) {
+        for(size_t f = begin; f < end; ++f) {
+            LidarBinary& frame = ref_frames[f];
+            const uint32_t* off = &out_offsets[f * (slots + 1)];
+            if(!ref_identity) {
+                transformPoints(frame.lidar_data.data(), frame.lidar_data.size(), matrices[0], frame.lidar_data.data());
+            }
+            if(slots < 2) continue;
+            frame.lidar_data.resize(off[slots]);
+            for(size_t k = 1; k < slots; ++k) {
+                if(match[k][f] < 0) continue;
+                const std::vector<LidarData>& src = sensor_frames[slot_src[k]][match[k][f]].lidar_data;
+                transformPoints(src.data(), src.size(), matrices[k], frame.lidar_data.data() + off[k]);
+            }
+            frame.num = static_cast<uint32_t>(frame.lidar_data.size());
+        }
+    });
+}
+
+void LidarFusion::commit(const std::vector<LidarBinary>& out_frames, const std::vector<uint32_t>& batch_offsets,
+                         const std::vector<size_t>& batch_matched, double batch_ms) {
+    elapsed_ms += batch_ms;
+    offsets.insert(offsets.end(), batch_offsets.begin(), batch_offsets.end());
+    for(size_t k = 0; k < batch_matched.size() && k < matched_sweeps.size(); ++k) {
+        matched_sweeps[k] += batch_matched[k];
+    }
+    frames_begin = out_frames.data();
+    frame_count = out_frames.size();
+}
+
+
+size_t LidarFusion::getSensorCount() const {
+    return slot_sensor_ids.size();
+}
+
+int LidarFusion::getSensorId(size_t slot) const {
+    return slot_sensor_ids[slot];
+}
+
+size_t LidarFusion::getMatchedSweeps(size_t slot) const {
+    return matched_sweeps[slot];
+}
+
+bool LidarFusion::getSensorRange(const LidarBinary& frame, size_t slot, size_t& begin, size_t& end) const {
+    if(frames_begin == nullptr || &frame < frames_begin || &frame >= frames_begin + frame_count || slot >= slot_sensor_ids.size()) {
+        return false;
+    }
+    const size_t f = static_cast<size_t>(&frame - frames_begin);
+    begin = offsets[f * (slot_sensor_ids.size() + 1) + slot];
+    end = offsets[f * (slot_sensor_ids.size() + 1) + slot + 1];
+    return true;
+}
+
+double LidarFusion::getElapsedMs() const {
+    return elapsed_ms;
+}
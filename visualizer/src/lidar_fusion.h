@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "configs.h"
+#include "binary_utils.h"
+
+
+// 여러 라이다(lidar_N_*.uld) 스윕을 기준 센서(LIDAR_ID) 시간축에 맞춰 공통 좌표계 프레임 하나로 합침 (로드 시 1회)
+// 기준 스윕마다 다른 센서의 가장 가까운 스윕(FUSION_MAX_TIME_DIFF 안)을 configs.h lidar_extrinsics로 변환해 뒤에 이어 붙임
+// 합친 프레임 안 점은 센서 순서대로 연속 -> 센서별 구간(getSensorRange)으로 따로 그리거나 색 구분
+// 비용은 센서별 (점 수 + log 스윕 수) 합 -> 센서 수에 선형, 프레임 단위 병렬
+class LidarFusion {
+public:
+    // sensor_frames[s] : sensor_ids[s] 센서의 시간순 스윕, 처리 후 비워짐 (기준 센서 점 버퍼는 복사 없이 이동)
+    void build(const std::vector<int>& sensor_ids, std::vector<std::vector<LidarBinary>>& sensor_frames,
+               std::vector<LidarBinary>& out_frames);
+
+    // 점진 로드 (progressive_loader.h) : begin 후 기준 스윕 묶음마다 fuse (로드 스레드) -> commit (메인 스레드), build도 같은 순서
+    void begin(const std::vector<int>& sensor_ids);
+    // ref_frames(기준 센서 스윕)에 제자리에서 다른 센서 스윕을 합치고 프레임별 센서 구간 / 묶인 스윕 수를 돌려줌
+    // sensor_frames[s] : sensor_ids[s] 센서의 시간순 스윕 (기준 센서 자리는 사용 안 함)
+    //   기준 스윕 시간 +- FUSION_MAX_TIME_DIFF 안의 스윕을 모두 담고 있으면 녹화 전체로 build한 결과와 같음
+    // begin 이후 읽기만 하므로 commit과 다른 스레드에서 호출 가능, workers 1이면 호출 스레드에서만 처리
+    void fuse(std::vector<LidarBinary>& ref_frames, const std::vector<std::vector<LidarBinary>>& sensor_frames,
+              std::vector<uint32_t>& out_offsets, std::vector<size_t>& out_matched, size_t workers) const;
+    // fuse한 묶음이 out_frames 끝에 붙은 뒤 호출 - out_frames는 이후 재할당되지 않아야 함 (getSensorRange 포인터 비교)
+    // batch_ms : 호출자가 잰 fuse 시간 (getElapsedMs에 누적)
+    void commit(const std::vector<LidarBinary>& out_frames, const std::vector<uint32_t>& batch_offsets,
+                const std::vector<size_t>& batch_matched, double batch_ms = 0.0);
+    static size_t referenceSensor(const std::vector<int>& sensor_ids);     // sensor_ids 안 기준 센서 위치 (LIDAR_ID, 없으면 0)
+
+    size_t getSensorCount() const;
+    int getSensorId(size_t slot) const;             // slot 0 = 기준 센서
+    size_t getMatchedSweeps(size_t slot) const;     // 기준 스윕과 묶인 스윕 수
+    // build 결과 프레임 안에서 slot 센서 점 구간 [begin, end), 다른 프레임이면 false
+    bool getSensorRange(const LidarBinary& frame, size_t slot, size_t& begin, size_t& end) const;
+    double getElapsedMs() const;
+
+    static glm::mat4 extrinsicMatrix(int sensor_id);    // 설정 없으면 단위 행렬
+    // 점 좌표 변환 커널 (in == out 가능), reflectivity / cluster_id는 그대로
+    static void transformPoints(const LidarData* in, size_t count, const glm::mat4& m, LidarData* out);
+    static void sensorColor(size_t slot, glm::vec3& out_color);
+
+private:
+    std::vector<int> slot_sensor_ids;
+    std::vector<size_t> slot_src;           // slot -> sensor_ids 위치
+    std::vector<glm::mat4> matrices;        // slot별 외부 파라미터
+    std::vector<size_t> matched_sweeps;
+    std::vector<uint32_t> offsets;          // 프레임마다 (센서 수 + 1)개 시작 위치
+    const LidarBinary* frames_begin = nullptr;
+    size_t frame_count = 0;
+    double elapsed_ms = 0.0;
+};
@@ -0,0 +1,24 @@
+#include "lidar_soa.h"
+
+
+void LidarSoA::load(const LidarBinary& frame) {
+    const auto& points = frame.lidar_data;
+    size = points.size();
+
+    // 크기가 커질 때만 재할당 발생
+    if(x.size() < size) {
+        x.resize(size);
+        y.resize(size);
+        z.resize(size);
+        reflectivity.resize(size);
+        cluster_id.resize(size);
+    }
+
+    for(size_t i = 0; i < size; ++i) {
+        x[i] = points[i].x;
+        y[i] = points[i].y;
+        z[i] = points[i].z;
+        reflectivity[i] = static_cast<float>(points[i].reflectivity);
+        cluster_id[i] = points[i].cluster_id;
+    }
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include "binary_utils.h"
+
+
+// 라이다 프레임을 SoA(Structure of Arrays)로 펼친 버퍼
+// LidarData(AoS, 20byte stride)는 벡터화가 어려우므로 처리 커널 입력 전에 x/y/z/반사도 배열로 분리
+// resize만 하고 해제하지 않으므로 프레임이 바뀌어도 capacity 재사용
+struct LidarSoA {
+    std::vector<float> x, y, z;
+    std::vector<float> reflectivity;
+    std::vector<int> cluster_id;
+    size_t size = 0;
+
+    void load(const LidarBinary& frame);
+};
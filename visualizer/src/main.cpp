@@ -11,27 +11,47 @@
 #include <vector>
 #include <algorithm>
 #include <chrono>
+#include <cstdlib>
 
 #include "camera.h"
 #include "space.h"
 #include "configs.h"
 #include "binary_utils.h"
+#include "timeline.h"
+#include "panorama.h"
+#include "density_map.h"
+#include "timeline_stats.h"
+#include "recording_files.h"
+#include "detection_index.h"
+#include "picker.h"
+#include "alloc_counter.h"
+#include "profiler.h"
+#include "profiler_hud.h"
+#include "lidar_fusion.h"
+#include "scan_registration.h"
+#include "camera_path.h"
+#include "compact_lidar.h"
+#include "progressive_loader.h"
+#include "viewport_layout.h"
 
 #define WINDOW          1
+#define PANORAMA        1       // 파노라마(범위 이미지) 창
 #define PRINT_VAL       0
 #define TIMELINE        1
 #define BINARY_SEARCH   2
 int mode = TIMELINE;
 #define FRAME_RATE      5      // 초당 프레임 수(Hz)
-
-// 비정상 time 값 필터링
-#define MIN_VALID_TIME      1577836800000ULL    // 2020년 1월 1일
-#define MAX_VALID_TIME      1893456000000ULL    // 2030년 1월 1일
     
 // Globals
 Camera camera;
 Space space;
-BinaryUtils binaryutils;
+Panorama panorama;
+CompactLidarStore compact_store;    // --compact (density_map / 정합 백그라운드 스레드보다 늦게 소멸)
+DensityMap density_map;
+TimelineStats timeline_stats;
+Picker picker;
+ProfilerHud profiler_hud;
+ViewportLayout view_layout;         // 보기 1 / 2 / 4개 (v 키 / --views)
 
 bool leftMousePressed = false;
 double lastMouseX = 0.0, lastMouseY = 0.0;
@@ -59,13 +79,53 @@ int print_current = 1;
 int print_current_lidar = 1;
 int print_current_obj = 1;
 
+// density map click (callback -> main loop)
+int map_click_pending = 0;
+double map_click_x = 0.0, map_click_y = 0.0;
+
+// timeline strip click (callback -> main loop)
+int strip_click_pending = 0;
+size_t strip_click_entry = 0;
+
+// ray picking (right click -> main loop)
+int pick_pending = 0;
+double pick_x = 0.0, pick_y = 0.0;
+
+// panorama window close button (callback -> main loop) : 창은 숨기고 세션은 계속
+int panorama_closed = 0;
+
+// association table export (e key -> main loop)
+int export_pending = 0;
+
+// detection query hits (n / b key -> main loop)
+int find_step = 0;      // +1 : 다음 hit, -1 : 이전 hit
+
+uint64_t last_frame_allocs = 0;     // 직전 프레임 힙 할당 횟수 (space bar 출력)
+
+// scripted flythrough (--flythrough 재생 / --record-path 녹화)
+CameraPath fly_path;
+CameraPath record_path;
+bool flythrough = false;
+bool recording_path = false;
+size_t loop_frame = 0;      // 메인 루프 바퀴 수 (경로 frame 번호)
+
+// 경로 파일 키 이름 <-> GLFW 키
+struct NamedKey {
+    int key;
+    const char* name;
+};
+static const NamedKey named_keys[] = {
+    {GLFW_KEY_SPACE, "space"}, {GLFW_KEY_PAGE_UP, "pageup"}, {GLFW_KEY_PAGE_DOWN, "pagedown"},
+};
+const char* keyName(int key);
+int keyFromName(const std::string& name);
+
 // argument callback function
 void printHowToUse();
-std::string getFileExtension(const std::string& fileName);
-std::string removeFileExtension(const std::string& fileName);
 
 // Function Prototypes
 void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
+void panoramaCloseCallback(GLFWwindow* window);
 void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
 void cursorPosCallback(GLFWwindow* window, double xpos, double ypos);
 void scrollCallback(GLFWwindow* window, double xoffset, double yoffset);
@@ -80,7 +140,7 @@ int main(int argc, char* argv[]) {
         return -1;
     }
 
-    std::string uam_data_path = "../../data/uam_data";
+    std::string uam_data_path = UAM_DATA_PATH;
 
     // 디렉토리 존재 확인
     if(!std::filesystem::exists(uam_data_path)) {
@@ -91,112 +151,70 @@ int main(int argc, char* argv[]) {
     std::string start_time = argv[1];
     std::string end_time = argv[2];
 
-    std::vector<std::string> get_lidar_filename;      // 불러온 파일들 벡터
+    std::vector<int> lidar_sensor_ids;                          // 라이다 센서 (lidar_[id]_*.uld)
+    std::vector<std::vector<std::string>> get_lidar_filename;   // 불러온 파일들 벡터 (센서별)
     std::vector<std::string> get_detectinfo_filename;
 
-    for(const auto& entry : std::filesystem::directory_iterator(uam_data_path)) {
-        std::string filename = entry.path().filename().string();  // 파일 이름만 추출
-        
-        if(getFileExtension(filename) == "uld") {
-            std::string lidar_start_time = "lidar_0_" + start_time;
-            std::string lidar_end_time = "lidar_0_" + end_time;
-
-            std::string _filename = removeFileExtension(filename);
-
-            if(_filename >= lidar_start_time && _filename <= lidar_end_time) {
-                get_lidar_filename.push_back(uam_data_path + "/" + filename);
-            }
-        }
-        else if(getFileExtension(filename) == "udd") {
-            std::string detectinfo_start_time = "detectinfo_" + start_time;
-            std::string detectinfo_end_time = "detectinfo_" + end_time;
-
-            std::string _filename = removeFileExtension(filename);
+    if(!RecordingFiles::collectSensors(uam_data_path, start_time, end_time, lidar_sensor_ids, get_lidar_filename, get_detectinfo_filename)) {
+        return 0;
+    }
 
-            if(_filename >= detectinfo_start_time && _filename <= detectinfo_end_time) {
-                get_detectinfo_filename.push_back(uam_data_path + "/" + filename);
+    // 선택 인자 : --find [query] -> 검출 역색인 조회 결과를 n / b 키로 이동
+    //           --trace (file) -> 로딩부터 종료까지 단계별 시간을 Chrome trace JSON으로 저장
+    //           --flythrough [path] (--fly-out file.json) -> 경로 파일대로 카메라 / 키 입력을 고정 시간 간격으로 재생하며 프레임 시간 측정
+    //           --record-path [path] -> 조작한 카메라 / 키 입력을 경로 파일로 저장
+    //           --compact -> 라이다 점을 점당 9 bytes로 양자화해 메모리에 두고 화면에 올리는 프레임만 복원
+    //           --roi -> 로드하면서 관심 영역(configs.h ROI_*) 밖 점을 버림 (ROI_FILTER 1이면 항상)
+    //           --views [1|2|4] -> 시작 보기 수 (orbit / top / side / front, 실행 중 v 키로 변경)
+    std::string find_query_text;
+    std::string trace_filename;
+    std::string fly_path_filename, fly_out_filename = FLY_DEFAULT_RESULT_FILE, record_path_filename;
+    bool compact_lidar = false;
+    bool roi_filter = ROI_FILTER;
+    for(int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        if(arg == "--find" && i + 1 < argc) {
+            find_query_text = argv[++i];
+        } else if(arg == "--trace") {
+            trace_filename = PROFILE_TRACE_DEFAULT_FILE;
+            if(i + 1 < argc && std::string(argv[i + 1]).rfind("--", 0) != 0) {
+                trace_filename = argv[++i];
             }
+        } else if(arg == "--flythrough" && i + 1 < argc) {
+            fly_path_filename = argv[++i];
+        } else if(arg == "--fly-out" && i + 1 < argc) {
+            fly_out_filename = argv[++i];
+        } else if(arg == "--record-path" && i + 1 < argc) {
+            record_path_filename = argv[++i];
+        } else if(arg == "--compact") {
+            compact_lidar = true;
+        } else if(arg == "--roi") {
+            roi_filter = true;
+        } else if(arg == "--views" && i + 1 < argc) {
+            view_layout.setViewCount(std::max(std::atoi(argv[++i]), 1));
         }
-        else {
-            std::cout << "Error: file extension is not .uld or .udd" << std::endl;
-            return 0;
+    }
+    if(!fly_path_filename.empty()) {
+        if(!fly_path.load(fly_path_filename)) {
+            return 1;
         }
+        flythrough = true;
+        std::cout << "[Flythrough] " << fly_path_filename << ": " << fly_path.getFrameCount() << " frames, step "
+                  << fly_path.getStepMs() << " ms, " << fly_path.getKeys().size() << " key inputs" << std::endl;
+    }
+    recording_path = !record_path_filename.empty() && !flythrough;
+    if(!trace_filename.empty()) {
+        Profiler::startTrace();
     }
 
-    std::sort(get_lidar_filename.begin(), get_lidar_filename.end());    // 불러온 파일들 시간순 정렬
-    std::sort(get_detectinfo_filename.begin(), get_detectinfo_filename.end());
-
-
-    //============================= read binary files =================================
-    BinaryUtils utils;
-    std::vector<LidarBinary> lidar_loaded_bin;    // 여러 프레임
-    std::vector<ObjBinary> obj_loaded_bin;
-
-    for(const std::string& name : get_lidar_filename) {
-        std::cout << "Loaded filename: " << name << std::endl;
-#if PRINT_VAL
-        lidar_loaded_bin.clear();
-#endif
-        if(utils.load_lidar_binary(name, lidar_loaded_bin)) {
-#if PRINT_VAL
-            for(const auto& data : lidar_loaded_bin) {
-
-                std::string time_str = space.formatUnixTime(data.time);
 
-                std::cout << "Loaded binary time: " << data.time << " / " << time_str << std::endl;
-                std::cout << "Loaded num: " << data.num << std::endl;
-                // int i=0;
-                // for(const auto& _data : data.lidar_data) {
-                    
-                //     std::cout << i << " x: " << _data.x
-                //                     << ", y: " << _data.y
-                //                     << ", z: " << _data.z
-                //                     << ", reflectivity: " << _data.reflectivity
-                //                     << ", cluster_id: " << _data.cluster_id
-                //                     << std::endl;
-                //     i++;
-                // }
-            }
-#endif
-            std::cout << "Lidar data loaded" << std::endl;
+    for(size_t sensor = 0; sensor < lidar_sensor_ids.size(); ++sensor) {
+        for(const std::string& name : get_lidar_filename[sensor]) {
+            std::cout << "Loaded filename: " << name << std::endl;
         }
     }
-
     for(const std::string& name : get_detectinfo_filename) {
         std::cout << "Loaded filename: " << name << std::endl;
-#if PRINT_VAL
-        obj_loaded_bin.clear();
-#endif
-        if(utils.load_obj_binary(name, obj_loaded_bin)) {
-#if PRINT_VAL
-            for(const auto& data : obj_loaded_bin) {
-
-                std::string time_str = space.formatUnixTime(data.time);
-                
-                std::cout << "Loaded binary time: " << data.time << " / " << time_str << std::endl;
-                std::cout << "Loaded num: " << data.num << std::endl;
-                int i=0;
-                for(const auto& _data : data.obj_data) {
-                    
-                    std::cout << i << " obj_id: " << _data.obj_id
-                                    << ", nearest_x: " << _data.nearest_x
-                                    << ", nearest_y: " << _data.nearest_y
-                                    << ", nearest_z: " << _data.nearest_z
-                                    << ", min_x: " << _data.min_x
-                                    << ", min_y: " << _data.min_y
-                                    << ", min_z: " << _data.min_z
-                                    << ", max_x: " << _data.max_x
-                                    << ", max_y: " << _data.max_y
-                                    << ", max_z: " << _data.max_z
-                                    << ", distance: " << _data.distance
-                                    << ", size: " << _data.size
-                                    << std::endl;
-                    i++;
-                }
-            }
-#endif
-            std::cout << "ObjectInfo data loaded" << std::endl;
-        }
     }
 
     /**** time util ****/
@@ -210,6 +228,9 @@ int main(int argc, char* argv[]) {
         return -1;
     }
 
+    if (flythrough) {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);  // 측정 중 창 표시 / 입력 없음 (Mesa 등 headless 환경에서도 동일)
+    }
     GLFWwindow* window = glfwCreateWindow(WINDOW_WIDTH, WINDOW_HEIGHT, "Orbiting Camera", nullptr, nullptr);
     if (!window) {
         std::cerr << "Failed to create GLFW window" << std::endl;
@@ -225,6 +246,9 @@ int main(int argc, char* argv[]) {
     }
 
     setupViewport(WINDOW_WIDTH, WINDOW_HEIGHT);
+    if (flythrough) {
+        glfwSwapInterval(0);        // vsync 대기가 프레임 시간에 섞이지 않도록
+    }
 
     // Enable depth testing
     glEnable(GL_DEPTH_TEST);
@@ -235,82 +259,211 @@ int main(int argc, char* argv[]) {
     glfwSetCursorPosCallback(window, cursorPosCallback);
     glfwSetScrollCallback(window, scrollCallback);
 
+#if PANORAMA
+    GLFWwindow* panorama_window = glfwCreateWindow(PANORAMA_WINDOW_WIDTH, PANORAMA_WINDOW_HEIGHT, "Panorama", nullptr, nullptr);
+    if (!panorama_window) {
+        std::cerr << "Failed to create panorama window" << std::endl;
+    } else {
+        glfwSetKeyCallback(panorama_window, keyCallback);     // 파노라마 창에서도 같은 키 조작
+        glfwSetWindowUserPointer(panorama_window, window);    // ESC는 메인 창을 닫음 (메인 루프는 메인 창만 확인)
+        glfwSetWindowCloseCallback(panorama_window, panoramaCloseCallback);
+        glfwMakeContextCurrent(panorama_window);
+        glfwSwapInterval(0);        // 메인 창 swap과 vsync 대기가 겹치지 않도록
+        glfwMakeContextCurrent(window);
+    }
+#endif
 
-    /**** Main loop ****/ 
 
-    std::cout << "==================================================" << std::endl;
-    std::cout << "Lidar frame num: " << lidar_loaded_bin.size() << std::endl;      // 라이다 프레임 총 개수
-    std::cout << "Detection data set num: " << obj_loaded_bin.size() << std::endl;  // 객체 인식 데이터셋 총 개수
-    std::cout << "==================================================" << std::endl;
+    //============================= read binary files (progressive) =================================
+    // 창을 먼저 띄우고 로드 스레드가 녹화를 LOAD_CHUNK_MS 구간 단위로 병합 / 융합 -> 메인 루프가 구간씩 받아 첫 구간부터 재생
+    // 파일마다 시간순 run 하나로 보고 병합 (겹치거나 재시작한 녹화 파일의 순서 뒤바뀜 / 중복 프레임 정리)
+    std::vector<LidarBinary> lidar_loaded_bin;    // 여러 프레임 (첫 구간을 받을 때 헤더 수만큼 reserve -> 로드 중 재할당 없음)
+    std::vector<ObjBinary> obj_loaded_bin;
+    LidarFusion lidar_fusion;       // 멀티 라이다 융합 - 기준 센서(LIDAR_ID) 스윕마다 다른 센서 스윕을 외부 파라미터로 변환해 합침
+    space.setLidarFusion(&lidar_fusion);
+    LidarRoi roi;                   // 센서 좌표 기준 (융합 전)
+    ProgressiveLoader loader;       // 종료 시 로드 중이면 중단
+    loader.start(lidar_sensor_ids, get_lidar_filename, get_detectinfo_filename, roi_filter ? &roi : nullptr, compact_lidar);
 
+    // --compact : 로드 스레드가 점 배열을 압축해 넘기고 원본은 버림 (time / num은 유지, 화면에 올리는 프레임만 materialize로 복원)
+    // lidar_loaded_bin[i].lidar_data는 메인 스레드의 표시 프레임 외에는 비어 있음 -> 백그라운드 처리는 저장소에서 복원
+    const CompactLidarStore* compact = compact_lidar ? &compact_store : nullptr;
 
-    // 이진탐색 방식 - 객체 기준 매칭 테이블 생성
+    // 구간을 받을 때마다 이어 붙이는 표 - 이진탐색 방식 객체 기준 매칭, 타임라인, 프레임 인덱스 -> 타임라인 인덱스 (밀도 지도 클릭 이동용)
     std::vector<int> obj_to_lidar_mapping;
-    if(!lidar_loaded_bin.empty() && !obj_loaded_bin.empty()) {
-        // 모든 객체 프레임에 대해 가장 가까운 라이다 프레임 인덱스를 매핑
-        obj_to_lidar_mapping.resize(obj_loaded_bin.size());
-        for(size_t i = 0; i < obj_loaded_bin.size(); ++i) {
-            obj_to_lidar_mapping[i] = binaryutils.findClosestLidarFrame(obj_loaded_bin[i].time, lidar_loaded_bin);
-        }
-        std::cout << "Object-to-Lidar mapping created successfully" << std::endl;
-    }
-    
-
-    // 타임라인 방식
     std::vector<UnifiedData> timeline;
+    std::vector<size_t> lidar_to_timeline, obj_to_timeline;     // 타임라인에서 빠진 프레임은 max
     size_t lidar_idx = 0;
-    size_t obj_idx = 0;
+    size_t timeline_idx = 0;
     MyTimer timer;
 
-    // 비정상 time 값 원인: 타임라인 생성시 벡터 인덱스 초과 -> 라이다와 객체인식 데이터가 범위 내 정상 시간인지 확인
-    while(lidar_idx < lidar_loaded_bin.size() || obj_idx < obj_loaded_bin.size()) {
-        bool valid_obj = (obj_idx < obj_loaded_bin.size() && 
-                            obj_loaded_bin[obj_idx].time >= MIN_VALID_TIME && 
-                            obj_loaded_bin[obj_idx].time <= MAX_VALID_TIME);
-        bool valid_lidar = (lidar_idx < lidar_loaded_bin.size() && 
-                            lidar_loaded_bin[lidar_idx].time >= MIN_VALID_TIME && 
-                            lidar_loaded_bin[lidar_idx].time <= MAX_VALID_TIME);
-
-        if(!valid_obj && valid_lidar) {
-            timeline.push_back({DataType::LIDAR, lidar_idx++});
-            continue;
+    // 녹화 전체가 필요한 처리는 로드가 끝난 뒤 백그라운드에서 (객체 추적 / 검출 역색인은 analysis_thread, 밀도 지도 / 통계 / 정합은 각자 스레드)
+    Tracker tracker;
+    DetectionIndex detection_index;
+    std::thread analysis_thread;
+    std::atomic<bool> analysis_ready(false);
+    bool analysis_applied = false;
+    ScanRegistration scan_registration;         // 백그라운드에서 스윕 간 ICP 정합 + 누적 지도 (lidar_loaded_bin보다 먼저 소멸 -> 종료 시 중단)
+    space.setScanRegistration(&scan_registration);
+
+    // --find 조회 결과 -> 타임라인 인덱스
+    std::vector<size_t> find_hits;
+    size_t find_hit_pos = std::numeric_limits<size_t>::max();     // 아직 이동 전
+
+    // 메인 루프 한 바퀴마다 : 준비된 구간 받기 (LOAD_POLL_BUDGET_MS 안) -> 표 이어 붙이기, 로드 / 전체 처리가 끝나면 결과 반영
+    auto pollLoad = [&]() {
+        if(!analysis_applied && analysis_ready.load()) {
+            analysis_applied = true;
+            space.setTracker(&tracker);
+            std::cout << "Tracks: " << tracker.getTrackCount() << " (" << tracker.getElapsedMs() << " ms)" << std::endl;
+            std::cout << "Detection index: " << detection_index.getPostingCount() << " postings (" << detection_index.getElapsedMs() << " ms)" << std::endl;
+            if(!find_query_text.empty()) {
+                DetectionQuery query;
+                if(DetectionIndex::parseQuery(find_query_text, query)) {
+                    MyTimer query_timer;
+                    std::vector<uint32_t> hit_frames;
+                    detection_index.find(query, hit_frames);
+                    query_timer.end();
+                    for(uint32_t f : hit_frames) {
+                        if(obj_to_timeline[f] != std::numeric_limits<size_t>::max()) find_hits.push_back(obj_to_timeline[f]);
+                    }
+                    std::cout << "[Find] " << find_query_text << ": " << find_hits.size() << " frames ("
+                              << std::chrono::duration<double, std::milli>(query_timer.end_time - query_timer.start_time).count() << " ms), n / b to jump" << std::endl;
+                }
+            }
+            return;
         }
-        if(!valid_lidar && valid_obj) {
-            timeline.push_back({DataType::OBJECT, obj_idx++});
-            continue;
+        if(loader.isComplete()) {
+            return;
         }
 
-        if(!valid_obj && !valid_lidar) {
-            ++obj_idx;
-            ++lidar_idx;
-            continue;
+        const size_t lidar_begin = lidar_loaded_bin.size(), obj_begin = obj_loaded_bin.size(), timeline_begin = timeline.size();
+        if(loader.poll(lidar_loaded_bin, obj_loaded_bin, lidar_fusion, compact_store)) {
+            Timeline::append(lidar_loaded_bin, obj_loaded_bin, lidar_begin, obj_begin, timeline);
+            Timeline::extendObjToLidarMapping(obj_loaded_bin, lidar_loaded_bin, loader.getLoadedUntil(), obj_to_lidar_mapping);
+            Timeline::appendReverseIndex(timeline, timeline_begin, lidar_loaded_bin.size(), obj_loaded_bin.size(), lidar_to_timeline, obj_to_timeline);
+#if PRINT_VAL
+            for(size_t i = timeline_begin; i < timeline.size(); ++i) {
+                const UnifiedData& entry = timeline[i];
+                if(entry.type == DataType::LIDAR) {
+                    std::string time_str = space.formatUnixTime(lidar_loaded_bin[entry.index].time);
+                    std::cout << "[" << i << "] lid idx = " << entry.index << ", time = " << lidar_loaded_bin[entry.index].time << " / " << time_str << std::endl;
+                }
+                else{
+                    std::string time_str = space.formatUnixTime(obj_loaded_bin[entry.index].time);
+                    std::cout << "[" << i << "] obj idx = " << entry.index << ", time = " << obj_loaded_bin[entry.index].time << " / " << time_str << std::endl;
+                }
+            }
+#endif
         }
-
-        if(obj_loaded_bin[obj_idx].time <= lidar_loaded_bin[lidar_idx].time) {
-            timeline.push_back({DataType::OBJECT, obj_idx++});
-        } else {
-            timeline.push_back({DataType::LIDAR, lidar_idx++});
+        if(!loader.isComplete()) {
+            timeline_stats.setLoadProgress(loader.getFraction(), timeline.size());
+            return;
         }
-    }
 
-    for(size_t i=0; i<timeline.size(); ++i) {
-        const UnifiedData& entry = timeline[i];
-        if(entry.type == DataType::LIDAR) {
-            std::string time_str = space.formatUnixTime(lidar_loaded_bin[entry.index].time);
-            std::cout << "[" << i << "] lid idx = " << entry.index << ", time = " << lidar_loaded_bin[entry.index].time << " / " << time_str << std::endl;
+        // 로드 끝 : 통계 출력 후 녹화 전체 처리 시작
+        timeline_stats.setLoadProgress(-1.0f, 0);
+        loader.printReport();
+        if(lidar_fusion.getSensorCount() > 1) {
+            std::cout << "Lidar fusion: " << lidar_fusion.getSensorCount() << " sensors (" << lidar_fusion.getElapsedMs() << " ms)" << std::endl;
+            for(size_t slot = 0; slot < lidar_fusion.getSensorCount(); ++slot) {
+                std::cout << "  lidar_" << lidar_fusion.getSensorId(slot) << " : " << lidar_fusion.getMatchedSweeps(slot)
+                          << " / " << lidar_loaded_bin.size() << " sweeps" << std::endl;
+            }
         }
-        else{
-            std::string time_str = space.formatUnixTime(obj_loaded_bin[entry.index].time);
-            std::cout << "[" << i << "] obj idx = " << entry.index << ", time = " << obj_loaded_bin[entry.index].time << " / " << time_str << std::endl;
+        std::cout << "==================================================" << std::endl;
+        std::cout << "Lidar frame num: " << lidar_loaded_bin.size() << std::endl;      // 라이다 프레임 총 개수
+        std::cout << "Detection data set num: " << obj_loaded_bin.size() << std::endl;  // 객체 인식 데이터셋 총 개수
+        std::cout << "Timeline entries: " << timeline.size() << std::endl;
+        std::cout << "==================================================" << std::endl;
+        if(!obj_to_lidar_mapping.empty()) {
+            std::cout << "Object-to-Lidar mapping created successfully" << std::endl;
+        }
+        if(compact != nullptr) {
+            compact_store.measureDecode();      // 복원 vs 원래 배치 복사 비교 (백그라운드 처리 시작 전)
+            compact_store.printReport();
         }
-    }
 
-    size_t timeline_idx = 0;
+        density_map.startBuild(lidar_loaded_bin, obj_loaded_bin, compact);   // 백그라운드에서 전체 구간 누적
+        timeline_stats.startBuild(timeline, lidar_loaded_bin, obj_loaded_bin);     // 백그라운드에서 항목별 통계
+        scan_registration.startBuild(lidar_loaded_bin, compact);
+        analysis_thread = std::thread([&]() {
+            tracker.build(obj_loaded_bin);              // 객체 추적 - 녹화 전체 track id / 궤적
+            detection_index.build(obj_loaded_bin);      // 검출 역색인 - 클래스별 시간순 / 거리순 posting
+            analysis_ready = true;
+        });
+    };
+
+    int map_cell_x = -1, map_cell_y = -1;
+    std::vector<size_t> map_hits;       // 선택 셀에 기여한 타임라인 인덱스
+    size_t map_hit_pos = 0;
+
+    auto timelineTime = [&](size_t i) {
+        return (timeline[i].type == DataType::LIDAR) ? lidar_loaded_bin[timeline[i].index].time : obj_loaded_bin[timeline[i].index].time;
+    };
+
+    // flythrough : 로드와 백그라운드 생성(추적 / 밀도 지도 / 통계 / 정합)이 끝난 뒤 측정 시작 -> 같은 경로면 같은 CPU 부하
+    std::vector<double> fly_frame_ms;
+    size_t fly_key_pos = 0;
+    size_t fly_views = view_layout.getViewCount();     // 측정 시작 시 보기 수 (결과 JSON)
+    if(flythrough) {
+        std::cout << "[Flythrough] waiting for loading and background builds..." << std::endl;
+        while(!(analysis_applied && density_map.isReady() && timeline_stats.isReady() && scan_registration.isReady())) {
+            pollLoad();
+            glfwPollEvents();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        fly_frame_ms.reserve(fly_path.getFrameCount());
+        fly_views = view_layout.getViewCount();
+    }
 
 
 #if WINDOW
     // 한 프레임씩 while문
     while (!glfwWindowShouldClose(window)) {
+        uint64_t frame_alloc_start = AllocCounter::count();
+        MyTimer frame_timer;
+
+        //============================= 점진 로드 : 준비된 구간 받기 / 녹화 전체 처리 결과 반영 =================================
+        PROFILE_BEGIN(load_probe, "load");
+        pollLoad();
+        PROFILE_END(load_probe);
+
+        //============================= 비행 경로 : 재생(키 입력 / 카메라 / 타임라인 위치) 또는 녹화 =================================
+        if(flythrough) {
+            const std::vector<PathKey>& keys = fly_path.getKeys();
+            for(; fly_key_pos < keys.size() && keys[fly_key_pos].frame <= loop_frame; ++fly_key_pos) {
+                int key = keyFromName(keys[fly_key_pos].key);
+                if(key != GLFW_KEY_UNKNOWN) keyCallback(window, key, 0, GLFW_PRESS, 0);
+            }
+            CameraPose pose;
+            fly_path.sample(loop_frame, pose);
+            orbitRadius = pose.radius;
+            horizontalAngle = glm::radians(pose.h_angle);
+            verticalAngle = glm::radians(pose.v_angle);
+            cameraPosition = glm::vec3(pose.pan_x, pose.pan_y, 0.0f);
+            cameraTarget = cameraPosition;
+
+            // 렌더 프레임마다 step ms씩 진행 (벽시계와 무관), 재생 / 프레임 이동 키는 무시
+            if(!timeline.empty()) {
+                uint64_t fly_time = timelineTime(0) + static_cast<uint64_t>(loop_frame * fly_path.getStepMs());
+                while(timeline_idx + 1 < timeline.size() && timelineTime(timeline_idx + 1) <= fly_time) {
+                    ++timeline_idx;
+                }
+            }
+            mode = TIMELINE;
+            video_control = 1;
+        }
+        else if(recording_path) {
+            CameraPose pose;
+            pose.radius = orbitRadius;
+            pose.h_angle = glm::degrees(horizontalAngle);
+            pose.v_angle = glm::degrees(verticalAngle);
+            pose.pan_x = cameraPosition.x;
+            pose.pan_y = cameraPosition.y;
+            record_path.record(loop_frame, pose);
+        }
+
         // Clear screen
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -329,9 +482,87 @@ int main(int argc, char* argv[]) {
         }
 
 
+        //============================= 박스별 라이다 통계 표 저장 =================================
+        PROFILE_BEGIN(input_probe, "input");
+        if(export_pending && !loader.isComplete()) {
+            export_pending = 0;
+            std::cout << "\n[Export] recording is still loading" << std::endl;
+        }
+        if(export_pending) {
+            export_pending = 0;
+            Association::exportCsv("association_" + start_time + "_" + end_time + ".csv",
+                                   obj_loaded_bin, lidar_loaded_bin, obj_to_lidar_mapping, compact);
+        }
+
+
+        //============================= 검출 조회 hit 이동 =================================
+        if(find_step != 0) {
+            if(!find_hits.empty()) {
+                if(find_hit_pos >= find_hits.size()) find_hit_pos = (find_step > 0) ? 0 : find_hits.size() - 1;
+                else if(find_step > 0)               find_hit_pos = (find_hit_pos + 1) % find_hits.size();
+                else                                 find_hit_pos = (find_hit_pos + find_hits.size() - 1) % find_hits.size();
+                timeline_idx = find_hits[find_hit_pos];
+                mode = TIMELINE;
+                video_control = 1;
+                print_current = 0;
+                std::cout << "\n[Find] hit " << find_hit_pos + 1 << "/" << find_hits.size() << " -> timeline_idx = " << timeline_idx << std::endl;
+            }
+            find_step = 0;
+        }
+
+
+        //============================= 타임라인 스트립 클릭 -> 재생 위치 이동 =================================
+        if(strip_click_pending) {
+            strip_click_pending = 0;
+            timeline_idx = strip_click_entry;
+            mode = TIMELINE;
+            video_control = 1;
+            timeline_stats.printEntry(timeline_idx);
+        }
+
+
+        //============================= 밀도 지도 클릭 -> 타임라인 이동 =================================
+        if(map_click_pending) {
+            map_click_pending = 0;
+            int cell_x, cell_y;
+            if(density_map.isReady() && density_map.screenToCell(map_click_x, map_click_y, cell_x, cell_y)) {
+                if(cell_x != map_cell_x || cell_y != map_cell_y) {
+                    // 새 셀 선택: 기여한 프레임 목록을 다시 수집
+                    std::vector<size_t> hit_lidar, hit_obj;
+                    density_map.collectCellFrames(cell_x, cell_y, hit_lidar, hit_obj);
+
+                    map_hits.clear();
+                    for(size_t f : hit_lidar) {
+                        if(lidar_to_timeline[f] != std::numeric_limits<size_t>::max()) map_hits.push_back(lidar_to_timeline[f]);
+                    }
+                    for(size_t f : hit_obj) {
+                        if(obj_to_timeline[f] != std::numeric_limits<size_t>::max()) map_hits.push_back(obj_to_timeline[f]);
+                    }
+                    std::sort(map_hits.begin(), map_hits.end());
+                    map_hit_pos = 0;
+                    map_cell_x = cell_x;
+                    map_cell_y = cell_y;
+                    density_map.setSelectedCell(cell_x, cell_y);
+                    std::cout << "\n[Map] cell (" << cell_x << ", " << cell_y << "): " << hit_lidar.size() << " lidar / "
+                              << hit_obj.size() << " obj frames" << std::endl;
+                } else if(!map_hits.empty()) {
+                    map_hit_pos = (map_hit_pos + 1) % map_hits.size();     // 같은 셀 다시 클릭 -> 다음 프레임
+                }
+
+                if(!map_hits.empty()) {
+                    timeline_idx = map_hits[map_hit_pos];
+                    mode = TIMELINE;
+                    video_control = 1;
+                    std::cout << "[Map] jump " << map_hit_pos + 1 << "/" << map_hits.size() << " -> timeline_idx = " << timeline_idx << std::endl;
+                }
+            }
+        }
+        PROFILE_END(input_probe);
+
+        PROFILE_BEGIN(select_probe, "select");
         timer.end();
         //============================= TIMELINE MODE =================================
-        if(mode == TIMELINE) {
+        if(mode == TIMELINE && !timeline.empty()) {     // 로드 중이면 받은 구간 끝에서 다음 구간을 기다림
             if((timer.elapsed_ms() >= new_ms_per_frame) && (video_control == 0)) {
                 if(timeline_idx + 1 < timeline.size()) {
                     ++timeline_idx;
@@ -356,14 +587,21 @@ int main(int argc, char* argv[]) {
             const UnifiedData& current = timeline[timeline_idx];
             
             if(current.type == DataType::LIDAR) {
+                compact_store.materialize(current.index, lidar_loaded_bin);     // --compact가 아니면 아무것도 안 함
                 const LidarBinary& current_lidar = lidar_loaded_bin[current.index];
                 space.clearLidarPoints();
                 space.clearObjPoints();     // obj box 그린 후 다음 프레임 넘어갔을 때 lidar 데이터 차례에 min, max, nearest 점들이 남아있는 것 삭제
                 space.lidarIntoSpace(current_lidar);
+                panorama.setLidarFrame(&current_lidar);
+                panorama.setObjFrame(nullptr, space);
 
                 if(print_current == 0) {
                     std::string time_str = space.formatUnixTime(current_lidar.time);
                     std::cout << "\n[Lidar] idx = " << current.index << ", time = " << current_lidar.time << " (" << time_str << "), num = " << current_lidar.num << std::endl;
+                    space.printProcessingInfo();
+                    if(compact != nullptr) {
+                        std::cout << "Compact decode: " << compact_store.getLastDecodeMs() << " ms" << std::endl;
+                    }
                     
                     print_current = 1;
                 }
@@ -384,12 +622,15 @@ int main(int argc, char* argv[]) {
                     }
                 }
                 if(lidar_to_display != -1) {
+                    compact_store.materialize(lidar_to_display, lidar_loaded_bin);
                     space.clearLidarPoints();
                     space.lidarIntoSpace(lidar_loaded_bin[lidar_to_display]);
+                    panorama.setLidarFrame(&lidar_loaded_bin[lidar_to_display]);
                 }
 
                 space.clearObjPoints();
                 space.objIntoSpace(current_obj);
+                panorama.setObjFrame(&current_obj, space);
 
                 if(print_current == 0) {
                     std::string time_str = space.formatUnixTime(current_obj.time);
@@ -424,7 +665,7 @@ int main(int argc, char* argv[]) {
         }
         
         //============================= BINARY SEARCH MODE =================================
-        else if(mode == BINARY_SEARCH) {
+        else if(mode == BINARY_SEARCH && !lidar_loaded_bin.empty()) {
             if((timer.elapsed_ms() >= new_ms_per_frame) && (video_control == 0)) {
                 if(lidar_idx + 1 < lidar_loaded_bin.size()) {
                     ++lidar_idx;
@@ -446,13 +687,19 @@ int main(int argc, char* argv[]) {
                 video_control = 1;
             }
 
+            compact_store.materialize(lidar_idx, lidar_loaded_bin);
             const LidarBinary& current_lidar = lidar_loaded_bin[lidar_idx];
             space.clearLidarPoints();
             space.lidarIntoSpace(current_lidar);
+            panorama.setLidarFrame(&current_lidar);
 
             if(print_current_lidar == 0) {
                 std::string time_str = space.formatUnixTime(current_lidar.time);
                 std::cout << "\n[Lidar] idx = " << lidar_idx << ", time = " << current_lidar.time << " (" << time_str << "), num = " << current_lidar.num << std::endl;
+                space.printProcessingInfo();
+                if(compact != nullptr) {
+                    std::cout << "Compact decode: " << compact_store.getLastDecodeMs() << " ms" << std::endl;
+                }
                 
                 print_current_lidar = 1;
             }
@@ -463,6 +710,7 @@ int main(int argc, char* argv[]) {
                 if(obj_to_lidar_mapping[i] == static_cast<int>(lidar_idx)) {
                     space.clearObjPoints();
                     space.objIntoSpace(obj_loaded_bin[i]);
+                    panorama.setObjFrame(&obj_loaded_bin[i], space);
 
                     const ObjBinary& current_obj = obj_loaded_bin[i];
                     if(print_current_obj == 0) {
@@ -500,6 +748,7 @@ int main(int argc, char* argv[]) {
 
             if(!obj_found) {
                 space.clearObjPoints();     // 라이다 데이터만 화면에 출력될 때 이전의 객체인식 점이 남아있는 것 제거
+                panorama.setObjFrame(nullptr, space);
                 if(print_current_obj == 0) {
                     std::cout << "[Object] No object frame mapped to lidar frame " << lidar_idx << std::endl;
                     print_current_obj = 1;
@@ -509,7 +758,7 @@ int main(int argc, char* argv[]) {
 
         //============================= 모드 전환시 시간 동기화 =================================
         if(video_control == 6) {        // key O -> TIMELINE 모드로 전환
-            if(mode != TIMELINE) {
+            if(mode != TIMELINE && !lidar_loaded_bin.empty()) {
                 uint64_t lidar_time = lidar_loaded_bin[lidar_idx].time;
 
                 // timeline에서 lidar_time과 가장 가까운 index 찾기
@@ -532,7 +781,7 @@ int main(int argc, char* argv[]) {
         }
 
         if(video_control == 7) {        // key L -> BINARY SEARCH 모드로 전환
-            if(mode != BINARY_SEARCH) {
+            if(mode != BINARY_SEARCH && !timeline.empty()) {
                 uint64_t current_time;
                 if(timeline[timeline_idx].type == DataType::LIDAR) {
                     current_time = lidar_loaded_bin[timeline[timeline_idx].index].time;
@@ -557,6 +806,7 @@ int main(int argc, char* argv[]) {
             }
             video_control = 1;
         }
+        PROFILE_END(select_probe);
 
 
         // Update camera position based on spherical coordinates
@@ -566,56 +816,179 @@ int main(int argc, char* argv[]) {
         camera.setPosition(glm::vec3(x, y, z));
         camera.setTarget(cameraTarget);
 
-        // Apply camera view matrix
-        glm::mat4 view = camera.getViewMatrix();
-        glMatrixMode(GL_MODELVIEW);
-        glLoadMatrixf(&view[0][0]);
+        // 보기별 카메라 : orbit 보기는 궤도 카메라 그대로, top / side / front는 같은 중심 / 방향을 따라감
+        view_layout.update(camera.getPosition(), cameraTarget, orbitRadius);
+
+        //============================= ray picking =================================
+        size_t pick_view = 0;
+        if(pick_pending && view_layout.viewAt(pick_x, pick_y, pick_view)) {
+            PROFILE_SCOPE("pick");
+            glm::vec3 ray_origin, ray_dir;
+            view_layout.screenRay(pick_view, pick_x, pick_y, ray_origin, ray_dir);     // 클릭한 보기의 카메라 / 투영 기준
+
+            picker.pick(ray_origin, ray_dir, space.current_lidar, space.current_obj);
+            if(picker.hasResult()) {
+                const PickResult& res = picker.getResult();
+                if(res.has_point) {
+                    std::cout << "\n[Pick] point idx = " << res.point_idx << " (" << res.point.x << ", " << res.point.y << ", " << res.point.z
+                              << "), reflectivity = " << res.reflectivity << ", cluster_id = " << res.cluster_id << std::endl;
+                }
+                if(res.has_obj) {
+                    std::cout << "[Pick] obj id=[" << res.obj_id << "] " << res.label << ", distance = " << res.distance << std::endl;
+                }
+                std::cout << "[Pick] query " << res.elapsed_ms << " ms, BVH build " << res.build_ms << " ms" << std::endl;
+            }
+        }
+        pick_pending = 0;
 
         // Render scene
-        space.render();
+        PROFILE_BEGIN(draw_probe, "draw");
+        picker.validate(space.current_lidar);
+        // 보기마다 viewport / 행렬만 바꿔 같은 버퍼를 다시 그림 (준비 / 업로드는 위에서 프레임당 한 번)
+        for(size_t v = 0; v < view_layout.getViewCount(); ++v) {
+            PROFILE_SCOPE("view");
+            view_layout.apply(v);
+            space.renderScene();
+            picker.render();
+        }
+        view_layout.restoreFullWindow();
+        space.renderText();
+        view_layout.renderFrames(space);
+        picker.renderText(space);
+        PROFILE_BEGIN(overlay_probe, "overlays");
+        density_map.render();
+        timeline_stats.setPlayhead(timeline_idx);
+        timeline_stats.render();
+        PROFILE_END(overlay_probe);
         // space.renderBillboards(camera.getPosition());       // 카메라 위치 전달
+        PROFILE_END(draw_probe);
+        profiler_hud.render();
+
+        last_frame_allocs = AllocCounter::count() - frame_alloc_start;
 
-        // Swap buffers and poll events
+        // Swap buffers and poll events - GL 명령은 비동기라 GPU 대기 시간은 swap에 잡힘
+        PROFILE_BEGIN(swap_probe, "glfwSwapBuffers");
         glfwSwapBuffers(window);
+        PROFILE_END(swap_probe);
+
+#if PANORAMA
+        if(panorama_window && !panorama_closed) {
+            PROFILE_SCOPE("panorama");
+            glfwMakeContextCurrent(panorama_window);
+            panorama.render();
+            glfwSwapBuffers(panorama_window);
+            glfwMakeContextCurrent(window);
+        }
+#endif
+
+        PROFILE_BEGIN(poll_probe, "poll");
         glfwPollEvents();
+        PROFILE_END(poll_probe);
+        Profiler::frameEnd();
+
+        if(flythrough) {
+            glFinish();     // GPU 작업까지 끝난 시점 기준
+            frame_timer.end();
+            if(loop_frame >= fly_path.getWarmupFrames()) {
+                fly_frame_ms.push_back(std::chrono::duration<double, std::milli>(frame_timer.end_time - frame_timer.start_time).count());
+            }
+            if(loop_frame + 1 >= fly_path.getFrameCount()) {
+                glfwSetWindowShouldClose(window, GLFW_TRUE);
+            }
+        }
+        ++loop_frame;
+    }
+
+    if(recording_path && record_path.save(record_path_filename)) {
+        std::cout << "[Flythrough] camera path saved: " << record_path_filename << " (" << record_path.getFrameCount() << " frames)" << std::endl;
+    }
+    if(flythrough) {
+        FrameTimeSummary summary;
+        CameraPath::summarize(fly_frame_ms, summary);
+        std::cout << "[Flythrough] " << fly_views << " views, " << summary.frames << " frames (warmup " << fly_path.getWarmupFrames() << " excluded): min "
+                  << summary.min_ms << " / median " << summary.median_ms << " / p99 " << summary.p99_ms << " / max "
+                  << summary.max_ms << " ms, mean " << summary.mean_ms << " ms" << std::endl;
+        if(CameraPath::writeResults(fly_out_filename, fly_path_filename, fly_path.getStepMs(), fly_views, summary, fly_frame_ms)) {
+            std::cout << "[Flythrough] results saved: " << fly_out_filename << std::endl;
+        }
     }
 
+#if PANORAMA
+    if(panorama_window) {
+        glfwDestroyWindow(panorama_window);
+    }
+#endif
     glfwDestroyWindow(window);
     glfwTerminate();
 #endif
+    // 백그라운드 생성은 main 지역 프레임 배열을 읽으므로 여기서 중단 / join (전역 소멸자는 배열이 사라진 뒤)
+    density_map.stop();
+    timeline_stats.stop();
+    if(analysis_thread.joinable()) {
+        analysis_thread.join();
+    }
+
+    if(Profiler::isTracing()) {
+        size_t events = Profiler::getTraceEventCount();
+        size_t dropped = Profiler::getDroppedEventCount();
+        if(Profiler::writeTrace(trace_filename)) {
+            std::cout << "[Profiler] trace saved: " << trace_filename << " (" << events << " events";
+            if(dropped > 0) std::cout << ", " << dropped << " dropped";
+            std::cout << ")" << std::endl;
+        }
+    }
 
     return 0;
 }
 
 
 void printHowToUse(){
-    std::cout << "Usage: ./aeronSW_visualizer [start_time] [end_time]\nTime Format: yy-MM-dd-HH-mm-ss" << std::endl;
+    std::cout << "Usage: ./aeronSW_visualizer [start_time] [end_time] (--find [query]) (--trace [file.json])\n"
+              << "                           (--flythrough [path.txt] (--fly-out [file.json])) (--record-path [path.txt]) (--compact) (--roi)\n"
+              << "                           (--views [1|2|4])\n"
+              << "Time Format: yy-MM-dd-HH-mm-ss\n"
+              << "Query: label[<max_distance][>min_distance][:first] (e.g. person<15, truck:first)" << std::endl;
 }
 
 
-std::string getFileExtension(const std::string& fileName) {
-    // 마지막 '.'의 위치를 찾음
-    size_t dotPos = fileName.rfind('.');
-    if (dotPos == std::string::npos) {
-        // '.'이 없다면 확장자가 없는 경우
-        return "";
+// a ~ z, space, pageup, pagedown (그 외 null)
+const char* keyName(int key) {
+    static const char* letters[] = {"a", "b", "c", "d", "e", "f", "g", "h", "i", "j", "k", "l", "m",
+                                    "n", "o", "p", "q", "r", "s", "t", "u", "v", "w", "x", "y", "z"};
+    if (key >= GLFW_KEY_A && key <= GLFW_KEY_Z) {
+        return letters[key - GLFW_KEY_A];
+    }
+    for (const NamedKey& k : named_keys) {
+        if (k.key == key) return k.name;
     }
-    // '.' 이후의 문자열 반환
-    return fileName.substr(dotPos + 1);
+    return nullptr;
 }
 
-std::string removeFileExtension(const std::string& fileName) {
-    size_t lastDot = fileName.find_last_of('.');
-    if(lastDot == std::string::npos) {
-        // '.'이 없다면 확장자가 없다고 간주하고 원본 파일명 그대로 반환
-        return fileName;
+int keyFromName(const std::string& name) {
+    if (name.size() == 1 && name[0] >= 'a' && name[0] <= 'z') {
+        return GLFW_KEY_A + (name[0] - 'a');
     }
-    // 파일명 문자열의 처음부터 '.' 직전까지의 부분 문자열을 잘라서 반환
-    return fileName.substr(0, lastDot);
+    for (const NamedKey& k : named_keys) {
+        if (name == k.name) return k.key;
+    }
+    std::cerr << "[Flythrough] unknown key: " << name << std::endl;
+    return GLFW_KEY_UNKNOWN;
+}
+
+
+// 파노라마 창 닫기 버튼 : 창만 숨기고 그리기 중단 (콜백 안에서는 창을 파괴할 수 없음, 파괴는 종료 시)
+void panoramaCloseCallback(GLFWwindow* window) {
+    glfwSetWindowShouldClose(window, GLFW_FALSE);
+    glfwHideWindow(window);
+    panorama_closed = 1;
 }
 
 void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
     if (action == GLFW_PRESS || action == GLFW_REPEAT) {
+        // 경로 녹화 : 콜백은 루프 끝 poll에서 불리므로 효과는 다음 프레임부터 (WASD 이동은 카메라 pose로 기록)
+        if (recording_path && key != GLFW_KEY_W && key != GLFW_KEY_A && key != GLFW_KEY_S && key != GLFW_KEY_D && keyName(key) != nullptr) {
+            record_path.addKey(loop_frame + 1, keyName(key));
+        }
         glm::vec3 cameraDirection(glm::cos(horizontalAngle),
                                   glm::sin(horizontalAngle),
                                   0.0f);
@@ -635,7 +1008,8 @@ void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods
             cameraPosition += CAMERA_SPEED * cameraOrthoDirection; // 오른쪽 이동
             cameraTarget += CAMERA_SPEED * cameraOrthoDirection; // 오른쪽 이동
         } else if (key == GLFW_KEY_ESCAPE) {                //esc
-            glfwSetWindowShouldClose(window, GLFW_TRUE);
+            GLFWwindow* main_window = static_cast<GLFWwindow*>(glfwGetWindowUserPointer(window));   // 파노라마 창이면 메인 창
+            glfwSetWindowShouldClose(main_window ? main_window : window, GLFW_TRUE);
         } else if (key == GLFW_KEY_P) {                     //p
             if(video_control != 1)
                 video_control = 1;                          //pause
@@ -657,10 +1031,40 @@ void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods
         } else if (key == GLFW_KEY_K) {                     //k
             mode = BINARY_SEARCH;
             video_control = 5;                              //next frame (binary search with object)
+        } else if (key == GLFW_KEY_C) {                     //c
+            space.toggleClusterMode();                      //lidar color : reflectivity <-> cluster (+ cluster box)
+        } else if (key == GLFW_KEY_G) {                     //g
+            space.cycleGroundMode();                        //ground points : show -> dim -> hide
+        } else if (key == GLFW_KEY_H) {                     //h
+            space.cycleBackgroundMode();                    //lidar points : all -> static background + changes -> changes only
+        } else if (key == GLFW_KEY_T) {                     //t
+            space.toggleTrackMode();                        //box color : class <-> track id (+ trail)
+        } else if (key == GLFW_KEY_N) {                     //n
+            find_step = 1;                                  //next --find hit
+        } else if (key == GLFW_KEY_B) {                     //b
+            find_step = -1;                                 //previous --find hit
+        } else if (key == GLFW_KEY_M) {                     //m
+            density_map.toggleVisible();                    //density map show / hide
+        } else if (key == GLFW_KEY_E) {                     //e
+            export_pending = 1;                             //export association table (whole recording)
+        } else if (key == GLFW_KEY_R) {                     //r
+            panorama.toggleColorMode();                     //panorama color : range <-> reflectivity
+        } else if (key == GLFW_KEY_F) {                     //f
+            profiler_hud.toggleVisible();                   //frame-time profiler HUD show / hide
+        } else if (key == GLFW_KEY_X) {                     //x
+            space.cycleSensorMode();                        //lidar sensors : all -> color by sensor -> sensor 0 -> sensor 1 ... -> all
+        } else if (key == GLFW_KEY_Z) {                     //z
+            space.toggleMapMode();                          //accumulated map (scan registration) show / hide
+        } else if (key == GLFW_KEY_V) {                     //v
+            view_layout.cycle();                            //views : 1 (orbit) -> 2 (+ top) -> 4 (+ side, front) -> 1
+            std::cout << "\n[View] " << view_layout.getViewCount() << " views" << std::endl;
         } else if(key == GLFW_KEY_SPACE){                   //space bar
             print_current = 0;                              //print current data info
             print_current_lidar = 0;
             print_current_obj = 0;
+#if ALLOC_COUNTER
+            std::cout << "\n[Alloc] heap allocations in last frame = " << last_frame_allocs << std::endl;
+#endif
         } else if (key == GLFW_KEY_PAGE_DOWN){              //page down
             if (video_speed_coeffi < VIDEO_SPEED_COEFFI_MAX)
                 video_speed_coeffi += VIDEO_SPEED_CONTROL_RESOLUTION; //video speed down
@@ -674,8 +1078,33 @@ void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods
 
 void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
     if (button == GLFW_MOUSE_BUTTON_LEFT) {
+        // 밀도 지도 위 클릭은 화면 회전 대신 타임라인 이동
+        if (action == GLFW_PRESS && density_map.isVisible()) {
+            double mouse_x, mouse_y;
+            int cell_x, cell_y;
+            glfwGetCursorPos(window, &mouse_x, &mouse_y);
+            if (density_map.screenToCell(mouse_x, mouse_y, cell_x, cell_y)) {
+                map_click_x = mouse_x;
+                map_click_y = mouse_y;
+                map_click_pending = 1;
+                return;
+            }
+        }
+        // 타임라인 스트립 클릭은 재생 위치 이동
+        if (action == GLFW_PRESS) {
+            double mouse_x, mouse_y;
+            glfwGetCursorPos(window, &mouse_x, &mouse_y);
+            if (timeline_stats.screenToEntry(mouse_x, mouse_y, strip_click_entry)) {
+                strip_click_pending = 1;
+                return;
+            }
+        }
         leftMousePressed = (action == GLFW_PRESS);
     }
+    else if (button == GLFW_MOUSE_BUTTON_RIGHT && action == GLFW_PRESS) {
+        glfwGetCursorPos(window, &pick_x, &pick_y);
+        pick_pending = 1;                                   //ray picking
+    }
 }
 
 void cursorPosCallback(GLFWwindow* window, double xpos, double ypos) {
@@ -699,6 +1128,11 @@ void cursorPosCallback(GLFWwindow* window, double xpos, double ypos) {
 }
 
 void scrollCallback(GLFWwindow* window, double xoffset, double yoffset) {
+    double mouse_x, mouse_y;
+    glfwGetCursorPos(window, &mouse_x, &mouse_y);
+    if (timeline_stats.zoom(mouse_x, mouse_y, yoffset)) {
+        return;                                         // 타임라인 스트립 위 스크롤 : 스트립 확대 / 축소
+    }
     orbitRadius -= (float)(yoffset * ZOOM_SPEED);
     if (orbitRadius < 1.0f) orbitRadius = 1.0f; // 최소 거리 제한
 }
@@ -707,5 +1141,5 @@ void setupViewport(const GLuint width, const GLuint height) {
     glViewport(0, 0, width, height);
     glMatrixMode(GL_PROJECTION);
     glLoadIdentity();
-    gluPerspective(45.0, static_cast<double>(width) / height, 0.1, 100.0);
+    gluPerspective(FOV_Y, static_cast<double>(width) / height, NEAR_PLANE, FAR_PLANE);
 }
\ No newline at end of file
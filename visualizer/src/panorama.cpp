@@ -0,0 +1,275 @@
+#include "panorama.h"
+#include "space.h"
+
+#include <cmath>
+#include <algorithm>
+
+static const float PANO_PI = 3.14159265358979f;
+
+
+// 분기 없는 atan2 근사 (최대 오차 ~1e-5 rad) - std::atan2와 달리 루프 벡터화 가능
+static inline float fastAtan2(float y, float x) {
+    float ax = std::fabs(x);
+    float ay = std::fabs(y);
+    float mx = ax > ay ? ax : ay;
+    float mn = ax > ay ? ay : ax;
+    float a = mn / (mx + 1e-20f);
+    float s = a * a;
+    float r = ((((-0.0117212f * s + 0.05265332f) * s - 0.11643287f) * s + 0.19354346f) * s - 0.33262347f) * s * a + 0.99997726f * a;
+    r = (ay > ax) ? (0.5f * PANO_PI - r) : r;
+    r = (x < 0.0f) ? (PANO_PI - r) : r;
+    r = (y < 0.0f) ? -r : r;
+    return r;
+}
+
+// 가까울수록 빨강, 멀수록 파랑 (jet colormap)
+static inline void rangeToColor(float range, unsigned char* out) {
+    float t = 1.0f - std::min(range / PANORAMA_MAX_RANGE, 1.0f);
+    float r = std::min(std::max(1.5f - std::fabs(4.0f * t - 3.0f), 0.0f), 1.0f);
+    float g = std::min(std::max(1.5f - std::fabs(4.0f * t - 2.0f), 0.0f), 1.0f);
+    float b = std::min(std::max(1.5f - std::fabs(4.0f * t - 1.0f), 0.0f), 1.0f);
+    out[0] = static_cast<unsigned char>(r * 255.0f);
+    out[1] = static_cast<unsigned char>(g * 255.0f);
+    out[2] = static_cast<unsigned char>(b * 255.0f);
+}
+
+// Space::lidarIntoSpace와 동일한 반사도 색상
+static inline void reflectivityToColor(float reflectivity, unsigned char* out) {
+    float color_sense = reflectivity / 26.54f;
+    float g = std::min(std::max(0.973f - color_sense, 0.0f), 1.0f);
+    float b = std::min(std::max(0.364f + color_sense, 0.0f), 1.0f);
+    out[0] = 0;
+    out[1] = static_cast<unsigned char>(g * 255.0f);
+    out[2] = static_cast<unsigned char>(b * 255.0f);
+}
+
+
+Panorama::Panorama()
+    : width(PANORAMA_WINDOW_WIDTH / ZOOM), height(PANORAMA_WINDOW_HEIGHT / ZOOM),
+      color_mode(ColorMode::RANGE), lidar_frame(nullptr), image_dirty(false) {
+    range_image.assign(width * height, 0.0f);
+    refl_image.assign(width * height, 0.0f);
+    rgb_image.assign(width * height * 3, 0);
+}
+
+void Panorama::setLidarFrame(const LidarBinary* frame) {
+    // 같은 프레임이 매 루프 들어오므로 바뀐 경우에만 다시 투영
+    if(frame == lidar_frame) {
+        return;
+    }
+    lidar_frame = frame;
+    image_dirty = true;
+}
+
+void Panorama::toggleColorMode() {
+    color_mode = (color_mode == ColorMode::RANGE) ? ColorMode::REFLECTIVITY : ColorMode::RANGE;
+    image_dirty = true;
+}
+
+Panorama::ColorMode Panorama::getColorMode() const {
+    return color_mode;
+}
+
+int Panorama::getImageWidth() const {
+    return width;
+}
+
+int Panorama::getImageHeight() const {
+    return height;
+}
+
+
+// 점마다 방위각/고도각/거리를 계산해 픽셀 인덱스로 변환 (SoA 입력, 분기 없는 루프)
+void Panorama::projectPoints() {
+    const size_t n = soa.size;
+    if(pixel_idx.size() < n) {
+        pixel_idx.resize(n);
+        point_range.resize(n);
+    }
+
+    const float* __restrict px = soa.x.data();
+    const float* __restrict py = soa.y.data();
+    const float* __restrict pz = soa.z.data();
+    int* __restrict out_idx = pixel_idx.data();
+    float* __restrict out_range = point_range.data();
+
+    const float elev_min = PANORAMA_ELEV_MIN * PANO_PI / 180.0f;
+    const float elev_max = PANORAMA_ELEV_MAX * PANO_PI / 180.0f;
+    const float u_scale = width / (2.0f * PANO_PI);
+    const float v_scale = height / (elev_max - elev_min);
+    const int w = width;
+    const int h = height;
+
+    for(size_t i = 0; i < n; ++i) {
+        float xy2 = px[i] * px[i] + py[i] * py[i];
+        float rxy = std::sqrt(xy2);
+        float range = std::sqrt(xy2 + pz[i] * pz[i]);
+        float azimuth = fastAtan2(py[i], px[i]);
+        float elevation = fastAtan2(pz[i], rxy);
+
+        int u = static_cast<int>((azimuth + PANO_PI) * u_scale);
+        int v = static_cast<int>((elevation - elev_min) * v_scale);
+        u = u >= w ? w - 1 : u;
+
+        bool valid = (v >= 0) & (v < h) & (range > 0.0f);
+        out_idx[i] = valid ? (v * w + u) : -1;
+        out_range[i] = range;
+    }
+}
+
+void Panorama::buildImage() {
+    std::fill(range_image.begin(), range_image.end(), 0.0f);
+    std::fill(refl_image.begin(), refl_image.end(), 0.0f);
+    std::fill(rgb_image.begin(), rgb_image.end(), 0);
+
+    if(lidar_frame == nullptr) {
+        return;
+    }
+
+    soa.load(*lidar_frame);
+    projectPoints();
+
+    // 같은 픽셀에 여러 점이 떨어지면 가장 가까운 점만 남김 (z-buffer)
+    for(size_t i = 0; i < soa.size; ++i) {
+        int idx = pixel_idx[i];
+        if(idx < 0) {
+            continue;
+        }
+        float& current = range_image[idx];
+        if(current == 0.0f || point_range[i] < current) {
+            current = point_range[i];
+            refl_image[idx] = soa.reflectivity[i];
+        }
+    }
+
+    for(size_t i = 0; i < range_image.size(); ++i) {
+        if(range_image[i] == 0.0f) {
+            continue;
+        }
+        if(color_mode == ColorMode::RANGE) {
+            rangeToColor(range_image[i], &rgb_image[i * 3]);
+        } else {
+            reflectivityToColor(refl_image[i], &rgb_image[i * 3]);
+        }
+    }
+}
+
+
+bool Panorama::projectCorner(const glm::vec3& p, float& u, float& v) const {
+    float rxy = std::sqrt(p.x * p.x + p.y * p.y);
+    if(rxy == 0.0f && p.z == 0.0f) {
+        return false;
+    }
+    const float elev_min = PANORAMA_ELEV_MIN * PANO_PI / 180.0f;
+    const float elev_max = PANORAMA_ELEV_MAX * PANO_PI / 180.0f;
+    u = (fastAtan2(p.y, p.x) + PANO_PI) * width / (2.0f * PANO_PI);
+    v = (fastAtan2(p.z, rxy) - elev_min) * height / (elev_max - elev_min);
+    return true;
+}
+
+void Panorama::addRect(float u0, float v0, float u1, float v1, const glm::vec3& color, const std::string& label) {
+    rects.push_back({u0, v0, u1, v1, color, label});
+}
+
+// ObjData min/max 박스의 8개 꼭짓점을 투영해 범위 이미지 위 사각형으로 변환
+void Panorama::setObjFrame(const ObjBinary* frame, Space& space) {
+    rects.clear();
+    if(frame == nullptr) {
+        return;
+    }
+
+    for(const auto& obj : frame->obj_data) {
+        if(obj.obj_id == -1) {
+            continue;
+        }
+
+        float us[8], vs[8];
+        int count = 0;
+        for(int c = 0; c < 8; ++c) {
+            glm::vec3 corner((c & 1) ? obj.max_x : obj.min_x,
+                             (c & 2) ? obj.max_y : obj.min_y,
+                             (c & 4) ? obj.max_z : obj.min_z);
+            if(projectCorner(corner, us[count], vs[count])) {
+                ++count;
+            }
+        }
+        if(count == 0) {
+            continue;
+        }
+
+        float u_min = *std::min_element(us, us + count);
+        float u_max = *std::max_element(us, us + count);
+        float v_min = *std::min_element(vs, vs + count);
+        float v_max = *std::max_element(vs, vs + count);
+
+        // 방위각 경계(±180도)에 걸친 박스는 오른쪽으로 한 바퀴 밀어 연속 구간으로 만든 뒤 둘로 나눠 그림
+        if(u_max - u_min > width * 0.5f) {
+            for(int c = 0; c < count; ++c) {
+                if(us[c] < width * 0.5f) {
+                    us[c] += width;
+                }
+            }
+            u_min = *std::min_element(us, us + count);
+            u_max = *std::max_element(us, us + count);
+        }
+
+        glm::vec3 color;
+        space.getDynamicColorById(obj.obj_id, color);
+        auto it = objId_to_label.find(obj.obj_id);
+        std::string label = (it != objId_to_label.end()) ? it->second : "unknown";
+
+        addRect(u_min, v_min, u_max, v_max, color, label);
+        if(u_max > width) {
+            addRect(u_min - width, v_min, u_max - width, v_max, color, label);
+        }
+    }
+}
+
+
+void Panorama::render() {
+    if(image_dirty) {
+        buildImage();
+        image_dirty = false;
+    }
+
+    glViewport(0, 0, PANORAMA_WINDOW_WIDTH, PANORAMA_WINDOW_HEIGHT);
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glDisable(GL_DEPTH_TEST);
+
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    gluOrtho2D(0, width, 0, height);    // 이미지 픽셀 좌표계, (0, 0)이 좌하단
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelZoom(ZOOM, ZOOM);
+    glRasterPos2i(0, 0);
+    glDrawPixels(width, height, GL_RGB, GL_UNSIGNED_BYTE, rgb_image.data());
+
+    for(const auto& rect : rects) {
+        glLineWidth(LINE_THICKNESS);
+        glColor3f(rect.color.x, rect.color.y, rect.color.z);
+        glBegin(GL_LINE_LOOP);
+        glVertex2f(rect.u0, rect.v0);
+        glVertex2f(rect.u1, rect.v0);
+        glVertex2f(rect.u1, rect.v1);
+        glVertex2f(rect.u0, rect.v1);
+        glEnd();
+
+        glRasterPos2f(std::max(rect.u0, 0.0f), std::min(rect.v1 + 2.0f, height - 8.0f));
+        for(char c : rect.label) {
+            glutBitmapCharacter(GLUT_BITMAP_HELVETICA_12, c);
+        }
+    }
+
+    const char* mode_text = (color_mode == ColorMode::RANGE) ? "color: range" : "color: reflectivity";
+    glColor3f(1.0f, 1.0f, 1.0f);
+    glRasterPos2f(4.0f, height - 10.0f);
+    for(const char* c = mode_text; *c; ++c) {
+        glutBitmapCharacter(GLUT_BITMAP_HELVETICA_12, *c);
+    }
+
+    glEnable(GL_DEPTH_TEST);
+}
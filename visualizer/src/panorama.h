@@ -0,0 +1,64 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <GL/glut.h>
+
+#include "configs.h"
+#include "binary_utils.h"
+#include "lidar_soa.h"
+
+class Space;
+
+// 범위 이미지에 투영된 객체 박스 (픽셀 좌표)
+struct PanoramaRect {
+    float u0, v0, u1, v1;
+    glm::vec3 color;
+    std::string label;
+};
+
+// 라이다 스윕을 방위각/고도각 범위 이미지(range image)로 투영하는 파노라마 뷰
+class Panorama {
+public:
+    enum class ColorMode { RANGE, REFLECTIVITY };
+
+    Panorama();
+
+    void setLidarFrame(const LidarBinary* frame);
+    void setObjFrame(const ObjBinary* frame, Space& space);   // 박스 색상은 Space의 obj_id 색상과 동일하게
+
+    void toggleColorMode();
+    ColorMode getColorMode() const;
+
+    // 현재 GL 컨텍스트(파노라마 창)에 범위 이미지와 박스 그리기
+    void render();
+
+    int getImageWidth() const;
+    int getImageHeight() const;
+
+private:
+    void buildImage();
+    void projectPoints();       // 벡터화 투영 커널
+    bool projectCorner(const glm::vec3& p, float& u, float& v) const;
+    void addRect(float u0, float v0, float u1, float v1, const glm::vec3& color, const std::string& label);
+
+    int width;      // 이미지 해상도 = 창 크기 / ZOOM
+    int height;
+
+    ColorMode color_mode;
+
+    const LidarBinary* lidar_frame;
+    bool image_dirty;
+
+    LidarSoA soa;
+    std::vector<int> pixel_idx;         // 점 -> 픽셀 인덱스 (-1 : 시야 밖)
+    std::vector<float> point_range;
+
+    std::vector<float> range_image;     // 픽셀별 최근접 거리 (0 : 빈 픽셀)
+    std::vector<float> refl_image;
+    std::vector<unsigned char> rgb_image;
+
+    std::vector<PanoramaRect> rects;
+};
@@ -0,0 +1,92 @@
+#include "parallel_utils.h"
+
+static thread_local bool in_pool_job = false;      // 중첩 parallelFor 감지
+
+
+WorkerPool& WorkerPool::instance() {
+    static WorkerPool pool;
+    return pool;
+}
+
+WorkerPool& WorkerPool::background() {
+    static WorkerPool pool;     // 처음 쓸 때 생성 (CLI처럼 백그라운드 작업이 없으면 스레드도 없음)
+    return pool;
+}
+
+WorkerPool::WorkerPool() {
+    size_t n = workerCount();
+    threads.reserve(n - 1);
+    for(size_t t = 1; t < n; ++t) {     // worker 0은 호출 스레드
+        threads.emplace_back(&WorkerPool::loop, this, t);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    start_cv.notify_all();
+    for(auto& th : threads) {
+        th.join();
+    }
+}
+
+size_t WorkerPool::size() const {
+    return threads.size() + 1;
+}
+
+bool WorkerPool::tryRun(Job fn, void* ctx, size_t workers) {
+    if(in_pool_job || !run_mutex.try_lock()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> run_lock(run_mutex, std::adopt_lock);
+
+    workers = std::min(workers, size());
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = fn;
+        job_ctx = ctx;
+        job_workers = workers;
+        pending = workers - 1;
+        ++generation;
+    }
+    start_cv.notify_all();
+
+    in_pool_job = true;
+    fn(ctx, 0);
+    in_pool_job = false;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done_cv.wait(lock, [this] { return pending == 0; });
+    return true;
+}
+
+void WorkerPool::loop(size_t worker_idx) {
+    in_pool_job = true;
+    size_t seen = 0;
+    while(true) {
+        Job fn;
+        void* ctx;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            start_cv.wait(lock, [&] { return stop || generation != seen; });
+            if(stop) {
+                return;
+            }
+            seen = generation;
+            if(worker_idx >= job_workers) {
+                continue;       // 이번 작업에 참여하지 않는 worker
+            }
+            fn = job;
+            ctx = job_ctx;
+        }
+
+        fn(ctx, worker_idx);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if(--pending == 0) {
+            done_cv.notify_one();
+        }
+    }
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <cstddef>
+
+
+// 사용할 작업 스레드 수 (hardware_concurrency가 0을 돌려주는 환경 대비)
+inline size_t workerCount() {
+    size_t n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+// 프로그램 수명 동안 유지되는 작업 스레드 풀 - 프레임마다 스레드 생성 / 힙 할당이 없도록
+// 다른 스레드가 이미 사용 중이면 tryRun이 false를 돌려주고 호출자가 임시 스레드로 처리
+class WorkerPool {
+public:
+    typedef void (*Job)(void* ctx, size_t worker_idx);
+
+    static WorkerPool& instance();
+    static WorkerPool& background();    // 백그라운드 생성 전용 (parallelForBackground) - 화면 프레임 처리는 instance()
+
+    size_t size() const;    // 호출 스레드 포함 worker 수
+    bool tryRun(Job job, void* ctx, size_t workers);
+
+    ~WorkerPool();
+
+private:
+    WorkerPool();
+    void loop(size_t worker_idx);
+
+    std::vector<std::thread> threads;
+    std::mutex run_mutex;           // 한 번에 하나의 parallelFor만
+    std::mutex mutex;
+    std::condition_variable start_cv;
+    std::condition_variable done_cv;
+    Job job = nullptr;
+    void* job_ctx = nullptr;
+    size_t job_workers = 0;
+    size_t generation = 0;
+    size_t pending = 0;
+    bool stop = false;
+};
+
+
+namespace parallel_detail {
+
+// spawn_when_busy : 풀이 사용 중(다른 스레드의 긴 작업, 중첩 호출)일 때 임시 스레드로 처리 (false면 호출 스레드에서 순차)
+template <typename Fn>
+void run(WorkerPool& pool, bool spawn_when_busy, size_t count, size_t grain, size_t workers, Fn&& fn) {
+    if(count == 0) {
+        return;
+    }
+    grain = std::max<size_t>(grain, 1);
+    workers = std::max<size_t>(1, std::min(workers, (count + grain - 1) / grain));
+
+    if(workers == 1) {
+        fn(size_t(0), count, size_t(0));
+        return;
+    }
+
+    struct Context {
+        std::atomic<size_t> next;
+        size_t count;
+        size_t grain;
+        Fn* fn;
+    } ctx;
+    ctx.next = 0;
+    ctx.count = count;
+    ctx.grain = grain;
+    ctx.fn = &fn;
+
+    WorkerPool::Job job = [](void* p, size_t worker_idx) {
+        Context& c = *static_cast<Context*>(p);
+        while(true) {
+            size_t begin = c.next.fetch_add(c.grain);
+            if(begin >= c.count) {
+                break;
+            }
+            (*c.fn)(begin, std::min(begin + c.grain, c.count), worker_idx);
+        }
+    };
+
+    if(pool.tryRun(job, &ctx, workers)) {
+        return;
+    }
+    if(!spawn_when_busy) {
+        job(&ctx, 0);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for(size_t t = 1; t < workers; ++t) {
+        threads.emplace_back(job, &ctx, t);
+    }
+    job(&ctx, 0);
+    for(auto& th : threads) {
+        th.join();
+    }
+}
+
+}
+
+
+// [0, count) 구간을 grain 크기 청크로 나눠 worker 스레드들이 가져가며 처리
+// fn(begin, end, worker_idx) - worker_idx로 스레드별 누적 버퍼(타일)를 골라 쓰면 잠금 없이 병렬 누적 가능
+// 풀이 사용 중이면 임시 스레드로 처리
+template <typename Fn>
+void parallelFor(size_t count, size_t grain, size_t workers, Fn&& fn) {
+    parallel_detail::run(WorkerPool::instance(), true, count, grain, workers, std::forward<Fn>(fn));
+}
+
+template <typename Fn>
+void parallelFor(size_t count, size_t grain, Fn&& fn) {
+    parallelFor(count, grain, workerCount(), std::forward<Fn>(fn));
+}
+
+// 백그라운드 스레드의 긴 생성 작업 (정합 / 밀도 지도 / 타임라인 통계 / 검출 역색인) - 별도 풀 사용
+// 화면 프레임의 parallelFor가 공유 풀을 못 잡아 프레임마다 임시 스레드를 만드는 일이 없도록
+// 백그라운드끼리 겹쳐 풀이 사용 중이면 임시 스레드 대신 호출 스레드에서 순차 처리 (스레드 생성 없음)
+template <typename Fn>
+void parallelForBackground(size_t count, size_t grain, size_t workers, Fn&& fn) {
+    parallel_detail::run(WorkerPool::background(), false, count, grain, workers, std::forward<Fn>(fn));
+}
+
+template <typename Fn>
+void parallelForBackground(size_t count, size_t grain, Fn&& fn) {
+    parallelForBackground(count, grain, workerCount(), std::forward<Fn>(fn));
+}
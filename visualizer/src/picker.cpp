@@ -0,0 +1,210 @@
+#include "picker.h"
+#include "space.h"
+
+#include <cstdio>
+
+
+void Picker::buildPointBvh(const LidarBinary* lidar) {
+    point_frame = lidar;
+    point_built = true;
+    point_bvh.clear();
+    if(lidar == nullptr) {
+        return;
+    }
+
+    // 점은 선택 허용 반경만큼의 작은 AABB로 취급
+    const glm::vec3 r(PICK_POINT_RADIUS);
+    const auto& points = lidar->lidar_data;
+    prim_min.resize(points.size());
+    prim_max.resize(points.size());
+    for(size_t i = 0; i < points.size(); ++i) {
+        glm::vec3 p(points[i].x, points[i].y, points[i].z);
+        prim_min[i] = p - r;
+        prim_max[i] = p + r;
+    }
+    point_bvh.build(prim_min, prim_max);
+}
+
+void Picker::buildObjBvh(const ObjBinary* obj) {
+    obj_frame = obj;
+    obj_built = true;
+    obj_bvh.clear();
+    obj_prim_to_data.clear();
+    if(obj == nullptr) {
+        return;
+    }
+
+    prim_min.clear();
+    prim_max.clear();
+    for(size_t i = 0; i < obj->obj_data.size(); ++i) {
+        const auto& o = obj->obj_data[i];
+        if(o.obj_id == -1) {
+            continue;
+        }
+        prim_min.push_back(glm::min(glm::vec3(o.min_x, o.min_y, o.min_z), glm::vec3(o.max_x, o.max_y, o.max_z)));
+        prim_max.push_back(glm::max(glm::vec3(o.min_x, o.min_y, o.min_z), glm::vec3(o.max_x, o.max_y, o.max_z)));
+        obj_prim_to_data.push_back(i);
+    }
+    obj_bvh.build(prim_min, prim_max);
+}
+
+
+void Picker::pick(const glm::vec3& origin, const glm::vec3& dir, const LidarBinary* lidar, const ObjBinary* obj) {
+    // 재생 중에는 대부분 새 프레임이라 생성이 클릭 시간의 대부분 -> 질의와 따로 잼
+    MyTimer build_timer;
+    if(!point_built || lidar != point_frame) {
+        buildPointBvh(lidar);
+    }
+    if(!obj_built || obj != obj_frame) {
+        buildObjBvh(obj);
+    }
+    build_timer.end();
+
+    MyTimer timer;
+    result = PickResult();
+    result.build_ms = std::chrono::duration<double, std::milli>(build_timer.end_time - build_timer.start_time).count();
+
+    // 점: 광선과의 수직 거리가 PICK_POINT_RADIUS 이내인 점 중 광선 방향으로 가장 가까운 점
+    if(lidar != nullptr) {
+        const auto& points = lidar->lidar_data;
+        const float r2 = PICK_POINT_RADIUS * PICK_POINT_RADIUS;
+        float t_hit;
+        int idx = point_bvh.intersect(origin, dir, t_hit, [&](uint32_t i, float t_best, float& t_out) {
+            glm::vec3 to_point = glm::vec3(points[i].x, points[i].y, points[i].z) - origin;
+            float t = glm::dot(to_point, dir);
+            if(t < 0.0f || t >= t_best) {
+                return false;
+            }
+            if(glm::dot(to_point, to_point) - t * t > r2) {
+                return false;
+            }
+            t_out = t;
+            return true;
+        });
+        if(idx >= 0) {
+            result.has_point = true;
+            result.point_idx = idx;
+            result.point = glm::vec3(points[idx].x, points[idx].y, points[idx].z);
+            result.reflectivity = points[idx].reflectivity;
+            result.cluster_id = points[idx].cluster_id;
+        }
+    }
+
+    // 박스: 광선이 처음 들어가는 박스 (광선 시작점이 박스 안이면 t = 0)
+    if(obj != nullptr) {
+        glm::vec3 inv_dir(1.0f / dir.x, 1.0f / dir.y, 1.0f / dir.z);
+        float t_hit;
+        int prim = obj_bvh.intersect(origin, dir, t_hit, [&](uint32_t i, float t_best, float& t_out) {
+            const ObjData& o = obj->obj_data[obj_prim_to_data[i]];
+            glm::vec3 bmin = glm::min(glm::vec3(o.min_x, o.min_y, o.min_z), glm::vec3(o.max_x, o.max_y, o.max_z));
+            glm::vec3 bmax = glm::max(glm::vec3(o.min_x, o.min_y, o.min_z), glm::vec3(o.max_x, o.max_y, o.max_z));
+            float t0 = 0.0f, t1 = t_best;
+            for(int a = 0; a < 3; ++a) {
+                float ta = (bmin[a] - origin[a]) * inv_dir[a];
+                float tb = (bmax[a] - origin[a]) * inv_dir[a];
+                if(ta > tb) std::swap(ta, tb);
+                t0 = ta > t0 ? ta : t0;
+                t1 = tb < t1 ? tb : t1;
+                if(t0 > t1) return false;
+            }
+            if(t0 >= t_best) {
+                return false;
+            }
+            t_out = t0;
+            return true;
+        });
+        if(prim >= 0) {
+            const ObjData& o = obj->obj_data[obj_prim_to_data[prim]];
+            result.has_obj = true;
+            result.obj_id = o.obj_id;
+            auto it = objId_to_label.find(o.obj_id);
+            result.label = (it != objId_to_label.end()) ? it->second : "unknown";
+            result.distance = o.distance;
+            result.box_min = glm::vec3(o.min_x, o.min_y, o.min_z);
+            result.box_max = glm::vec3(o.max_x, o.max_y, o.max_z);
+        }
+    }
+
+    timer.end();
+    result.elapsed_ms = std::chrono::duration<double, std::milli>(timer.end_time - timer.start_time).count();
+    has_result = result.has_point || result.has_obj;
+    result_frame = lidar;
+}
+
+bool Picker::hasResult() const {
+    return has_result;
+}
+
+const PickResult& Picker::getResult() const {
+    return result;
+}
+
+void Picker::clearResult() {
+    has_result = false;
+}
+
+void Picker::validate(const LidarBinary* lidar) {
+    if(has_result && lidar != result_frame) {
+        has_result = false;
+    }
+}
+
+
+void Picker::render() const {
+    if(!has_result) {
+        return;
+    }
+
+    glLineWidth(LINE_THICKNESS);
+    glBegin(GL_LINES);
+    if(result.has_point) {
+        // 선택된 점 : 흰색 십자
+        const float s = 0.1f;
+        const glm::vec3& p = result.point;
+        glColor3f(1.0f, 1.0f, 1.0f);
+        glVertex3f(p.x - s, p.y, p.z);  glVertex3f(p.x + s, p.y, p.z);
+        glVertex3f(p.x, p.y - s, p.z);  glVertex3f(p.x, p.y + s, p.z);
+        glVertex3f(p.x, p.y, p.z - s);  glVertex3f(p.x, p.y, p.z + s);
+    }
+    if(result.has_obj) {
+        // 선택된 박스 : 흰색 테두리 - 한 축만 다른 꼭짓점 쌍 = 12개 모서리
+        const glm::vec3& a = result.box_min;
+        const glm::vec3& b = result.box_max;
+        glColor3f(1.0f, 1.0f, 1.0f);
+        for(int c = 0; c < 8; ++c) {
+            for(int bit = 1; bit < 8; bit <<= 1) {
+                if(c & bit) {
+                    continue;
+                }
+                int d = c | bit;
+                glVertex3f((c & 1) ? b.x : a.x, (c & 2) ? b.y : a.y, (c & 4) ? b.z : a.z);
+                glVertex3f((d & 1) ? b.x : a.x, (d & 2) ? b.y : a.y, (d & 4) ? b.z : a.z);
+            }
+        }
+    }
+    glEnd();
+}
+
+void Picker::renderText(const Space& space) const {
+    if(!has_result) {
+        return;
+    }
+
+    const glm::vec3 white(1.0f, 1.0f, 1.0f);
+    char buff[256];
+    float y = WINDOW_HEIGHT - 60.0f - TIMELINE_STRIP_HEIGHT - TIMELINE_STRIP_MARGIN;     // 타임라인 스트립 위
+
+    if(result.has_point) {
+        snprintf(buff, sizeof(buff), "[pick] point (%.3f, %.3f, %.3f) reflectivity=%u cluster_id=%d",
+                 result.point.x, result.point.y, result.point.z, result.reflectivity, result.cluster_id);
+        space.renderText2D(buff, 10, y, white);
+        y += 20.0f;
+    }
+    if(result.has_obj) {
+        snprintf(buff, sizeof(buff), "[pick] %s (id=%d) distance=%.3f", result.label.c_str(), result.obj_id, result.distance);
+        space.renderText2D(buff, 10, y, white);
+        y += 20.0f;
+    }
+    snprintf(buff, sizeof(buff), "[pick] query %.3f ms, BVH build %.3f ms", result.elapsed_ms, result.build_ms);
+    space.renderText2D(buff, 10, y, white);
+}
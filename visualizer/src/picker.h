@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "configs.h"
+#include "binary_utils.h"
+#include "bvh.h"
+
+class Space;
+
+struct PickResult {
+    bool has_point = false;         // 라이다 점
+    glm::vec3 point;
+    uint32_t reflectivity = 0;
+    int cluster_id = 0;
+    size_t point_idx = 0;
+
+    bool has_obj = false;           // 객체인식 박스
+    int obj_id = -1;
+    std::string label;
+    float distance = 0.0f;
+    glm::vec3 box_min, box_max;
+
+    double build_ms = 0.0;          // 이번 클릭에서 BVH 생성 시간 (프레임이 바뀐 뒤 첫 클릭만, 아니면 0)
+    double elapsed_ms = 0.0;        // 광선 질의 시간 (BVH 생성 제외)
+};
+
+// 마우스 광선으로 현재 프레임의 점 / 박스 선택 (프레임별 BVH)
+class Picker {
+public:
+    // 현재 프레임이 바뀐 경우에만 BVH 재생성 후 광선 질의
+    void pick(const glm::vec3& origin, const glm::vec3& dir, const LidarBinary* lidar, const ObjBinary* obj);
+
+    bool hasResult() const;
+    const PickResult& getResult() const;
+    void clearResult();
+    void validate(const LidarBinary* lidar);    // 표시 중인 라이다 프레임이 바뀌면 선택 해제
+
+    void render() const;                        // 선택 표시 (3D, view 행렬 적용 상태에서 호출)
+    void renderText(const Space& space) const;  // 선택 정보 (좌하단 2D text)
+
+private:
+    void buildPointBvh(const LidarBinary* lidar);
+    void buildObjBvh(const ObjBinary* obj);
+
+    Bvh point_bvh;
+    Bvh obj_bvh;
+    const LidarBinary* point_frame = nullptr;
+    const ObjBinary* obj_frame = nullptr;
+    bool point_built = false;
+    bool obj_built = false;
+
+    std::vector<glm::vec3> prim_min, prim_max;
+    std::vector<size_t> obj_prim_to_data;   // -1(obj_id)을 뺀 박스 -> obj_data 인덱스
+
+    PickResult result;
+    const LidarBinary* result_frame = nullptr;
+    bool has_result = false;
+};
@@ -0,0 +1,44 @@
+#include "point_vbo.h"
+
+
+size_t PointVbo::upload(const glm::vec3* positions, const glm::vec3* colors, size_t _count, GLenum usage) {
+    if(vbo == 0) {
+        glGenBuffers(1, &vbo);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+
+    const size_t half = _count * sizeof(glm::vec3);
+    if(_count > capacity) {
+        capacity = _count + _count / 2;     // 여유를 두고 키움
+        glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(glm::vec3) * 2, nullptr, usage);
+    }
+    // color 구간은 capacity 기준 위치 -> 개수가 바뀌어도 버퍼 배치 유지
+    glBufferSubData(GL_ARRAY_BUFFER, 0, half, positions);
+    glBufferSubData(GL_ARRAY_BUFFER, capacity * sizeof(glm::vec3), half, colors);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    count = _count;
+    return half * 2;
+}
+
+void PointVbo::draw(float point_size) const {
+    if(vbo == 0 || count == 0) {
+        return;
+    }
+    glPointSize(point_size);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, reinterpret_cast<const void*>(0));
+    glColorPointer(3, GL_FLOAT, 0, reinterpret_cast<const void*>(capacity * sizeof(glm::vec3)));
+
+    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(count));
+
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+size_t PointVbo::size() const {
+    return count;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+
+// 점 VBO - 한 버퍼에 [position | color] 배치, GL_POINTS로 그림
+// 용량이 충분하면 glBufferSubData로 덮어써 재할당 없음
+// (버퍼는 GL context 종료 시 함께 해제 - 전역 객체 소멸 시점엔 context가 없으므로 직접 지우지 않음)
+class PointVbo {
+public:
+    // 업로드한 바이트 수 반환
+    size_t upload(const glm::vec3* positions, const glm::vec3* colors, size_t count, GLenum usage);
+    void draw(float point_size) const;
+
+    size_t size() const;
+
+private:
+    GLuint vbo = 0;
+    size_t count = 0;
+    size_t capacity = 0;        // 점 개수 기준
+};
@@ -0,0 +1,257 @@
+#include "profiler.h"
+
+#include <mutex>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+
+// trace 이벤트 하나 (24 bytes) - 이름은 단계 id로만 저장
+struct TraceEvent {
+    int64_t start_ns;       // trace 시작 기준
+    int64_t dur_ns;
+    int32_t stage;
+    int32_t tid;
+};
+
+static std::mutex stage_mutex;
+static const char* stage_names[PROFILE_MAX_STAGES] = {};
+static std::atomic<int> stage_count(0);
+static std::atomic<int> stage_depth[PROFILE_MAX_STAGES];
+
+// 현재 프레임 누적 (여러 스레드에서 더함)
+static std::atomic<int64_t> frame_ns[PROFILE_MAX_STAGES];
+static std::atomic<uint32_t> frame_calls[PROFILE_MAX_STAGES];
+
+// 프레임 이력 (메인 스레드 전용)
+static float history_ms[PROFILE_MAX_STAGES][PROFILE_HISTORY_FRAMES];
+static float history_calls[PROFILE_MAX_STAGES][PROFILE_HISTORY_FRAMES];
+static size_t history_pos = 0;
+static size_t history_count = 0;
+static Profiler::Clock::time_point last_frame_end = Profiler::Clock::now();
+static int frame_stage = Profiler::registerStage("frame");
+
+static bool hud_enabled = false;
+
+static std::mutex trace_mutex;
+static std::atomic<bool> tracing(false);
+static std::vector<TraceEvent> trace_events;
+static size_t dropped_events = 0;
+static Profiler::Clock::time_point trace_epoch;
+static int main_tid = -1;
+
+static std::atomic<int> next_tid(0);
+static thread_local int scope_depth = 0;
+static thread_local int thread_id = -1;
+
+static int currentThreadId() {
+    if(thread_id < 0) thread_id = next_tid.fetch_add(1, std::memory_order_relaxed);
+    return thread_id;
+}
+
+static void appendTraceEvent(int stage, Profiler::Clock::time_point start, int64_t dur_ns) {
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    if(!tracing.load(std::memory_order_relaxed)) return;
+    if(trace_events.size() >= PROFILE_TRACE_MAX_EVENTS) {
+        ++dropped_events;
+        return;
+    }
+    TraceEvent event;
+    event.start_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(start - trace_epoch).count();
+    event.dur_ns = dur_ns;
+    event.stage = stage;
+    event.tid = currentThreadId();
+    trace_events.push_back(event);
+}
+
+
+int Profiler::registerStage(const char* name) {
+    std::lock_guard<std::mutex> lock(stage_mutex);
+    int count = stage_count.load(std::memory_order_relaxed);
+    for(int i = 0; i < count; ++i) {
+        if(std::strcmp(stage_names[i], name) == 0) return i;
+    }
+    if(count >= PROFILE_MAX_STAGES) {
+        std::cerr << "[Profiler] too many stages, ignored: " << name << std::endl;
+        return -1;
+    }
+    stage_names[count] = name;
+    stage_depth[count].store(-1, std::memory_order_relaxed);
+    frame_ns[count].store(0, std::memory_order_relaxed);
+    frame_calls[count].store(0, std::memory_order_relaxed);
+    stage_count.store(count + 1, std::memory_order_release);
+    return count;
+}
+
+Profiler::Clock::time_point Profiler::begin() {
+    ++scope_depth;
+    return Clock::now();
+}
+
+void Profiler::end(int stage, Clock::time_point start) {
+    Clock::time_point now = Clock::now();
+    --scope_depth;
+    if(stage < 0) return;
+
+    int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count();
+    frame_ns[stage].fetch_add(ns, std::memory_order_relaxed);
+    frame_calls[stage].fetch_add(1, std::memory_order_relaxed);
+    if(stage_depth[stage].load(std::memory_order_relaxed) < 0) {
+        stage_depth[stage].store(scope_depth + 1, std::memory_order_relaxed);    // "frame" 아래 한 단계부터
+    }
+    if(tracing.load(std::memory_order_relaxed)) {
+        appendTraceEvent(stage, start, ns);
+    }
+}
+
+void Profiler::frameEnd() {
+    Clock::time_point now = Clock::now();
+    Clock::time_point prev = last_frame_end;
+    last_frame_end = now;
+    if(!isEnabled()) return;
+
+    int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - prev).count();
+    frame_ns[frame_stage].fetch_add(ns, std::memory_order_relaxed);
+    frame_calls[frame_stage].fetch_add(1, std::memory_order_relaxed);
+    stage_depth[frame_stage].store(0, std::memory_order_relaxed);
+    if(tracing.load(std::memory_order_relaxed)) {
+        main_tid = currentThreadId();
+        appendTraceEvent(frame_stage, prev, ns);
+    }
+
+    const int count = stage_count.load(std::memory_order_acquire);
+    for(int s = 0; s < count; ++s) {
+        history_ms[s][history_pos] = frame_ns[s].exchange(0, std::memory_order_relaxed) / 1e6f;
+        history_calls[s][history_pos] = static_cast<float>(frame_calls[s].exchange(0, std::memory_order_relaxed));
+    }
+    history_pos = (history_pos + 1) % PROFILE_HISTORY_FRAMES;
+    history_count = std::min<size_t>(history_count + 1, PROFILE_HISTORY_FRAMES);
+}
+
+
+void Profiler::setHudEnabled(bool on) {
+    if(on && !hud_enabled) {
+        // 꺼져 있던 동안의 값이 섞이지 않도록 이력 / 누적 초기화
+        history_pos = 0;
+        history_count = 0;
+        const int count = stage_count.load(std::memory_order_acquire);
+        for(int s = 0; s < count; ++s) {
+            frame_ns[s].store(0, std::memory_order_relaxed);
+            frame_calls[s].store(0, std::memory_order_relaxed);
+        }
+    }
+    hud_enabled = on;
+    updateEnabled();
+}
+
+bool Profiler::isHudEnabled() {
+    return hud_enabled;
+}
+
+void Profiler::updateEnabled() {
+    enabled.store(hud_enabled || tracing.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+
+void Profiler::startTrace() {
+    {
+        std::lock_guard<std::mutex> lock(trace_mutex);
+        trace_events.clear();
+        trace_events.reserve(std::min<size_t>(PROFILE_TRACE_MAX_EVENTS, 1 << 16));
+        dropped_events = 0;
+        trace_epoch = Clock::now();
+        main_tid = currentThreadId();
+        tracing.store(true, std::memory_order_relaxed);
+    }
+    updateEnabled();
+}
+
+bool Profiler::isTracing() {
+    return tracing.load(std::memory_order_relaxed);
+}
+
+size_t Profiler::getTraceEventCount() {
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    return trace_events.size();
+}
+
+size_t Profiler::getDroppedEventCount() {
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    return dropped_events;
+}
+
+bool Profiler::writeTrace(const std::string& filename) {
+    std::vector<TraceEvent> events;
+    {
+        std::lock_guard<std::mutex> lock(trace_mutex);
+        tracing.store(false, std::memory_order_relaxed);
+        events.swap(trace_events);
+    }
+    updateEnabled();
+
+    std::ofstream ofs(filename, std::ios::binary);
+    if(!ofs) {
+        std::cerr << "Failed to open trace file: " << filename << std::endl;
+        return false;
+    }
+
+    // 이벤트 시작 시간 순 (스레드별로는 끝나는 순서로 쌓였으므로)
+    std::sort(events.begin(), events.end(), [](const TraceEvent& a, const TraceEvent& b) {
+        return a.start_ns < b.start_ns;
+    });
+
+    int max_tid = main_tid;
+    for(const auto& event : events) max_tid = std::max(max_tid, static_cast<int>(event.tid));
+
+    char line[256];
+    ofs << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    for(int tid = 0; tid <= max_tid; ++tid) {
+        snprintf(line, sizeof(line), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                 first ? "" : ",\n", tid, (tid == main_tid) ? "main" : "worker");
+        ofs << line;
+        first = false;
+    }
+    for(const auto& event : events) {
+        snprintf(line, sizeof(line), "%s{\"name\":\"%s\",\"cat\":\"aeronSW\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                 first ? "" : ",\n", stage_names[event.stage], event.tid, event.start_ns / 1000.0, event.dur_ns / 1000.0);
+        ofs << line;
+        first = false;
+    }
+    ofs << "\n]}\n";
+    return static_cast<bool>(ofs);
+}
+
+
+void Profiler::summarize(std::vector<StageSummary>& out) {
+    out.clear();
+    if(history_count == 0) return;
+
+    const int count = stage_count.load(std::memory_order_acquire);
+    const size_t last = (history_pos + PROFILE_HISTORY_FRAMES - 1) % PROFILE_HISTORY_FRAMES;
+    float scratch[PROFILE_HISTORY_FRAMES];
+    for(int s = 0; s < count; ++s) {
+        double calls = 0.0;
+        for(size_t i = 0; i < history_count; ++i) calls += history_calls[s][i];
+        if(calls == 0.0) continue;      // 창 안에서 한 번도 안 지난 단계 (로딩 등)
+
+        std::copy(history_ms[s], history_ms[s] + history_count, scratch);
+        const size_t i50 = history_count / 2;
+        const size_t i95 = std::min(history_count - 1, history_count * 95 / 100);
+        std::nth_element(scratch, scratch + i50, scratch + history_count);
+        float p50 = scratch[i50];
+        std::nth_element(scratch, scratch + i95, scratch + history_count);
+        float p95 = scratch[i95];
+        float max = *std::max_element(scratch + i95, scratch + history_count);
+
+        StageSummary summary;
+        summary.name = stage_names[s];
+        summary.depth = std::max(0, stage_depth[s].load(std::memory_order_relaxed));
+        summary.last_ms = history_ms[s][last];
+        summary.p50_ms = p50;
+        summary.p95_ms = p95;
+        summary.max_ms = max;
+        summary.calls = calls / history_count;
+        out.push_back(summary);
+    }
+}
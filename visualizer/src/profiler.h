@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "configs.h"
+
+
+// 단계별 시간 측정 - PROFILE_SCOPE("이름")가 있는 블록의 실행 시간을 단계별로 누적
+// 꺼져 있으면 (HUD 숨김 + trace 없음) probe 하나가 flag 읽기 + 분기 하나, configs.h PROFILER 0이면 코드 자체가 빠짐
+// 프레임 누적 / 이력 / 백분위는 메인 스레드에서 frameEnd() 호출 기준, 기록(record)은 어느 스레드에서나 가능
+struct StageSummary {
+    const char* name;
+    int depth;              // 처음 기록될 때의 중첩 깊이 (HUD 들여쓰기)
+    double last_ms;         // 직전 프레임 합
+    double p50_ms;
+    double p95_ms;
+    double max_ms;
+    double calls;           // 프레임당 평균 호출 수
+};
+
+class Profiler {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    static int registerStage(const char* name);     // 같은 이름이면 같은 id
+
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+    static Clock::time_point begin();
+    static void end(int stage, Clock::time_point start);
+
+    static void frameEnd();     // 메인 루프 한 바퀴 끝 - 단계별 합을 이력에 넣고 "frame" 단계 기록
+
+    static void setHudEnabled(bool on);
+    static bool isHudEnabled();
+
+    // Chrome trace-event JSON (chrome://tracing, Perfetto에서 열기)
+    static void startTrace();
+    static bool writeTrace(const std::string& filename);   // 기록 중단 후 저장
+    static bool isTracing();
+    static size_t getTraceEventCount();
+    static size_t getDroppedEventCount();                  // PROFILE_TRACE_MAX_EVENTS 초과분
+
+    static void summarize(std::vector<StageSummary>& out); // 최근 PROFILE_HISTORY_FRAMES 프레임 기준 (메인 스레드)
+
+private:
+    static void updateEnabled();
+
+    inline static std::atomic<bool> enabled{false};
+};
+
+
+// RAII probe - 생성 시점에 켜져 있던 경우만 기록
+class ProfileScope {
+public:
+    explicit ProfileScope(int _stage) : stage(_stage), active(Profiler::isEnabled()) {
+        if(active) start = Profiler::begin();
+    }
+    ~ProfileScope() {
+        stop();
+    }
+    void stop() {       // 블록 끝 전에 측정 종료 (PROFILE_END)
+        if(active) Profiler::end(stage, start);
+        active = false;
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    int stage;
+    bool active;
+    Profiler::Clock::time_point start;
+};
+
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if PROFILER
+// 단계 id는 처음 지날 때 한 번만 등록 (함수 내 static)
+#define PROFILE_SCOPE(name) \
+    static const int PROFILE_CONCAT(profile_stage_, __LINE__) = Profiler::registerStage(name); \
+    ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__)(PROFILE_CONCAT(profile_stage_, __LINE__))
+// 블록으로 감싸기 어려운 연속 구간 (메인 루프 단계 등) - PROFILE_END(var)까지
+#define PROFILE_BEGIN(var, name) \
+    static const int PROFILE_CONCAT(var, _stage) = Profiler::registerStage(name); \
+    ProfileScope var(PROFILE_CONCAT(var, _stage))
+#define PROFILE_END(var) var.stop()
+#else
+#define PROFILE_SCOPE(name) do {} while(0)
+#define PROFILE_BEGIN(var, name) do {} while(0)
+#define PROFILE_END(var) do {} while(0)
+#endif
@@ -0,0 +1,102 @@
+#include "profiler_hud.h"
+
+#include <cstdio>
+#include <algorithm>
+
+#define PROFILE_HUD_LINE    96      // 한 행 글자 수 상한
+
+static const float HUD_WIDTH = 540.0f;
+static const float HUD_ROW = 15.0f;
+static const float HUD_MARGIN = 10.0f;
+static const float HUD_BAR_WIDTH = 60.0f;
+
+
+void ProfilerHud::toggleVisible() {
+    Profiler::setHudEnabled(!Profiler::isHudEnabled());
+    frames_since_refresh = PROFILE_HUD_REFRESH;
+    summary.clear();
+}
+
+bool ProfilerHud::isVisible() const {
+    return Profiler::isHudEnabled();
+}
+
+void ProfilerHud::refresh() {
+    Profiler::summarize(summary);
+    lines.assign((summary.size() + 1) * PROFILE_HUD_LINE, '\0');
+    snprintf(lines.data(), PROFILE_HUD_LINE, "%-22s %6s %6s %6s %6s %5s", "stage (ms)", "last", "p50", "p95", "max", "calls");
+    for(size_t i = 0; i < summary.size(); ++i) {
+        const StageSummary& s = summary[i];
+        char name[32];
+        int indent = std::min(s.depth, 4) * 2;
+        snprintf(name, sizeof(name), "%*s%s", indent, "", s.name);
+        snprintf(lines.data() + (i + 1) * PROFILE_HUD_LINE, PROFILE_HUD_LINE, "%-22.22s %6.2f %6.2f %6.2f %6.2f %5.1f",
+                 name, s.last_ms, s.p50_ms, s.p95_ms, s.max_ms, s.calls);
+    }
+}
+
+void ProfilerHud::render() {
+    if(!Profiler::isHudEnabled()) {
+        return;
+    }
+    PROFILE_SCOPE("hud");
+    if(++frames_since_refresh >= PROFILE_HUD_REFRESH) {
+        frames_since_refresh = 0;
+        refresh();
+    }
+
+    const size_t rows = summary.size() + 1;
+    const float x0 = WINDOW_WIDTH - HUD_WIDTH - HUD_MARGIN;
+    const float y1 = WINDOW_HEIGHT - HUD_MARGIN;
+    const float y0 = y1 - rows * HUD_ROW - 6.0f;
+
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    gluOrtho2D(0, WINDOW_WIDTH, 0, WINDOW_HEIGHT);
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+    glDisable(GL_DEPTH_TEST);
+
+    // 반투명 배경
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glColor4f(0.0f, 0.0f, 0.0f, 0.6f);
+    glBegin(GL_QUADS);
+    glVertex2f(x0, y0);                 glVertex2f(x0 + HUD_WIDTH, y0);
+    glVertex2f(x0 + HUD_WIDTH, y1);     glVertex2f(x0, y1);
+    glEnd();
+    glDisable(GL_BLEND);
+
+    // p95 막대 - 프레임 p95 대비 비율 (맨 왼쪽)
+    double frame_p95 = 0.0;
+    for(const auto& s : summary) frame_p95 = std::max(frame_p95, s.p95_ms);
+    if(frame_p95 > 0.0) {
+        glBegin(GL_QUADS);
+        for(size_t i = 0; i < summary.size(); ++i) {
+            float ratio = static_cast<float>(summary[i].p95_ms / frame_p95);
+            float bottom = y1 - (i + 2) * HUD_ROW - 2.0f;      // 해당 행 글자 기준선 바로 아래
+            float top = bottom + HUD_ROW - 3.0f;
+            float w = std::max(1.0f, ratio * HUD_BAR_WIDTH);
+            glColor3f(0.2f + 0.8f * ratio, 0.8f - 0.6f * ratio, 0.2f);     // 클수록 빨강
+            glVertex2f(x0 + 4.0f, bottom);      glVertex2f(x0 + 4.0f + w, bottom);
+            glVertex2f(x0 + 4.0f + w, top);     glVertex2f(x0 + 4.0f, top);
+        }
+        glEnd();
+    }
+
+    glColor3f(1.0f, 1.0f, 1.0f);
+    for(size_t i = 0; i < rows && !lines.empty(); ++i) {
+        glRasterPos2f(x0 + HUD_BAR_WIDTH + 10.0f, y1 - (i + 1) * HUD_ROW);
+        for(const char* c = lines.data() + i * PROFILE_HUD_LINE; *c; ++c) {
+            glutBitmapCharacter(GLUT_BITMAP_8_BY_13, *c);
+        }
+    }
+
+    glEnable(GL_DEPTH_TEST);
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+}
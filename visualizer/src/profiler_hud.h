@@ -0,0 +1,26 @@
+#pragma once
+
+#include <vector>
+#include <GL/glew.h>
+#include <GL/glut.h>
+
+#include "configs.h"
+#include "profiler.h"
+
+
+// 단계별 프레임 시간 오버레이 (메인 창 우상단) - f 키로 표시 / 숨김
+// 숫자는 PROFILE_HUD_REFRESH 프레임마다 다시 계산 (백분위는 최근 PROFILE_HISTORY_FRAMES 프레임 기준)
+class ProfilerHud {
+public:
+    void toggleVisible();
+    bool isVisible() const;
+
+    void render();
+
+private:
+    void refresh();
+
+    std::vector<StageSummary> summary;
+    std::vector<char> lines;        // 행마다 PROFILE_HUD_LINE bytes (갱신 때만 포맷)
+    int frames_since_refresh = PROFILE_HUD_REFRESH;
+};
@@ -0,0 +1,328 @@
+#include "progressive_loader.h"
+#include "parallel_utils.h"
+#include "profiler.h"
+
+#include <memory>
+#include <fstream>
+#include <limits>
+#include <algorithm>
+#include <iostream>
+
+
+namespace {
+
+// 구간 끝 last (포함)까지의 프레임을 merger에서 꺼내 out 뒤에 추가, pending은 다음 구간의 첫 프레임
+template <typename Frame>
+void takeUntil(FrameMerger<Frame>& merger, Frame& pending, bool& has_pending, uint64_t last, std::vector<Frame>& out) {
+    while(has_pending && pending.time <= last) {
+        out.push_back(std::move(pending));
+        pending = Frame();
+        has_pending = merger.next(pending);
+    }
+}
+
+uint64_t addSaturate(uint64_t a, uint64_t b) {
+    return (a > std::numeric_limits<uint64_t>::max() - b) ? std::numeric_limits<uint64_t>::max() : a + b;
+}
+
+}
+
+
+ProgressiveLoader::ProgressiveLoader()
+    : cancel(false), frames_total(0), frames_read(0) {}
+
+ProgressiveLoader::~ProgressiveLoader() {
+    cancel = true;      // 종료 시 남은 구간은 버림
+    if(load_thread.joinable()) {
+        load_thread.join();
+    }
+}
+
+void ProgressiveLoader::start(const std::vector<int>& _sensor_ids, const std::vector<std::vector<std::string>>& _lidar_files,
+                              const std::vector<std::string>& _obj_files, const LidarRoi* _roi, bool _compact) {
+    if(load_thread.joinable()) {
+        cancel = true;
+        load_thread.join();
+    }
+    sensor_ids = _sensor_ids;
+    lidar_files = _lidar_files;
+    obj_files = _obj_files;
+    use_roi = (_roi != nullptr);
+    if(use_roi) {
+        roi = *_roi;
+    }
+    compact = _compact;
+    fusion_plan.begin(sensor_ids);
+
+    batches.clear();
+    lidar_capacity = obj_capacity = 0;
+    scanned = finished = false;
+    reserved = complete = overflow = false;
+    loaded_until = 0;
+    lidar_frames = obj_frames = 0;
+    cancel = false;
+    frames_total = 0;
+    frames_read = 0;
+    load_thread = std::thread(&ProgressiveLoader::run, this);
+}
+
+
+void ProgressiveLoader::run() {
+    PROFILE_SCOPE("ProgressiveLoader::run");
+    MyTimer timer;
+    const size_t sensors = sensor_ids.size();
+    const size_t ref = LidarFusion::referenceSensor(sensor_ids);
+
+    // 1. 헤더 스캔 : 프레임 배열 reserve 크기 (병합은 중복 / 늦은 프레임을 버리기만 하므로 상한) + 진행률 분모
+    size_t total = 0, ref_frames = 0, obj_count = 0;
+    HeaderScan scan;
+    for(size_t s = 0; s < sensors; ++s) {
+        for(const std::string& name : lidar_files[s]) {
+            if(BinaryUtils::scan_lidar_headers(name, scan)) {
+                total += scan.frames.size();
+                if(s == ref) ref_frames += scan.frames.size();
+            }
+        }
+    }
+    for(const std::string& name : obj_files) {
+        if(BinaryUtils::scan_obj_headers(name, scan)) {
+            total += scan.frames.size();
+            obj_count += scan.frames.size();
+        }
+    }
+    frames_total = total;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        lidar_capacity = ref_frames;
+        obj_capacity = obj_count;
+        scanned = true;
+    }
+    timer.end();
+    scan_ms = std::chrono::duration<double, std::milli>(timer.end_time - timer.start_time).count();
+
+    // 2. 센서 / 객체마다 파일별 run 병합 (읽은 프레임 수는 진행률로)
+    std::vector<FrameMerger<LidarBinary>> lidar_mergers(sensors);
+    FrameMerger<ObjBinary> obj_merger;
+    roi_stats.assign(sensors, std::vector<RoiStats>());
+    const LidarRoi* active_roi = use_roi ? &roi : nullptr;
+    for(size_t s = 0; s < sensors; ++s) {
+        roi_stats[s].resize(lidar_files[s].size());
+        std::vector<RoiStats>* stats = &roi_stats[s];
+        RecordingMerge::addRunsWith(lidar_files[s], lidar_mergers[s],
+                                    [this, active_roi, stats](std::istream& is, LidarBinary& out, size_t f) {
+            if(!RecordingMerge::readLidarFrame(is, out, active_roi, &(*stats)[f])) {
+                return false;
+            }
+            ++frames_read;
+            return true;
+        });
+    }
+    RecordingMerge::addRunsWith(obj_files, obj_merger, [this](std::istream& is, ObjBinary& out, size_t) {
+        if(!BinaryUtils::read_obj_frame(is, out)) {
+            return false;
+        }
+        ++frames_read;
+        return true;
+    });
+
+    std::vector<LidarBinary> lidar_pending(sensors);
+    std::vector<bool> lidar_has(sensors, false);
+    for(size_t s = 0; s < sensors; ++s) {
+        bool has = lidar_mergers[s].next(lidar_pending[s]);
+        lidar_has[s] = has;
+    }
+    ObjBinary obj_pending;
+    bool obj_has = obj_merger.next(obj_pending);
+
+    // 3. 구간 단위 : 기준 스윕 / 객체 프레임 중 가장 이른 시간부터 LOAD_CHUNK_MS
+    //    다른 센서 스윕은 구간 끝 + FUSION_MAX_TIME_DIFF까지 미리 읽어 창에 두고, 다음 구간과 묶일 수 없는 스윕만 버림
+    std::vector<std::vector<LidarBinary>> windows(sensors);
+    bool first_chunk = true;
+    while(!cancel) {
+        const bool ref_has = sensors > 0 && lidar_has[ref];
+        if(!ref_has && !obj_has) {
+            break;
+        }
+        uint64_t first = ref_has ? lidar_pending[ref].time : obj_pending.time;
+        if(obj_has) first = std::min(first, obj_pending.time);
+        const uint64_t last = addSaturate(first, LOAD_CHUNK_MS - 1);
+
+        Batch batch;
+        batch.until = last;
+        if(sensors > 0) {
+            bool has = lidar_has[ref];
+            takeUntil(lidar_mergers[ref], lidar_pending[ref], has, last, batch.lidar);
+            lidar_has[ref] = has;
+        }
+        for(size_t s = 0; s < sensors; ++s) {
+            if(s == ref) continue;
+            bool has = lidar_has[s];
+            takeUntil(lidar_mergers[s], lidar_pending[s], has, addSaturate(last, FUSION_MAX_TIME_DIFF), windows[s]);
+            lidar_has[s] = has;
+        }
+        bool has = obj_has;
+        takeUntil(obj_merger, obj_pending, has, last, batch.obj);
+        obj_has = has;
+
+        if(sensors > 0) {
+            MyTimer fusion_timer;
+            fusion_plan.fuse(batch.lidar, windows, batch.fusion_offsets, batch.fusion_matched, LOAD_WORKERS);
+            fusion_timer.end();
+            batch.fusion_ms = std::chrono::duration<double, std::milli>(fusion_timer.end_time - fusion_timer.start_time).count();
+        }
+        for(size_t s = 0; s < sensors; ++s) {
+            // 다음 구간 기준 스윕은 last보다 늦음 -> last - FUSION_MAX_TIME_DIFF 이전 스윕은 더 묶일 일 없음
+            auto keep = std::find_if(windows[s].begin(), windows[s].end(), [last](const LidarBinary& frame) {
+                return addSaturate(frame.time, FUSION_MAX_TIME_DIFF) > last;
+            });
+            windows[s].erase(windows[s].begin(), keep);
+        }
+
+        if(compact && !batch.lidar.empty()) {
+            MyTimer compact_timer;
+            batch.compact.resize(batch.lidar.size());
+            parallelFor(batch.lidar.size(), 1, LOAD_WORKERS, [&](size_t begin, size_t end, size_t) {
+                for(size_t i = begin; i < end; ++i) {
+                    CompactLidarStore::encode(batch.lidar[i], batch.compact[i]);
+                    std::vector<LidarData>().swap(batch.lidar[i].lidar_data);
+                }
+            });
+            compact_timer.end();
+            batch.compact_ms = std::chrono::duration<double, std::milli>(compact_timer.end_time - compact_timer.start_time).count();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            batches.push_back(std::move(batch));
+        }
+        if(first_chunk) {
+            first_chunk = false;
+            timer.end();
+            first_chunk_ms = std::chrono::duration<double, std::milli>(timer.end_time - timer.start_time).count();
+        }
+    }
+
+    lidar_merge_stats.clear();
+    for(size_t s = 0; s < sensors; ++s) {
+        lidar_merge_stats.push_back(lidar_mergers[s].getStats());
+    }
+    obj_merge_stats = obj_merger.getStats();
+    timer.end();
+    load_ms = std::chrono::duration<double, std::milli>(timer.end_time - timer.start_time).count();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    finished = true;
+}
+
+
+bool ProgressiveLoader::poll(std::vector<LidarBinary>& lidar_out, std::vector<ObjBinary>& obj_out, LidarFusion& fusion,
+                             CompactLidarStore& compact_store) {
+    if(complete) {
+        return false;
+    }
+    PROFILE_SCOPE("ProgressiveLoader::poll");
+    MyTimer timer;
+    bool changed = false;
+    while(true) {
+        Batch batch;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(!reserved && scanned) {
+                // 처음 한 번 : 헤더 수만큼 자리 확보 -> 이후 push_back은 재할당 없음
+                lidar_out.reserve(lidar_out.size() + lidar_capacity);
+                obj_out.reserve(obj_out.size() + obj_capacity);
+                fusion.begin(sensor_ids);
+                reserved = true;
+            }
+            if(batches.empty()) {
+                if(finished) {
+                    complete = true;
+                    changed = true;
+                }
+                break;
+            }
+            batch = std::move(batches.front());
+            batches.pop_front();
+        }
+
+        // 헤더 수는 상한이라 넘을 수 없지만, 넘으면 재할당 대신 로드를 거기서 끝냄 (이미 넘긴 프레임 주소 보호)
+        if(lidar_out.size() + batch.lidar.size() > lidar_out.capacity() || obj_out.size() + batch.obj.size() > obj_out.capacity()) {
+            std::cerr << "[Load] more frames than the header scan, loading stopped at " << lidar_out.size() << " lidar / "
+                      << obj_out.size() << " obj frames" << std::endl;
+            overflow = true;
+            complete = true;
+            changed = true;
+            cancel = true;
+            break;
+        }
+        for(LidarBinary& frame : batch.lidar) {
+            lidar_out.push_back(std::move(frame));
+        }
+        for(ObjBinary& frame : batch.obj) {
+            obj_out.push_back(std::move(frame));
+        }
+        if(!sensor_ids.empty()) {
+            fusion.commit(lidar_out, batch.fusion_offsets, batch.fusion_matched, batch.fusion_ms);
+        }
+        if(compact) {
+            compact_store.append(batch.compact, batch.compact_ms);
+        }
+        loaded_until = batch.until;
+        lidar_frames = lidar_out.size();
+        obj_frames = obj_out.size();
+        changed = true;
+
+        timer.end();
+        if(std::chrono::duration<double, std::milli>(timer.end_time - timer.start_time).count() >= LOAD_POLL_BUDGET_MS) {
+            break;
+        }
+    }
+    return changed;
+}
+
+
+bool ProgressiveLoader::isComplete() const {
+    return complete;
+}
+
+uint64_t ProgressiveLoader::getLoadedUntil() const {
+    return complete ? std::numeric_limits<uint64_t>::max() : loaded_until;
+}
+
+LoadProgress ProgressiveLoader::getProgress() const {
+    LoadProgress p;
+    p.frames_total = frames_total.load();
+    p.frames_read = frames_read.load();
+    p.lidar_frames = lidar_frames;
+    p.obj_frames = obj_frames;
+    p.complete = complete;
+    return p;
+}
+
+float ProgressiveLoader::getFraction() const {
+    if(complete) {
+        return 1.0f;
+    }
+    const size_t total = frames_total.load();
+    return (total > 0) ? std::min(1.0f, static_cast<float>(frames_read.load()) / total) : 0.0f;
+}
+
+
+void ProgressiveLoader::printReport() const {
+    if(overflow) {
+        return;     // 로드 스레드가 중단 중일 수 있음 -> 통계 없음
+    }
+    for(size_t s = 0; s < lidar_merge_stats.size(); ++s) {
+        RecordingMerge::printStats("lidar_" + std::to_string(sensor_ids[s]), lidar_merge_stats[s]);
+        if(use_roi) {
+            for(size_t f = 0; f < lidar_files[s].size(); ++f) {
+                if(roi_stats[s][f].frames > 0) {
+                    BinaryUtils::print_roi_stats(lidar_files[s][f], roi_stats[s][f]);
+                }
+            }
+        }
+    }
+    RecordingMerge::printStats("detectinfo", obj_merge_stats);
+    std::cout << "[Load] " << lidar_frames << " lidar / " << obj_frames << " obj frames in " << load_ms << " ms (header scan "
+              << scan_ms << " ms, first " << LOAD_CHUNK_MS << " ms chunk playable after " << first_chunk_ms << " ms)" << std::endl;
+}
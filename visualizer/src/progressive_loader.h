@@ -0,0 +1,104 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+#include "configs.h"
+#include "binary_utils.h"
+#include "frame_merge.h"
+#include "lidar_fusion.h"
+#include "compact_lidar.h"
+
+
+// 점진 로드 진행 상황 (메인 스레드에서 읽음)
+struct LoadProgress {
+    size_t frames_total = 0;        // 헤더로 센 프레임 (모든 파일, 헤더 스캔 전 0)
+    size_t frames_read = 0;         // 로드 스레드가 읽은 프레임
+    size_t lidar_frames = 0;        // 메인 스레드 배열로 옮긴 프레임
+    size_t obj_frames = 0;
+    bool complete = false;
+};
+
+// 녹화를 시간 구간(LOAD_CHUNK_MS) 단위로 백그라운드 스레드에서 로드 -> 메인 루프가 poll로 구간씩 받아 재생하면서 나머지를 기다림
+// 로드 스레드 : 헤더 스캔 -> 센서 / 객체 파일마다 FrameMerger 스트리밍 병합 (+ ROI) -> 구간마다 멀티 라이다 융합 (+ --compact 압축)
+// 메인 스레드 : poll에서 준비된 구간을 통째로 프레임 배열 뒤에 옮김 -> 구간 경계 앞 프레임은 모두 들어온 상태라
+//   Timeline::append / extendObjToLidarMapping / appendReverseIndex로 녹화 전체로 만든 것과 같은 결과를 이어 붙일 수 있음
+// 프레임 배열은 처음 poll에서 헤더 수만큼 reserve -> 로드가 끝날 때까지 재할당 없음 (표시 중인 프레임 포인터, 융합 구간 유지)
+class ProgressiveLoader {
+public:
+    ProgressiveLoader();
+    ~ProgressiveLoader();       // 로드 중이면 중단
+
+    // sensor_ids[s] 센서 파일 lidar_files[s], roi : 센서 좌표 기준 관심 영역 (없으면 nullptr), compact : --compact 저장소로 압축
+    void start(const std::vector<int>& sensor_ids, const std::vector<std::vector<std::string>>& lidar_files,
+               const std::vector<std::string>& obj_files, const LidarRoi* roi, bool compact);
+
+    // 메인 스레드 전용 - 준비된 구간을 lidar_out / obj_out 뒤에 옮기고 융합 구간 / 압축 프레임 등록 (LOAD_POLL_BUDGET_MS 안에서 구간 단위)
+    // 옮긴 구간이 있거나 이번에 로드가 끝났으면 true
+    bool poll(std::vector<LidarBinary>& lidar_out, std::vector<ObjBinary>& obj_out, LidarFusion& fusion, CompactLidarStore& compact_store);
+
+    bool isComplete() const;            // 마지막 구간까지 옮김 (메인 스레드)
+    uint64_t getLoadedUntil() const;    // 이 시간까지의 프레임은 모두 옮김, 로드가 끝나면 UINT64_MAX
+    LoadProgress getProgress() const;
+    float getFraction() const;          // 읽은 프레임 / 헤더 프레임 (0 ~ 1)
+
+    // 로드가 끝난 뒤 : 파일별 병합 / ROI 통계, 단계별 시간
+    void printReport() const;
+
+private:
+    struct Batch {
+        std::vector<LidarBinary> lidar;         // 융합 끝난 기준 스윕 (--compact면 점 배열은 비어 있음)
+        std::vector<ObjBinary> obj;
+        std::vector<uint32_t> fusion_offsets;
+        std::vector<size_t> fusion_matched;
+        double fusion_ms = 0.0;
+        std::vector<CompactLidarFrame> compact;
+        double compact_ms = 0.0;
+        uint64_t until = 0;                     // 이 구간의 마지막 시간 (포함)
+    };
+
+    void run();
+
+    std::vector<int> sensor_ids;
+    std::vector<std::vector<std::string>> lidar_files;
+    std::vector<std::string> obj_files;
+    LidarRoi roi;
+    bool use_roi = false;
+    bool compact = false;
+    LidarFusion fusion_plan;                    // 로드 스레드의 fuse용 (slot 구성만, 메인의 LidarFusion과 같은 begin)
+
+    // 로드 스레드 -> 메인 스레드 (mutex)
+    std::mutex mutex;
+    std::deque<Batch> batches;
+    size_t lidar_capacity = 0;                  // 헤더 스캔 결과 (기준 센서 / 객체 파일 프레임 수 상한)
+    size_t obj_capacity = 0;
+    bool scanned = false;
+    bool finished = false;
+
+    std::thread load_thread;
+    std::atomic<bool> cancel;
+    std::atomic<size_t> frames_total;
+    std::atomic<size_t> frames_read;
+
+    // 로드 스레드가 끝난 뒤 읽음 (finished를 mutex로 확인한 뒤)
+    std::vector<MergeStats> lidar_merge_stats;
+    MergeStats obj_merge_stats;
+    std::vector<std::vector<RoiStats>> roi_stats;       // 센서별, 파일별
+    double scan_ms = 0.0;
+    double first_chunk_ms = 0.0;        // 시작부터 첫 구간 준비까지 (재생 시작 지연)
+    double load_ms = 0.0;
+
+    // 메인 스레드
+    bool reserved = false;
+    bool complete = false;
+    bool overflow = false;
+    uint64_t loaded_until = 0;
+    size_t lidar_frames = 0;
+    size_t obj_frames = 0;
+};
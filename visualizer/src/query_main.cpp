@@ -0,0 +1,63 @@
+// 검출 역색인 CLI : 창 없이 객체인식 파일만 읽어 조회
+// Usage: ./aeronSW_query [start_time] [end_time] [query] ...
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <filesystem>
+
+#include "configs.h"
+#include "binary_utils.h"
+#include "recording_files.h"
+#include "frame_merge.h"
+#include "detection_index.h"
+
+
+int main(int argc, char* argv[]) {
+    if(argc < 4) {
+        std::cout << "Usage: ./aeronSW_query [start_time] [end_time] [query] ...\nTime Format: yy-MM-dd-HH-mm-ss\n"
+                  << "Query: label[<max_distance][>min_distance][:first] (e.g. person<15, truck:first)" << std::endl;
+        return -1;
+    }
+
+    std::string uam_data_path = UAM_DATA_PATH;
+    if(!std::filesystem::exists(uam_data_path)) {
+        std::cerr << "UAM data directory is not found: " << uam_data_path << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> lidar_files, detectinfo_files;
+    if(!RecordingFiles::collect(uam_data_path, argv[1], argv[2], lidar_files, detectinfo_files)) {
+        return 1;
+    }
+
+    MyTimer load_timer;
+    std::vector<ObjBinary> obj_loaded_bin;
+    MergeStats merge_stats;
+    RecordingMerge::loadObj(detectinfo_files, obj_loaded_bin, merge_stats);
+    load_timer.end();
+
+    DetectionIndex index;
+    index.build(obj_loaded_bin);
+    std::cout << "Detection frames: " << obj_loaded_bin.size() << " (" << detectinfo_files.size() << " files, "
+              << load_timer.elapsed_ms() << " ms, " << merge_stats.duplicates << " duplicates dropped), postings: " << index.getPostingCount()
+              << " (" << index.getElapsedMs() << " ms)" << std::endl;
+
+    std::vector<uint32_t> hits;
+    for(int i = 3; i < argc; ++i) {
+        DetectionQuery query;
+        if(!DetectionIndex::parseQuery(argv[i], query)) {
+            continue;
+        }
+        MyTimer timer;
+        index.find(query, hits);
+        timer.end();
+
+        std::cout << "\n[" << argv[i] << "] " << hits.size() << " frames ("
+                  << std::chrono::duration<double, std::milli>(timer.end_time - timer.start_time).count() << " ms)" << std::endl;
+        for(uint32_t f : hits) {
+            std::cout << "  obj idx = " << f << ", time = " << obj_loaded_bin[f].time << std::endl;
+        }
+    }
+    return 0;
+}
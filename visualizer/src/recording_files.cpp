@@ -0,0 +1,113 @@
+#include "recording_files.h"
+#include "binary_utils.h"
+
+#include <filesystem>
+#include <algorithm>
+#include <map>
+#include <iostream>
+
+
+bool RecordingFiles::collect(const std::string& data_path, const std::string& start_time, const std::string& end_time,
+                             std::vector<std::string>& out_lidar_files, std::vector<std::string>& out_detectinfo_files) {
+    out_lidar_files.clear();
+
+    std::vector<int> sensor_ids;
+    std::vector<std::vector<std::string>> sensor_files;
+    if(!collectSensors(data_path, start_time, end_time, sensor_ids, sensor_files, out_detectinfo_files)) {
+        return false;
+    }
+    for(size_t s = 0; s < sensor_ids.size(); ++s) {
+        if(sensor_ids[s] == LIDAR_ID) {
+            out_lidar_files = std::move(sensor_files[s]);
+        }
+    }
+    return true;
+}
+
+bool RecordingFiles::collectSensors(const std::string& data_path, const std::string& start_time, const std::string& end_time,
+                                    std::vector<int>& out_sensor_ids, std::vector<std::vector<std::string>>& out_lidar_files,
+                                    std::vector<std::string>& out_detectinfo_files) {
+    out_sensor_ids.clear();
+    out_lidar_files.clear();
+    out_detectinfo_files.clear();
+
+    std::map<int, std::vector<std::string>> sensors;
+    for(const auto& entry : std::filesystem::directory_iterator(data_path)) {
+        std::string filename = entry.path().filename().string();  // 파일 이름만 추출
+        
+        if(getFileExtension(filename) == "uld") {
+            int sensor_id;
+            std::string time;
+            if(!parseLidarName(removeFileExtension(filename), sensor_id, time)) {
+                std::cout << "Warning: unknown lidar file name, skipped: " << filename << std::endl;
+                continue;
+            }
+            if(time >= start_time && time <= end_time) {
+                sensors[sensor_id].push_back(data_path + "/" + filename);
+            }
+        }
+        else if(getFileExtension(filename) == "udd") {
+            std::string detectinfo_start_time = "detectinfo_" + start_time;
+            std::string detectinfo_end_time = "detectinfo_" + end_time;
+
+            std::string _filename = removeFileExtension(filename);
+
+            if(_filename >= detectinfo_start_time && _filename <= detectinfo_end_time) {
+                out_detectinfo_files.push_back(data_path + "/" + filename);
+            }
+        }
+        else {
+            std::cout << "Error: file extension is not .uld or .udd" << std::endl;
+            return false;
+        }
+    }
+
+    for(auto& sensor : sensors) {
+        std::sort(sensor.second.begin(), sensor.second.end());    // 불러온 파일들 시간순 정렬
+        out_sensor_ids.push_back(sensor.first);
+        out_lidar_files.push_back(std::move(sensor.second));
+    }
+    std::sort(out_detectinfo_files.begin(), out_detectinfo_files.end());
+    return true;
+}
+
+bool RecordingFiles::parseLidarName(const std::string& name, int& out_sensor_id, std::string& out_time) {
+    const std::string prefix = "lidar_";
+    if(name.compare(0, prefix.size(), prefix) != 0) {
+        return false;
+    }
+    size_t sep = name.find('_', prefix.size());
+    if(sep == std::string::npos || sep == prefix.size()) {
+        return false;
+    }
+    int id = 0;
+    for(size_t i = prefix.size(); i < sep; ++i) {
+        if(name[i] < '0' || name[i] > '9') return false;
+        id = id * 10 + (name[i] - '0');
+    }
+    out_sensor_id = id;
+    out_time = name.substr(sep + 1);
+    return true;
+}
+
+
+std::string RecordingFiles::getFileExtension(const std::string& fileName) {
+    // 마지막 '.'의 위치를 찾음
+    size_t dotPos = fileName.rfind('.');
+    if (dotPos == std::string::npos) {
+        // '.'이 없다면 확장자가 없는 경우
+        return "";
+    }
+    // '.' 이후의 문자열 반환
+    return fileName.substr(dotPos + 1);
+}
+
+std::string RecordingFiles::removeFileExtension(const std::string& fileName) {
+    size_t lastDot = fileName.find_last_of('.');
+    if(lastDot == std::string::npos) {
+        // '.'이 없다면 확장자가 없다고 간주하고 원본 파일명 그대로 반환
+        return fileName;
+    }
+    // 파일명 문자열의 처음부터 '.' 직전까지의 부분 문자열을 잘라서 반환
+    return fileName.substr(0, lastDot);
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+
+// uam_data 디렉토리에서 녹화 구간에 해당하는 라이다(.uld) / 객체인식(.udd) 파일 수집 (뷰어, CLI 공용)
+// collect는 기준 센서(LIDAR_ID)만, collectSensors는 모든 센서
+class RecordingFiles {
+public:
+    // 파일명 시간 문자열 기준 [start_time, end_time] 구간, 시간순 정렬
+    // .uld / .udd 외의 파일이 있으면 false
+    static bool collect(const std::string& data_path, const std::string& start_time, const std::string& end_time,
+                        std::vector<std::string>& out_lidar_files, std::vector<std::string>& out_detectinfo_files);
+
+    // 모든 라이다 센서 (lidar_[id]_[time].uld) - sensor id 오름차순, 센서마다 시간순 파일 목록
+    static bool collectSensors(const std::string& data_path, const std::string& start_time, const std::string& end_time,
+                               std::vector<int>& out_sensor_ids, std::vector<std::vector<std::string>>& out_lidar_files,
+                               std::vector<std::string>& out_detectinfo_files);
+
+    // "lidar_3_24-01-01-00-00-00" -> 3, "24-01-01-00-00-00"
+    static bool parseLidarName(const std::string& name, int& out_sensor_id, std::string& out_time);
+
+    static std::string getFileExtension(const std::string& fileName);
+    static std::string removeFileExtension(const std::string& fileName);
+};
@@ -0,0 +1,400 @@
+#include "recording_generator.h"
+#include "configs.h"
+#include "parallel_utils.h"
+
+#include <cmath>
+#include <ctime>
+#include <cstdio>
+#include <limits>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <filesystem>
+
+
+// 합성 장면 형상
+#define GEN_SWEEP_RINGS     64          // 수직 채널 수
+#define GEN_ELEV_MIN        -25.0f      // degree
+#define GEN_ELEV_MAX        15.0f       // degree
+#define GEN_SENSOR_HEIGHT   1.8f        // 지면 z = -GEN_SENSOR_HEIGHT // m
+#define GEN_AREA_HALF       40.0f       // 물체가 움직이는 영역 (원점 기준 ±) // m
+#define GEN_OBJECT_POINTS   400         // 물체 하나의 최대 점 수
+#define GEN_BAD_TIME        123456789ULL
+
+
+// splitmix64 - (seed, 번호)로 독립 난수열 시작점
+static inline uint64_t splitmix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// xorshift64* - 점마다 부르므로 std 분포 대신 가벼운 생성기
+struct FastRng {
+    uint64_t s;
+    FastRng(uint64_t seed, uint64_t stream) : s(splitmix(seed ^ splitmix(stream)) | 1) {}
+    uint64_t next() {
+        s ^= s >> 12;
+        s ^= s << 25;
+        s ^= s >> 27;
+        return s * 2685821657736338717ULL;
+    }
+    float uniform() { return static_cast<float>(next() >> 40) * (1.0f / 16777216.0f); }     // [0, 1)
+    float range(float a, float b) { return a + (b - a) * uniform(); }
+};
+
+// 난수열 구분 (같은 seed에서 용도별로 겹치지 않도록)
+enum : uint64_t { STREAM_SCENE = 1ULL << 60, STREAM_LIDAR = 2ULL << 60, STREAM_OBJ = 3ULL << 60, STREAM_PLAN = 4ULL << 60 };
+
+// [lo, hi] 사이를 왕복 (벽에서 튕기는 물체)
+static inline float fold(float v, float lo, float hi) {
+    float span = hi - lo;
+    float m = std::fmod(v - lo, 2.0f * span);
+    if(m < 0.0f) m += 2.0f * span;
+    return lo + ((m < span) ? m : 2.0f * span - m);
+}
+
+
+RecordingGenerator::RecordingGenerator(const GeneratorOptions& options) : options(options) {
+    int yy, MM, dd, HH, mm, ss;
+    if(std::sscanf(options.start_time.c_str(), "%d-%d-%d-%d-%d-%d", &yy, &MM, &dd, &HH, &mm, &ss) == 6) {
+        std::tm tm = {};
+        tm.tm_year = yy + 100;
+        tm.tm_mon = MM - 1;
+        tm.tm_mday = dd;
+        tm.tm_hour = HH;
+        tm.tm_min = mm;
+        tm.tm_sec = ss;
+        tm.tm_isdst = -1;
+        std::time_t t = std::mktime(&tm);
+        if(t > 0) start_ms = static_cast<uint64_t>(t) * 1000ULL;
+    }
+
+    // 움직이는 물체 (검출과 같은 물체가 점으로도 보이도록)
+    static const struct { int obj_id; glm::vec3 dims; float speed; } kinds[] = {
+        {0, glm::vec3(0.6f, 0.6f, 1.7f), 1.4f},     // person
+        {2, glm::vec3(4.5f, 1.8f, 1.5f), 10.0f},    // car
+        {1, glm::vec3(1.8f, 0.6f, 1.5f), 5.0f},     // bicycle
+        {7, glm::vec3(8.0f, 2.5f, 3.0f), 8.0f},     // truck
+    };
+    FastRng rng(options.seed, STREAM_SCENE);
+    objects.resize(options.detections);
+    for(auto& o : objects) {
+        const auto& kind = kinds[rng.next() % 4];
+        float angle = rng.range(0.0f, 2.0f * glm::pi<float>());
+        float radius = rng.range(6.0f, 35.0f);
+        float heading = rng.range(0.0f, 2.0f * glm::pi<float>());
+        o.obj_id = kind.obj_id;
+        o.dims = kind.dims;
+        o.start = glm::vec3(radius * std::cos(angle), radius * std::sin(angle), -GEN_SENSOR_HEIGHT + 0.5f * kind.dims.z);
+        o.velocity = kind.speed * glm::vec3(std::cos(heading), std::sin(heading), 0.0f);
+    }
+
+    object_points = 0;
+    if(options.detections > 0) {
+        object_points = std::min<uint32_t>(GEN_OBJECT_POINTS, options.points / (4 * options.detections));
+    }
+
+    // 배경 스윕 : 방위각 열 단위 (열마다 GEN_SWEEP_RINGS 채널), 아래 채널은 지면, 나머지는 방위각에 따라 거리가 바뀌는 벽
+    size_t base = options.points - static_cast<size_t>(object_points) * options.detections;
+    size_t columns = (base + GEN_SWEEP_RINGS - 1) / GEN_SWEEP_RINGS;
+    base_sweep.resize(base);
+    for(size_t i = 0; i < base; ++i) {
+        size_t col = i / GEN_SWEEP_RINGS;
+        size_t ring = i % GEN_SWEEP_RINGS;
+        float elev = glm::radians(GEN_ELEV_MIN + (GEN_ELEV_MAX - GEN_ELEV_MIN) * ring / (GEN_SWEEP_RINGS - 1));
+        float az = 2.0f * glm::pi<float>() * col / columns;
+        float wall = 25.0f + 10.0f * std::sin(3.0f * az) + 5.0f * std::sin(7.0f * az + 1.0f);
+        float range = wall;
+        bool ground = false;
+        if(elev < 0.0f) {
+            float g = GEN_SENSOR_HEIGHT / std::tan(-elev);
+            if(g < wall) {
+                range = g;
+                ground = true;
+            }
+        }
+        LidarData& p = base_sweep[i];
+        p.x = range * std::cos(az);
+        p.y = range * std::sin(az);
+        p.z = ground ? -GEN_SENSOR_HEIGHT : range * std::tan(elev);
+        p.reflectivity = ground ? static_cast<uint32_t>(rng.range(2.0f, 8.0f)) : static_cast<uint32_t>(rng.range(8.0f, 18.0f));
+        p.cluster_id = -1;
+    }
+}
+
+
+uint64_t RecordingGenerator::getStartTimeMs() const {
+    return start_ms;
+}
+
+size_t RecordingGenerator::getLidarFrameCount() const {
+    return lidar_frames;
+}
+
+size_t RecordingGenerator::getObjFrameCount() const {
+    return obj_frames;
+}
+
+size_t RecordingGenerator::getFileCount() const {
+    return file_count;
+}
+
+uint64_t RecordingGenerator::getBytesWritten() const {
+    return bytes_written;
+}
+
+double RecordingGenerator::getElapsedMs() const {
+    return elapsed_ms;
+}
+
+size_t RecordingGenerator::getCorruptionCount(Corruption kind) const {
+    return corruption_counts[kind];
+}
+
+
+glm::vec3 RecordingGenerator::objectCenter(const MovingObject& object, uint64_t time) const {
+    float dt = static_cast<float>(static_cast<int64_t>(time - start_ms)) / 1000.0f;
+    glm::vec3 p = object.start + object.velocity * dt;
+    return glm::vec3(fold(p.x, -GEN_AREA_HALF, GEN_AREA_HALF), fold(p.y, -GEN_AREA_HALF, GEN_AREA_HALF), p.z);
+}
+
+
+void RecordingGenerator::makeLidarFrame(uint64_t frame_idx, uint64_t time, LidarBinary& out) const {
+    FastRng rng(options.seed, STREAM_LIDAR + frame_idx);
+    out.time = time;
+    out.num = options.points;
+    out.lidar_data.resize(options.points);
+
+    // 배경 : 거리 방향 잡음 (난수 하나를 둘로 나눠 사용)
+    LidarData* dst = out.lidar_data.data();
+    const size_t base = base_sweep.size();
+    for(size_t i = 0; i < base; ++i) {
+        const LidarData& src = base_sweep[i];
+        uint64_t r = rng.next();
+        float scale = 1.0f + (static_cast<float>(r & 0xFFFF) * (1.0f / 65536.0f) - 0.5f) * 0.004f;
+        dst[i].x = src.x * scale;
+        dst[i].y = src.y * scale;
+        dst[i].z = src.z + (static_cast<float>((r >> 16) & 0xFFFF) * (1.0f / 65536.0f) - 0.5f) * 0.04f;
+        dst[i].reflectivity = src.reflectivity;
+        dst[i].cluster_id = -1;
+    }
+
+    // 물체 : 현재 위치 박스 안 점
+    size_t idx = base;
+    for(size_t k = 0; k < objects.size(); ++k) {
+        glm::vec3 c = objectCenter(objects[k], time);
+        glm::vec3 d = objects[k].dims;
+        for(uint32_t j = 0; j < object_points; ++j, ++idx) {
+            LidarData& p = dst[idx];
+            p.x = c.x + (rng.uniform() - 0.5f) * d.x;
+            p.y = c.y + (rng.uniform() - 0.5f) * d.y;
+            p.z = c.z + (rng.uniform() - 0.5f) * d.z;
+            p.reflectivity = static_cast<uint32_t>(rng.range(15.0f, 26.0f));
+            p.cluster_id = static_cast<int>(k);
+        }
+    }
+}
+
+void RecordingGenerator::makeObjFrame(uint64_t frame_idx, uint64_t time, ObjBinary& out) const {
+    FastRng rng(options.seed, STREAM_OBJ + frame_idx);
+    out.time = time;
+    out.num = static_cast<uint32_t>(objects.size());
+    out.obj_data.resize(objects.size());
+    for(size_t k = 0; k < objects.size(); ++k) {
+        glm::vec3 c = objectCenter(objects[k], time) + glm::vec3(rng.range(-0.1f, 0.1f), rng.range(-0.1f, 0.1f), 0.0f);
+        glm::vec3 half = 0.5f * objects[k].dims;
+        glm::vec3 lo = c - half, hi = c + half;
+        glm::vec3 nearest = glm::clamp(glm::vec3(0.0f), lo, hi);      // 센서(원점)에 가장 가까운 박스 점
+
+        ObjData& o = out.obj_data[k];
+        o.obj_id = objects[k].obj_id;
+        o.nearest_x = nearest.x;    o.nearest_y = nearest.y;    o.nearest_z = nearest.z;
+        o.min_x = lo.x;             o.min_y = lo.y;             o.min_z = lo.z;
+        o.max_x = hi.x;             o.max_y = hi.y;             o.max_z = hi.z;
+        o.distance = glm::length(nearest);
+        o.size = std::max(objects[k].dims.x, std::max(objects[k].dims.y, objects[k].dims.z));
+    }
+}
+
+
+// 시간 흔들림 / 중복 / 순서 뒤바뀜 / 손상 종류 결정 (파일 단위, 직렬)
+void RecordingGenerator::planFrames(uint64_t first_idx, uint64_t count, double hz, bool lidar, std::vector<FramePlan>& out_plans) const {
+    FastRng rng(options.seed, STREAM_PLAN + (first_idx << 1) + (lidar ? 1 : 0));
+    out_plans.resize(count);
+    for(uint64_t i = 0; i < count; ++i) {
+        FramePlan& plan = out_plans[i];
+        double nominal = static_cast<double>(start_ms) + static_cast<double>(first_idx + i) * 1000.0 / hz;
+        double jitter = (options.jitter_ms > 0.0) ? (rng.uniform() * 2.0 - 1.0) * options.jitter_ms : 0.0;
+        plan.time = static_cast<uint64_t>(std::llround(nominal + jitter));
+        plan.corruption = CORRUPT_NONE;
+
+        if(i > 0 && rng.uniform() < options.duplicate_rate) {
+            plan.time = out_plans[i - 1].time;
+        }
+        if(i > 0 && rng.uniform() < options.reorder_rate) {
+            std::swap(plan.time, out_plans[i - 1].time);
+        }
+        if(rng.uniform() < options.corrupt_rate) {
+            static const uint8_t lidar_kinds[] = {CORRUPT_EMPTY, CORRUPT_BAD_TIME, CORRUPT_NAN};
+            static const uint8_t obj_kinds[] = {CORRUPT_EMPTY, CORRUPT_BAD_TIME, CORRUPT_HUGE_COUNT};
+            plan.corruption = lidar ? lidar_kinds[rng.next() % 3] : obj_kinds[rng.next() % 3];
+        }
+    }
+    if(count > 0 && rng.uniform() < options.corrupt_rate) {
+        out_plans[count - 1].corruption = CORRUPT_TRUNCATED;
+    }
+}
+
+
+bool RecordingGenerator::writeLidarFile(const std::string& filename, uint64_t first_idx, const std::vector<FramePlan>& plans) {
+    std::ofstream ofs(filename, std::ios::binary);
+    if(!ofs) {
+        std::cerr << "Failed to open output file: " << filename << std::endl;
+        return false;
+    }
+
+    // 묶음 2개 교대 : 한 묶음을 쓰는 동안 다음 묶음 합성
+    const size_t batch_size = WorkerPool::instance().size() * GEN_BATCH_PER_WORKER;
+    std::vector<LidarBinary> batches[2];
+    batches[0].resize(batch_size);
+    batches[1].resize(batch_size);
+
+    std::atomic<bool> write_ok(true);
+    auto writeBatch = [&](const std::vector<LidarBinary>& frames, size_t begin, size_t count) {
+        for(size_t i = 0; i < count && write_ok; ++i) {
+            const LidarBinary& f = frames[i];
+            uint8_t kind = plans[begin + i].corruption;
+            uint64_t time = (kind == CORRUPT_BAD_TIME) ? GEN_BAD_TIME : f.time;
+            uint32_t num = (kind == CORRUPT_EMPTY) ? 0 : f.num;
+            size_t bytes = (kind == CORRUPT_EMPTY) ? 0 : f.lidar_data.size() * sizeof(LidarData);
+            if(kind == CORRUPT_TRUNCATED) bytes /= 2;
+            ofs.write(reinterpret_cast<const char*>(&time), sizeof(time));
+            ofs.write(reinterpret_cast<const char*>(&num), sizeof(num));
+            ofs.write(reinterpret_cast<const char*>(f.lidar_data.data()), static_cast<std::streamsize>(bytes));
+            write_ok = !ofs.fail();
+            bytes_written += sizeof(time) + sizeof(num) + bytes;
+        }
+    };
+
+    std::thread writer;
+    size_t cur = 0;
+    for(size_t begin = 0; begin < plans.size() && write_ok; begin += batch_size) {
+        size_t count = std::min(batch_size, plans.size() - begin);
+        std::vector<LidarBinary>& frames = batches[cur];
+        parallelFor(count, 1, [&](size_t b, size_t e, size_t) {
+            for(size_t i = b; i < e; ++i) {
+                makeLidarFrame(first_idx + begin + i, plans[begin + i].time, frames[i]);
+                if(plans[begin + i].corruption == CORRUPT_NAN) {
+                    for(size_t j = 0; j < frames[i].lidar_data.size(); j += 97) {
+                        frames[i].lidar_data[j].x = std::numeric_limits<float>::quiet_NaN();
+                        frames[i].lidar_data[j].y = std::numeric_limits<float>::infinity();
+                    }
+                }
+            }
+        });
+        for(size_t i = 0; i < count; ++i) {
+            ++corruption_counts[plans[begin + i].corruption];
+        }
+        if(writer.joinable()) {
+            writer.join();
+        }
+        writer = std::thread(writeBatch, std::cref(frames), begin, count);
+        cur ^= 1;
+    }
+    if(writer.joinable()) {
+        writer.join();
+    }
+    if(!write_ok) {
+        std::cerr << "Failed to write output file: " << filename << std::endl;
+    }
+    return write_ok.load();
+}
+
+bool RecordingGenerator::writeObjFile(const std::string& filename, uint64_t first_idx, const std::vector<FramePlan>& plans) {
+    std::ofstream ofs(filename, std::ios::binary);
+    if(!ofs) {
+        std::cerr << "Failed to open output file: " << filename << std::endl;
+        return false;
+    }
+
+    ObjBinary frame;
+    for(size_t i = 0; i < plans.size(); ++i) {
+        makeObjFrame(first_idx + i, plans[i].time, frame);
+        uint8_t kind = plans[i].corruption;
+        ++corruption_counts[kind];
+
+        uint64_t time = (kind == CORRUPT_BAD_TIME) ? GEN_BAD_TIME : frame.time;
+        uint32_t num = (kind == CORRUPT_EMPTY) ? 0 : (kind == CORRUPT_HUGE_COUNT) ? 0x7FFFFFF0u : frame.num;
+        size_t bytes = (kind == CORRUPT_EMPTY) ? 0 : frame.obj_data.size() * sizeof(ObjData);
+        if(kind == CORRUPT_TRUNCATED) bytes /= 2;
+        ofs.write(reinterpret_cast<const char*>(&time), sizeof(time));
+        ofs.write(reinterpret_cast<const char*>(&num), sizeof(num));
+        ofs.write(reinterpret_cast<const char*>(frame.obj_data.data()), static_cast<std::streamsize>(bytes));
+        bytes_written += sizeof(time) + sizeof(num) + bytes;
+    }
+    if(!ofs) {
+        std::cerr << "Failed to write output file: " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+bool RecordingGenerator::run() {
+    MyTimer timer;
+    if(start_ms == 0) {
+        std::cerr << "Invalid start time (yy-MM-dd-HH-mm-ss): " << options.start_time << std::endl;
+        return false;
+    }
+    if(options.sweep_hz <= 0.0 || options.obj_hz <= 0.0 || options.file_seconds <= 0.0) {
+        std::cerr << "Rates and file length must be positive" << std::endl;
+        return false;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(options.out_dir, ec);
+    if(ec) {
+        std::cerr << "Failed to create output directory: " << options.out_dir << std::endl;
+        return false;
+    }
+
+    lidar_frames = 0;
+    obj_frames = 0;
+    file_count = 0;
+    bytes_written = 0;
+    std::fill(std::begin(corruption_counts), std::end(corruption_counts), 0);
+
+    const uint64_t total_lidar = static_cast<uint64_t>(options.seconds * options.sweep_hz);
+    const uint64_t total_obj = static_cast<uint64_t>(options.seconds * options.obj_hz);
+    std::vector<FramePlan> plans;
+
+    // 파일 하나 = file_seconds 구간, 파일명은 구간 시작 시간 (RecordingFiles::collect 형식)
+    for(double t = 0.0; t < options.seconds; t += options.file_seconds) {
+        double t_end = std::min(t + options.file_seconds, options.seconds);
+        std::time_t sec = static_cast<std::time_t>((start_ms + static_cast<uint64_t>(t * 1000.0)) / 1000);
+        char time_str[32];
+        std::strftime(time_str, sizeof(time_str), "%y-%m-%d-%H-%M-%S", std::localtime(&sec));
+
+        uint64_t lidar_begin = std::min(total_lidar, static_cast<uint64_t>(std::ceil(t * options.sweep_hz)));
+        uint64_t lidar_end = std::min(total_lidar, static_cast<uint64_t>(std::ceil(t_end * options.sweep_hz)));
+        planFrames(lidar_begin, lidar_end - lidar_begin, options.sweep_hz, true, plans);
+        if(!writeLidarFile(options.out_dir + "/lidar_0_" + time_str + ".uld", lidar_begin, plans)) {
+            return false;
+        }
+        lidar_frames += plans.size();
+
+        uint64_t obj_begin = std::min(total_obj, static_cast<uint64_t>(std::ceil(t * options.obj_hz)));
+        uint64_t obj_end = std::min(total_obj, static_cast<uint64_t>(std::ceil(t_end * options.obj_hz)));
+        planFrames(obj_begin, obj_end - obj_begin, options.obj_hz, false, plans);
+        if(!writeObjFile(options.out_dir + "/detectinfo_" + time_str + ".udd", obj_begin, plans)) {
+            return false;
+        }
+        obj_frames += plans.size();
+        file_count += 2;
+    }
+
+    timer.end();
+    elapsed_ms = std::chrono::duration<double, std::milli>(timer.end_time - timer.start_time).count();
+    return true;
+}
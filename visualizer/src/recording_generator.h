@@ -0,0 +1,88 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+
+#include "binary_utils.h"
+
+
+struct GeneratorOptions {
+    std::string out_dir = ".";
+    std::string start_time = "24-01-01-00-00-00";   // 파일명 / 첫 프레임 시간 (yy-MM-dd-HH-mm-ss, 로컬 시간)
+    double seconds = 60.0;              // 녹화 길이
+    double file_seconds = 60.0;         // 파일 하나 길이 (실제 녹화처럼 구간을 여러 파일로 나눔)
+    double sweep_hz = 10.0;             // 라이다 회전 주기
+    double obj_hz = 10.0;               // 객체인식 주기
+    uint32_t points = 65536;            // 스윕당 점 수
+    uint32_t detections = 8;            // 객체인식 프레임당 검출 수 (= 움직이는 물체 수)
+    double jitter_ms = 0.0;             // 프레임 시간 ± 흔들림
+    double reorder_rate = 0.0;          // 직전 프레임과 시간이 뒤바뀌는 비율
+    double duplicate_rate = 0.0;        // 직전 프레임 시간이 반복되는 비율
+    double corrupt_rate = 0.0;          // 손상 레코드 비율 (파일마다 같은 비율로 마지막 레코드 잘림)
+    uint64_t seed = 1;
+};
+
+// 합성 녹화 생성기 - LidarBinary / ObjBinary 레코드 배치 그대로 .uld / .udd 작성
+// 스윕 기본 형상(지면 + 벽)은 한 번만 만들고 프레임마다 잡음 + 움직이는 물체 점만 새로 채움 -> 점 생성이 쓰기보다 빠름
+// 프레임 합성은 worker pool에서 프레임 단위 병렬, 쓰기는 별도 스레드 (묶음 2개 교대)
+// 프레임마다 (seed, 프레임 번호)로 난수를 시작 -> worker 수와 무관하게 같은 출력
+class RecordingGenerator {
+public:
+    enum Corruption : uint8_t {
+        CORRUPT_NONE = 0,
+        CORRUPT_EMPTY,          // num = 0 헤더만 (로더가 건너뜀)
+        CORRUPT_BAD_TIME,       // 범위 밖 시간 + payload (로더는 payload를 헤더로 읽게 됨)
+        CORRUPT_NAN,            // 라이다 : 일부 점 좌표 NaN / inf
+        CORRUPT_HUGE_COUNT,     // 객체인식 : 비정상적으로 큰 num
+        CORRUPT_TRUNCATED,      // 파일 마지막 레코드가 중간에 끊김
+        CORRUPT_KIND_COUNT
+    };
+
+    explicit RecordingGenerator(const GeneratorOptions& options);
+
+    bool run();
+
+    // 프레임 합성 (벤치마크 등에서 직접 사용)
+    void makeLidarFrame(uint64_t frame_idx, uint64_t time, LidarBinary& out) const;
+    void makeObjFrame(uint64_t frame_idx, uint64_t time, ObjBinary& out) const;
+
+    uint64_t getStartTimeMs() const;
+    size_t getLidarFrameCount() const;
+    size_t getObjFrameCount() const;
+    size_t getFileCount() const;
+    uint64_t getBytesWritten() const;
+    double getElapsedMs() const;
+    size_t getCorruptionCount(Corruption kind) const;
+
+private:
+    struct FramePlan {
+        uint64_t time;
+        uint8_t corruption;
+    };
+    struct MovingObject {
+        int obj_id;
+        glm::vec3 start;
+        glm::vec3 velocity;     // m/s
+        glm::vec3 dims;
+    };
+
+    void planFrames(uint64_t first_idx, uint64_t count, double hz, bool lidar, std::vector<FramePlan>& out_plans) const;
+    glm::vec3 objectCenter(const MovingObject& object, uint64_t time) const;
+    bool writeLidarFile(const std::string& filename, uint64_t first_idx, const std::vector<FramePlan>& plans);
+    bool writeObjFile(const std::string& filename, uint64_t first_idx, const std::vector<FramePlan>& plans);
+
+    GeneratorOptions options;
+    uint64_t start_ms = 0;
+    uint32_t object_points = 0;             // 물체 하나의 점 수
+    std::vector<LidarData> base_sweep;      // 정적 배경 스윕 (points - 물체 점)
+    std::vector<MovingObject> objects;
+
+    size_t lidar_frames = 0;
+    size_t obj_frames = 0;
+    size_t file_count = 0;
+    uint64_t bytes_written = 0;
+    double elapsed_ms = 0.0;
+    size_t corruption_counts[CORRUPT_KIND_COUNT] = {};
+};
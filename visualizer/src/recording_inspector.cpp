@@ -0,0 +1,351 @@
+#include "recording_inspector.h"
+#include "configs.h"
+#include "timeline.h"
+#include "parallel_utils.h"
+
+#include <ctime>
+#include <cstdio>
+#include <memory>
+#include <fstream>
+#include <algorithm>
+#include <filesystem>
+#include <unordered_map>
+
+
+// Space::formatUnixTime과 같은 형식 (GL 없는 CLI용)
+static std::string formatTime(uint64_t unixtime) {
+    std::time_t sec_time = static_cast<std::time_t>(unixtime / 1000);
+    std::tm tm_buf;
+    localtime_r(&sec_time, &tm_buf);
+    char buf[40];
+    size_t n = std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &tm_buf);
+    snprintf(buf + n, sizeof(buf) - n, ".%03u", static_cast<unsigned>(unixtime % 1000));
+    return buf;
+}
+
+static std::string formatDuration(uint64_t ms) {
+    char buf[40];
+    snprintf(buf, sizeof(buf), "%02llu:%02llu:%02llu.%03llu", static_cast<unsigned long long>(ms / 3600000),
+             static_cast<unsigned long long>(ms / 60000 % 60), static_cast<unsigned long long>(ms / 1000 % 60),
+             static_cast<unsigned long long>(ms % 1000));
+    return buf;
+}
+
+static std::string formatBytes(uint64_t bytes) {
+    char buf[32];
+    if(bytes >= (1ULL << 30))       snprintf(buf, sizeof(buf), "%.2f GB", bytes / double(1ULL << 30));
+    else if(bytes >= (1ULL << 20))  snprintf(buf, sizeof(buf), "%.1f MB", bytes / double(1ULL << 20));
+    else                            snprintf(buf, sizeof(buf), "%.1f KB", bytes / 1024.0);
+    return buf;
+}
+
+
+bool RecordingInspector::run(const std::vector<std::string>& lidar_files, const std::vector<std::string>& obj_files) {
+    MyTimer timer;
+
+    const size_t lidar_count = lidar_files.size();
+    const size_t count = lidar_count + obj_files.size();
+    files.assign(count, FileSummary());
+    std::vector<std::vector<FrameHeader>> headers(count);
+    std::vector<std::vector<ObjBinary>> obj_file_frames(obj_files.size());
+    std::vector<uint64_t> file_bytes_read(count, 0);
+    std::vector<char> file_ok(count, 0);
+
+    // 파일 하나 = 작업 하나 (헤더 훑기는 seek 위주라 파일끼리 독립)
+    parallelFor(count, 1, [&](size_t begin, size_t end, size_t) {
+        for(size_t f = begin; f < end; ++f) {
+            FileSummary& file = files[f];
+            file.lidar = (f < lidar_count);
+            file.path = file.lidar ? lidar_files[f] : obj_files[f - lidar_count];
+
+            HeaderScan scan;
+            bool ok = file.lidar ? BinaryUtils::scan_lidar_headers(file.path, scan) : BinaryUtils::scan_obj_headers(file.path, scan);
+            file_ok[f] = ok;
+            if(!ok) continue;
+
+            file.file_size = scan.file_size;
+            file.frames = scan.frames.size();
+            file.skipped = scan.skipped;
+            file.truncated = scan.truncated;
+            if(!scan.frames.empty()) {
+                file.first_time = scan.frames.front().time;
+                file.last_time = scan.frames.back().time;
+            }
+            file_bytes_read[f] = (scan.frames.size() + scan.skipped) * (sizeof(uint64_t) + sizeof(uint32_t));
+
+            if(!file.lidar) {
+                // 검출 payload만 읽어 둠 (프레임 순서대로라 seek는 대부분 제자리) - 병합 후 클래스 집계 / 중복 판정에 사용
+                std::ifstream ifs(file.path, std::ios::binary);
+                auto& frames = obj_file_frames[f - lidar_count];
+                frames.reserve(scan.frames.size());
+                for(const FrameHeader& header : scan.frames) {
+                    ObjBinary frame{header.time, header.num, std::vector<ObjData>(header.num)};
+                    ifs.seekg(static_cast<std::streamoff>(header.payload_offset));
+                    ifs.read(reinterpret_cast<char*>(frame.obj_data.data()), header.num * sizeof(ObjData));
+                    if(!ifs) break;
+                    file_bytes_read[f] += header.num * sizeof(ObjData);
+                    frames.push_back(std::move(frame));
+                }
+            }
+            headers[f].swap(scan.frames);
+        }
+    });
+
+    std::vector<FileSummary> lidar_file_list(files.begin(), files.begin() + lidar_count);
+    std::vector<FileSummary> obj_file_list(files.begin() + lidar_count, files.end());
+
+    // 뷰어 / CLI 로더와 같은 FrameMerger 병합 순서 (중복 / 창을 넘어 늦은 프레임 버림)
+    // 라이다 점 payload는 다른 프레임과 시간이 겹치는 프레임만 읽음 (같은 시간끼리만 내용 서명을 비교하므로 결과는 전체를 읽은 것과 같음)
+    std::vector<uint64_t> shared_times;
+    for(size_t f = 0; f < lidar_count; ++f) {
+        for(const FrameHeader& h : headers[f]) shared_times.push_back(h.time);
+    }
+    std::sort(shared_times.begin(), shared_times.end());
+    size_t unique_end = 0;
+    for(size_t i = 0; i < shared_times.size(); ) {
+        size_t j = i + 1;
+        while(j < shared_times.size() && shared_times[j] == shared_times[i]) ++j;
+        if(j - i > 1) shared_times[unique_end++] = shared_times[i];
+        i = j;
+    }
+    shared_times.resize(unique_end);
+
+    FrameMerger<LidarBinary> lidar_merger;
+    for(size_t f = 0; f < lidar_count; ++f) {
+        struct RunState {
+            size_t next = 0;
+            std::unique_ptr<std::ifstream> input;   // 겹치는 시간의 프레임이 나올 때 열고 run이 끝나면 닫음
+        };
+        auto state = std::make_shared<RunState>();
+        const std::vector<FrameHeader>* list = &headers[f];
+        const std::string* path = &files[f].path;
+        uint64_t* bytes = &file_bytes_read[f];
+        lidar_merger.addRun([state, list, path, bytes, &shared_times](LidarBinary& out) {
+            if(state->next >= list->size()) {
+                state->input.reset();
+                return false;
+            }
+            const FrameHeader& h = (*list)[state->next++];
+            out.time = h.time;
+            out.num = h.num;
+            out.lidar_data.clear();
+            if(std::binary_search(shared_times.begin(), shared_times.end(), h.time)) {
+                if(!state->input) state->input.reset(new std::ifstream(*path, std::ios::binary));
+                out.lidar_data.resize(h.num);
+                state->input->seekg(static_cast<std::streamoff>(h.payload_offset));
+                state->input->read(reinterpret_cast<char*>(out.lidar_data.data()), h.num * sizeof(LidarData));
+                if(*state->input) {
+                    *bytes += h.num * sizeof(LidarData);
+                } else {
+                    state->input->clear();
+                    out.lidar_data.clear();
+                }
+            }
+            return true;
+        });
+    }
+    FrameMerger<ObjBinary> obj_merger;
+    for(auto& frames : obj_file_frames) {
+        auto next = std::make_shared<size_t>(0);
+        std::vector<ObjBinary>* list = &frames;
+        obj_merger.addRun([next, list](ObjBinary& out) {
+            if(*next >= list->size()) return false;
+            std::swap(out, (*list)[(*next)++]);
+            return true;
+        });
+    }
+
+    // 헤더만 채운 프레임으로 뷰어와 같은 타임라인 / 객체-라이다 매칭 구성
+    std::vector<LidarBinary> lidar_frames;
+    std::vector<ObjBinary> obj_frames;
+    std::vector<FrameHeader> lidar_merged, obj_merged;
+    LidarBinary lidar_frame;
+    while(lidar_merger.next(lidar_frame)) {
+        lidar_frames.push_back({lidar_frame.time, lidar_frame.num, {}});
+        lidar_merged.push_back({lidar_frame.time, lidar_frame.num, 0});
+    }
+
+    // 클래스별 검출 수 - 병합 순서로 집계 (중복 프레임은 한 번만)
+    std::unordered_map<int, ClassCount> classes;
+    ObjBinary obj_frame;
+    while(obj_merger.next(obj_frame)) {
+        const size_t i = obj_frames.size();
+        for(const ObjData& det : obj_frame.obj_data) {
+            if(det.obj_id == -1) continue;
+            ClassCount& c = classes.try_emplace(det.obj_id, ClassCount{det.obj_id, 0, 0, 0}).first->second;
+            if(c.detections == 0 || c.last_frame != i) {
+                ++c.frames;
+                c.last_frame = i;
+            }
+            ++c.detections;
+        }
+        obj_frames.push_back({obj_frame.time, obj_frame.num, {}});
+        obj_merged.push_back({obj_frame.time, obj_frame.num, 0});
+    }
+    obj_file_frames.clear();
+
+    summarize(lidar_file_list, lidar_merged, lidar_merger.getStats(), lidar_summary);
+    summarize(obj_file_list, obj_merged, obj_merger.getStats(), obj_summary);
+
+    class_counts.clear();
+    for(const auto& entry : classes) class_counts.push_back(entry.second);
+    std::sort(class_counts.begin(), class_counts.end(), [](const ClassCount& a, const ClassCount& b) {
+        return a.detections != b.detections ? a.detections > b.detections : a.obj_id < b.obj_id;
+    });
+
+    std::vector<UnifiedData> timeline;
+    Timeline::build(lidar_frames, obj_frames, timeline);
+    timeline_size = timeline.size();
+    std::vector<int> mapping;
+    Timeline::buildObjToLidarMapping(obj_frames, lidar_frames, mapping);
+    matched_obj_frames = std::count_if(mapping.begin(), mapping.end(), [](int idx) { return idx >= 0; });
+
+    bytes_read = 0;
+    for(uint64_t b : file_bytes_read) bytes_read += b;
+
+    timer.end();
+    elapsed_ms = std::chrono::duration<double, std::milli>(timer.end_time - timer.start_time).count();
+    return std::all_of(file_ok.begin(), file_ok.end(), [](char ok) { return ok != 0; });
+}
+
+
+void RecordingInspector::summarize(const std::vector<FileSummary>& file_list, const std::vector<FrameHeader>& merged,
+                                   const MergeStats& merge, StreamSummary& out_summary) {
+    out_summary = StreamSummary();
+    out_summary.files = file_list.size();
+    for(const auto& file : file_list) {
+        out_summary.skipped += file.skipped;
+        out_summary.truncated_files += file.truncated ? 1 : 0;
+        out_summary.file_bytes += file.file_size;
+    }
+    out_summary.merge = merge;
+
+    // 병합 결과는 시간 오름차순 -> 같은 시간 (내용이 다른 프레임)만 간격에서 뺌
+    std::vector<uint64_t> intervals;
+    std::vector<Gap> gaps;
+    for(size_t i = 0; i < merged.size(); ++i) {
+        const FrameHeader& h = merged[i];
+        if(i == 0) {
+            out_summary.min_items = h.num;
+            out_summary.first_time = h.time;
+        }
+        ++out_summary.frames;
+        out_summary.items += h.num;
+        out_summary.min_items = std::min(out_summary.min_items, h.num);
+        out_summary.max_items = std::max(out_summary.max_items, h.num);
+        out_summary.last_time = h.time;
+
+        if(i > 0 && h.time > merged[i - 1].time) {
+            intervals.push_back(h.time - merged[i - 1].time);
+            gaps.push_back({merged[i - 1].time, h.time});
+        }
+    }
+    if(intervals.empty()) {
+        return;
+    }
+
+    std::vector<uint64_t> sorted_intervals = intervals;
+    std::nth_element(sorted_intervals.begin(), sorted_intervals.begin() + sorted_intervals.size() / 2, sorted_intervals.end());
+    const uint64_t median = sorted_intervals[sorted_intervals.size() / 2];
+    out_summary.median_interval_ms = static_cast<double>(median);
+    out_summary.rate_hz = 1000.0 / median;
+
+    // 중앙 간격의 INSPECT_GAP_FACTOR배를 넘는 간격 = 끊김
+    const double gap_threshold = median * INSPECT_GAP_FACTOR;
+    gaps.erase(std::remove_if(gaps.begin(), gaps.end(), [&](const Gap& g) { return (g.to - g.from) <= gap_threshold; }), gaps.end());
+    out_summary.gap_count = gaps.size();
+    for(const Gap& g : gaps) out_summary.gap_total_ms += g.to - g.from;
+    const size_t keep = std::min<size_t>(gaps.size(), INSPECT_MAX_GAPS);
+    std::partial_sort(gaps.begin(), gaps.begin() + keep, gaps.end(), [](const Gap& a, const Gap& b) {
+        return (a.to - a.from) > (b.to - b.from);
+    });
+    out_summary.longest_gaps.assign(gaps.begin(), gaps.begin() + keep);
+}
+
+
+static void printStream(std::ostream& os, const char* title, const char* item_name, const RecordingInspector::StreamSummary& s) {
+    char line[256];
+    snprintf(line, sizeof(line), "[%s] %zu files (%s), %zu frames, %zu skipped headers, %zu truncated files\n",
+             title, s.files, formatBytes(s.file_bytes).c_str(), s.frames, s.skipped, s.truncated_files);
+    os << line;
+    if(s.frames == 0) {
+        return;
+    }
+    snprintf(line, sizeof(line), "    %llu %s (min %u / avg %.1f / max %u per frame)\n", static_cast<unsigned long long>(s.items), item_name,
+             s.min_items, static_cast<double>(s.items) / s.frames, s.max_items);
+    os << line;
+    os << "    " << formatTime(s.first_time) << " ~ " << formatTime(s.last_time) << " (" << formatDuration(s.last_time - s.first_time) << ")\n";
+    snprintf(line, sizeof(line), "    rate %.2f Hz (median interval %.0f ms), merged %zu / %zu frames: %zu duplicates, %zu reordered, %zu late dropped\n",
+             s.rate_hz, s.median_interval_ms, s.merge.frames_out, s.merge.frames_in, s.merge.duplicates, s.merge.reordered, s.merge.late);
+    os << line;
+    snprintf(line, sizeof(line), "    gaps > %.0f ms: %zu (total %s)\n", s.median_interval_ms * INSPECT_GAP_FACTOR, s.gap_count,
+             formatDuration(s.gap_total_ms).c_str());
+    os << line;
+    for(const auto& gap : s.longest_gaps) {
+        os << "      " << formatTime(gap.from) << " -> " << formatTime(gap.to) << " (" << gap.to - gap.from << " ms)\n";
+    }
+}
+
+void RecordingInspector::print(std::ostream& os, bool per_file) const {
+    char line[256];
+    if(per_file) {
+        for(const auto& file : files) {
+            snprintf(line, sizeof(line), "%-48s %10s %7zu frames", std::filesystem::path(file.path).filename().string().c_str(),
+                     formatBytes(file.file_size).c_str(), file.frames);
+            os << line;
+            if(file.frames > 0) os << "  " << formatTime(file.first_time) << " ~ " << formatTime(file.last_time);
+            if(file.skipped > 0) os << "  skipped " << file.skipped;
+            if(file.truncated) os << "  TRUNCATED";
+            os << "\n";
+        }
+        os << "\n";
+    }
+
+    printStream(os, "Lidar", "points", lidar_summary);
+    printStream(os, "Detections", "detections", obj_summary);
+
+    if(!class_counts.empty()) {
+        os << "    classes:\n";
+        for(const auto& c : class_counts) {
+            std::string label = "unknown";
+            auto it = objId_to_label.find(c.obj_id);
+            if(it != objId_to_label.end()) label = it->second;
+            snprintf(line, sizeof(line), "      %-16s (id %3d) %10llu detections in %zu frames\n", label.c_str(), c.obj_id,
+                     static_cast<unsigned long long>(c.detections), c.frames);
+            os << line;
+        }
+    }
+
+    snprintf(line, sizeof(line), "[Timeline] %zu entries, detection frames with lidar within %d ms: %zu / %zu\n",
+             timeline_size, MAX_TIME_DIFF, matched_obj_frames, obj_summary.frames);
+    os << line;
+}
+
+
+const RecordingInspector::StreamSummary& RecordingInspector::getLidarSummary() const {
+    return lidar_summary;
+}
+
+const RecordingInspector::StreamSummary& RecordingInspector::getObjSummary() const {
+    return obj_summary;
+}
+
+const std::vector<RecordingInspector::ClassCount>& RecordingInspector::getClassCounts() const {
+    return class_counts;
+}
+
+size_t RecordingInspector::getMatchedObjFrames() const {
+    return matched_obj_frames;
+}
+
+size_t RecordingInspector::getTimelineSize() const {
+    return timeline_size;
+}
+
+uint64_t RecordingInspector::getBytesRead() const {
+    return bytes_read;
+}
+
+double RecordingInspector::getElapsedMs() const {
+    return elapsed_ms;
+}
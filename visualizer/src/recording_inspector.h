@@ -0,0 +1,83 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <ostream>
+
+#include "binary_utils.h"
+#include "frame_merge.h"
+
+
+// 녹화 구성 요약 - 프레임 헤더만 훑어 파일 / 프레임 수, 시간 범위, 간격, 주기, 클래스별 검출 수 집계
+// 라이다 점 payload는 다른 프레임과 시간이 겹칠 때만 읽음 (seek), 객체인식은 검출 payload(프레임당 수백 bytes)를 읽어 obj_id 사용
+// 파일 단위로 worker pool에서 병렬 처리 -> 뷰어와 같은 FrameMerger 순서로 병합한 뒤 집계 (프레임 수 / 매칭이 뷰어 재생과 같음)
+class RecordingInspector {
+public:
+    struct FileSummary {
+        std::string path;
+        bool lidar;
+        uint64_t file_size = 0;
+        size_t frames = 0;
+        size_t skipped = 0;
+        bool truncated = false;
+        uint64_t first_time = 0;
+        uint64_t last_time = 0;
+    };
+
+    struct Gap {
+        uint64_t from;          // 직전 프레임 시간
+        uint64_t to;
+    };
+
+    // 센서 하나 (라이다 / 객체인식) 전체 구간 요약
+    struct StreamSummary {
+        size_t files = 0;
+        size_t frames = 0;                  // 병합 후 (뷰어가 재생하는 프레임)
+        size_t skipped = 0;
+        size_t truncated_files = 0;
+        uint64_t file_bytes = 0;
+        uint64_t items = 0;                 // 점 / 검출 수 합
+        uint32_t min_items = 0;
+        uint32_t max_items = 0;
+        uint64_t first_time = 0;
+        uint64_t last_time = 0;
+        double median_interval_ms = 0.0;
+        double rate_hz = 0.0;               // 중앙 간격 기준
+        MergeStats merge;                   // 병합 입력 / 출력, 중복 / 순서 뒤바뀜 / 늦어서 버린 프레임
+        size_t gap_count = 0;               // 중앙 간격 x INSPECT_GAP_FACTOR 넘는 간격
+        uint64_t gap_total_ms = 0;
+        std::vector<Gap> longest_gaps;      // 긴 순서, 최대 INSPECT_MAX_GAPS
+    };
+
+    struct ClassCount {
+        int obj_id;
+        uint64_t detections;
+        size_t frames;          // 이 클래스가 한 번이라도 나온 프레임 수
+        size_t last_frame;      // 집계용 - 마지막으로 센 프레임 (병합 순번)
+    };
+
+    bool run(const std::vector<std::string>& lidar_files, const std::vector<std::string>& obj_files);
+    void print(std::ostream& os, bool per_file) const;
+
+    const StreamSummary& getLidarSummary() const;
+    const StreamSummary& getObjSummary() const;
+    const std::vector<ClassCount>& getClassCounts() const;
+    size_t getMatchedObjFrames() const;     // MAX_TIME_DIFF 안에 라이다 프레임이 있는 객체인식 프레임
+    size_t getTimelineSize() const;
+    uint64_t getBytesRead() const;
+    double getElapsedMs() const;
+
+private:
+    static void summarize(const std::vector<FileSummary>& files, const std::vector<FrameHeader>& merged, const MergeStats& merge,
+                          StreamSummary& out_summary);
+
+    std::vector<FileSummary> files;
+    StreamSummary lidar_summary;
+    StreamSummary obj_summary;
+    std::vector<ClassCount> class_counts;
+    size_t matched_obj_frames = 0;
+    size_t timeline_size = 0;
+    uint64_t bytes_read = 0;
+    double elapsed_ms = 0.0;
+};
@@ -0,0 +1,530 @@
+#include "scan_registration.h"
+#include "parallel_utils.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <iostream>
+#include <unordered_map>
+
+
+// 21bit씩 묶음 (voxel 0.5m 기준 약 ±500km)
+static inline uint64_t voxelKey(int64_t ix, int64_t iy, int64_t iz) {
+    return ((static_cast<uint64_t>(ix) & 0x1FFFFF) << 42) | ((static_cast<uint64_t>(iy) & 0x1FFFFF) << 21) | (static_cast<uint64_t>(iz) & 0x1FFFFF);
+}
+
+// 대칭 3x3 행렬의 가장 작은 고유값 방향 (Jacobi 회전), 고유값은 오름차순으로 out_values
+static void symmetricEigen3(double a[3][3], double out_values[3], glm::vec3& out_min_vector) {
+    double v[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    for(int sweep = 0; sweep < 8; ++sweep) {
+        double off = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+        if(off < 1e-18) {
+            break;
+        }
+        for(int p = 0; p < 2; ++p) {
+            for(int q = p + 1; q < 3; ++q) {
+                if(std::fabs(a[p][q]) < 1e-18) {
+                    continue;
+                }
+                double theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+                double t = ((theta >= 0.0) ? 1.0 : -1.0) / (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+                double c = 1.0 / std::sqrt(t * t + 1.0);
+                double s = t * c;
+                for(int k = 0; k < 3; ++k) {
+                    double akp = a[k][p], akq = a[k][q];
+                    a[k][p] = c * akp - s * akq;
+                    a[k][q] = s * akp + c * akq;
+                }
+                for(int k = 0; k < 3; ++k) {
+                    double apk = a[p][k], aqk = a[q][k];
+                    a[p][k] = c * apk - s * aqk;
+                    a[q][k] = s * apk + c * aqk;
+                }
+                for(int k = 0; k < 3; ++k) {
+                    double vkp = v[k][p], vkq = v[k][q];
+                    v[k][p] = c * vkp - s * vkq;
+                    v[k][q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+    int order[3] = {0, 1, 2};
+    std::sort(order, order + 3, [&a](int i, int j) { return a[i][i] < a[j][j]; });
+    for(int i = 0; i < 3; ++i) {
+        out_values[i] = a[order[i]][order[i]];
+    }
+    out_min_vector = glm::vec3(static_cast<float>(v[0][order[0]]), static_cast<float>(v[1][order[0]]), static_cast<float>(v[2][order[0]]));
+}
+
+// 6x6 선형 방정식 (부분 피벗 가우스 소거), 특이 행렬이면 false
+static bool solve6(double h[6][6], double b[6], double out_x[6]) {
+    for(int col = 0; col < 6; ++col) {
+        int pivot = col;
+        for(int r = col + 1; r < 6; ++r) {
+            if(std::fabs(h[r][col]) > std::fabs(h[pivot][col])) pivot = r;
+        }
+        if(std::fabs(h[pivot][col]) < 1e-12) {
+            return false;
+        }
+        if(pivot != col) {
+            for(int k = 0; k < 6; ++k) std::swap(h[col][k], h[pivot][k]);
+            std::swap(b[col], b[pivot]);
+        }
+        for(int r = col + 1; r < 6; ++r) {
+            double f = h[r][col] / h[col][col];
+            for(int k = col; k < 6; ++k) h[r][k] -= f * h[col][k];
+            b[r] -= f * b[col];
+        }
+    }
+    for(int r = 5; r >= 0; --r) {
+        double sum = b[r];
+        for(int k = r + 1; k < 6; ++k) sum -= h[r][k] * out_x[k];
+        out_x[r] = sum / h[r][r];
+    }
+    return true;
+}
+
+// (회전 벡터, 이동) -> 4x4 (Rodrigues)
+static glm::mat4 twistToMatrix(const double x[6]) {
+    glm::mat4 m(1.0f);
+    double theta = std::sqrt(x[0] * x[0] + x[1] * x[1] + x[2] * x[2]);
+    if(theta > 1e-12) {
+        double kx = x[0] / theta, ky = x[1] / theta, kz = x[2] / theta;
+        double s = std::sin(theta), c = 1.0 - std::cos(theta);
+        // R = I + s K + c K^2, 열 우선 (m[col][row])
+        m[0][0] = static_cast<float>(1.0 - c * (ky * ky + kz * kz));
+        m[0][1] = static_cast<float>(s * kz + c * kx * ky);
+        m[0][2] = static_cast<float>(-s * ky + c * kx * kz);
+        m[1][0] = static_cast<float>(-s * kz + c * kx * ky);
+        m[1][1] = static_cast<float>(1.0 - c * (kx * kx + kz * kz));
+        m[1][2] = static_cast<float>(s * kx + c * ky * kz);
+        m[2][0] = static_cast<float>(s * ky + c * kx * kz);
+        m[2][1] = static_cast<float>(-s * kx + c * ky * kz);
+        m[2][2] = static_cast<float>(1.0 - c * (kx * kx + ky * ky));
+    }
+    m[3][0] = static_cast<float>(x[3]);
+    m[3][1] = static_cast<float>(x[4]);
+    m[3][2] = static_cast<float>(x[5]);
+    return m;
+}
+
+static inline glm::vec3 transformPoint(const glm::mat4& m, const glm::vec3& p) {
+    return glm::vec3(m[0][0] * p.x + m[1][0] * p.y + m[2][0] * p.z + m[3][0],
+                     m[0][1] * p.x + m[1][1] * p.y + m[2][1] * p.z + m[3][1],
+                     m[0][2] * p.x + m[1][2] * p.y + m[2][2] * p.z + m[3][2]);
+}
+
+
+ScanRegistration::ScanRegistration()
+    : lidar_list(nullptr), ready(false), cancel(false), processed(0) {}
+
+ScanRegistration::~ScanRegistration() {
+    cancel = true;      // 종료 시 남은 스윕은 버림
+    if(build_thread.joinable()) {
+        build_thread.join();
+    }
+}
+
+void ScanRegistration::startBuild(const std::vector<LidarBinary>& lidar, const CompactLidarStore* compact_store) {
+    if(build_thread.joinable()) {
+        build_thread.join();
+    }
+    lidar_list = &lidar;
+    compact = compact_store;
+    ready = false;
+    cancel = false;
+    processed = 0;
+    build_thread = std::thread(&ScanRegistration::build, this);
+}
+
+bool ScanRegistration::isReady() const {
+    return ready.load();
+}
+
+float ScanRegistration::getProgress() const {
+    if(lidar_list == nullptr || lidar_list->empty()) {
+        return ready.load() ? 1.0f : 0.0f;
+    }
+    return static_cast<float>(processed.load()) / lidar_list->size();
+}
+
+
+// downsample 작업 버퍼 (스레드별 재사용) - 정렬 대신 open addressing 해시로 voxel 번호를 매기고 counting sort로 점을 voxel별로 모음
+struct VoxelScratch {
+    std::vector<uint64_t> point_keys;
+    std::vector<uint32_t> point_index;
+    std::vector<uint32_t> point_slot;
+    std::vector<uint64_t> table_keys;
+    std::vector<uint32_t> table_slots;
+    std::vector<uint32_t> slot_start;
+    std::vector<uint32_t> order;
+};
+
+static inline uint64_t hashKey(uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return key;
+}
+
+// REG_VOXEL_SIZE voxel로 묶어 중심점, 점이 충분하고 평평한 voxel은 공분산 최소 고유벡터를 법선으로
+void ScanRegistration::downsample(const LidarBinary& frame, Cloud& out_cloud) {
+    static thread_local VoxelScratch scratch;
+    out_cloud.points.clear();
+    out_cloud.plane_points.clear();
+    out_cloud.plane_normals.clear();
+
+    const auto& pts = frame.lidar_data;
+    const float inv_voxel = 1.0f / REG_VOXEL_SIZE;
+    scratch.point_keys.clear();
+    scratch.point_index.clear();
+    for(uint32_t i = 0; i < pts.size(); ++i) {
+        const LidarData& p = pts[i];
+        if(!std::isfinite(p.x) || !std::isfinite(p.y) || !std::isfinite(p.z)) {
+            continue;
+        }
+        float range_sq = p.x * p.x + p.y * p.y + p.z * p.z;
+        if(range_sq < REG_MIN_RANGE * REG_MIN_RANGE || range_sq > REG_MAX_RANGE * REG_MAX_RANGE) {
+            continue;
+        }
+        scratch.point_keys.push_back(voxelKey(static_cast<int64_t>(std::floor(p.x * inv_voxel)),
+                                              static_cast<int64_t>(std::floor(p.y * inv_voxel)),
+                                              static_cast<int64_t>(std::floor(p.z * inv_voxel))));
+        scratch.point_index.push_back(i);
+    }
+    const size_t count = scratch.point_keys.size();
+
+    // voxel 번호 (처음 나온 순서)
+    size_t table_size = 64;
+    while(table_size < 2 * count) table_size <<= 1;
+    const uint64_t empty_key = ~0ULL;       // voxelKey는 63bit
+    scratch.table_keys.assign(table_size, empty_key);
+    scratch.table_slots.resize(table_size);
+    scratch.point_slot.resize(count);
+    scratch.slot_start.clear();
+    uint32_t voxels = 0;
+    for(size_t i = 0; i < count; ++i) {
+        const uint64_t key = scratch.point_keys[i];
+        size_t h = hashKey(key) & (table_size - 1);
+        while(scratch.table_keys[h] != empty_key && scratch.table_keys[h] != key) {
+            h = (h + 1) & (table_size - 1);
+        }
+        if(scratch.table_keys[h] == empty_key) {
+            scratch.table_keys[h] = key;
+            scratch.table_slots[h] = voxels++;
+            scratch.slot_start.push_back(0);
+        }
+        scratch.point_slot[i] = scratch.table_slots[h];
+        ++scratch.slot_start[scratch.table_slots[h]];
+    }
+    // counting sort : slot_start[v] = voxel v의 첫 점 위치
+    uint32_t offset = 0;
+    for(uint32_t v = 0; v < voxels; ++v) {
+        uint32_t n = scratch.slot_start[v];
+        scratch.slot_start[v] = offset;
+        offset += n;
+    }
+    scratch.slot_start.push_back(offset);
+    scratch.order.resize(count);
+    for(size_t i = 0; i < count; ++i) {
+        scratch.order[scratch.slot_start[scratch.point_slot[i]]++] = scratch.point_index[i];
+    }
+    for(uint32_t v = voxels; v > 0; --v) {
+        scratch.slot_start[v] = scratch.slot_start[v - 1];      // ++로 밀린 시작 위치 되돌림
+    }
+    scratch.slot_start[0] = 0;
+
+    out_cloud.points.reserve(voxels);
+    for(uint32_t v = 0; v < voxels; ++v) {
+        const size_t begin = scratch.slot_start[v];
+        const size_t end = scratch.slot_start[v + 1];
+
+        double sx = 0, sy = 0, sz = 0;
+        for(size_t k = begin; k < end; ++k) {
+            const LidarData& p = pts[scratch.order[k]];
+            sx += p.x; sy += p.y; sz += p.z;
+        }
+        const double n = static_cast<double>(end - begin);
+        const double mx = sx / n, my = sy / n, mz = sz / n;
+        glm::vec3 centroid(static_cast<float>(mx), static_cast<float>(my), static_cast<float>(mz));
+        out_cloud.points.push_back(centroid);
+
+        if(end - begin >= REG_MIN_VOXEL_POINTS) {
+            double cov[3][3] = {};
+            for(size_t k = begin; k < end; ++k) {
+                const LidarData& p = pts[scratch.order[k]];
+                double dx = p.x - mx, dy = p.y - my, dz = p.z - mz;
+                cov[0][0] += dx * dx; cov[0][1] += dx * dy; cov[0][2] += dx * dz;
+                cov[1][1] += dy * dy; cov[1][2] += dy * dz; cov[2][2] += dz * dz;
+            }
+            cov[1][0] = cov[0][1]; cov[2][0] = cov[0][2]; cov[2][1] = cov[1][2];
+            double values[3];
+            glm::vec3 normal;
+            symmetricEigen3(cov, values, normal);
+            // 평면 : 가장 작은 고유값이 중간 고유값보다 충분히 작음 (선 / 덩어리 voxel 제외)
+            if(values[1] > 1e-9 && values[0] < REG_PLANARITY * values[1]) {
+                out_cloud.plane_points.push_back(centroid);
+                out_cloud.plane_normals.push_back(normal);
+            }
+        }
+    }
+    out_cloud.tree.build(out_cloud.plane_points);
+}
+
+
+// point-to-plane ICP (Gauss-Newton) - 반복마다 source 점을 현재 변환으로 옮겨 target kd-tree에서 최근접 평면 voxel 탐색
+// 대응점 탐색 + 정규방정식 누적은 worker별 누적 버퍼로 병렬, 6x6 풀이는 호출 스레드
+glm::mat4 ScanRegistration::align(const Cloud& source, const Cloud& target, const glm::mat4& initial,
+                                  float& out_inlier_ratio, int& out_iterations) {
+    struct Accum {
+        double h[6][6];
+        double g[6];
+        size_t inliers;
+    };
+
+    glm::mat4 transform = initial;
+    out_inlier_ratio = 0.0f;
+    out_iterations = 0;
+    if(source.points.empty() || target.tree.empty()) {
+        return transform;
+    }
+
+    // source는 일정 간격 표본 (REG_MAX_SOURCE_POINTS 이하)
+    const size_t stride = std::max<size_t>(1, (source.points.size() + REG_MAX_SOURCE_POINTS - 1) / REG_MAX_SOURCE_POINTS);
+    const size_t samples = (source.points.size() + stride - 1) / stride;
+    const size_t workers = workerCount();
+    std::vector<Accum> accums(workers);
+    const float max_dist_sq = REG_MAX_CORR_DIST * REG_MAX_CORR_DIST;
+
+    for(int iter = 0; iter < REG_MAX_ITERATIONS; ++iter) {
+        out_iterations = iter + 1;
+        for(auto& a : accums) {
+            a = Accum();
+        }
+
+        parallelForBackground(samples, REG_POINT_GRAIN, workers, [&](size_t begin, size_t end, size_t worker) {
+            Accum& a = accums[worker];
+            for(size_t s = begin; s < end; ++s) {
+                const glm::vec3 p = transformPoint(transform, source.points[s * stride]);
+                float dist_sq;
+                int idx = target.tree.nearest(p, max_dist_sq, dist_sq);
+                if(idx < 0) {
+                    continue;
+                }
+                const glm::vec3& n = target.plane_normals[idx];
+                const double r = glm::dot(n, p - target.plane_points[idx]);
+                // Huber weight - 큰 잔차(움직이는 물체, 잘못된 대응)의 영향 제한
+                const double w = (std::fabs(r) <= REG_HUBER_DELTA) ? 1.0 : REG_HUBER_DELTA / std::fabs(r);
+                const glm::vec3 c = glm::cross(p, n);
+                const double j[6] = {c.x, c.y, c.z, n.x, n.y, n.z};
+                for(int row = 0; row < 6; ++row) {
+                    for(int col = row; col < 6; ++col) {
+                        a.h[row][col] += w * j[row] * j[col];
+                    }
+                    a.g[row] += w * j[row] * r;
+                }
+                ++a.inliers;
+            }
+        });
+
+        double h[6][6] = {};
+        double g[6] = {};
+        size_t inliers = 0;
+        for(const auto& a : accums) {
+            for(int row = 0; row < 6; ++row) {
+                for(int col = row; col < 6; ++col) h[row][col] += a.h[row][col];
+                g[row] += a.g[row];
+            }
+            inliers += a.inliers;
+        }
+        out_inlier_ratio = static_cast<float>(inliers) / samples;
+        if(inliers < 6) {
+            break;
+        }
+        for(int row = 0; row < 6; ++row) {
+            for(int col = 0; col < row; ++col) h[row][col] = h[col][row];
+            h[row][row] += 1e-3;        // 관측되지 않는 방향(긴 복도 등)은 갱신하지 않도록 약한 감쇠
+            g[row] = -g[row];
+        }
+        double x[6];
+        if(!solve6(h, g, x)) {
+            break;
+        }
+        transform = twistToMatrix(x) * transform;
+
+        double step = std::sqrt(x[0] * x[0] + x[1] * x[1] + x[2] * x[2]) + std::sqrt(x[3] * x[3] + x[4] * x[4] + x[5] * x[5]);
+        if(step < REG_CONVERGE_EPS) {
+            break;
+        }
+    }
+    return transform;
+}
+
+
+void ScanRegistration::build() {
+    MyTimer timer;
+    struct MapVoxel {
+        glm::vec3 sum;
+        uint32_t count;
+    };
+
+    const std::vector<LidarBinary>& list = *lidar_list;
+    const size_t frames = list.size();
+    poses.assign(frames, glm::mat4(1.0f));
+    inlier_ratios.assign(frames, 1.0f);
+    trajectory.assign(frames, glm::vec3(0.0f));
+    failed_count = 0;
+
+    std::unordered_map<uint64_t, MapVoxel> map_voxels;
+    const float inv_map_voxel = 1.0f / REG_MAP_VOXEL_SIZE;
+
+    // 스윕 묶음 단위 : voxel 축소 + kd-tree 생성은 스윕별 병렬, 정합은 순서대로 (등속 예측을 초기값으로)
+    const size_t batch = workerCount() * REG_BATCH_PER_WORKER;
+    std::vector<Cloud> clouds(batch);
+    std::vector<LidarBinary> decoded(batch);    // --compact : 묶음 안 스윕 복원 버퍼
+    Cloud prev;
+    size_t prev_idx = SIZE_MAX;
+    glm::mat4 velocity(1.0f);       // 직전 스윕 간 움직임
+    size_t aligned = 0;
+    size_t iterations_total = 0;
+
+    for(size_t batch_begin = 0; batch_begin < frames && !cancel; batch_begin += batch) {
+        const size_t batch_end = std::min(frames, batch_begin + batch);
+        parallelForBackground(batch_end - batch_begin, 1, [&](size_t begin, size_t end, size_t) {
+            for(size_t i = begin; i < end; ++i) {
+                downsample(CompactLidarStore::view(compact, list, batch_begin + i, decoded[i]), clouds[i]);
+            }
+        });
+
+        for(size_t f = batch_begin; f < batch_end && !cancel; ++f) {
+            Cloud& cloud = clouds[f - batch_begin];
+            if(prev_idx != SIZE_MAX) {
+                // 시간 간격이 크면 (녹화 끊김) 움직임 예측 대신 정지 가정
+                const uint64_t t0 = list[prev_idx].time, t1 = list[f].time;
+                const uint64_t gap = (t1 > t0) ? t1 - t0 : t0 - t1;
+                const glm::mat4 initial = (gap <= REG_MAX_GAP_MS) ? velocity : glm::mat4(1.0f);
+
+                float inlier_ratio;
+                int iterations;
+                glm::mat4 relative = align(cloud, prev, initial, inlier_ratio, iterations);
+                ++aligned;
+                iterations_total += iterations;
+                inlier_ratios[f] = inlier_ratio;
+                if(inlier_ratio < REG_MIN_INLIER_RATIO) {
+                    relative = initial;
+                    ++failed_count;
+                } else {
+                    velocity = relative;
+                }
+                poses[f] = poses[prev_idx] * relative;
+            }
+            trajectory[f] = glm::vec3(poses[f][3][0], poses[f][3][1], poses[f][3][2]);
+
+            for(const glm::vec3& p : cloud.points) {
+                glm::vec3 w = transformPoint(poses[f], p);
+                uint64_t key = voxelKey(static_cast<int64_t>(std::floor(w.x * inv_map_voxel)),
+                                        static_cast<int64_t>(std::floor(w.y * inv_map_voxel)),
+                                        static_cast<int64_t>(std::floor(w.z * inv_map_voxel)));
+                MapVoxel& v = map_voxels[key];
+                v.sum += w;
+                ++v.count;
+            }
+
+            // 평면 voxel이 없는 스윕(빈 프레임 등)은 다음 정합 기준으로 쓰지 않음
+            if(!cloud.plane_points.empty()) {
+                std::swap(prev, cloud);     // 이전 기준 버퍼는 다음 묶음에서 재사용
+                prev_idx = f;
+            }
+            processed = f + 1;
+        }
+    }
+    if(cancel) {
+        return;
+    }
+
+    // 지도 : REG_MAP_MIN_HITS 이상 쌓인 voxel 평균점 (움직이는 물체 흔적 제외), 높이 2% ~ 98% 구간으로 색상
+    map_points.clear();
+    map_colors.clear();
+    map_points.reserve(map_voxels.size());
+    for(const auto& entry : map_voxels) {
+        if(entry.second.count >= REG_MAP_MIN_HITS) {
+            map_points.push_back(entry.second.sum / static_cast<float>(entry.second.count));
+        }
+    }
+    if(!map_points.empty()) {
+        std::vector<float> heights(map_points.size());
+        for(size_t i = 0; i < map_points.size(); ++i) heights[i] = map_points[i].z;
+        const size_t lo = heights.size() * 2 / 100, hi = heights.size() * 98 / 100;
+        std::nth_element(heights.begin(), heights.begin() + lo, heights.end());
+        const float z_min = heights[lo];
+        std::nth_element(heights.begin(), heights.begin() + hi, heights.end());
+        const float z_max = heights[hi];
+        const float inv_span = (z_max > z_min) ? 1.0f / (z_max - z_min) : 0.0f;
+        map_colors.resize(map_points.size());
+        for(size_t i = 0; i < map_points.size(); ++i) {
+            float t = std::min(std::max((map_points[i].z - z_min) * inv_span, 0.0f), 1.0f);
+            map_colors[i] = glm::vec3(0.25f + 0.5f * t, 0.35f + 0.3f * t, 0.6f - 0.4f * t) * REG_MAP_BRIGHTNESS;
+        }
+    }
+
+    frames_begin = list.data();
+    frame_count = frames;
+    mean_iterations = aligned > 0 ? static_cast<double>(iterations_total) / aligned : 0.0;
+    timer.end();
+    elapsed_ms = std::chrono::duration<double, std::milli>(timer.end_time - timer.start_time).count();
+    ready = true;
+
+    const glm::vec3 last = trajectory.empty() ? glm::vec3(0.0f) : trajectory.back();
+    std::cout << "Scan registration: " << frames << " sweeps, " << failed_count << " failed, "
+              << mean_iterations << " iterations/sweep, map " << map_points.size() << " points, end position ("
+              << last.x << ", " << last.y << ", " << last.z << "), " << elapsed_ms << " ms" << std::endl;
+}
+
+
+bool ScanRegistration::getPose(const LidarBinary& frame, glm::mat4& out_pose) const {
+    size_t f = getFrameIndex(frame);
+    if(f == SIZE_MAX) {
+        return false;
+    }
+    out_pose = poses[f];
+    return true;
+}
+
+const glm::mat4& ScanRegistration::getPose(size_t frame_idx) const {
+    return poses[frame_idx];
+}
+
+size_t ScanRegistration::getFrameIndex(const LidarBinary& frame) const {
+    if(!ready.load() || frames_begin == nullptr || &frame < frames_begin || &frame >= frames_begin + frame_count) {
+        return SIZE_MAX;
+    }
+    return static_cast<size_t>(&frame - frames_begin);
+}
+
+float ScanRegistration::getInlierRatio(size_t frame_idx) const {
+    return inlier_ratios[frame_idx];
+}
+
+const std::vector<glm::vec3>& ScanRegistration::getMapPoints() const {
+    return map_points;
+}
+
+const std::vector<glm::vec3>& ScanRegistration::getMapColors() const {
+    return map_colors;
+}
+
+const std::vector<glm::vec3>& ScanRegistration::getTrajectory() const {
+    return trajectory;
+}
+
+size_t ScanRegistration::getFailedCount() const {
+    return failed_count;
+}
+
+double ScanRegistration::getMeanIterations() const {
+    return mean_iterations;
+}
+
+double ScanRegistration::getElapsedMs() const {
+    return elapsed_ms;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "configs.h"
+#include "binary_utils.h"
+#include "kd_tree.h"
+#include "compact_lidar.h"
+
+
+// 연속 스윕 간 ICP 정합(point-to-plane) + 녹화 전체 누적 지도 (백그라운드 스레드에서 1회 계산)
+// .uld에 자세 정보가 없으므로 첫 스윕을 지도 원점으로 두고 스윕마다 직전 스윕 대비 움직임을 누적
+// 스윕은 REG_VOXEL_SIZE voxel 중심(+ 평면 법선)으로 줄여 정합, 직전 스윕 voxel은 kd-tree로 대응점 탐색 (worker pool 병렬)
+class ScanRegistration {
+public:
+    ScanRegistration();
+    ~ScanRegistration();
+
+    void startBuild(const std::vector<LidarBinary>& lidar_list, const CompactLidarStore* compact = nullptr);    // compact : --compact 저장소
+    bool isReady() const;
+    float getProgress() const;          // 0 ~ 1
+
+    // 스윕 좌표 -> 지도 좌표 (ready 전이거나 lidar_list의 프레임이 아니면 false)
+    bool getPose(const LidarBinary& frame, glm::mat4& out_pose) const;
+    const glm::mat4& getPose(size_t frame_idx) const;
+    size_t getFrameIndex(const LidarBinary& frame) const;      // lidar_list 밖이면 SIZE_MAX
+    float getInlierRatio(size_t frame_idx) const;               // 직전 스윕과의 대응점 비율 (첫 스윕 1)
+
+    // REG_MAP_VOXEL_SIZE voxel 평균점, 높이 색상
+    const std::vector<glm::vec3>& getMapPoints() const;
+    const std::vector<glm::vec3>& getMapColors() const;
+    const std::vector<glm::vec3>& getTrajectory() const;       // 스윕별 센서 위치 (지도 좌표)
+
+    size_t getFailedCount() const;      // 대응점 부족으로 등속 예측을 쓴 스윕 수
+    double getMeanIterations() const;
+    double getElapsedMs() const;
+
+    // 스윕 하나를 voxel 중심으로 줄인 점 집합 (정합 입력)
+    struct Cloud {
+        std::vector<glm::vec3> points;          // 모든 voxel 중심 (source)
+        std::vector<glm::vec3> plane_points;    // 법선을 구한 voxel 중심 (target)
+        std::vector<glm::vec3> plane_normals;
+        KdTree tree;                            // plane_points
+    };
+    static void downsample(const LidarBinary& frame, Cloud& out_cloud);
+
+    // source를 target에 맞추는 변환 (initial에서 시작), 대응점 비율 / 반복 수 반환
+    static glm::mat4 align(const Cloud& source, const Cloud& target, const glm::mat4& initial,
+                           float& out_inlier_ratio, int& out_iterations);
+
+private:
+    void build();
+
+    const std::vector<LidarBinary>* lidar_list;
+    const CompactLidarStore* compact = nullptr;
+    const LidarBinary* frames_begin = nullptr;
+    size_t frame_count = 0;
+
+    std::vector<glm::mat4> poses;
+    std::vector<float> inlier_ratios;
+    std::vector<glm::vec3> map_points;
+    std::vector<glm::vec3> map_colors;
+    std::vector<glm::vec3> trajectory;
+    size_t failed_count = 0;
+    double mean_iterations = 0.0;
+    double elapsed_ms = 0.0;
+
+    std::thread build_thread;
+    std::atomic<bool> ready;
+    std::atomic<bool> cancel;
+    std::atomic<size_t> processed;
+};
@@ -0,0 +1,116 @@
+// 원격 보기 서버 : 데이터가 있는 기기에서 녹화를 읽고 (멀티 라이다 융합 포함) 압축 프레임을 TCP로 스트리밍
+// 클라이언트는 한 번에 하나, 연결이 끊기면 다음 연결을 기다림
+// Usage: ./aeronSW_server [start_time] [end_time] [--port p] [--speed s] [--limit-kbps k] [--data dir] [--roi]
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <filesystem>
+
+#include "configs.h"
+#include "binary_utils.h"
+#include "timeline.h"
+#include "recording_files.h"
+#include "frame_merge.h"
+#include "lidar_fusion.h"
+#include "stream_protocol.h"
+#include "frame_server.h"
+
+
+int main(int argc, char* argv[]) {
+    if(argc < 3) {
+        std::cout << "Usage: ./aeronSW_server [start_time] [end_time] [--port p] [--speed s] [--limit-kbps k] [--data dir] [--roi]\n"
+                  << "Time Format: yy-MM-dd-HH-mm-ss\n"
+                  << "--port        : listen port (default " << STREAM_DEFAULT_PORT << ")\n"
+                  << "--speed       : initial playback speed (default 1)\n"
+                  << "--limit-kbps  : emulate a link of this bandwidth (localhost test)\n"
+                  << "--data        : recording directory (default " << UAM_DATA_PATH << ")\n"
+                  << "--roi         : drop points outside the configs.h ROI_* region while loading" << std::endl;
+        return -1;
+    }
+
+    std::string uam_data_path = UAM_DATA_PATH;
+    int port = STREAM_DEFAULT_PORT;
+    ServerOptions options;
+    bool roi_filter = ROI_FILTER;
+    for(int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        if(arg == "--port" && i + 1 < argc)             port = std::atoi(argv[++i]);
+        else if(arg == "--speed" && i + 1 < argc)       options.speed = std::stof(argv[++i]);
+        else if(arg == "--limit-kbps" && i + 1 < argc)  options.limit_bytes_per_s = std::stod(argv[++i]) * 1000.0 / 8.0;
+        else if(arg == "--data" && i + 1 < argc)        uam_data_path = argv[++i];
+        else if(arg == "--roi")                         roi_filter = true;
+        else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return -1;
+        }
+    }
+    if(port <= 0 || port > 65535 || options.speed <= 0.0f) {
+        std::cerr << "Invalid port / speed" << std::endl;
+        return -1;
+    }
+
+    if(!std::filesystem::exists(uam_data_path)) {
+        std::cerr << "UAM data directory is not found: " << uam_data_path << std::endl;
+        return 1;
+    }
+
+    std::vector<int> lidar_sensor_ids;
+    std::vector<std::vector<std::string>> lidar_files;
+    std::vector<std::string> detectinfo_files;
+    if(!RecordingFiles::collectSensors(uam_data_path, argv[1], argv[2], lidar_sensor_ids, lidar_files, detectinfo_files)) {
+        return 1;
+    }
+
+    //============================= 녹화 읽기 / 융합 / 타임라인 =================================
+    std::vector<std::vector<LidarBinary>> sensor_loaded_bin(lidar_sensor_ids.size());
+    std::vector<LidarBinary> lidar_loaded_bin;
+    std::vector<ObjBinary> obj_loaded_bin;
+    MergeStats merge_stats;
+    LidarRoi roi;       // 센서 좌표 기준 (융합 전)
+    for(size_t sensor = 0; sensor < lidar_sensor_ids.size(); ++sensor) {
+        RecordingMerge::loadLidar(lidar_files[sensor], sensor_loaded_bin[sensor], merge_stats, roi_filter ? &roi : nullptr);
+        RecordingMerge::printStats("lidar_" + std::to_string(lidar_sensor_ids[sensor]), merge_stats);
+    }
+    RecordingMerge::loadObj(detectinfo_files, obj_loaded_bin, merge_stats);
+    RecordingMerge::printStats("detectinfo", merge_stats);
+
+    LidarFusion lidar_fusion;
+    lidar_fusion.build(lidar_sensor_ids, sensor_loaded_bin, lidar_loaded_bin);
+
+    std::vector<UnifiedData> timeline;
+    Timeline::build(lidar_loaded_bin, obj_loaded_bin, timeline);
+
+    std::cout << "==================================================" << std::endl;
+    std::cout << "Lidar frame num: " << lidar_loaded_bin.size() << " (" << lidar_fusion.getSensorCount() << " sensors)" << std::endl;
+    std::cout << "Detection data set num: " << obj_loaded_bin.size() << std::endl;
+    std::cout << "Timeline entries: " << timeline.size() << std::endl;
+    std::cout << "==================================================" << std::endl;
+
+    //============================= 연결 대기 / 스트리밍 =================================
+    StreamSocket listener;
+    if(!listener.listen(static_cast<uint16_t>(port))) {
+        return 1;
+    }
+    std::cout << "Listening on port " << port;
+    if(options.limit_bytes_per_s > 0.0) {
+        std::cout << " (link limit " << options.limit_bytes_per_s * 8.0 / 1000.0 << " kbps)";
+    }
+    std::cout << std::endl;
+
+    FrameServer server(lidar_loaded_bin, obj_loaded_bin, timeline);
+    while(true) {
+        StreamSocket client;
+        if(!listener.accept(client)) {
+            return 1;
+        }
+        std::string peer = client.getPeerName();
+        std::cout << "Client connected: " << peer << std::endl;
+        server.serve(client, options);
+        std::cout << "Client disconnected: " << peer << " (" << server.getSentBytes() / 1024 << " KB, "
+                  << server.getSentLidar() << " lidar sent, " << server.getSkippedLidar() << " skipped, "
+                  << server.getSentObj() << " obj)" << std::endl;
+    }
+    return 0;
+}
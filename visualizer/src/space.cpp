@@ -1,5 +1,8 @@
 
 #include "space.h"
+#include "profiler.h"
+
+#include <glm/gtc/type_ptr.hpp>
 
 #define DYNAMIC 1
 #define STATIC  0
@@ -7,11 +10,6 @@
 
 extern float orbitRadius;
 
-std::string vecToStr(const glm::vec3& v) {
-    char buff[100];
-    snprintf(buff, sizeof(buff), "%.4f, %.4f, %.4f", v.x, v.y, v.z);
-    return std::string(buff);
-}
 
 std::string Space::formatUnixTime(uint64_t unixtime) const{
     std::time_t sec_time = static_cast<std::time_t>(unixtime / 1000);
@@ -25,44 +23,34 @@ std::string Space::formatUnixTime(uint64_t unixtime) const{
 
 
 void Space::addLidarPoint(const glm::vec3& point) {      // point(x, y, z) 위치에 빨간색 점
-    std::pair<glm::vec3, glm::vec3> _point;
-    _point.first = point;
-    _point.second = glm::vec3(1.0f, 0.0f, 0.0f); //default = red
-    lidar_points.push_back(_point);
+    lidar_points.push(point, glm::vec3(1.0f, 0.0f, 0.0f));   //default = red
 }
 
 void Space::addLidarPoint(const glm::vec3& point, const glm::vec3& color){   // point(x, y, z) 위치에 내가 지정한 색 점
-    std::pair<glm::vec3, glm::vec3> _point;
-    _point.first = point;
-    _point.second = color;
-    lidar_points.push_back(_point);
+    lidar_points.push(point, color);
 }
 
 void Space::addObjPoint(const glm::vec3& point, const glm::vec3& color) {
-    std::pair<glm::vec3, glm::vec3> _point;
-    _point.first = point;
-    _point.second = color;
-    obj_points.push_back(_point);
+    obj_points.push(point, color);
 }
 
+// clear*는 capacity를 유지 (swap으로 해제하면 다음 프레임에 다시 할당됨)
 void Space::clearLidarPoints(){
+    current_lidar = nullptr;
     lidar_points.clear();
-    std::vector <std::pair<glm::vec3, glm::vec3>>().swap(lidar_points);
-    // std::vector <std::pair<glm::vec3, glm::vec3>>() -> 빈 벡터 / 빈 벡터와 points를 교환해서 할당된 메모리 전부 해제
 }
 
 void Space::clearObjPoints(){
+    current_obj = nullptr;
     obj_points.clear();
-    std::vector <std::pair<glm::vec3, glm::vec3>>().swap(obj_points);
 }
 
 void Space::addLine(const glm::vec3& start, const glm::vec3& end, const glm::vec3& color) {
-    lines.emplace_back(start, end, color);
+    lines.push(start, end, color);
 }
 
 void Space::clearLines(){
     lines.clear();
-    std::vector <std::tuple<glm::vec3, glm::vec3, glm::vec3>>().swap(lines);
 }
 
 void Space::addBox(const glm::vec3& point, const glm::vec3& xway, 
@@ -84,7 +72,6 @@ void Space::addBox(const glm::vec3& start_point, const glm::vec3& end_point, con
 
 void Space::clearBoxes(){
     boxes.clear();
-    std::vector <Box>().swap(boxes);
 }
 
 
@@ -105,127 +92,448 @@ void drawCircle(const glm::vec3& center, float radius, int segments, const glm::
 }
 
 void Space::drawGrid(){
-    std::vector<std::pair<glm::vec3, glm::vec3>> gridpoints;
+    const glm::vec3 color(0.6f, 0.6f, 0.6f);    //grid: gray line
 
     for(int i=-GRID_NUM; i<GRID_NUM+1; i++){
-        std::pair<glm::vec3, glm::vec3> line0_points;
-        line0_points.first = glm::vec3(GRID_COEFFI*orbitRadius*i/GRID_NUM, -GRID_COEFFI*orbitRadius, GRID_Z_OFFSET);
-        line0_points.second = glm::vec3(GRID_COEFFI*orbitRadius*i/GRID_NUM, GRID_COEFFI*orbitRadius, GRID_Z_OFFSET);
-        gridpoints.push_back(line0_points);
-
-        std::pair<glm::vec3, glm::vec3> line1_points;
-        line1_points.first = glm::vec3(-GRID_COEFFI*orbitRadius, GRID_COEFFI*orbitRadius*i/GRID_NUM, GRID_Z_OFFSET);
-        line1_points.second = glm::vec3(GRID_COEFFI*orbitRadius, GRID_COEFFI*orbitRadius*i/GRID_NUM, GRID_Z_OFFSET);
-        gridpoints.push_back(line1_points);
-    }
-
-    for(const auto &points : gridpoints){
-        const glm::vec3 color(0.6f, 0.6f, 0.6f);    //grid: gray line
-        addLine(points.first, points.second, color);
+        addLine(glm::vec3(GRID_COEFFI*orbitRadius*i/GRID_NUM, -GRID_COEFFI*orbitRadius, GRID_Z_OFFSET),
+                glm::vec3(GRID_COEFFI*orbitRadius*i/GRID_NUM, GRID_COEFFI*orbitRadius, GRID_Z_OFFSET), color);
+        addLine(glm::vec3(-GRID_COEFFI*orbitRadius, GRID_COEFFI*orbitRadius*i/GRID_NUM, GRID_Z_OFFSET),
+                glm::vec3(GRID_COEFFI*orbitRadius, GRID_COEFFI*orbitRadius*i/GRID_NUM, GRID_Z_OFFSET), color);
     }
 }
 
 void Space::render() const {
-    // Draw circles for points
-    float lidar_radius = 0.01f;  // 동그라미 크기 설정
-    int segments = 30;     // 동그라미 세그먼트 (정확도)
-    for (const auto& point : lidar_points) {
-        drawCircle(point.first, lidar_radius, segments, point.second);
-    }
+    PROFILE_SCOPE("Space::render");
+    renderScene();
+    renderText();
+}
 
-    float obj_radius = 0.01f;
-    int obj_segments = 30;
-    for(const auto& point : obj_points) {
-        drawCircle(point.first, obj_radius, obj_segments, point.second);
+void Space::renderScene() const {
+    // Draw lidar points (VBO)
+    if(current_lidar != nullptr) {
+        PROFILE_SCOPE("points");
+        if(background_split) {
+            static_vbo.draw(LIDAR_POINT_SIZE);
+        }
+        dynamic_vbo.draw(LIDAR_POINT_SIZE);
+
+        // 누적 지도 + 센서 궤적 - 현재 스윕이 원점에 오도록 지도 쪽을 옮김 (박스 / picking은 스윕 좌표 그대로)
+        if(map_mode && map_uploaded && map_pose_valid) {
+            glPushMatrix();
+            glMultMatrixf(glm::value_ptr(map_to_sweep));
+            map_vbo.draw(REG_MAP_POINT_SIZE);
+            const auto& trajectory = scan_registration->getTrajectory();
+            glLineWidth(LINE_THICKNESS);
+            glColor3f(1.0f, 0.9f, 0.2f);
+            glBegin(GL_LINE_STRIP);
+            for(size_t i = 0; i <= map_frame_idx && i < trajectory.size(); ++i) {
+                glVertex3f(trajectory[i].x, trajectory[i].y, trajectory[i].z);
+            }
+            glEnd();
+            glPopMatrix();
+        }
     }
 
-    // Draw lines
-    for (const auto& line : lines) {
+    {
+        PROFILE_SCOPE("geometry");
+        // Draw circles for points
+        float obj_radius = 0.01f;
+        int obj_segments = 30;
+        for (size_t i = 0; i < obj_points.size(); ++i) {
+            drawCircle(obj_points.position[i], obj_radius, obj_segments, obj_points.color[i]);
+        }
+
+        // Draw lines
         glLineWidth(LINE_THICKNESS);  // 선 두께 설정
         glBegin(GL_LINES);
-        
-        glColor3f(std::get<2>(line).x, std::get<2>(line).y, std::get<2>(line).z);  // 선 색상
-        glVertex3f(std::get<0>(line).x, std::get<0>(line).y, std::get<0>(line).z);  // 시작점
-        glVertex3f(std::get<1>(line).x, std::get<1>(line).y, std::get<1>(line).z);  // 끝점
+        for (size_t i = 0; i < lines.size(); ++i) {
+            glColor3f(lines.color[i].x, lines.color[i].y, lines.color[i].z);    // 선 색상
+            glVertex3f(lines.start[i].x, lines.start[i].y, lines.start[i].z);   // 시작점
+            glVertex3f(lines.end[i].x, lines.end[i].y, lines.end[i].z);         // 끝점
+        }
         glEnd();
-    }
 
-    // Draw boxes
-    for (const auto& box : boxes) {
-        glLineWidth(LINE_THICKNESS);
-        glBegin(GL_LINES);
-        glColor3f(box.color.x, box.color.y, box.color.z);
+        // Draw boxes
+        for (const auto& box : boxes) {
+            glLineWidth(LINE_THICKNESS);
+            glBegin(GL_LINES);
+            glColor3f(box.color.x, box.color.y, box.color.z);
 
-        float x = box.point.x;
-        float y = box.point.y;
-        float z = box.point.z;
+            float x = box.point.x;
+            float y = box.point.y;
+            float z = box.point.z;
 
         
-        glVertex3f(x, y, z);        glVertex3f(x + box.xway.x, y + box.xway.y, z + box.xway.z);
-        glVertex3f(x, y, z);        glVertex3f(x + box.yway.x, y + box.yway.y, z + box.yway.z);
-        glVertex3f(x, y, z);        glVertex3f(x + box.zway.x, y + box.zway.y, z + box.zway.z);
+            glVertex3f(x, y, z);        glVertex3f(x + box.xway.x, y + box.xway.y, z + box.xway.z);
+            glVertex3f(x, y, z);        glVertex3f(x + box.yway.x, y + box.yway.y, z + box.yway.z);
+            glVertex3f(x, y, z);        glVertex3f(x + box.zway.x, y + box.zway.y, z + box.zway.z);
         
-        x = box.point.x + box.xway.x + box.yway.x;
-        y = box.point.y + box.xway.y + box.yway.y;
-        z = box.point.z + box.xway.z + box.yway.z;
+            x = box.point.x + box.xway.x + box.yway.x;
+            y = box.point.y + box.xway.y + box.yway.y;
+            z = box.point.z + box.xway.z + box.yway.z;
 
-        glVertex3f(x, y, z);        glVertex3f(x - box.xway.x, y - box.xway.y, z - box.xway.z);
-        glVertex3f(x, y, z);        glVertex3f(x - box.yway.x, y - box.yway.y, z - box.yway.z);
-        glVertex3f(x, y, z);        glVertex3f(x + box.zway.x, y + box.zway.y, z + box.zway.z);
+            glVertex3f(x, y, z);        glVertex3f(x - box.xway.x, y - box.xway.y, z - box.xway.z);
+            glVertex3f(x, y, z);        glVertex3f(x - box.yway.x, y - box.yway.y, z - box.yway.z);
+            glVertex3f(x, y, z);        glVertex3f(x + box.zway.x, y + box.zway.y, z + box.zway.z);
 
-        x = box.point.x + box.yway.x + box.zway.x;
-        y = box.point.y + box.yway.y + box.zway.y;
-        z = box.point.z + box.yway.z + box.zway.z;
+            x = box.point.x + box.yway.x + box.zway.x;
+            y = box.point.y + box.yway.y + box.zway.y;
+            z = box.point.z + box.yway.z + box.zway.z;
 
-        glVertex3f(x, y, z);        glVertex3f(x - box.yway.x, y - box.yway.y, z - box.yway.z);
-        glVertex3f(x, y, z);        glVertex3f(x - box.zway.x, y - box.zway.y, z - box.zway.z);
-        glVertex3f(x, y, z);        glVertex3f(x + box.xway.x, y + box.xway.y, z + box.xway.z);
+            glVertex3f(x, y, z);        glVertex3f(x - box.yway.x, y - box.yway.y, z - box.yway.z);
+            glVertex3f(x, y, z);        glVertex3f(x - box.zway.x, y - box.zway.y, z - box.zway.z);
+            glVertex3f(x, y, z);        glVertex3f(x + box.xway.x, y + box.xway.y, z + box.xway.z);
 
-        x = box.point.x + box.zway.x + box.xway.x;
-        y = box.point.y + box.zway.y + box.xway.y;
-        z = box.point.z + box.zway.z + box.xway.z;
+            x = box.point.x + box.zway.x + box.xway.x;
+            y = box.point.y + box.zway.y + box.xway.y;
+            z = box.point.z + box.zway.z + box.xway.z;
 
-        glVertex3f(x, y, z);        glVertex3f(x - box.zway.x, y - box.zway.y, z - box.zway.z);
-        glVertex3f(x, y, z);        glVertex3f(x - box.xway.x, y - box.xway.y, z - box.xway.z);
-        glVertex3f(x, y, z);        glVertex3f(x + box.yway.x, y + box.yway.y, z + box.yway.z);
+            glVertex3f(x, y, z);        glVertex3f(x - box.zway.x, y - box.zway.y, z - box.zway.z);
+            glVertex3f(x, y, z);        glVertex3f(x - box.xway.x, y - box.xway.y, z - box.xway.z);
+            glVertex3f(x, y, z);        glVertex3f(x + box.yway.x, y + box.yway.y, z + box.yway.z);
 
-        glEnd();
+            glEnd();
+        }
     }
+}
 
+void Space::renderText() const {
+    PROFILE_SCOPE("text");
     int y_offset = 20;
+    char line[128];     // 스택 버퍼 - 매 프레임 std::string 할당 방지
 
     for(const auto& info : render_text_list) {
-        std::string line1 = colorToString(info.color) + ": " + info.label + " (id=" + std::to_string(info.obj_id) + ")";
-        std::string line2 = "min(" + vecToStr(info.min_coord) + ")";
-        std::string line3 = "max(" + vecToStr(info.max_coord) + ")";
-        std::string line4 = "distance=" + std::to_string(info.distance);
-
-        renderText2D(line1, 10, y_offset, info.color); y_offset += 20;
-        renderText2D(line2, 10, y_offset, info.color); y_offset += 20;
-        renderText2D(line3, 10, y_offset, info.color); y_offset += 20;
-        renderText2D(line4, 10, y_offset, info.color); y_offset += 20;
+        if(track_mode && info.track_id >= 0) {
+            snprintf(line, sizeof(line), "%s: %s (id=%d, track=%d)", colorToString(info.color), info.label, info.obj_id, info.track_id);
+        } else {
+            snprintf(line, sizeof(line), "%s: %s (id=%d)", colorToString(info.color), info.label, info.obj_id);
+        }
+        renderText2D(line, 10, y_offset, info.color); y_offset += 20;
+        snprintf(line, sizeof(line), "min(%.4f, %.4f, %.4f)", info.min_coord.x, info.min_coord.y, info.min_coord.z);
+        renderText2D(line, 10, y_offset, info.color); y_offset += 20;
+        snprintf(line, sizeof(line), "max(%.4f, %.4f, %.4f)", info.max_coord.x, info.max_coord.y, info.max_coord.z);
+        renderText2D(line, 10, y_offset, info.color); y_offset += 20;
+        snprintf(line, sizeof(line), "distance=%f", info.distance);
+        renderText2D(line, 10, y_offset, info.color); y_offset += 20;
+        if(info.lidar_points > 0) {
+            snprintf(line, sizeof(line), "lidar: %d pts, nearest=%.3f, refl=%.1f", info.lidar_points, info.lidar_nearest, info.lidar_reflectivity);
+            renderText2D(line, 10, y_offset, info.color); y_offset += 20;
+        } else if(info.lidar_points == 0) {
+            renderText2D("lidar: no points in box", 10, y_offset, info.color); y_offset += 20;
+        }
     }
 }
 
 
 void Space::lidarIntoSpace(const LidarBinary& index) {
+    PROFILE_SCOPE("Space::lidarIntoSpace");
     render_text_list.clear();   // obj 데이터 차례에만 2d text 띄워지도록
+    current_lidar = &index;
     const auto& _points = index.lidar_data;
+    lidar_points.reserve(lidar_points.size() + _points.size());     // capacity가 충분하면 할당 없음
+
+    // 처리 단계 - 프레임이 바뀐 경우에만 계산
+    const uint8_t* ground = nullptr;
+    if(ground_mode != GroundMode::OFF) {
+        PROFILE_SCOPE("ground");
+        ground_filter.process(index);
+        if(ground_filter.getPlane().valid) {
+            ground = ground_filter.getGroundMask().data();
+        }
+    }
+    const bool cluster_mode = (lidar_color_mode == LidarColorMode::CLUSTER);
+    if(cluster_mode) {
+        PROFILE_SCOPE("cluster");
+        cluster_stats.compute(index);
+    }
 
-    for(size_t i = 0; i < _points.size(); ++i) {
-        glm::vec3 point(_points[i].x, _points[i].y, _points[i].z);
-        float color_sense = _points[i].reflectivity / 26.54f;
-        glm::vec3 color(0.0f, 0.973f - color_sense, 0.364f + color_sense);
-        addLidarPoint(point, color);
+    const uint8_t* static_mask = nullptr;
+    if(background_mode != BackgroundMode::OFF) {
+        PROFILE_SCOPE("background");
+        background_model.update(index);
+        static_mask = background_model.getStaticMask().data();
+    }
+
+    // 멀티 라이다 - 센서 하나만 보기면 그 센서 구간만, 센서별 색상이면 구간마다 색
+    size_t point_begin = 0;
+    size_t point_end = _points.size();
+    size_t sensor_count = 0;
+    if(lidar_fusion && sensor_mode != SensorMode::ALL) {
+        sensor_count = lidar_fusion->getSensorCount();
+        sensor_begin.assign(sensor_count + 1, _points.size());     // capacity 재사용
+        for(size_t slot = 0; slot < sensor_count; ++slot) {
+            size_t end;
+            if(!lidar_fusion->getSensorRange(index, slot, sensor_begin[slot], end)) {
+                sensor_count = 0;       // 융합 결과가 아닌 프레임
+                break;
+            }
+        }
+        if(sensor_count > 0 && sensor_mode == SensorMode::SINGLE && sensor_slot < sensor_count) {
+            lidar_fusion->getSensorRange(index, sensor_slot, point_begin, point_end);
+        }
+    }
+    const bool sensor_colored = (sensor_mode == SensorMode::COLORED && sensor_count > 0);
+
+    // 정적 배경 대표점은 어느 센서의 점인지 모름 -> 센서별 보기 / 색상에서는 정적 점도 변화 점 버퍼로 그림
+    background_split = (background_mode == BackgroundMode::SPLIT && sensor_count == 0);
+    if(background_mode == BackgroundMode::SPLIT && !background_split) {
+        static_mask = nullptr;
+    }
+
+    // 화면 내용(프레임, 색상/지면/배경/센서 모드)이 바뀐 경우에만 점 버퍼를 다시 만들어 업로드
+    last_upload_bytes = 0;
+    last_full_bytes = 0;
+    const bool changed = (&index != uploaded_lidar || index.time != uploaded_time ||
+                          lidar_color_mode != uploaded_color_mode || ground_mode != uploaded_ground_mode ||
+                          background_mode != uploaded_background_mode ||
+                          sensor_mode != uploaded_sensor_mode || sensor_slot != uploaded_sensor_slot);
+    if(changed) {
+        PROFILE_SCOPE("upload");
+        lidar_points.clear();
+        size_t drawable = 0;
+        size_t slot = 0;
+        for(size_t i = point_begin; i < point_end; ++i) {
+            if(ground && ground[i] && ground_mode == GroundMode::HIDE) {
+                continue;
+            }
+            ++drawable;
+            if(static_mask && static_mask[i]) {
+                continue;       // 정적 배경 voxel의 점 - 배경 버퍼로 그림
+            }
+
+            glm::vec3 point(_points[i].x, _points[i].y, _points[i].z);
+            glm::vec3 color;
+            if(cluster_mode) {
+                ClusterStats::clusterColor(_points[i].cluster_id, color);
+            } else if(sensor_colored) {
+                while(slot + 1 < sensor_count && i >= sensor_begin[slot + 1]) ++slot;
+                LidarFusion::sensorColor(slot, color);
+            } else {
+                float color_sense = _points[i].reflectivity / 26.54f;
+                color = glm::vec3(0.0f, 0.973f - color_sense, 0.364f + color_sense);
+            }
+            if(ground && ground[i]) {
+                color *= GROUND_DIM_FACTOR;
+            }
+            addLidarPoint(point, color);
+        }
+        last_upload_bytes += dynamic_vbo.upload(lidar_points.position.data(), lidar_points.color.data(), lidar_points.size(), GL_STREAM_DRAW);
+        last_full_bytes = drawable * sizeof(glm::vec3) * 2;
+
+        uploaded_lidar = &index;
+        uploaded_time = index.time;
+        uploaded_color_mode = lidar_color_mode;
+        uploaded_ground_mode = ground_mode;
+        uploaded_background_mode = background_mode;
+        uploaded_sensor_mode = sensor_mode;
+        uploaded_sensor_slot = sensor_slot;
+    }
+    // 누적 지도 - 백그라운드 정합이 끝난 뒤 처음 지도 모드로 그릴 때 한 번 업로드
+    map_pose_valid = false;
+    if(map_mode && scan_registration && scan_registration->isReady()) {
+        if(!map_uploaded) {
+            PROFILE_SCOPE("upload");
+            const auto& map_points = scan_registration->getMapPoints();
+            last_upload_bytes += map_vbo.upload(map_points.data(), scan_registration->getMapColors().data(), map_points.size(), GL_STATIC_DRAW);
+            map_uploaded = true;
+        }
+        glm::mat4 pose;
+        if(scan_registration->getPose(index, pose)) {
+            map_to_sweep = glm::inverse(pose);
+            map_frame_idx = scan_registration->getFrameIndex(index);
+            map_pose_valid = true;
+        }
+    }
+    // 정적 배경 - 모델을 다시 모았거나 색상 / 지면 모드가 바뀐 경우에만 변화 점과 같은 규칙으로 색 / 지면 처리해 업로드
+    // 지면 판정은 버퍼를 만들 때의 평면 기준 (다음 모델 갱신까지 유지)
+    if(background_split && (background_model.getVersion() != uploaded_background_version ||
+                            lidar_color_mode != uploaded_background_color_mode || ground_mode != uploaded_background_ground_mode)) {
+        PROFILE_SCOPE("upload");
+        const GroundPlane& plane = ground_filter.getPlane();
+        const bool classify_ground = (ground_mode != GroundMode::OFF && plane.valid);
+        background_points.clear();
+        for(const LidarData& p : background_model.getBackgroundPoints()) {
+            const bool is_ground = classify_ground && std::fabs(plane.a * p.x + plane.b * p.y + plane.c * p.z + plane.d) < GROUND_DIST_THRESHOLD;
+            if(is_ground && ground_mode == GroundMode::HIDE) {
+                continue;
+            }
+            glm::vec3 color;
+            if(cluster_mode) {
+                ClusterStats::clusterColor(p.cluster_id, color);
+            } else {
+                float color_sense = p.reflectivity / 26.54f;
+                color = glm::vec3(0.0f, 0.973f - color_sense, 0.364f + color_sense);
+            }
+            if(is_ground) {
+                color *= GROUND_DIM_FACTOR;
+            }
+            background_points.push(glm::vec3(p.x, p.y, p.z), color);
+        }
+        last_upload_bytes += static_vbo.upload(background_points.position.data(), background_points.color.data(), background_points.size(), GL_STATIC_DRAW);
+        uploaded_background_version = background_model.getVersion();
+        uploaded_background_color_mode = lidar_color_mode;
+        uploaded_background_ground_mode = ground_mode;
+    }
+    total_upload_bytes += last_upload_bytes;
+    total_full_bytes += last_full_bytes;
+
+    if(cluster_mode) {
+        for(const auto& cluster : cluster_stats.getClusters()) {
+            glm::vec3 color;
+            ClusterStats::clusterColor(cluster.cluster_id, color);
+            addBox(cluster.obb_point, cluster.obb_xway, cluster.obb_yway, cluster.obb_zway, color);
+        }
+    }
+}
+
+void Space::toggleClusterMode() {
+    lidar_color_mode = (lidar_color_mode == LidarColorMode::CLUSTER) ? LidarColorMode::REFLECTIVITY : LidarColorMode::CLUSTER;
+}
+
+LidarColorMode Space::getLidarColorMode() const {
+    return lidar_color_mode;
+}
+
+void Space::cycleGroundMode() {
+    if(ground_mode == GroundMode::OFF)          ground_mode = GroundMode::DIM;
+    else if(ground_mode == GroundMode::DIM)     ground_mode = GroundMode::HIDE;
+    else                                        ground_mode = GroundMode::OFF;
+}
+
+GroundMode Space::getGroundMode() const {
+    return ground_mode;
+}
+
+void Space::cycleBackgroundMode() {
+    if(background_mode == BackgroundMode::OFF)          background_mode = BackgroundMode::SPLIT;
+    else if(background_mode == BackgroundMode::SPLIT)   background_mode = BackgroundMode::CHANGES_ONLY;
+    else                                                background_mode = BackgroundMode::OFF;
+    uploaded_background_version = UINT32_MAX;       // 배경 버퍼 다시 올림
+}
+
+BackgroundMode Space::getBackgroundMode() const {
+    return background_mode;
+}
+
+void Space::setTracker(const Tracker* _tracker) {
+    tracker = _tracker;
+}
+
+void Space::setLidarFusion(const LidarFusion* _lidar_fusion) {
+    lidar_fusion = _lidar_fusion;
+}
+
+void Space::cycleSensorMode() {
+    const size_t sensor_count = lidar_fusion ? lidar_fusion->getSensorCount() : 0;
+    if(sensor_mode == SensorMode::ALL) {
+        sensor_mode = SensorMode::COLORED;
+        sensor_slot = 0;
+    } else if(sensor_mode == SensorMode::COLORED && sensor_count > 1) {
+        sensor_mode = SensorMode::SINGLE;
+        sensor_slot = 0;
+    } else if(sensor_mode == SensorMode::SINGLE && sensor_slot + 1 < sensor_count) {
+        ++sensor_slot;
+    } else {
+        sensor_mode = SensorMode::ALL;
+        sensor_slot = 0;
+    }
+
+    if(sensor_mode == SensorMode::SINGLE) {
+        std::cout << "Lidar sensor : lidar_" << lidar_fusion->getSensorId(sensor_slot) << " only" << std::endl;
+    } else {
+        std::cout << "Lidar sensor : " << (sensor_mode == SensorMode::COLORED ? "color by sensor" : "all") << std::endl;
+    }
+}
+
+SensorMode Space::getSensorMode() const {
+    return sensor_mode;
+}
+
+void Space::setScanRegistration(const ScanRegistration* _scan_registration) {
+    scan_registration = _scan_registration;
+}
+
+void Space::toggleMapMode() {
+    map_mode = !map_mode;
+    if(map_mode && scan_registration && !scan_registration->isReady()) {
+        std::cout << "Map : scan registration in progress (" << static_cast<int>(scan_registration->getProgress() * 100.0f) << "%)" << std::endl;
+    }
+}
+
+bool Space::getMapMode() const {
+    return map_mode;
+}
+
+void Space::toggleTrackMode() {
+    track_mode = !track_mode;
+}
+
+bool Space::getTrackMode() const {
+    return track_mode;
+}
+
+// 처리 단계 결과 출력 (space bar)
+void Space::printProcessingInfo() const {
+    if(ground_mode != GroundMode::OFF) {
+        const GroundPlane& plane = ground_filter.getPlane();
+        if(plane.valid) {
+            std::cout << "ground plane = (" << plane.a << ", " << plane.b << ", " << plane.c << ", " << plane.d
+                      << "), ground points = " << ground_filter.getGroundCount()
+                      << (ground_filter.wasWarmStarted() ? ", warm start" : "")
+                      << ", " << ground_filter.getElapsedMs() << " ms" << std::endl;
+        } else {
+            std::cout << "ground plane = not found" << std::endl;
+        }
+    }
+
+    if(background_mode != BackgroundMode::OFF) {
+        std::cout << "background voxels = " << background_model.getVoxelCount()
+                  << ", static points in frame = " << background_model.getStaticCount()
+                  << ", background points = " << background_model.getBackgroundPoints().size() << std::endl;
+    }
+    if(map_mode && map_pose_valid) {
+        const glm::vec3& position = scan_registration->getTrajectory()[map_frame_idx];
+        std::cout << "map pose = (" << position.x << ", " << position.y << ", " << position.z << "), sweep " << map_frame_idx
+                  << ", inlier ratio = " << scan_registration->getInlierRatio(map_frame_idx)
+                  << ", map points = " << scan_registration->getMapPoints().size() << std::endl;
+    }
+    std::cout << "lidar upload = " << last_upload_bytes / 1024.0 << " KB (full " << last_full_bytes / 1024.0 << " KB)";
+    if(total_full_bytes > 0) {
+        double saved = static_cast<double>(total_full_bytes) - static_cast<double>(total_upload_bytes);
+        std::cout << ", total saved = " << saved / (1024.0 * 1024.0) << " MB (" << 100.0 * saved / total_full_bytes << "%)";
+    }
+    std::cout << std::endl;
+
+    if(lidar_color_mode != LidarColorMode::CLUSTER) {
+        return;
+    }
+    const auto& clusters = cluster_stats.getClusters();
+    std::cout << "clusters = " << clusters.size() << std::endl;
+    for(const auto& c : clusters) {
+        std::cout << "cluster_id=[" << c.cluster_id << "] points=" << c.count
+                  << "/ centroid(" << c.centroid.x << ", " << c.centroid.y << ", " << c.centroid.z
+                  << "), aabb min(" << c.aabb_min.x << ", " << c.aabb_min.y << ", " << c.aabb_min.z
+                  << "), max(" << c.aabb_max.x << ", " << c.aabb_max.y << ", " << c.aabb_max.z
+                  << "), obb size(" << glm::length(c.obb_xway) << ", " << glm::length(c.obb_yway) << ", " << glm::length(c.obb_zway)
+                  << ")" << std::endl;
     }
 }
 
 void Space::objIntoSpace(const ObjBinary& index) {
+    PROFILE_SCOPE("Space::objIntoSpace");
     render_text_list.clear();
+    current_obj = &index;
 
-    
     const auto& _points = index.obj_data;
 
+    // 같이 띄워진 라이다 프레임이 있으면 박스별 점 통계 (프레임 쌍이 바뀐 경우에만 계산)
+    const std::vector<BoxLidarStats>* box_stats = nullptr;
+    if(current_lidar != nullptr) {
+        PROFILE_SCOPE("associate");
+        box_stats = &association.associate(index, *current_lidar);
+    }
+    const size_t track_frame = (tracker != nullptr) ? tracker->findFrame(index) : std::numeric_limits<size_t>::max();
+
     for(size_t i = 0; i < _points.size(); ++i) {
         if(_points[i].obj_id == -1) {
             continue;
@@ -233,7 +541,7 @@ void Space::objIntoSpace(const ObjBinary& index) {
         glm::vec3 point_nearest(_points[i].nearest_x, _points[i].nearest_y, _points[i].nearest_z);
         glm::vec3 point_min(_points[i].min_x, _points[i].min_y, _points[i].min_z);
         glm::vec3 point_max(_points[i].max_x, _points[i].max_y, _points[i].max_z);
-
+        int track_id = (track_frame != std::numeric_limits<size_t>::max()) ? tracker->getTrackId(track_frame, i) : -1;
 
         #if STATIC
         glm::vec3 red(1.0f, 0.0f, 0.0f);
@@ -247,6 +555,18 @@ void Space::objIntoSpace(const ObjBinary& index) {
         #if DYNAMIC
         glm::vec3 color;
         getDynamicColorById(_points[i].obj_id, color);
+        if(track_mode && track_id >= 0) {
+            Tracker::trackColor(track_id, color);
+
+            // 현재 프레임까지의 궤적 (최근 TRACK_TRAIL_LENGTH 점)
+            const auto& trail = tracker->getTrack(track_id).points;
+            auto end = std::upper_bound(trail.begin(), trail.end(), track_frame,
+                                        [](size_t frame, const TrackPoint& p) { return frame < p.frame; });
+            auto begin = (end - trail.begin() > TRACK_TRAIL_LENGTH) ? end - TRACK_TRAIL_LENGTH : trail.begin();
+            for(auto it = begin; it != end && it + 1 != end; ++it) {
+                addLine(it->center, (it + 1)->center, color);
+            }
+        }
         addObjPoint(point_nearest, color);
         addObjPoint(point_min, color);
         addObjPoint(point_max, color);
@@ -256,7 +576,7 @@ void Space::objIntoSpace(const ObjBinary& index) {
 
 
         auto it = objId_to_label.find(_points[i].obj_id);
-        std::string label = (it != objId_to_label.end()) ? it->second : "unknown";
+        const char* label = (it != objId_to_label.end()) ? it->second.c_str() : "unknown";
 
         render_text_list.push_back({
             color,
@@ -264,7 +584,11 @@ void Space::objIntoSpace(const ObjBinary& index) {
             label,
             point_min,
             point_max,
-            _points[i].distance
+            _points[i].distance,
+            track_id,
+            box_stats ? static_cast<int>((*box_stats)[i].point_count) : -1,
+            box_stats ? (*box_stats)[i].nearest_range : -1.0f,
+            box_stats ? (*box_stats)[i].mean_reflectivity : 0.0f
         });
 
         #if STATIC
@@ -345,7 +669,7 @@ void Space::resetColorMap() {
 #endif
 
 // 좌측 상단 2D text 고정
-std::string Space::colorToString(const glm::vec3& color) const{
+const char* Space::colorToString(const glm::vec3& color) const{
     if(color == glm::vec3(1.0f, 0.0f, 0.0f)) return "red";
     if(color == glm::vec3(1.0f, 0.65f, 0.0f)) return "orange";
     if(color == glm::vec3(1.0f, 1.0f, 0.0f)) return "yellow";
@@ -357,6 +681,10 @@ std::string Space::colorToString(const glm::vec3& color) const{
 }
 
 void Space::renderText2D(const std::string& text, float x, float y, const glm::vec3& color) const{
+    renderText2D(text.c_str(), x, y, color);
+}
+
+void Space::renderText2D(const char* text, float x, float y, const glm::vec3& color) const{
     glMatrixMode(GL_PROJECTION);
     glPushMatrix();
     glLoadIdentity();
@@ -368,8 +696,8 @@ void Space::renderText2D(const std::string& text, float x, float y, const glm::v
 
     glColor3f(color.r, color.g, color.b);
     glRasterPos2f(x, WINDOW_HEIGHT - y);    // 좌측 상단 기준   (0, 0)이 좌하단
-    for(char c : text) {
-        glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, c);
+    for(const char* c = text; *c; ++c) {
+        glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, *c);
     }
 
     glPopMatrix();
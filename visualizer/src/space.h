@@ -11,9 +11,19 @@
 #include <ctime>
 #include <iomanip>
 #include <sstream>
+#include <algorithm>
+#include <limits>
 
 #include "configs.h"
 #include "binary_utils.h"
+#include "cluster_stats.h"
+#include "ground_filter.h"
+#include "association.h"
+#include "tracker.h"
+#include "background_model.h"
+#include "point_vbo.h"
+#include "lidar_fusion.h"
+#include "scan_registration.h"
 
 
 typedef struct _box{
@@ -27,12 +37,42 @@ typedef struct _box{
 struct RenderTextInfo {
     glm::vec3 color;
     int obj_id;
-    std::string label;
+    const char* label;      // objId_to_label 문자열 (정적 저장소) -> 프레임마다 문자열 할당 없음
     glm::vec3 min_coord;
     glm::vec3 max_coord;
     float distance;
+    int track_id;               // -1 : track 없음
+    int lidar_points;           // 박스 내 라이다 점 수 (-1 : 매칭 라이다 프레임 없음)
+    float lidar_nearest;        // 박스 내 점의 최단거리
+    float lidar_reflectivity;   // 박스 내 점의 평균 reflectivity
 };
 
+// 점 버퍼 (SoA) - clear는 크기만 0으로 되돌리고 capacity는 유지 -> 정상 재생 중 재할당 없음
+struct PointBuffer {
+    std::vector<glm::vec3> position;
+    std::vector<glm::vec3> color;
+
+    void reserve(size_t n) { position.reserve(n); color.reserve(n); }
+    void push(const glm::vec3& p, const glm::vec3& c) { position.push_back(p); color.push_back(c); }
+    void clear() { position.clear(); color.clear(); }
+    size_t size() const { return position.size(); }
+};
+
+// 선 버퍼 (SoA) - start point, end point, color
+struct LineBuffer {
+    std::vector<glm::vec3> start;
+    std::vector<glm::vec3> end;
+    std::vector<glm::vec3> color;
+
+    void push(const glm::vec3& s, const glm::vec3& e, const glm::vec3& c) { start.push_back(s); end.push_back(e); color.push_back(c); }
+    void clear() { start.clear(); end.clear(); color.clear(); }
+    size_t size() const { return start.size(); }
+};
+
+enum class LidarColorMode { REFLECTIVITY, CLUSTER };
+enum class GroundMode { OFF, DIM, HIDE };     // 지면 점 처리
+enum class SensorMode { ALL, COLORED, SINGLE };     // 멀티 라이다 : 전체 / 센서별 색상 / 센서 하나만
+
 class Space {
 public:
     void addLidarPoint(const glm::vec3& point);
@@ -53,25 +93,97 @@ public:
     void clearBoxes();
     
     void drawGrid();
-    void render() const;
+    void render() const;                // renderScene + renderText
+    void renderScene() const;           // 점 VBO / 원 / 선 / 박스 - 현재 GL 행렬 그대로 (보기마다 호출, 업로드 없음)
+    void renderText() const;            // 객체 정보 2D 글자 - 창 전체 기준 (프레임마다 한 번)
 
     void lidarIntoSpace(const LidarBinary& index);
     void objIntoSpace(const ObjBinary& index);
 
+    void toggleClusterMode();
+    LidarColorMode getLidarColorMode() const;
+    void cycleGroundMode();
+    GroundMode getGroundMode() const;
+    void printProcessingInfo() const;
+    void cycleBackgroundMode();
+    BackgroundMode getBackgroundMode() const;
+    void setTracker(const Tracker* tracker);
+    void setLidarFusion(const LidarFusion* lidar_fusion);
+    void cycleSensorMode();
+    SensorMode getSensorMode() const;
+    void setScanRegistration(const ScanRegistration* scan_registration);
+    void toggleMapMode();
+    bool getMapMode() const;
+    void toggleTrackMode();
+    bool getTrackMode() const;
+
     void getDynamicColorById(int obj_id, glm::vec3& out_color);
     void resetColorMap();
 
-    std::string colorToString(const glm::vec3& color) const;
+    const char* colorToString(const glm::vec3& color) const;
     void renderText2D(const std::string& text, float x, float y, const glm::vec3& color) const;
+    void renderText2D(const char* text, float x, float y, const glm::vec3& color) const;
 
     std::string formatUnixTime(uint64_t unixtime) const;
     
 
-    std::vector<std::pair<glm::vec3, glm::vec3>> lidar_points; //point, color
-    std::vector<std::pair<glm::vec3, glm::vec3>> obj_points;
-    //start point, end point, R, G, B
-    std::vector<std::tuple<glm::vec3, glm::vec3, glm::vec3>> lines; 
+    PointBuffer lidar_points;
+    PointBuffer obj_points;
+    LineBuffer lines;
     std::vector<Box> boxes;
 
     std::vector<RenderTextInfo> render_text_list;
+
+    // 현재 화면에 올라간 원본 프레임 (picking 등에서 reflectivity, cluster_id 조회용)
+    const LidarBinary* current_lidar = nullptr;
+    const ObjBinary* current_obj = nullptr;
+
+    LidarColorMode lidar_color_mode = LidarColorMode::REFLECTIVITY;
+    ClusterStats cluster_stats;     // cluster 모드에서 프레임 준비 시 계산
+
+    GroundMode ground_mode = GroundMode::OFF;
+    GroundFilter ground_filter;     // 지면 모드에서 프레임 준비 시 계산
+
+    Association association;        // 화면의 라이다 프레임 점 -> 객체 박스 할당
+
+    const Tracker* tracker = nullptr;   // 로드 시 녹화 전체로 계산된 track (main 소유)
+    bool track_mode = false;            // 박스 색상 : 클래스 -> track id, 궤적 표시
+
+    BackgroundMode background_mode = BackgroundMode::OFF;
+    BackgroundModel background_model;   // 배경 모드에서 재생 프레임마다 갱신
+
+    const LidarFusion* lidar_fusion = nullptr;  // 융합 프레임의 센서별 점 구간 (main 소유)
+    SensorMode sensor_mode = SensorMode::ALL;
+    size_t sensor_slot = 0;                     // SINGLE 모드의 센서 (LidarFusion slot)
+    std::vector<size_t> sensor_begin;           // 현재 프레임의 센서별 시작 점 (COLORED)
+
+    const ScanRegistration* scan_registration = nullptr;    // 스윕 자세 + 누적 지도 (main 소유, 백그라운드 생성)
+    bool map_mode = false;              // 누적 지도를 현재 스윕 좌표로 옮겨 함께 그림
+    PointVbo map_vbo;                   // 지도 점 - 생성 완료 후 한 번만 업로드
+    bool map_uploaded = false;
+    bool map_pose_valid = false;
+    glm::mat4 map_to_sweep = glm::mat4(1.0f);   // 지도 좌표 -> 현재 스윕 좌표 (자세의 역변환)
+    size_t map_frame_idx = 0;                   // 현재 스윕 (궤적을 여기까지 그림)
+
+    // 라이다 점 GPU 버퍼 - 정적 배경은 모델이 다시 모였을 때만, 변화 점은 화면 내용이 바뀐 경우에만 업로드
+    PointVbo static_vbo;
+    PointVbo dynamic_vbo;
+    const LidarBinary* uploaded_lidar = nullptr;
+    uint64_t uploaded_time = 0;
+    LidarColorMode uploaded_color_mode = LidarColorMode::REFLECTIVITY;
+    GroundMode uploaded_ground_mode = GroundMode::OFF;
+    BackgroundMode uploaded_background_mode = BackgroundMode::OFF;
+    uint32_t uploaded_background_version = UINT32_MAX;
+    LidarColorMode uploaded_background_color_mode = LidarColorMode::REFLECTIVITY;    // 정적 배경 버퍼를 만든 색상 / 지면 모드
+    GroundMode uploaded_background_ground_mode = GroundMode::OFF;
+    PointBuffer background_points;      // 정적 배경 버퍼 준비용 (capacity 재사용)
+    bool background_split = false;      // 정적 배경 버퍼를 그림 (SPLIT, 센서별 보기가 아닐 때)
+    SensorMode uploaded_sensor_mode = SensorMode::ALL;
+    size_t uploaded_sensor_slot = 0;
+
+    // 업로드량 (전체 점을 매번 올렸을 때 대비)
+    size_t last_upload_bytes = 0;
+    size_t last_full_bytes = 0;
+    uint64_t total_upload_bytes = 0;
+    uint64_t total_full_bytes = 0;
 };
\ No newline at end of file
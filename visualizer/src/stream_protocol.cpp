@@ -0,0 +1,226 @@
+#include "stream_protocol.h"
+#include "configs.h"
+
+#include <cstring>
+#include <iostream>
+#include <unistd.h>
+#include <netdb.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+
+StreamSocket::StreamSocket() {}
+
+StreamSocket::~StreamSocket() {
+    close();
+}
+
+void StreamSocket::setupOptions() {
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));    // 작은 제어 / ACK 메시지 지연 방지
+}
+
+bool StreamSocket::listen(uint16_t port) {
+    close();
+    fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if(fd < 0) {
+        std::cerr << "Failed to create socket: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    if(::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || ::listen(fd, 1) < 0) {
+        std::cerr << "Failed to listen on port " << port << ": " << std::strerror(errno) << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool StreamSocket::accept(StreamSocket& out_client) {
+    out_client.close();
+    int client_fd;
+    do {
+        client_fd = ::accept(fd, nullptr, nullptr);
+    } while(client_fd < 0 && errno == EINTR);
+    if(client_fd < 0) {
+        std::cerr << "Failed to accept: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    out_client.fd = client_fd;
+    out_client.setupOptions();
+    return true;
+}
+
+bool StreamSocket::connect(const std::string& host, uint16_t port) {
+    close();
+    addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* result = nullptr;
+    std::string port_str = std::to_string(port);
+    int err = ::getaddrinfo(host.c_str(), port_str.c_str(), &hints, &result);
+    if(err != 0) {
+        std::cerr << "Failed to resolve " << host << ": " << gai_strerror(err) << std::endl;
+        return false;
+    }
+    for(addrinfo* ai = result; ai != nullptr; ai = ai->ai_next) {
+        fd = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if(fd < 0) {
+            continue;
+        }
+        if(::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+            break;
+        }
+        ::close(fd);
+        fd = -1;
+    }
+    ::freeaddrinfo(result);
+    if(fd < 0) {
+        std::cerr << "Failed to connect to " << host << ":" << port << std::endl;
+        return false;
+    }
+    setupOptions();
+    return true;
+}
+
+std::string StreamSocket::getPeerName() const {
+    sockaddr_storage addr;
+    socklen_t len = sizeof(addr);
+    char host[NI_MAXHOST], service[NI_MAXSERV];
+    if(fd < 0 || ::getpeername(fd, reinterpret_cast<sockaddr*>(&addr), &len) < 0 ||
+       ::getnameinfo(reinterpret_cast<sockaddr*>(&addr), len, host, sizeof(host), service, sizeof(service), NI_NUMERICHOST | NI_NUMERICSERV) != 0) {
+        return "unknown";
+    }
+    return std::string(host) + ":" + service;
+}
+
+
+bool StreamSocket::sendAll(const void* data, size_t size) {
+    const char* p = static_cast<const char*>(data);
+    while(size > 0) {
+        ssize_t n = ::send(fd, p, size, MSG_NOSIGNAL);
+        if(n < 0 && errno == EINTR) {
+            continue;
+        }
+        if(n <= 0) {
+            return false;
+        }
+        p += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool StreamSocket::recvAll(void* data, size_t size) {
+    char* p = static_cast<char*>(data);
+    while(size > 0) {
+        ssize_t n = ::recv(fd, p, size, 0);
+        if(n < 0 && errno == EINTR) {
+            continue;
+        }
+        if(n <= 0) {
+            return false;
+        }
+        p += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool StreamSocket::sendMessage(StreamMessage type, uint32_t seq, const void* payload, size_t size) {
+    return sendMessage(type, seq, nullptr, 0, payload, size);
+}
+
+// 헤더 + 앞부분(head) + payload를 한 번의 sendmsg로 (작은 메시지가 여러 TCP segment로 나뉘지 않도록)
+bool StreamSocket::sendMessage(StreamMessage type, uint32_t seq, const void* head, size_t head_size, const void* payload, size_t size) {
+    if(fd < 0) {
+        return false;
+    }
+    StreamHeader header;
+    header.magic = STREAM_MAGIC;
+    header.type = static_cast<uint32_t>(type);
+    header.seq = seq;
+    header.size = static_cast<uint32_t>(head_size + size);
+
+    iovec iov[3];
+    int count = 0;
+    iov[count].iov_base = &header;
+    iov[count++].iov_len = sizeof(header);
+    if(head_size > 0) {
+        iov[count].iov_base = const_cast<void*>(head);
+        iov[count++].iov_len = head_size;
+    }
+    if(size > 0) {
+        iov[count].iov_base = const_cast<void*>(payload);
+        iov[count++].iov_len = size;
+    }
+    msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = count;
+
+    size_t total = sizeof(header) + head_size + size;
+    ssize_t n;
+    do {
+        n = ::sendmsg(fd, &msg, MSG_NOSIGNAL);
+    } while(n < 0 && errno == EINTR);
+    if(n < 0) {
+        return false;
+    }
+    // 일부만 보내졌으면 나머지를 이어서
+    size_t sent = static_cast<size_t>(n);
+    for(int i = 0; i < count && sent < total; ++i) {
+        if(sent >= iov[i].iov_len) {
+            sent -= iov[i].iov_len;
+            total -= iov[i].iov_len;
+            continue;
+        }
+        if(!sendAll(static_cast<const char*>(iov[i].iov_base) + sent, iov[i].iov_len - sent)) {
+            return false;
+        }
+        total -= iov[i].iov_len;
+        sent = 0;
+    }
+    return true;
+}
+
+bool StreamSocket::recvMessage(StreamHeader& out_header, std::vector<uint8_t>& out_payload) {
+    if(fd < 0 || !recvAll(&out_header, sizeof(out_header))) {
+        return false;
+    }
+    if(out_header.magic != STREAM_MAGIC || out_header.size > STREAM_MAX_MESSAGE_BYTES) {
+        std::cerr << "Invalid stream message (magic " << std::hex << out_header.magic << std::dec << ", size " << out_header.size << ")" << std::endl;
+        return false;
+    }
+    out_payload.resize(out_header.size);
+    return out_header.size == 0 || recvAll(out_payload.data(), out_header.size);
+}
+
+
+void StreamSocket::shutdown() {
+    if(fd >= 0) {
+        ::shutdown(fd, SHUT_RDWR);
+    }
+}
+
+void StreamSocket::close() {
+    if(fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+bool StreamSocket::isOpen() const {
+    return fd >= 0;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+
+// 원격 보기 (aeronSW_server -> aeronSW_client) TCP 메시지
+// 메시지 = StreamHeader + payload(size bytes), 구조체는 .uld / .udd와 같이 같은 바이트 순서의 기기끼리 그대로 주고받음
+#define STREAM_MAGIC    0x56534541u     // "AESV"
+
+enum class StreamMessage : uint32_t {
+    HELLO = 1,          // server -> client : StreamHello
+    LIDAR = 2,          // server -> client : StreamFrameInfo + FrameCodec 라이다 payload
+    OBJ = 3,            // server -> client : StreamFrameInfo + FrameCodec 검출 목록
+    END = 4,            // server -> client : 녹화 끝 (일시 정지 상태)
+    CONTROL = 16,       // client -> server : StreamControl
+    ACK = 17            // client -> server : StreamAck (프레임 처리 완료, 서버 전송량 조절에 사용)
+};
+
+enum class StreamCommand : uint32_t {
+    PLAY = 1,
+    PAUSE = 2,
+    SEEK = 3,           // value : 현재 위치 기준 이동 ms
+    SPEED = 4           // value : 배속 x 1000
+};
+
+struct StreamHeader {
+    uint32_t magic;
+    uint32_t type;      // StreamMessage
+    uint32_t seq;       // 서버 메시지 순번 (ACK 대상)
+    uint32_t size;      // payload bytes
+};
+
+struct StreamHello {
+    uint64_t first_time;
+    uint64_t last_time;
+    uint32_t timeline_size;
+    uint32_t lidar_frames;
+    uint32_t obj_frames;
+    float quant_step;   // 점 좌표 양자화 간격 // m
+};
+
+struct StreamFrameInfo {
+    uint64_t time;
+    uint32_t timeline_idx;
+    uint32_t stride;    // 라이다 : 보낸 점 간격 (1 = 전체)
+};
+
+struct StreamControl {
+    uint32_t command;   // StreamCommand
+    int32_t value;
+};
+
+struct StreamAck {
+    uint64_t received_bytes;    // 연결 이후 받은 전체 bytes (헤더 포함) -> 서버 전송량 - 이 값 = 아직 처리 안 된 양
+    uint32_t seq;
+    uint32_t reserved;
+};
+
+
+// TCP 연결 하나 (POSIX socket, Nagle 끔) - 보내기 / 받기를 서로 다른 스레드에서 동시에 써도 됨 (보내기끼리는 호출자가 직렬화)
+class StreamSocket {
+public:
+    StreamSocket();
+    ~StreamSocket();
+    StreamSocket(const StreamSocket&) = delete;
+    StreamSocket& operator=(const StreamSocket&) = delete;
+
+    bool listen(uint16_t port);
+    bool accept(StreamSocket& out_client);                  // 연결이 올 때까지 대기
+    bool connect(const std::string& host, uint16_t port);
+    std::string getPeerName() const;
+
+    bool sendMessage(StreamMessage type, uint32_t seq, const void* payload, size_t size);
+    bool sendMessage(StreamMessage type, uint32_t seq, const void* head, size_t head_size, const void* payload, size_t size);
+    bool recvMessage(StreamHeader& out_header, std::vector<uint8_t>& out_payload);    // STREAM_MAX_MESSAGE_BYTES 초과 / 잘못된 magic이면 false
+
+    void shutdown();        // 다른 스레드의 recv 대기를 깨움
+    void close();
+    bool isOpen() const;
+
+private:
+    bool sendAll(const void* data, size_t size);
+    bool recvAll(void* data, size_t size);
+    void setupOptions();
+
+    int fd = -1;
+};
@@ -0,0 +1,89 @@
+#include "timeline.h"
+
+#include <limits>
+
+
+void Timeline::build(const std::vector<LidarBinary>& lidar_list, const std::vector<ObjBinary>& obj_list,
+                     std::vector<UnifiedData>& out_timeline) {
+    out_timeline.clear();
+    out_timeline.reserve(lidar_list.size() + obj_list.size());
+    append(lidar_list, obj_list, 0, 0, out_timeline);
+}
+
+void Timeline::append(const std::vector<LidarBinary>& lidar_list, const std::vector<ObjBinary>& obj_list,
+                      size_t lidar_begin, size_t obj_begin, std::vector<UnifiedData>& out_timeline) {
+    size_t lidar_idx = lidar_begin;
+    size_t obj_idx = obj_begin;
+
+    // 비정상 time 값 원인: 타임라인 생성시 벡터 인덱스 초과 -> 라이다와 객체인식 데이터가 범위 내 정상 시간인지 확인
+    // 범위 밖 프레임은 그 프레임만 건너뜀 (구간 단위로 나눠 붙여도 결과가 같도록)
+    while(lidar_idx < lidar_list.size() || obj_idx < obj_list.size()) {
+        if(obj_idx < obj_list.size() && (obj_list[obj_idx].time < MIN_VALID_TIME || obj_list[obj_idx].time > MAX_VALID_TIME)) {
+            ++obj_idx;
+            continue;
+        }
+        if(lidar_idx < lidar_list.size() && (lidar_list[lidar_idx].time < MIN_VALID_TIME || lidar_list[lidar_idx].time > MAX_VALID_TIME)) {
+            ++lidar_idx;
+            continue;
+        }
+
+        if(lidar_idx >= lidar_list.size()) {
+            out_timeline.push_back({DataType::OBJECT, obj_idx++});
+        } else if(obj_idx >= obj_list.size()) {
+            out_timeline.push_back({DataType::LIDAR, lidar_idx++});
+        } else if(obj_list[obj_idx].time <= lidar_list[lidar_idx].time) {
+            out_timeline.push_back({DataType::OBJECT, obj_idx++});
+        } else {
+            out_timeline.push_back({DataType::LIDAR, lidar_idx++});
+        }
+    }
+}
+
+
+void Timeline::buildObjToLidarMapping(const std::vector<ObjBinary>& obj_list, const std::vector<LidarBinary>& lidar_list,
+                                      std::vector<int>& out_mapping) {
+    out_mapping.clear();
+    if(lidar_list.empty() || obj_list.empty()) {
+        return;
+    }
+    // 모든 객체 프레임에 대해 가장 가까운 라이다 프레임 인덱스를 매핑
+    BinaryUtils utils;
+    out_mapping.resize(obj_list.size());
+    for(size_t i = 0; i < obj_list.size(); ++i) {
+        out_mapping[i] = utils.findClosestLidarFrame(obj_list[i].time, lidar_list);
+    }
+}
+
+
+void Timeline::extendObjToLidarMapping(const std::vector<ObjBinary>& obj_list, const std::vector<LidarBinary>& lidar_list,
+                                       uint64_t lidar_until, std::vector<int>& out_mapping) {
+    BinaryUtils utils;
+    const bool complete = (lidar_until == std::numeric_limits<uint64_t>::max());
+    for(size_t i = out_mapping.size(); i < obj_list.size(); ++i) {
+        if(!complete && (lidar_until < MAX_TIME_DIFF || obj_list[i].time > lidar_until - MAX_TIME_DIFF)) {
+            break;      // 시간순이므로 뒤 프레임도 아직
+        }
+        out_mapping.push_back(utils.findClosestLidarFrame(obj_list[i].time, lidar_list));
+    }
+}
+
+
+void Timeline::buildReverseIndex(const std::vector<UnifiedData>& timeline, size_t lidar_count, size_t obj_count,
+                                 std::vector<size_t>& out_lidar_to_timeline, std::vector<size_t>& out_obj_to_timeline) {
+    out_lidar_to_timeline.clear();
+    out_obj_to_timeline.clear();
+    appendReverseIndex(timeline, 0, lidar_count, obj_count, out_lidar_to_timeline, out_obj_to_timeline);
+}
+
+void Timeline::appendReverseIndex(const std::vector<UnifiedData>& timeline, size_t timeline_begin, size_t lidar_count, size_t obj_count,
+                                  std::vector<size_t>& out_lidar_to_timeline, std::vector<size_t>& out_obj_to_timeline) {
+    out_lidar_to_timeline.resize(lidar_count, std::numeric_limits<size_t>::max());
+    out_obj_to_timeline.resize(obj_count, std::numeric_limits<size_t>::max());
+    for(size_t i = timeline_begin; i < timeline.size(); ++i) {
+        if(timeline[i].type == DataType::LIDAR) {
+            out_lidar_to_timeline[timeline[i].index] = i;
+        } else {
+            out_obj_to_timeline[timeline[i].index] = i;
+        }
+    }
+}
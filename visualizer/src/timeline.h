@@ -0,0 +1,40 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "binary_utils.h"
+
+
+// 비정상 time 값 필터링
+#define MIN_VALID_TIME      1577836800000ULL    // 2020년 1월 1일
+#define MAX_VALID_TIME      1893456000000ULL    // 2030년 1월 1일
+
+// 라이다 / 객체인식 프레임을 재생 순서로 엮는 타임라인 구성 (뷰어, 벤치마크 공용)
+class Timeline {
+public:
+    // 두 시간순 프레임 목록을 시간순으로 병합, 정상 범위 밖 시간의 프레임은 제외
+    static void build(const std::vector<LidarBinary>& lidar_list, const std::vector<ObjBinary>& obj_list,
+                      std::vector<UnifiedData>& out_timeline);
+
+    // 점진 로드 : lidar_begin / obj_begin부터 새로 붙은 프레임을 out_timeline 뒤에 병합
+    // 새 프레임이 모두 기존 프레임보다 늦으면 (구간 단위로 붙이면) 녹화 전체로 build한 결과와 같음
+    static void append(const std::vector<LidarBinary>& lidar_list, const std::vector<ObjBinary>& obj_list,
+                       size_t lidar_begin, size_t obj_begin, std::vector<UnifiedData>& out_timeline);
+
+    // 이진탐색 방식 - 객체 프레임마다 가장 가까운 라이다 프레임 인덱스 (MAX_TIME_DIFF 밖이면 -1)
+    static void buildObjToLidarMapping(const std::vector<ObjBinary>& obj_list, const std::vector<LidarBinary>& lidar_list,
+                                       std::vector<int>& out_mapping);
+    // 점진 로드 : lidar_until 시간까지의 라이다 프레임이 모두 들어온 상태에서 답이 정해진 객체 프레임만 out_mapping 뒤에 추가
+    // (객체 시간 + MAX_TIME_DIFF <= lidar_until), 로드가 끝나면 lidar_until = UINT64_MAX
+    static void extendObjToLidarMapping(const std::vector<ObjBinary>& obj_list, const std::vector<LidarBinary>& lidar_list,
+                                        uint64_t lidar_until, std::vector<int>& out_mapping);
+
+    // 프레임 인덱스 -> 타임라인 인덱스, 타임라인에서 빠진 프레임은 SIZE_MAX
+    static void buildReverseIndex(const std::vector<UnifiedData>& timeline, size_t lidar_count, size_t obj_count,
+                                  std::vector<size_t>& out_lidar_to_timeline, std::vector<size_t>& out_obj_to_timeline);
+    // 점진 로드 : timeline_begin부터 새로 붙은 항목만 반영 (배열은 프레임 수만큼 늘림)
+    static void appendReverseIndex(const std::vector<UnifiedData>& timeline, size_t timeline_begin, size_t lidar_count, size_t obj_count,
+                                   std::vector<size_t>& out_lidar_to_timeline, std::vector<size_t>& out_obj_to_timeline);
+};
@@ -0,0 +1,377 @@
+#include "timeline_stats.h"
+#include "parallel_utils.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <iostream>
+#include <cstdio>
+
+#define TIMELINE_ENTRY_GRAIN    256     // 스레드가 한 번에 가져가는 항목 수
+
+
+// 스트립 위치 : 좌하단, 밀도 지도 영역 왼쪽까지
+static const float STRIP_X0 = TIMELINE_STRIP_MARGIN;
+static const float STRIP_Y0 = TIMELINE_STRIP_MARGIN;
+static const float STRIP_WIDTH = WINDOW_WIDTH - DENSITY_MAP_VIEW_SIZE - DENSITY_MAP_MARGIN - 2 * TIMELINE_STRIP_MARGIN;
+static const float STRIP_ROW = TIMELINE_STRIP_HEIGHT / static_cast<float>(STRIP_CHANNEL_COUNT);
+
+
+TimelineStats::TimelineStats()
+    : timeline(nullptr), lidar_list(nullptr), obj_list(nullptr), channel_max{0.0f}, ready(false), cancel(false),
+      entry_count(0), view_begin(0), view_end(0), playhead(0), load_fraction(-1.0f), load_entries(0) {}
+
+TimelineStats::~TimelineStats() {
+    stop();
+}
+
+void TimelineStats::stop() {
+    cancel = true;      // 남은 항목은 버림 (ready는 false로 남음)
+    if(build_thread.joinable()) {
+        build_thread.join();
+    }
+}
+
+void TimelineStats::startBuild(const std::vector<UnifiedData>& _timeline, const std::vector<LidarBinary>& lidar,
+                               const std::vector<ObjBinary>& obj) {
+    if(build_thread.joinable()) {
+        build_thread.join();
+    }
+    timeline = &_timeline;
+    lidar_list = &lidar;
+    obj_list = &obj;
+    ready = false;
+    cancel = false;
+    build_thread = std::thread(&TimelineStats::build, this);
+}
+
+bool TimelineStats::isReady() const {
+    return ready.load();
+}
+
+
+void TimelineStats::build() {
+    MyTimer timer;
+    const auto& entries = *timeline;
+    const size_t n = entries.size();
+
+    point_count.assign(n, 0);
+    det_count.assign(n, 0);
+    min_distance.assign(n, std::numeric_limits<float>::quiet_NaN());
+    time_gap.assign(n, 0);
+    class_offset.assign(n + 1, 0);
+
+    // pass 1 : 항목별 점 수 / 검출 수 / 최단 거리 / 클래스 종류 수
+    parallelForBackground(n, TIMELINE_ENTRY_GRAIN, [&](size_t begin, size_t end, size_t) {
+        std::vector<int> ids;
+        for(size_t i = begin; i < end && !cancel; ++i) {
+            if(entries[i].type == DataType::LIDAR) {
+                point_count[i] = (*lidar_list)[entries[i].index].num;     // --compact면 lidar_data는 비어 있음
+                continue;
+            }
+            const auto& objs = (*obj_list)[entries[i].index].obj_data;
+            ids.clear();
+            float nearest = std::numeric_limits<float>::max();
+            for(const auto& o : objs) {
+                if(o.obj_id == -1) continue;
+                ids.push_back(o.obj_id);
+                nearest = std::min(nearest, o.distance);
+            }
+            det_count[i] = static_cast<uint16_t>(std::min<size_t>(ids.size(), UINT16_MAX));
+            if(!ids.empty()) {
+                min_distance[i] = nearest;
+            }
+            std::sort(ids.begin(), ids.end());
+            class_offset[i + 1] = static_cast<uint32_t>(std::unique(ids.begin(), ids.end()) - ids.begin());
+        }
+    });
+    if(cancel) {
+        return;
+    }
+
+    for(size_t i = 0; i < n; ++i) {
+        class_offset[i + 1] += class_offset[i];
+    }
+    class_id.resize(class_offset.back());
+    class_count.resize(class_offset.back());
+
+    // pass 2 : 클래스별 검출 수 채우기
+    parallelForBackground(n, TIMELINE_ENTRY_GRAIN, [&](size_t begin, size_t end, size_t) {
+        std::vector<int> ids;
+        for(size_t i = begin; i < end && !cancel; ++i) {
+            if(entries[i].type != DataType::OBJECT) continue;
+            ids.clear();
+            for(const auto& o : (*obj_list)[entries[i].index].obj_data) {
+                if(o.obj_id != -1) ids.push_back(o.obj_id);
+            }
+            std::sort(ids.begin(), ids.end());
+            uint32_t out = class_offset[i];
+            for(size_t k = 0; k < ids.size();) {
+                size_t run = k;
+                while(run < ids.size() && ids[run] == ids[k]) ++run;
+                class_id[out] = static_cast<int16_t>(ids[k]);
+                class_count[out] = static_cast<uint16_t>(run - k);
+                ++out;
+                k = run;
+            }
+        }
+    });
+    if(cancel) {
+        return;
+    }
+
+    // 같은 센서 직전 프레임과의 시간 간격 (순차)
+    uint64_t last_lidar = 0, last_obj = 0;
+    for(size_t i = 0; i < n; ++i) {
+        bool is_lidar = (entries[i].type == DataType::LIDAR);
+        uint64_t t = is_lidar ? (*lidar_list)[entries[i].index].time : (*obj_list)[entries[i].index].time;
+        uint64_t& last = is_lidar ? last_lidar : last_obj;
+        time_gap[i] = (last != 0 && t > last) ? static_cast<uint32_t>(std::min<uint64_t>(t - last, UINT32_MAX)) : 0;
+        last = t;
+    }
+
+    // 피라미드 (값 없는 항목은 NaN)
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    std::vector<float> base(n);
+    for(size_t i = 0; i < n; ++i) base[i] = (entries[i].type == DataType::LIDAR) ? static_cast<float>(point_count[i]) : nan;
+    buildPyramid(STRIP_POINTS, base);
+    for(size_t i = 0; i < n; ++i) base[i] = (entries[i].type == DataType::OBJECT) ? static_cast<float>(det_count[i]) : nan;
+    buildPyramid(STRIP_DETECTIONS, base);
+    buildPyramid(STRIP_MIN_DISTANCE, min_distance);
+    for(size_t i = 0; i < n; ++i) base[i] = static_cast<float>(time_gap[i]);
+    buildPyramid(STRIP_TIME_GAP, base);
+
+    entry_count = n;
+    view_begin = 0;
+    view_end = n;
+
+    timer.end();
+    std::cout << "Timeline stats: " << n << " entries ("
+              << std::chrono::duration<double, std::milli>(timer.end_time - timer.start_time).count() << " ms)" << std::endl;
+    ready = true;
+}
+
+void TimelineStats::buildPyramid(int channel, const std::vector<float>& base) {
+    auto& mins = pyr_min[channel];
+    auto& maxs = pyr_max[channel];
+    mins.clear();
+    maxs.clear();
+
+    const float inf = std::numeric_limits<float>::infinity();
+    mins.emplace_back(base.size());
+    maxs.emplace_back(base.size());
+    for(size_t i = 0; i < base.size(); ++i) {
+        bool has = !std::isnan(base[i]);
+        mins[0][i] = has ? base[i] : inf;
+        maxs[0][i] = has ? base[i] : -inf;
+    }
+
+    while(mins.back().size() > 1) {
+        const size_t prev = mins.size() - 1;
+        const size_t size = (mins[prev].size() + 1) / 2;
+        mins.emplace_back(size);
+        maxs.emplace_back(size);
+        for(size_t i = 0; i < size; ++i) {
+            size_t a = i * 2, b = std::min(a + 1, mins[prev].size() - 1);
+            mins[prev + 1][i] = std::min(mins[prev][a], mins[prev][b]);
+            maxs[prev + 1][i] = std::max(maxs[prev][a], maxs[prev][b]);
+        }
+    }
+    channel_max[channel] = std::max(maxs.back().empty() ? 0.0f : maxs.back()[0], 1e-6f);
+}
+
+// [begin, end) 범위를 2^L <= 범위 길이인 level의 정렬된 블록(최대 3개)으로 덮음 -> 블록 경계만큼 넓게 잡히는 근사
+bool TimelineStats::query(int channel, size_t begin, size_t end, float& out_min, float& out_max) const {
+    size_t span = std::max<size_t>(1, end - begin);
+    size_t level = 0;
+    while((static_cast<size_t>(2) << level) <= span && level + 1 < pyr_min[channel].size()) ++level;
+
+    const auto& mins = pyr_min[channel][level];
+    const auto& maxs = pyr_max[channel][level];
+    out_min = std::numeric_limits<float>::infinity();
+    out_max = -std::numeric_limits<float>::infinity();
+    size_t last = std::min((end - 1) >> level, mins.size() - 1);
+    for(size_t b = begin >> level; b <= last; ++b) {
+        out_min = std::min(out_min, mins[b]);
+        out_max = std::max(out_max, maxs[b]);
+    }
+    return out_min <= out_max;
+}
+
+
+bool TimelineStats::screenToEntry(double mouse_x, double mouse_y, size_t& out_entry) const {
+    if(!ready || entry_count == 0) {
+        return false;
+    }
+    double px = mouse_x - STRIP_X0;
+    double py = (WINDOW_HEIGHT - mouse_y) - STRIP_Y0;     // 마우스는 좌상단 기준
+    if(px < 0.0 || py < 0.0 || px >= STRIP_WIDTH || py >= TIMELINE_STRIP_HEIGHT) {
+        return false;
+    }
+    out_entry = view_begin + static_cast<size_t>(px / STRIP_WIDTH * (view_end - view_begin));
+    out_entry = std::min(out_entry, entry_count - 1);
+    return true;
+}
+
+bool TimelineStats::zoom(double mouse_x, double mouse_y, double amount) {
+    size_t anchor;
+    if(!screenToEntry(mouse_x, mouse_y, anchor)) {
+        return false;
+    }
+    const double span = static_cast<double>(view_end - view_begin);
+    double new_span = span * std::pow(TIMELINE_STRIP_ZOOM_STEP, amount);
+    new_span = std::max<double>(std::min<double>(new_span, entry_count), std::min<size_t>(TIMELINE_STRIP_MIN_SPAN, entry_count));
+
+    // 커서 아래 항목이 같은 화면 위치에 남도록
+    double ratio = (anchor - view_begin) / span;
+    double begin = anchor - ratio * new_span;
+    begin = std::max(0.0, std::min(begin, entry_count - new_span));
+    view_begin = static_cast<size_t>(begin);
+    view_end = std::min(entry_count, view_begin + static_cast<size_t>(new_span));
+    return true;
+}
+
+void TimelineStats::setPlayhead(size_t entry) {
+    playhead = entry;
+    if(!ready || (entry >= view_begin && entry < view_end)) {
+        return;
+    }
+    size_t span = view_end - view_begin;
+    size_t begin = (entry > span / 2) ? entry - span / 2 : 0;
+    view_begin = std::min(begin, entry_count - span);
+    view_end = view_begin + span;
+}
+
+void TimelineStats::setLoadProgress(float fraction, size_t entries) {
+    load_fraction = fraction;
+    load_entries = entries;
+}
+
+void TimelineStats::printEntry(size_t entry) const {
+    if(!ready || entry >= entry_count) {
+        return;
+    }
+    std::cout << "\n[Strip] timeline_idx = " << entry;
+    if((*timeline)[entry].type == DataType::LIDAR) {
+        std::cout << " (lidar), points = " << point_count[entry];
+    } else {
+        std::cout << " (object), detections = " << det_count[entry];
+        if(!std::isnan(min_distance[entry])) std::cout << ", min distance = " << min_distance[entry];
+    }
+    std::cout << ", gap = " << time_gap[entry] << " ms" << std::endl;
+
+    for(uint32_t k = class_offset[entry]; k < class_offset[entry + 1]; ++k) {
+        auto it = objId_to_label.find(class_id[k]);
+        std::cout << "  " << ((it != objId_to_label.end()) ? it->second : "unknown") << " x " << class_count[k] << std::endl;
+    }
+}
+
+
+void TimelineStats::render() const {
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    gluOrtho2D(0, WINDOW_WIDTH, 0, WINDOW_HEIGHT);
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+    glDisable(GL_DEPTH_TEST);
+
+    // 배경
+    glColor3f(0.08f, 0.08f, 0.08f);
+    glBegin(GL_QUADS);
+    glVertex2f(STRIP_X0, STRIP_Y0);                             glVertex2f(STRIP_X0 + STRIP_WIDTH, STRIP_Y0);
+    glVertex2f(STRIP_X0 + STRIP_WIDTH, STRIP_Y0 + TIMELINE_STRIP_HEIGHT); glVertex2f(STRIP_X0, STRIP_Y0 + TIMELINE_STRIP_HEIGHT);
+    glEnd();
+
+    if(ready && entry_count > 0) {
+        // 위에서부터 points, detections, min distance, time gap
+        static const float channel_color[STRIP_CHANNEL_COUNT][3] = {
+            {0.8f, 0.8f, 0.8f}, {1.0f, 0.65f, 0.0f}, {0.0f, 1.0f, 1.0f}, {1.0f, 0.0f, 0.0f}
+        };
+        static const char* channel_name[STRIP_CHANNEL_COUNT] = {"pts", "det", "near", "gap"};
+
+        const int pixels = static_cast<int>(STRIP_WIDTH);
+        const double span = static_cast<double>(view_end - view_begin);
+
+        glBegin(GL_LINES);
+        for(int ch = 0; ch < STRIP_CHANNEL_COUNT; ++ch) {
+            const float row_y = STRIP_Y0 + TIMELINE_STRIP_HEIGHT - (ch + 1) * STRIP_ROW;
+            const float row_h = STRIP_ROW - 2.0f;
+            glColor3fv(channel_color[ch]);
+            for(int px = 0; px < pixels; ++px) {
+                size_t a = view_begin + static_cast<size_t>(px * span / pixels);
+                size_t b = view_begin + static_cast<size_t>((px + 1) * span / pixels);
+                if(b <= a) b = a + 1;
+                float lo, hi;
+                if(!query(ch, a, b, lo, hi)) continue;
+
+                float n_lo = lo / channel_max[ch];
+                float n_hi = hi / channel_max[ch];
+                if(ch == STRIP_MIN_DISTANCE) {
+                    float t = 1.0f - n_hi;      // 가까울수록 높게
+                    n_hi = 1.0f - n_lo;
+                    n_lo = t;
+                }
+                float y_lo = row_y + 1.0f + n_lo * row_h;
+                float y_hi = std::max(row_y + 1.0f + n_hi * row_h, y_lo + 1.0f);
+                glVertex2f(STRIP_X0 + px + 0.5f, y_lo);
+                glVertex2f(STRIP_X0 + px + 0.5f, y_hi);
+            }
+        }
+
+        // 재생 위치
+        if(playhead >= view_begin && playhead < view_end) {
+            float x = STRIP_X0 + static_cast<float>((playhead - view_begin) / span * STRIP_WIDTH);
+            glColor3f(1.0f, 1.0f, 1.0f);
+            glVertex2f(x, STRIP_Y0);
+            glVertex2f(x, STRIP_Y0 + TIMELINE_STRIP_HEIGHT);
+        }
+        glEnd();
+
+        glColor3f(0.7f, 0.7f, 0.7f);
+        for(int ch = 0; ch < STRIP_CHANNEL_COUNT; ++ch) {
+            glRasterPos2f(STRIP_X0 + 4.0f, STRIP_Y0 + TIMELINE_STRIP_HEIGHT - (ch + 1) * STRIP_ROW + 4.0f);
+            for(const char* c = channel_name[ch]; *c; ++c) {
+                glutBitmapCharacter(GLUT_BITMAP_HELVETICA_12, *c);
+            }
+        }
+    } else if(load_fraction >= 0.0f) {
+        // 로드 진행 막대 (읽은 프레임 / 헤더 프레임)
+        const float w = STRIP_WIDTH * std::min(load_fraction, 1.0f);
+        glColor3f(0.15f, 0.35f, 0.6f);
+        glBegin(GL_QUADS);
+        glVertex2f(STRIP_X0, STRIP_Y0);         glVertex2f(STRIP_X0 + w, STRIP_Y0);
+        glVertex2f(STRIP_X0 + w, STRIP_Y0 + TIMELINE_STRIP_HEIGHT); glVertex2f(STRIP_X0, STRIP_Y0 + TIMELINE_STRIP_HEIGHT);
+        glEnd();
+
+        char text[96];
+        snprintf(text, sizeof(text), "loading recording... %d %% (%zu entries playable)",
+                 static_cast<int>(load_fraction * 100.0f), load_entries);
+        glColor3f(1.0f, 1.0f, 1.0f);
+        glRasterPos2f(STRIP_X0 + 8.0f, STRIP_Y0 + TIMELINE_STRIP_HEIGHT * 0.5f);
+        for(const char* c = text; *c; ++c) {
+            glutBitmapCharacter(GLUT_BITMAP_HELVETICA_12, *c);
+        }
+    } else {
+        const char* text = "building timeline stats...";
+        glColor3f(1.0f, 1.0f, 1.0f);
+        glRasterPos2f(STRIP_X0 + 8.0f, STRIP_Y0 + TIMELINE_STRIP_HEIGHT * 0.5f);
+        for(const char* c = text; *c; ++c) {
+            glutBitmapCharacter(GLUT_BITMAP_HELVETICA_12, *c);
+        }
+    }
+
+    // 테두리
+    glColor3f(0.6f, 0.6f, 0.6f);
+    glBegin(GL_LINE_LOOP);
+    glVertex2f(STRIP_X0, STRIP_Y0);                             glVertex2f(STRIP_X0 + STRIP_WIDTH, STRIP_Y0);
+    glVertex2f(STRIP_X0 + STRIP_WIDTH, STRIP_Y0 + TIMELINE_STRIP_HEIGHT); glVertex2f(STRIP_X0, STRIP_Y0 + TIMELINE_STRIP_HEIGHT);
+    glEnd();
+
+    glEnable(GL_DEPTH_TEST);
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include <GL/glew.h>
+#include <GL/glut.h>
+
+#include "configs.h"
+#include "binary_utils.h"
+
+
+enum StripChannel { STRIP_POINTS, STRIP_DETECTIONS, STRIP_MIN_DISTANCE, STRIP_TIME_GAP, STRIP_CHANNEL_COUNT };
+
+// 타임라인 항목별 통계 (점 수, 클래스별 검출 수, 최단 객체 거리, 같은 센서 직전 프레임과의 시간 간격)
+// 백그라운드 스레드에서 계산, 채널마다 min/max 피라미드를 만들어 확대 배율과 무관하게 픽셀당 상수 시간으로 그림
+class TimelineStats {
+public:
+    TimelineStats();
+    ~TimelineStats();
+
+    void startBuild(const std::vector<UnifiedData>& timeline, const std::vector<LidarBinary>& lidar_list,
+                    const std::vector<ObjBinary>& obj_list);
+    bool isReady() const;
+    // 계산 중단 + 스레드 join - 타임라인 / 프레임 배열(main 지역 변수)이 소멸하기 전에 호출
+    void stop();
+
+    // 메인 창 마우스 좌표(좌상단 기준) -> 타임라인 인덱스, 스트립 밖이면 false
+    bool screenToEntry(double mouse_x, double mouse_y, size_t& out_entry) const;
+    // 스트립 위 스크롤이면 커서 위치 기준 확대/축소 후 true
+    bool zoom(double mouse_x, double mouse_y, double amount);
+    // 재생 위치 표시, 보기 범위 밖이면 범위를 옮김
+    void setPlayhead(size_t entry);
+
+    void printEntry(size_t entry) const;
+
+    // 점진 로드 중 스트립 자리에 진행 막대 (fraction 0 ~ 1, 음수면 숨김), entries : 지금까지 재생 가능한 타임라인 항목 수
+    void setLoadProgress(float fraction, size_t entries);
+
+    // 3D 화면 하단 오버레이
+    void render() const;
+
+private:
+    void build();
+    void buildPyramid(int channel, const std::vector<float>& base);
+    bool query(int channel, size_t begin, size_t end, float& out_min, float& out_max) const;
+
+    const std::vector<UnifiedData>* timeline;
+    const std::vector<LidarBinary>* lidar_list;
+    const std::vector<ObjBinary>* obj_list;
+
+    // 항목별 원본 (compact)
+    std::vector<uint32_t> point_count;      // 라이다 항목만
+    std::vector<uint16_t> det_count;        // 객체 항목만
+    std::vector<float> min_distance;        // 객체 항목만, 검출 없으면 NaN
+    std::vector<uint32_t> time_gap;         // ms
+    std::vector<uint32_t> class_offset;     // 클래스별 검출 수 (CSR)
+    std::vector<int16_t> class_id;
+    std::vector<uint16_t> class_count;
+
+    // 채널별 min/max 피라미드 (level 0 = 항목, level k = 2^k 항목 묶음), 값 없는 항목은 min=+inf, max=-inf
+    std::vector<std::vector<float>> pyr_min[STRIP_CHANNEL_COUNT];
+    std::vector<std::vector<float>> pyr_max[STRIP_CHANNEL_COUNT];
+    float channel_max[STRIP_CHANNEL_COUNT];
+
+    std::thread build_thread;
+    std::atomic<bool> ready;
+    std::atomic<bool> cancel;
+    size_t entry_count;
+    size_t view_begin, view_end;            // 보기 범위 [begin, end)
+    size_t playhead;
+    float load_fraction;
+    size_t load_entries;
+};
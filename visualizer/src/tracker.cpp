@@ -0,0 +1,302 @@
+#include "tracker.h"
+#include "configs.h"
+#include "cluster_stats.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+
+static inline int64_t cellKey(int cx, int cy) {
+    return (static_cast<int64_t>(cx) << 32) ^ static_cast<uint32_t>(cy);
+}
+
+static inline int cellOf(float v) {
+    return static_cast<int>(std::floor(v / TRACK_GATE_DIST));
+}
+
+// 정방 비용 행렬 최소 비용 할당 (Hungarian, 포텐셜 방식 O(n^3)) - row_to_col[r] = 할당된 열
+static void hungarian(const std::vector<float>& cost, int n, std::vector<int>& row_to_col) {
+    const double inf = std::numeric_limits<double>::max();
+    std::vector<double> u(n + 1, 0.0), v(n + 1, 0.0);
+    std::vector<int> p(n + 1, 0), way(n + 1, 0);
+
+    for(int i = 1; i <= n; ++i) {
+        p[0] = i;
+        int j0 = 0;
+        std::vector<double> minv(n + 1, inf);
+        std::vector<char> used(n + 1, 0);
+        do {
+            used[j0] = 1;
+            int i0 = p[j0], j1 = 0;
+            double delta = inf;
+            for(int j = 1; j <= n; ++j) {
+                if(used[j]) continue;
+                double cur = cost[(i0 - 1) * n + (j - 1)] - u[i0] - v[j];
+                if(cur < minv[j]) {
+                    minv[j] = cur;
+                    way[j] = j0;
+                }
+                if(minv[j] < delta) {
+                    delta = minv[j];
+                    j1 = j;
+                }
+            }
+            for(int j = 0; j <= n; ++j) {
+                if(used[j]) {
+                    u[p[j]] += delta;
+                    v[j] -= delta;
+                } else {
+                    minv[j] -= delta;
+                }
+            }
+            j0 = j1;
+        } while(p[j0] != 0);
+        do {
+            int j1 = way[j0];
+            p[j0] = p[j1];
+            j0 = j1;
+        } while(j0);
+    }
+
+    row_to_col.assign(n, -1);
+    for(int j = 1; j <= n; ++j) {
+        if(p[j] != 0) row_to_col[p[j] - 1] = j - 1;
+    }
+}
+
+
+int Tracker::getTrackId(size_t frame, size_t det) const {
+    if(frame + 1 >= frame_offset.size()) {
+        return -1;
+    }
+    size_t idx = frame_offset[frame] + det;
+    return (idx < frame_offset[frame + 1]) ? det_track[idx] : -1;
+}
+
+const Track& Tracker::getTrack(int track_id) const {
+    return tracks[track_id];
+}
+
+size_t Tracker::getTrackCount() const {
+    return tracks.size();
+}
+
+size_t Tracker::findFrame(const ObjBinary& frame) const {
+    if(frames_begin == nullptr || &frame < frames_begin || &frame >= frames_begin + frame_count) {
+        return std::numeric_limits<size_t>::max();
+    }
+    return static_cast<size_t>(&frame - frames_begin);
+}
+
+double Tracker::getElapsedMs() const {
+    return elapsed_ms;
+}
+
+void Tracker::trackColor(int track_id, glm::vec3& out_color) {
+    ClusterStats::clusterColor(track_id, out_color);      // 같은 골든 비율 팔레트
+}
+
+int Tracker::findRoot(int node) {
+    while(parent[node] != node) {
+        parent[node] = parent[parent[node]];
+        node = parent[node];
+    }
+    return node;
+}
+
+
+// 예측 위치를 셀 key로 정렬해 두고, 검출마다 주변 3x3 셀만 이분 탐색 -> 같은 클래스 + gate 거리 이내만 후보
+void Tracker::gate(const std::vector<glm::vec3>& centers, const std::vector<int>& classes) {
+    cell_tracks.clear();
+    for(size_t t = 0; t < active.size(); ++t) {
+        cell_tracks.push_back({cellKey(cellOf(active[t].pred.x), cellOf(active[t].pred.y)), static_cast<int>(t)});
+    }
+    std::sort(cell_tracks.begin(), cell_tracks.end());
+
+    edges.clear();
+    for(size_t d = 0; d < centers.size(); ++d) {
+        if(classes[d] == -1) continue;
+        int cx = cellOf(centers[d].x);
+        int cy = cellOf(centers[d].y);
+        for(int dy = -1; dy <= 1; ++dy) {
+            for(int dx = -1; dx <= 1; ++dx) {
+                int64_t key = cellKey(cx + dx, cy + dy);
+                auto it = std::lower_bound(cell_tracks.begin(), cell_tracks.end(), std::make_pair(key, std::numeric_limits<int>::min()));
+                for(; it != cell_tracks.end() && it->first == key; ++it) {
+                    const ActiveTrack& at = active[it->second];
+                    if(at.class_id != classes[d]) continue;
+                    float dist = glm::length(centers[d] - at.pred);
+                    if(dist < TRACK_GATE_DIST) {
+                        edges.push_back({static_cast<int>(d), it->second, dist});
+                    }
+                }
+            }
+        }
+    }
+}
+
+// 후보 그래프의 연결 성분마다 독립적으로 할당 -> 혼잡한 장면도 작은 문제 여러 개로 나뉨
+void Tracker::assign(size_t det_count) {
+    const int tracks_n = static_cast<int>(active.size());
+    det_match.assign(det_count, -1);
+    track_match.assign(tracks_n, -1);
+    if(edges.empty()) {
+        return;
+    }
+
+    parent.resize(det_count + tracks_n);
+    for(size_t i = 0; i < parent.size(); ++i) parent[i] = static_cast<int>(i);
+    for(const Edge& e : edges) {
+        int a = findRoot(e.det);
+        int b = findRoot(static_cast<int>(det_count) + e.track);
+        if(a != b) parent[a] = b;
+    }
+
+    // 성분별로 모으고 성분 내에서는 비용 오름차순
+    std::vector<int> edge_root(edges.size());
+    for(size_t i = 0; i < edges.size(); ++i) edge_root[i] = findRoot(edges[i].det);
+    std::vector<size_t> order(edges.size());
+    for(size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        if(edge_root[a] != edge_root[b]) return edge_root[a] < edge_root[b];
+        return edges[a].cost < edges[b].cost;
+    });
+
+    std::vector<int> det_local(det_count, -1), track_local(tracks_n, -1);
+    std::vector<int> comp_dets, comp_tracks, row_to_col;
+    std::vector<float> cost;
+
+    for(size_t a = 0; a < order.size();) {
+        size_t b = a;
+        while(b < order.size() && edge_root[order[b]] == edge_root[order[a]]) ++b;
+
+        comp_dets.clear();
+        comp_tracks.clear();
+        for(size_t k = a; k < b; ++k) {
+            const Edge& e = edges[order[k]];
+            if(det_local[e.det] < 0)     { det_local[e.det] = static_cast<int>(comp_dets.size());       comp_dets.push_back(e.det); }
+            if(track_local[e.track] < 0) { track_local[e.track] = static_cast<int>(comp_tracks.size()); comp_tracks.push_back(e.track); }
+        }
+
+        int n = static_cast<int>(std::max(comp_dets.size(), comp_tracks.size()));
+        if(n <= TRACK_HUNGARIAN_MAX) {
+            // 간선 없는 칸은 gate 거리 = 미할당과 같은 비용
+            cost.assign(static_cast<size_t>(n) * n, TRACK_GATE_DIST);
+            for(size_t k = a; k < b; ++k) {
+                const Edge& e = edges[order[k]];
+                cost[det_local[e.det] * n + track_local[e.track]] = e.cost;
+            }
+            hungarian(cost, n, row_to_col);
+            for(size_t r = 0; r < comp_dets.size(); ++r) {
+                int c = row_to_col[r];
+                if(c < 0 || c >= static_cast<int>(comp_tracks.size()) || cost[r * n + c] >= TRACK_GATE_DIST) continue;
+                det_match[comp_dets[r]] = comp_tracks[c];
+                track_match[comp_tracks[c]] = comp_dets[r];
+            }
+        } else {
+            // 매우 큰 성분 : 비용 순 greedy
+            for(size_t k = a; k < b; ++k) {
+                const Edge& e = edges[order[k]];
+                if(det_match[e.det] >= 0 || track_match[e.track] >= 0) continue;
+                det_match[e.det] = e.track;
+                track_match[e.track] = e.det;
+            }
+        }
+
+        for(int d : comp_dets) det_local[d] = -1;
+        for(int t : comp_tracks) track_local[t] = -1;
+        a = b;
+    }
+}
+
+
+void Tracker::build(const std::vector<ObjBinary>& obj_list) {
+    MyTimer timer;
+    frames_begin = obj_list.data();
+    frame_count = obj_list.size();
+    tracks.clear();
+    active.clear();
+
+    frame_offset.assign(obj_list.size() + 1, 0);
+    for(size_t f = 0; f < obj_list.size(); ++f) {
+        frame_offset[f + 1] = frame_offset[f] + obj_list[f].obj_data.size();
+    }
+    det_track.assign(frame_offset.back(), -1);
+
+    std::vector<glm::vec3> centers;
+    std::vector<int> classes;
+
+    for(size_t f = 0; f < obj_list.size(); ++f) {
+        const ObjBinary& frame = obj_list[f];
+        const size_t det_count = frame.obj_data.size();
+
+        // 오래 안 보인 track 종료, 나머지는 현재 시각으로 등속 예측
+        size_t keep = 0;
+        for(size_t t = 0; t < active.size(); ++t) {
+            ActiveTrack& at = active[t];
+            if(frame.time < at.last_time) {
+                at.last_time = frame.time;      // 시간 역행 프레임 : 예측 없이 마지막 위치 사용
+            }
+            uint64_t gap = frame.time - at.last_time;
+            if(gap > TRACK_MAX_GAP_MS || at.misses > TRACK_MAX_MISSES) {
+                continue;
+            }
+            float dt = gap / 1000.0f;
+            at.pred = at.has_vel ? at.pos + at.vel * dt : at.pos;
+            active[keep++] = at;
+        }
+        active.resize(keep);
+
+        centers.resize(det_count);
+        classes.resize(det_count);
+        for(size_t d = 0; d < det_count; ++d) {
+            const ObjData& o = frame.obj_data[d];
+            centers[d] = glm::vec3((o.min_x + o.max_x) * 0.5f, (o.min_y + o.max_y) * 0.5f, (o.min_z + o.max_z) * 0.5f);
+            classes[d] = o.obj_id;
+        }
+
+        gate(centers, classes);
+        assign(det_count);
+
+        for(size_t t = 0; t < active.size(); ++t) {
+            if(track_match[t] < 0) ++active[t].misses;
+        }
+
+        for(size_t d = 0; d < det_count; ++d) {
+            if(classes[d] == -1) continue;
+            int t = det_match[d];
+            int track_id;
+            if(t >= 0) {
+                ActiveTrack& at = active[t];
+                float dt = (frame.time - at.last_time) / 1000.0f;
+                if(dt > 0.0f) {
+                    glm::vec3 vel = (centers[d] - at.pos) / dt;
+                    at.vel = at.has_vel ? TRACK_VELOCITY_ALPHA * vel + (1.0f - TRACK_VELOCITY_ALPHA) * at.vel : vel;
+                    at.has_vel = true;
+                }
+                at.pos = centers[d];
+                at.last_time = frame.time;
+                at.misses = 0;
+                track_id = at.track_id;
+            } else {
+                track_id = static_cast<int>(tracks.size());
+                tracks.push_back({track_id, classes[d], {}});
+                ActiveTrack at;
+                at.track_id = track_id;
+                at.class_id = classes[d];
+                at.pos = at.pred = centers[d];
+                at.vel = glm::vec3(0.0f);
+                at.last_time = frame.time;
+                at.misses = 0;
+                at.has_vel = false;
+                active.push_back(at);
+            }
+            tracks[track_id].points.push_back({f, centers[d]});
+            det_track[frame_offset[f] + d] = track_id;
+        }
+    }
+
+    timer.end();
+    elapsed_ms = std::chrono::duration<double, std::milli>(timer.end_time - timer.start_time).count();
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "binary_utils.h"
+
+
+struct TrackPoint {
+    size_t frame;           // obj_list 인덱스
+    glm::vec3 center;       // 박스 중심
+};
+
+struct Track {
+    int track_id;
+    int class_id;                       // obj_id (COCO class)
+    std::vector<TrackPoint> points;     // 프레임 순
+};
+
+// 객체인식 프레임 간 박스 연결 -> 녹화 전체에 대해 고정된 track id 부여 (로드 시 1회 계산)
+// 등속 예측 + xy 공간 해시 gating으로 후보 쌍만 만들고, 연결 성분마다 Hungarian (큰 성분은 greedy)
+class Tracker {
+public:
+    void build(const std::vector<ObjBinary>& obj_list);
+
+    int getTrackId(size_t frame, size_t det) const;        // -1 : 추적 대상 아님 (obj_id == -1)
+    const Track& getTrack(int track_id) const;
+    size_t getTrackCount() const;
+    size_t findFrame(const ObjBinary& frame) const;         // build에 쓴 obj_list 내 인덱스, 없으면 SIZE_MAX
+    double getElapsedMs() const;
+
+    static void trackColor(int track_id, glm::vec3& out_color);
+
+private:
+    struct ActiveTrack {
+        int track_id;
+        int class_id;
+        glm::vec3 pos;
+        glm::vec3 vel;
+        glm::vec3 pred;
+        uint64_t last_time;
+        int misses;
+        bool has_vel;
+    };
+    struct Edge {
+        int det;
+        int track;          // active 인덱스
+        float cost;
+    };
+
+    void gate(const std::vector<glm::vec3>& centers, const std::vector<int>& classes);
+    void assign(size_t det_count);
+    int findRoot(int node);
+
+    const ObjBinary* frames_begin = nullptr;
+    size_t frame_count = 0;
+
+    std::vector<Track> tracks;
+    std::vector<size_t> frame_offset;       // 프레임별 det_track 시작 위치 (CSR)
+    std::vector<int> det_track;
+
+    // 프레임 처리용 작업 버퍼 (프레임마다 재사용)
+    std::vector<ActiveTrack> active;
+    std::vector<std::pair<int64_t, int>> cell_tracks;      // (셀 key, active 인덱스) 정렬
+    std::vector<Edge> edges;
+    std::vector<int> parent;
+    std::vector<int> det_match, track_match;
+
+    double elapsed_ms = 0.0;
+};
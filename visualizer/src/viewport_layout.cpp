@@ -0,0 +1,200 @@
+#include "viewport_layout.h"
+#include "space.h"
+
+#include <cmath>
+#include <GL/glut.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+
+ViewportLayout::ViewportLayout()
+    : kinds(view_layout_1), count(1), ortho_half_height(1.0f) {
+    setViewCount(VIEW_DEFAULT_COUNT);
+}
+
+void ViewportLayout::setViewCount(size_t n) {
+    if(n >= 4) {
+        kinds = view_layout_4;
+        count = 4;
+    } else if(n >= 2) {
+        kinds = view_layout_2;
+        count = 2;
+    } else {
+        kinds = view_layout_1;
+        count = 1;
+    }
+}
+
+void ViewportLayout::cycle() {
+    setViewCount(count == 1 ? 2 : (count == 2 ? 4 : 1));
+}
+
+size_t ViewportLayout::getViewCount() const {
+    return count;
+}
+
+ViewKind ViewportLayout::getKind(size_t v) const {
+    return kinds[v];
+}
+
+
+void ViewportLayout::update(const glm::vec3& eye, const glm::vec3& target, float radius) {
+    // 궤도 카메라의 수평 방향 (중심 -> 카메라), 바로 위에 있으면 x축
+    glm::vec3 back(eye.x - target.x, eye.y - target.y, 0.0f);
+    back = (glm::length(back) > 1e-6f) ? glm::normalize(back) : glm::vec3(1.0f, 0.0f, 0.0f);
+    const glm::vec3 forward = -back;
+    const glm::vec3 right = glm::cross(forward, glm::vec3(0.0f, 0.0f, 1.0f));
+    const glm::vec3 z_up(0.0f, 0.0f, 1.0f);
+
+    // 중심 거리 radius에서 원근 보기와 같은 크기로 보이도록
+    ortho_half_height = radius * std::tan(glm::radians(FOV_Y) * 0.5f) * VIEW_ORTHO_SCALE;
+
+    for(size_t v = 0; v < count; ++v) {
+        Camera& cam = cameras[v];
+        cam.setTarget(target);
+        switch(kinds[v]) {
+        case VIEW_ORBIT:
+            cam.setPosition(eye);
+            cam.setUp(z_up);
+            break;
+        case VIEW_TOP:
+            cam.setPosition(target + z_up * VIEW_ORTHO_DEPTH);
+            cam.setUp(forward);
+            break;
+        case VIEW_SIDE:
+            cam.setPosition(target + right * VIEW_ORTHO_DEPTH);
+            cam.setUp(z_up);
+            break;
+        case VIEW_FRONT:
+            cam.setPosition(target + back * VIEW_ORTHO_DEPTH);
+            cam.setUp(z_up);
+            break;
+        }
+    }
+}
+
+
+ViewRect ViewportLayout::getRect(size_t v) const {
+    const int half_w = WINDOW_WIDTH / 2;
+    const int half_h = WINDOW_HEIGHT / 2;
+    if(count == 2) {
+        return (v == 0) ? ViewRect{0, 0, half_w, WINDOW_HEIGHT} : ViewRect{half_w, 0, WINDOW_WIDTH - half_w, WINDOW_HEIGHT};
+    }
+    if(count == 4) {
+        const int x = (v % 2 == 0) ? 0 : half_w;
+        const int w = (v % 2 == 0) ? half_w : WINDOW_WIDTH - half_w;
+        const int y = (v < 2) ? half_h : 0;             // 윗줄 먼저
+        const int h = (v < 2) ? WINDOW_HEIGHT - half_h : half_h;
+        return ViewRect{x, y, w, h};
+    }
+    return ViewRect{0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
+}
+
+glm::mat4 ViewportLayout::getViewMatrix(size_t v) const {
+    return cameras[v].getViewMatrix();
+}
+
+glm::mat4 ViewportLayout::getProjection(size_t v) const {
+    const ViewRect rect = getRect(v);
+    const float aspect = static_cast<float>(rect.width) / rect.height;
+    if(kinds[v] == VIEW_ORBIT) {
+        return glm::perspective(glm::radians(FOV_Y), aspect, NEAR_PLANE, FAR_PLANE);
+    }
+    const float half_w = ortho_half_height * aspect;
+    return glm::ortho(-half_w, half_w, -ortho_half_height, ortho_half_height, NEAR_PLANE, 2.0f * VIEW_ORTHO_DEPTH);
+}
+
+void ViewportLayout::apply(size_t v) const {
+    const ViewRect rect = getRect(v);
+    const glm::mat4 projection = getProjection(v);
+    const glm::mat4 view = getViewMatrix(v);
+    glViewport(rect.x, rect.y, rect.width, rect.height);
+    glMatrixMode(GL_PROJECTION);
+    glLoadMatrixf(glm::value_ptr(projection));
+    glMatrixMode(GL_MODELVIEW);
+    glLoadMatrixf(glm::value_ptr(view));
+}
+
+void ViewportLayout::restoreFullWindow() const {
+    const glm::mat4 projection = glm::perspective(glm::radians(FOV_Y), static_cast<float>(WINDOW_WIDTH) / WINDOW_HEIGHT, NEAR_PLANE, FAR_PLANE);
+    const glm::mat4 view = getViewMatrix(0);
+    glViewport(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
+    glMatrixMode(GL_PROJECTION);
+    glLoadMatrixf(glm::value_ptr(projection));
+    glMatrixMode(GL_MODELVIEW);
+    glLoadMatrixf(glm::value_ptr(view));
+}
+
+
+bool ViewportLayout::viewAt(double mouse_x, double mouse_y, size_t& out_view) const {
+    const double gl_y = WINDOW_HEIGHT - mouse_y;
+    for(size_t v = 0; v < count; ++v) {
+        const ViewRect rect = getRect(v);
+        if(mouse_x >= rect.x && mouse_x < rect.x + rect.width && gl_y >= rect.y && gl_y < rect.y + rect.height) {
+            out_view = v;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ViewportLayout::screenRay(size_t v, double mouse_x, double mouse_y, glm::vec3& out_origin, glm::vec3& out_dir) const {
+    const ViewRect rect = getRect(v);
+    const glm::mat4 projection = getProjection(v);
+    const glm::mat4 view = getViewMatrix(v);
+    const glm::vec4 viewport(rect.x, rect.y, rect.width, rect.height);
+    const float win_x = static_cast<float>(mouse_x);
+    const float win_y = static_cast<float>(WINDOW_HEIGHT - mouse_y);      // 마우스는 좌상단 기준
+    glm::vec3 ray_near = glm::unProject(glm::vec3(win_x, win_y, 0.0f), view, projection, viewport);
+    glm::vec3 ray_far = glm::unProject(glm::vec3(win_x, win_y, 1.0f), view, projection, viewport);
+    out_origin = ray_near;
+    out_dir = glm::normalize(ray_far - ray_near);
+}
+
+
+void ViewportLayout::renderFrames(const Space& space) const {
+    if(count < 2) {
+        return;
+    }
+
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    gluOrtho2D(0, WINDOW_WIDTH, 0, WINDOW_HEIGHT);
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+    glDisable(GL_DEPTH_TEST);
+
+    glLineWidth(1.0f);
+    glColor3f(0.5f, 0.5f, 0.5f);
+    glBegin(GL_LINES);
+    glVertex2f(WINDOW_WIDTH / 2, 0.0f);     glVertex2f(WINDOW_WIDTH / 2, WINDOW_HEIGHT);
+    if(count == 4) {
+        glVertex2f(0.0f, WINDOW_HEIGHT / 2);    glVertex2f(WINDOW_WIDTH, WINDOW_HEIGHT / 2);
+    }
+    glEnd();
+
+    glEnable(GL_DEPTH_TEST);
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+
+    // 보기 이름 : 보기 우상단 (좌상단은 객체 정보 글자)
+    const glm::vec3 gray(0.8f, 0.8f, 0.8f);
+    for(size_t v = 0; v < count; ++v) {
+        const ViewRect rect = getRect(v);
+        space.renderText2D(kindName(kinds[v]), rect.x + rect.width - 70.0f, WINDOW_HEIGHT - (rect.y + rect.height) + 20.0f, gray);
+    }
+}
+
+const char* ViewportLayout::kindName(ViewKind kind) {
+    switch(kind) {
+    case VIEW_ORBIT: return "orbit";
+    case VIEW_TOP:   return "top";
+    case VIEW_SIDE:  return "side";
+    case VIEW_FRONT: return "front";
+    }
+    return "";
+}
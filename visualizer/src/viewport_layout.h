@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "configs.h"
+#include "camera.h"
+
+class Space;
+
+
+// 창 안의 보기 영역 - GL viewport 좌표 (좌하단 원점) // pixel
+struct ViewRect {
+    int x, y, width, height;
+};
+
+// 한 창에 보기 1 / 2 / 4개 배치 (configs.h view_layout_*) - 보기마다 카메라 / 투영만 다르고 그리는 점 버퍼는 하나
+// 프레임 : lidarIntoSpace로 한 번 준비 / 업로드 -> 보기마다 apply + Space::renderScene (보기를 늘려도 draw call만 늘어남)
+//          -> restoreFullWindow 뒤 2D 글자 / overlay는 창 전체에 한 번
+// ORBIT 보기는 궤도 카메라 그대로, 나머지는 update에서 같은 중심 / 수평 방향 / 반지름으로 계산 -> 조작하면 모든 보기가 같이 움직임
+class ViewportLayout {
+public:
+    ViewportLayout();
+
+    void setViewCount(size_t count);    // 1, 2, 4 (그 사이 값은 작은 쪽 배치)
+    void cycle();                       // 1 -> 2 -> 4 -> 1
+    size_t getViewCount() const;
+    ViewKind getKind(size_t v) const;
+
+    // 궤도 카메라 위치 / 중심 / 반지름으로 보기별 카메라 갱신 (프레임마다 한 번)
+    void update(const glm::vec3& eye, const glm::vec3& target, float radius);
+
+    ViewRect getRect(size_t v) const;
+    glm::mat4 getViewMatrix(size_t v) const;
+    glm::mat4 getProjection(size_t v) const;
+    void apply(size_t v) const;             // glViewport + 투영 / view 행렬 적재
+    void restoreFullWindow() const;         // 창 전체 viewport + ORBIT 보기 투영 / 행렬 (overlay는 창 전체 기준)
+
+    // 마우스 좌표(좌상단 기준) 아래 보기, 창 밖이면 false
+    bool viewAt(double mouse_x, double mouse_y, size_t& out_view) const;
+    // 마우스 좌표 -> 보기 v의 광선 (picking)
+    void screenRay(size_t v, double mouse_x, double mouse_y, glm::vec3& out_origin, glm::vec3& out_dir) const;
+
+    // 보기 경계선 + 보기 이름 (2개 이상일 때) - restoreFullWindow 뒤에 호출
+    void renderFrames(const Space& space) const;
+
+    static const char* kindName(ViewKind kind);
+
+private:
+    const ViewKind* kinds;
+    size_t count;
+    Camera cameras[4];
+    float ortho_half_height;
+};